@@ -23,14 +23,13 @@ SOFTWARE.
 #include "EditorResources.h"
 
 #include <yave/graphics/shaders/SpirVData.h>
+#include <yave/graphics/shaders/ShaderBundle.h>
 #include <yave/graphics/shaders/ShaderModule.h>
 #include <yave/graphics/shaders/ComputeProgram.h>
 
 #include <yave/material/MaterialTemplate.h>
 #include <yave/graphics/device/DebugUtils.h>
 
-#include <y/io2/File.h>
-
 #include <y/utils/format.h>
 
 namespace editor {
@@ -73,13 +72,13 @@ EditorResources::~EditorResources() {
 }
 
 void EditorResources::load_resources() {
+    const ShaderBundle bundle = ShaderBundle::open_default();
+
     core::FlatHashMap<core::String, SpirVData> spirvs;
     auto load_spirv = [&](std::string_view name) -> const SpirVData& {
-        y_debug_assert(!name.empty());
-        const core::String filename = fmt_to_owned("{}.spv", name);
-        auto& spirv = spirvs[filename];
+        auto& spirv = spirvs[name];
         if(spirv.is_empty()) {
-            spirv = SpirVData::deserialized(io2::File::open(filename).expected(fmt_c_str("Unable to open SPIR-V file ({})", filename)));
+            spirv = bundle.load(name);
         }
         return spirv;
     };
@@ -38,10 +38,12 @@ SOFTWARE.
 #include <yave/components/TransformableComponent.h>
 #include <yave/components/AtmosphereComponent.h>
 
+#include <yave/systems/AnimationSystem.h>
 #include <yave/systems/AssetLoaderSystem.h>
 #include <yave/systems/JoltPhysicsSystem.h>
 #include <yave/systems/SceneSystem.h>
 #include <yave/systems/TimeSystem.h>
+#include <yave/systems/TransformSystem.h>
 
 #include <editor/systems/DebugAnimateSystem.h>
 #include <editor/systems/UndoRedoSystem.h>
@@ -67,6 +69,8 @@ EditorWorld::EditorWorld(AssetLoader& loader) {
     add_system<DebugAnimateSystem>();
     add_system<UndoRedoSystem>();
     add_system<JoltPhysicsSystem>();
+    add_system<AnimationSystem>();
+    add_system<TransformSystem>();
     add_system<SceneSystem>();
     add_system<TimeSystem>(0.0f);
 }
@@ -119,6 +119,9 @@ static Texture render_world(ecs::EntityWorld& world) {
 
     const SceneView scene_view(&scene, camera);
 
+    // Thumbnails are cached, so they can't skip batches whose pipeline is still compiling
+    DefaultRenderer::precompile_pipelines(&scene, true);
+
     CmdBufferRecorder recorder = create_disposable_cmd_buffer();
     StorageTexture out = StorageTexture(ImageFormat(VK_FORMAT_R8G8B8A8_UNORM), math::Vec2ui(ThumbnailRenderer::thumbnail_size));
     {
@@ -142,7 +145,7 @@ static Texture render_world(ecs::EntityWorld& world) {
             FrameGraphComputePassBuilder builder = graph.add_compute_pass("Thumbnail copy pass");
             builder.add_uniform_input(output_image);
             builder.add_uniform_input(renderer.gbuffer.depth);
-            builder.add_external_input(StorageView(out));
+            builder.add_external_output(StorageView(out));
             builder.set_render_func([size = out.size()](CmdBufferRecorder& rec, const FrameGraphPass* self) {
                 rec.dispatch_threads(resources()[EditorResources::ThumbnailProgram], size, self->descriptor_set());
             });
@@ -261,7 +264,10 @@ std::unique_ptr<ThumbnailRenderer::ThumbnailData> ThumbnailRenderer::schedule_re
 
                     const MeshDrawData& draw_data = ptr->draw_data();
                     data->infos.emplace_back(fmt("Vertices: {}", draw_data.vertex_count()));
-                    data->infos.emplace_back(fmt("Triangles: {}", draw_data.draw_command().index_count / 3));
+                    data->infos.emplace_back(fmt("Triangles: {}", ptr->draw_command().index_count / 3));
+                    if(ptr->lod_count() > 1) {
+                        data->infos.emplace_back(fmt("LODs: {}", ptr->lod_count()));
+                    }
                 }
             break;
 
@@ -36,6 +36,7 @@ SOFTWARE.
 #include <yave/utils/DebugValues.h>
 #include <yave/systems/SceneSystem.h>
 #include <yave/systems/JoltPhysicsSystem.h>
+#include <yave/renderer/DefaultRenderer.h>
 
 #include <y/io2/File.h>
 #include <y/serde3/archives.h>
@@ -91,6 +92,9 @@ enum DeferredActions : u32 {
 };
 
 u32 deferred_actions = None;
+
+// Set when a world is created, pipelines are precompiled once its assets are done loading
+bool precompile_pending = false;
 }
 
 
@@ -99,6 +103,8 @@ u32 deferred_actions = None;
 static void create_scene_view() {
     application::default_scene_view = SceneView(&current_scene());
     set_scene_view(nullptr);
+
+    application::precompile_pending = true;
 }
 
 static void save_world_deferred() {
@@ -147,6 +153,13 @@ static void load_world_deferred() {
 
 void post_tick() {
     y_profile();
+
+    // The world has ticked at least once since it was created, so its assets have been requested
+    if(application::precompile_pending && !application::loader->is_loading()) {
+        DefaultRenderer::precompile_pipelines(&current_scene());
+        application::precompile_pending = false;
+    }
+
     {
         if(application::deferred_actions & application::Save) {
             save_world_deferred();
@@ -25,7 +25,13 @@ SOFTWARE.
 #include <yave/graphics/images/ImageData.h>
 
 #include <y/core/ScratchPad.h>
+#include <y/core/Chrono.h>
+#include <y/concurrent/JobSystem.h>
+
 #include <y/utils/log.h>
+#include <y/utils/format.h>
+
+#include <bit>
 
 #include <external/bc7enc_rdo/bc7enc.h>
 #include <external/bc7enc_rdo/rgbcx.h>
@@ -46,151 +52,358 @@ static ImageData copy(const ImageData& image) {
     return ImageData(image.size().to<2>(), image.data(), image.format(), image.mipmaps());
 }
 
-static void unpack_with_gamma(const u8* in, usize size, float* out) {
-    y_profile();
-    float gamma_lut[256];
-    for(usize i = 0; i != 256; ++i) {
-        gamma_lut[i] = std::pow(i / 255.0f, 2.2f);
+static concurrent::JobSystem& image_job_system() {
+    static concurrent::JobSystem job_system;
+    return job_system;
+}
+
+
+
+static float srgb_to_linear(float x) {
+    return x <= 0.04045f ? x / 12.92f : std::pow((x + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linear_to_srgb(float x) {
+    return x <= 0.0031308f ? x * 12.92f : 1.055f * std::pow(x, 1.0f / 2.4f) - 0.055f;
+}
+
+struct SRGBLuts {
+    static constexpr usize from_linear_size = 1 << 12;
+
+    std::array<float, 256> to_linear;
+    std::array<u8, from_linear_size> from_linear;
+
+    SRGBLuts() {
+        for(usize i = 0; i != to_linear.size(); ++i) {
+            to_linear[i] = srgb_to_linear(i / 255.0f);
+        }
+        for(usize i = 0; i != from_linear.size(); ++i) {
+            from_linear[i] = u8(std::round(linear_to_srgb(i / float(from_linear_size - 1)) * 255.0f));
+        }
     }
+};
+
+static const SRGBLuts& srgb_luts() {
+    static const SRGBLuts luts;
+    return luts;
+}
 
-    for(usize i = 0; i != size; ++i) {
-        out[i] = gamma_lut[in[i]];
-        y_debug_assert(out[i] >= 0.0f);
-        y_debug_assert(out[i] <= 1.0f);
+static float half_to_float(u16 h) {
+    const u32 sign = u32(h & 0x8000) << 16;
+    const u32 exponent = (h >> 10) & 0x1F;
+    const u32 mantissa = h & 0x3FF;
+
+    if(exponent == 0) {
+        const float f = std::ldexp(float(mantissa), -24);
+        return sign ? -f : f;
     }
+
+    const u32 bits = exponent == 0x1F
+        ? (sign | 0x7F800000 | (mantissa << 13))
+        : (sign | ((exponent + 112) << 23) | (mantissa << 13));
+    return std::bit_cast<float>(bits);
 }
 
-static void unpack(const u8* in, usize size, float* out) {
-    y_profile();
-    for(usize i = 0; i != size; ++i) {
-        out[i] = in[i] / 255.0f;
-        y_debug_assert(out[i] >= 0.0f);
-        y_debug_assert(out[i] <= 1.0f);
+static u16 float_to_half(float f) {
+    const u32 bits = std::bit_cast<u32>(f);
+    const u16 sign = u16((bits >> 16) & 0x8000);
+    const u32 abs_bits = bits & 0x7FFFFFFF;
+
+    if(abs_bits >= 0x7F800000) {
+        return sign | 0x7C00 | (abs_bits > 0x7F800000 ? 0x200 : 0);
+    }
+    if(abs_bits >= 0x477FF000) {
+        return sign | 0x7C00;
     }
+    if(abs_bits < 0x38800000) {
+        return sign | u16(std::round(std::bit_cast<float>(abs_bits) * 16777216.0f));
+    }
+
+    // Round to nearest even
+    const u32 rounded = abs_bits + 0xFFF + ((abs_bits >> 13) & 1);
+    return sign | u16((rounded - 0x38000000) >> 13);
 }
 
-static void pack_with_gamma(const float* in, usize size, u8* out) {
-    y_profile();
-    const usize lut_size = 1 << 12;
-    const float lut_factor = float(lut_size - 1);
-    const float inv_lut_factor = 1.0f / lut_factor;
-    const float inv_gamma = 1.0f / 2.2f;
-
-    u8 gamma_lut[lut_size];
-    for(usize i = 0; i != lut_size; ++i) {
-        const float with_gamma = std::pow(i * inv_lut_factor, inv_gamma);
-        y_debug_assert(with_gamma <= 1.0f);
-        gamma_lut[i] = u8(with_gamma * 255.0f);
+
+enum class TexelEncoding {
+    Unorm8,
+    Float16,
+    Float32,
+};
+
+static TexelEncoding texel_encoding(ImageFormat format) {
+    const usize components = format.components();
+    if(format.is_float()) {
+        return format.bit_per_pixel() == 16 * components ? TexelEncoding::Float16 : TexelEncoding::Float32;
     }
+    return TexelEncoding::Unorm8;
+}
 
-#ifdef USE_SIMD
-    const __m128 norm = _mm_set1_ps(lut_factor);
-
-    y_always_assert(size % 4 == 0, "Size should be a multiple of 4");
-    for(usize i = 0; i != size; i += 4) {
-        const __m128 a = _mm_loadu_ps(in + i);
-        const __m128 b = _mm_mul_ps(a, norm);
-        const __m128 c = _mm_round_ps(b, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);    // round
-        const __m128i d = _mm_cvtps_epi32(c);           // to int
-        const u32* indices = reinterpret_cast<const u32*>(&d);
-        for(usize comp = 0; comp != 4; ++comp) {
-            out[i + comp] = gamma_lut[indices[comp]];
-        }
+static bool is_mipmapable(ImageFormat format) {
+    if(format.is_block_format() || format.is_depth_format()) {
+        return false;
     }
-#else
-    for(usize i = 0; i != size; ++i) {
-        const usize lut_index = usize(std::round(in[i] * lut_factor));
-        y_debug_assert(lut_index < lut_size);
-        out[i] = gamma_lut[lut_index];
+
+    const usize components = format.components();
+    if(format.is_float()) {
+        return format.bit_per_pixel() == 16 * components || format.bit_per_pixel() == 32 * components;
     }
-#endif
+    return format.bit_per_pixel() == 8 * components;
+}
+
+// Alpha is always stored linearly, even in sRGB formats
+static bool is_gamma_corrected(ImageFormat format, usize component) {
+    return format.is_sRGB() && (format.components() != 4 || component != 3);
 }
 
-static void pack(const float* in, usize size, u8* out) {
+static void unpack(const ImageFormat& format, const u8* in, usize size, float* out) {
     y_profile();
 
-#ifdef USE_SIMD
-    const char n = 15;
-    const __m128 norm = _mm_set1_ps(255.0f);
-    const __m128i mask = _mm_set_epi8(n, n, n, n, n, n, n, n, n, n, n, n, 12, 8, 4, 0);
-
-    y_always_assert(size % 4 == 0, "Size should be a multiple of 4");
-    for(usize i = 0; i != size; i += 4) {
-        const __m128 a = _mm_loadu_ps(in + i);
-        const __m128 b = _mm_mul_ps(a, norm);
-        const __m128 c = _mm_round_ps(b, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);    // round
-        const __m128i d = _mm_cvtps_epi32(c);           // to int
-        const __m128i e = _mm_shuffle_epi8(d, mask);    // extract bytes
-        _mm_storeu_si32(out + i, e);                    // store
-    }
-#else
-    for(usize i = 0; i < size; ++i) {
-        y_debug_assert(in[i] >= 0.0f);
-        y_debug_assert(in[i] <= 1.0f);
-        out[i] = u8(std::round(in[i] * 255.0f));
+    switch(texel_encoding(format)) {
+        case TexelEncoding::Float32:
+            std::memcpy(out, in, size * sizeof(float));
+        break;
+
+        case TexelEncoding::Float16:
+            for(usize i = 0; i != size; ++i) {
+                u16 h = 0;
+                std::memcpy(&h, in + i * sizeof(u16), sizeof(u16));
+                out[i] = half_to_float(h);
+            }
+        break;
+
+        case TexelEncoding::Unorm8: {
+            const usize components = format.components();
+
+            std::array<const float*, 4> luts = {};
+            std::array<float, 256> unorm_lut;
+            for(usize i = 0; i != unorm_lut.size(); ++i) {
+                unorm_lut[i] = i / 255.0f;
+            }
+            for(usize c = 0; c != components; ++c) {
+                luts[c] = is_gamma_corrected(format, c) ? srgb_luts().to_linear.data() : unorm_lut.data();
+            }
+
+            for(usize i = 0; i < size; i += components) {
+                for(usize c = 0; c != components; ++c) {
+                    out[i + c] = luts[c][in[i + c]];
+                }
+            }
+        } break;
     }
-#endif
 }
 
-core::FixedArray<float> compute_mipmaps_internal(core::FixedArray<float> input, const math::Vec2ui& size, usize components, usize mip_count) {
+static void pack(const ImageFormat& format, const float* in, usize size, u8* out) {
     y_profile();
 
-    y_debug_assert(size.x() * size.y() * components == input.size());
+    switch(texel_encoding(format)) {
+        case TexelEncoding::Float32:
+            std::memcpy(out, in, size * sizeof(float));
+        break;
+
+        case TexelEncoding::Float16:
+            for(usize i = 0; i != size; ++i) {
+                const u16 h = float_to_half(in[i]);
+                std::memcpy(out + i * sizeof(u16), &h, sizeof(u16));
+            }
+        break;
 
-    const ImageFormat normalized_format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    const usize output_size = ImageData::byte_size(math::Vec3ui(size, 1), normalized_format, mip_count) / sizeof(float);
+        case TexelEncoding::Unorm8: {
+            const usize components = format.components();
+            const float lut_factor = float(SRGBLuts::from_linear_size - 1);
+            const u8* from_linear = srgb_luts().from_linear.data();
 
-    core::FixedArray<float> output(output_size);
-    {
-        const auto compute_mip = [&](const float* image_data, float* out, const math::Vec2ui& orig_size) -> usize {
-            y_profile_zone("compute mip");
-
-            usize cursor = 0;
-            const math::Vec2ui mip_size = {
-                std::max(1u, orig_size.x() / 2),
-                std::max(1u, orig_size.y() / 2),
-            };
-
-            const math::Vec2 factors = math::Vec2(orig_size) / math::Vec2(mip_size);
-            const float texel_width = factors.x() * 0.5f;
-            const usize row_size = mip_size.y() > 1
-                ? std::min(orig_size.x(), u32(orig_size.x() * texel_width))
-                : 0u;
-
-            for(usize y = 0; y != mip_size.y(); ++y) {
-                for(usize x = 0; x != mip_size.x(); ++x) {
-                    const usize orig = (u32(x * factors.x()) + u32(y * factors.y()) * row_size);
-                    y_debug_assert(usize(orig + row_size + texel_width) <= orig_size.x() * orig_size.y());
-
-                    for(usize cc = 0; cc != components; ++cc) {
-                        const float a = image_data[components * usize(orig) + cc];
-                        const float b = image_data[components * usize(orig + texel_width) + cc];
-                        const float c = image_data[components * usize(orig + row_size) + cc];
-                        const float d = image_data[components * usize(orig + row_size + texel_width) + cc];
-                        y_debug_assert((a + b + c + d) >= 0.0f);
-                        out[cursor++] = std::min((a + b + c + d) * 0.25f, 1.0f);
+            std::array<bool, 4> gamma = {};
+            for(usize c = 0; c != components; ++c) {
+                gamma[c] = is_gamma_corrected(format, c);
+            }
+
+#ifdef USE_SIMD
+            if(components == 4) {
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 one = _mm_set1_ps(1.0f);
+                const __m128 norm = _mm_setr_ps(
+                    gamma[0] ? lut_factor : 255.0f,
+                    gamma[1] ? lut_factor : 255.0f,
+                    gamma[2] ? lut_factor : 255.0f,
+                    gamma[3] ? lut_factor : 255.0f
+                );
+
+                for(usize i = 0; i < size; i += 4) {
+                    const __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), zero), one);   // clamp
+                    const __m128 b = _mm_round_ps(_mm_mul_ps(a, norm), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                    alignas(16) std::array<i32, 4> indices;
+                    _mm_store_si128(reinterpret_cast<__m128i*>(indices.data()), _mm_cvtps_epi32(b));
+                    for(usize c = 0; c != 4; ++c) {
+                        out[i + c] = gamma[c] ? from_linear[indices[c]] : u8(indices[c]);
                     }
                 }
+                break;
             }
-            return cursor;
-        };
+#endif
 
+            for(usize i = 0; i < size; i += components) {
+                for(usize c = 0; c != components; ++c) {
+                    const float v = std::clamp(in[i + c], 0.0f, 1.0f);
+                    out[i + c] = gamma[c]
+                        ? from_linear[usize(std::round(v * lut_factor))]
+                        : u8(std::round(v * 255.0f));
+                }
+            }
+        } break;
+    }
+}
 
-        float* out_data = output.data();
-        usize mip_values = size.x() * size.y() * components;
-        std::copy_n(input.data(), mip_values, out_data);
 
-        for(usize mip = 0; mip < mip_count - 1; ++mip) {
-            const usize s = compute_mip(out_data, out_data + mip_values, ImageData::mip_size(math::Vec3ui(size, 1), mip).to<2>());
-            out_data += mip_values;
-            mip_values = s;
+static float sinc(float x) {
+    if(std::abs(x) < 1.0e-5f) {
+        return 1.0f;
+    }
+    x *= math::pi<float>;
+    return std::sin(x) / x;
+}
+
+static float bessel_i0(float x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+    for(usize k = 1; k != 32; ++k) {
+        const float f = x / (2.0f * k);
+        term *= f * f;
+        sum += term;
+        if(term < sum * 1.0e-7f) {
+            break;
         }
     }
+    return sum;
+}
 
-    return output;
+// Support, in destination texels
+static float filter_support(MipmapFilter filter) {
+    switch(filter) {
+        case MipmapFilter::Box:       return 0.5f;
+        case MipmapFilter::Kaiser:    return 3.0f;
+        case MipmapFilter::Lanczos:   return 3.0f;
+    }
+    y_fatal("Unknown filter");
+}
+
+static float filter_weight(MipmapFilter filter, float x) {
+    const float support = filter_support(filter);
+    if(std::abs(x) >= support) {
+        return 0.0f;
+    }
+
+    switch(filter) {
+        case MipmapFilter::Box:
+            return 1.0f;
+
+        case MipmapFilter::Kaiser: {
+            const float alpha = 4.0f;
+            const float t = x / support;
+            return sinc(x) * bessel_i0(alpha * std::sqrt(1.0f - t * t)) / bessel_i0(alpha);
+        }
+
+        case MipmapFilter::Lanczos:
+            return sinc(x) * sinc(x / support);
+    }
+    y_fatal("Unknown filter");
 }
 
-ImageData compute_mipmaps(const ImageData& image) {
+// Source texels and normalized weights for every destination texel along one axis, with clamp to edge
+struct FilterTaps {
+    usize tap_count = 0;
+    core::Vector<u32> indices;
+    core::Vector<float> weights;
+
+    FilterTaps(MipmapFilter filter, u32 src_size, u32 dst_size) {
+        const float scale = float(src_size) / float(dst_size);
+        const float support = filter_support(filter) * scale;
+
+        tap_count = usize(std::ceil(support * 2.0f)) + 1;
+        indices.set_min_size(dst_size * tap_count);
+        weights.set_min_size(dst_size * tap_count);
+
+        for(u32 x = 0; x != dst_size; ++x) {
+            const float center = (x + 0.5f) * scale;
+            const i64 first = i64(std::floor(center - support));
+
+            u32* index = indices.data() + x * tap_count;
+            float* weight = weights.data() + x * tap_count;
+
+            float total = 0.0f;
+            for(usize t = 0; t != tap_count; ++t) {
+                const i64 src = first + i64(t);
+                index[t] = u32(std::clamp(src, i64(0), i64(src_size - 1)));
+                weight[t] = filter_weight(filter, (src + 0.5f - center) / scale);
+                total += weight[t];
+            }
+
+            y_debug_assert(total > 0.0f);
+            for(usize t = 0; t != tap_count; ++t) {
+                weight[t] /= total;
+            }
+        }
+    }
+};
+
+// Separable downsample, each destination row is filtered vertically into a temporary row which is then filtered horizontally
+static void compute_mip(MipmapFilter filter, const float* src, const math::Vec2ui& src_size, float* dst, const math::Vec2ui& dst_size, usize components) {
+    y_profile_zone("compute mip");
+
+    const FilterTaps vertical(filter, src_size.y(), dst_size.y());
+    const FilterTaps horizontal(filter, src_size.x(), dst_size.x());
+
+    const usize src_row_size = src_size.x() * components;
+    const usize dst_row_size = dst_size.x() * components;
+
+    image_job_system().parallel_for(u32(0), dst_size.y(), [&](u32 begin, u32 end) {
+        core::FixedArray<float> row_buffer(src_row_size);
+        float* row = row_buffer.data();
+
+        for(u32 y = begin; y != end; ++y) {
+            std::fill_n(row, src_row_size, 0.0f);
+
+            for(usize t = 0; t != vertical.tap_count; ++t) {
+                const float w = vertical.weights[y * vertical.tap_count + t];
+                if(w == 0.0f) {
+                    continue;
+                }
+
+                const float* src_row = src + vertical.indices[y * vertical.tap_count + t] * src_row_size;
+                for(usize i = 0; i != src_row_size; ++i) {
+                    row[i] += src_row[i] * w;
+                }
+            }
+
+            float* dst_row = dst + y * dst_row_size;
+            for(u32 x = 0; x != dst_size.x(); ++x) {
+                const u32* indices = horizontal.indices.data() + x * horizontal.tap_count;
+                const float* weights = horizontal.weights.data() + x * horizontal.tap_count;
+
+#ifdef USE_SIMD
+                if(components == 4) {
+                    __m128 acc = _mm_setzero_ps();
+                    for(usize t = 0; t != horizontal.tap_count; ++t) {
+                        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(row + indices[t] * 4), _mm_set1_ps(weights[t])));
+                    }
+                    _mm_storeu_ps(dst_row + x * 4, acc);
+                    continue;
+                }
+#endif
+
+                for(usize c = 0; c != components; ++c) {
+                    float acc = 0.0f;
+                    for(usize t = 0; t != horizontal.tap_count; ++t) {
+                        acc += row[indices[t] * components + c] * weights[t];
+                    }
+                    dst_row[x * components + c] = acc;
+                }
+            }
+        }
+    });
+}
+
+ImageData compute_mipmaps(const ImageData& image, MipmapFilter filter) {
     y_profile();
 
     if(image.size().z() != 1) {
@@ -198,95 +411,134 @@ ImageData compute_mipmaps(const ImageData& image) {
         return copy(image);
     }
 
-    const bool is_sRGB = image.format().is_sRGB();
-    const usize components = image.format().components();
-    const usize texels = image.size().x() * image.size().y();
-    const usize mip_count = ImageData::mip_count(image.size());
-
-    if(image.format().is_block_format() || image.format().is_depth_format() || image.format().bit_per_pixel() != 8 * components) {
+    const ImageFormat format = image.format();
+    if(!is_mipmapable(format)) {
         log_msg("Unable to generate mipmaps: format is not supported", Log::Error);
         return copy(image);
     }
 
-    core::FixedArray<float> input(texels * components);
+    const usize components = format.components();
+    const usize mip_count = ImageData::mip_count(image.size());
+
+    usize total_values = 0;
+    for(usize i = 0; i != mip_count; ++i) {
+        const math::Vec3ui mip_size = ImageData::mip_size(image.size(), i);
+        total_values += mip_size.x() * mip_size.y() * components;
+    }
+
+    // Filtering is done in linear space, without clamping so HDR values are preserved
+    core::FixedArray<float> values(total_values);
     {
+        const usize base_values = image.size().x() * image.size().y() * components;
         y_profile_zone("unpack");
-        if(is_sRGB) {
-            Y_TODO(Alpha should not be gamma-corrected)
-            unpack_with_gamma(image.data(), input.size(), input.data());
-        } else {
-            unpack(image.data(), input.size(), input.data());
+        unpack(format, image.data(), base_values, values.data());
+    }
+
+    {
+        float* mip_data = values.data();
+        for(usize i = 0; i + 1 < mip_count; ++i) {
+            const math::Vec2ui src_size = ImageData::mip_size(image.size(), i).to<2>();
+            const math::Vec2ui dst_size = ImageData::mip_size(image.size(), i + 1).to<2>();
+            float* next_mip = mip_data + src_size.x() * src_size.y() * components;
+            compute_mip(filter, mip_data, src_size, next_mip, dst_size, components);
+            mip_data = next_mip;
         }
     }
 
-    core::FixedArray<float> output = compute_mipmaps_internal(std::move(input), image.size().to<2>(), components, mip_count);
-    core::FixedArray<u8> data(output.size());
+    core::FixedArray<u8> data(ImageData::byte_size(image.size(), format, mip_count));
     {
         y_profile_zone("pack");
-        if(is_sRGB) {
-            pack_with_gamma(output.data(), output.size(), data.data());
-        } else {
-            pack(output.data(), output.size(), data.data());
-        }
+        y_debug_assert(data.size() == total_values * (format.bit_per_pixel() / (8 * components)));
+
+        // Packing is independent per texel, so we split it in chunks
+        const usize chunk_size = components * 64 * 1024;
+        const usize bytes_per_value = format.bit_per_pixel() / (8 * components);
+        image_job_system().parallel_for(usize(0), (total_values + chunk_size - 1) / chunk_size, [&](usize begin, usize end) {
+            for(usize i = begin; i != end; ++i) {
+                const usize offset = i * chunk_size;
+                const usize size = std::min(chunk_size, total_values - offset);
+                pack(format, values.data() + offset, size, data.data() + offset * bytes_per_value);
+            }
+        });
     }
-    output.clear();
 
     y_profile_zone("building image");
-    return ImageData(image.size().to<2>(), data.data(), image.format(), mip_count);
+    return ImageData(image.size().to<2>(), data.data(), format, mip_count);
 }
 
-
+// Every row of blocks of every mip is compressed as a separate task, so even a single large image uses all threads
 template<typename F>
 ImageData block_compress(const ImageData& image, ImageFormat compressed_format, F&& process_block) {
     if(image.format().bit_per_pixel() == 32 && image.size().z() == 1) {
         y_profile_zone("compress");
 
+        const core::StopWatch timer;
+
         const usize mip_count = image.mipmaps();
         const usize compressed_size = ImageData::byte_size(image.size(), compressed_format, mip_count);
         core::FixedArray<u8> compressed_data(compressed_size);
 
         const math::Vec3ui block_size = compressed_format.block_size();
         y_debug_assert(block_size.z() == 1);
+        y_debug_assert(block_size.x() * block_size.y() <= 16);
 
         const usize block_bytes = (block_size.x() * block_size.y() * compressed_format.bit_per_pixel()) / 8;
+        y_debug_assert(block_bytes <= 16);
 
-        std::array<u8, 16 * 4> in_block;
-        std::array<u8, 16 * 4> out_block;
+        struct BlockRow {
+            u32 mip = 0;
+            u32 y = 0;
+            usize offset = 0;
+        };
+
+        core::Vector<BlockRow> rows;
+        usize texel_count = 0;
+        {
+            usize offset = 0;
+            for(usize i = 0; i != mip_count; ++i) {
+                const math::Vec3ui mip_size = image.mip_size(i);
+                const usize row_bytes = ((mip_size.x() + block_size.x() - 1) / block_size.x()) * block_bytes;
+                for(u32 y = 0; y < mip_size.y(); y += block_size.y()) {
+                    rows << BlockRow{u32(i), y, offset};
+                    offset += row_bytes;
+                }
+                texel_count += mip_size.x() * mip_size.y();
+            }
+            y_debug_assert(offset == compressed_size);
+        }
 
-        y_debug_assert(in_block.size() >= block_size.x() * block_size.y() * 4);
-        y_debug_assert(out_block.size() >= block_bytes);
+        image_job_system().parallel_for(rows.begin(), rows.end(), [&](const BlockRow* begin, const BlockRow* end) {
+            y_profile_zone("compress rows");
 
-        usize offset = 0;
-        for(usize i = 0; i != mip_count; ++i) {
-            y_profile_zone("compress mip");
-            const ImageData::Mip mip = image.mip_data(i);
-            const usize mip_texel_count = mip.size.x() * mip.size.y();
-            unused(mip_texel_count);
+            std::array<u8, 16 * 4> in_block;
 
-            for(usize y = 0; y < mip.size.y(); y += block_size.y()) {
-                for(usize x = 0; x < mip.size.x(); x += block_size.x()) {
+            for(const BlockRow* row = begin; row != end; ++row) {
+                const ImageData::Mip mip = image.mip_data(row->mip);
+                const usize mip_texel_count = mip.size.x() * mip.size.y();
+                unused(mip_texel_count);
 
+                u8* out = compressed_data.data() + row->offset;
+                for(usize x = 0; x < mip.size.x(); x += block_size.x()) {
                     usize block_index = 0;
                     for(usize by = 0; by != block_size.y(); ++by) {
                         for(usize bx = 0; bx != block_size.x(); ++bx) {
-                            const math::Vec2ui coord = math::Vec2ui(x + bx, y + by).min(mip.size.to<2>() - math::Vec2ui(1, 1));
+                            const math::Vec2ui coord = math::Vec2ui(x + bx, row->y + by).min(mip.size.to<2>() - math::Vec2ui(1, 1));
                             const usize image_index = coord.y() * mip.size.x() + coord.x();
                             y_debug_assert(image_index < mip_texel_count);
-                            for(usize c = 0; c != 4; ++c) {
-                                in_block[block_index++] = u8(mip.data[image_index * 4 + c]);
-                            }
+                            std::memcpy(in_block.data() + block_index, mip.data.data() + image_index * 4, 4);
+                            block_index += 4;
                         }
                     }
 
-                    process_block(in_block.data(), out_block.data());
-                    y_debug_assert(offset + block_bytes <= compressed_data.size());
-                    std::memcpy(compressed_data.data() + offset, out_block.data(), block_bytes);
-                    offset += block_bytes;
+                    y_debug_assert(out + block_bytes <= compressed_data.data() + compressed_data.size());
+                    process_block(in_block.data(), out);
+                    out += block_bytes;
                 }
             }
-        }
+        });
 
-        y_debug_assert(offset == compressed_size);
+        const double secs = timer.elapsed().to_secs();
+        log_msg(fmt("Compressed {}x{} image ({} mips) in {:.1f}ms ({:.1f} MPix/s)", image.size().x(), image.size().y(), mip_count, secs * 1000.0, (texel_count / 1000000.0) / std::max(secs, 1.0e-6)), Log::Perf);
 
         return ImageData(image.size().to<2>(), compressed_data.data(), compressed_format, mip_count);
     }
@@ -296,7 +548,7 @@ ImageData block_compress(const ImageData& image, ImageFormat compressed_format,
 }
 
 
-ImageData compress(const ImageData& image, ImageCompression compression) {
+ImageData compress(const ImageData& image, ImageCompression compression, CompressionQuality quality) {
     y_profile();
 
     const ImageFormat format = image.format();
@@ -319,19 +571,30 @@ ImageData compress(const ImageData& image, ImageCompression compression) {
     }
 
     switch(compression) {
-        case ImageCompression::BC1:
-            return block_compress(image, is_srgb ? VK_FORMAT_BC1_RGBA_SRGB_BLOCK : VK_FORMAT_BC1_RGBA_UNORM_BLOCK, [](const u8* src, u8* dst) {
-                rgbcx::encode_bc1(10, dst, src, true, false);
+        case ImageCompression::BC1: {
+            const u32 level = quality == CompressionQuality::Fast ? 2 : (quality == CompressionQuality::Best ? rgbcx::MAX_LEVEL : 10);
+            return block_compress(image, is_srgb ? VK_FORMAT_BC1_RGBA_SRGB_BLOCK : VK_FORMAT_BC1_RGBA_UNORM_BLOCK, [=](const u8* src, u8* dst) {
+                rgbcx::encode_bc1(level, dst, src, true, false);
             });
-        break;
+        } break;
 
         case ImageCompression::BC4:
+            if(quality == CompressionQuality::Best) {
+                return block_compress(image, VK_FORMAT_BC4_UNORM_BLOCK, [](const u8* src, u8* dst) {
+                    rgbcx::encode_bc4_hq(dst, src);
+                });
+            }
             return block_compress(image, VK_FORMAT_BC4_UNORM_BLOCK, [](const u8* src, u8* dst) {
                 rgbcx::encode_bc4(dst, src);
             });
         break;
 
         case ImageCompression::BC5:
+            if(quality == CompressionQuality::Best) {
+                return block_compress(image, VK_FORMAT_BC5_UNORM_BLOCK, [](const u8* src, u8* dst) {
+                    rgbcx::encode_bc5_hq(dst, src);
+                });
+            }
             return block_compress(image, VK_FORMAT_BC5_UNORM_BLOCK, [](const u8* src, u8* dst) {
                 rgbcx::encode_bc5(dst, src);
             });
@@ -341,6 +604,21 @@ ImageData compress(const ImageData& image, ImageCompression compression) {
             bc7enc_compress_block_params params = {};
             bc7enc_compress_block_params_init(&params);
 
+            switch(quality) {
+                case CompressionQuality::Fast:
+                    params.m_max_partitions = 16;
+                    params.m_try_least_squares = false;
+                break;
+
+                case CompressionQuality::Normal:
+                break;
+
+                case CompressionQuality::Best:
+                    params.m_uber_level = BC7ENC_MAX_UBER_LEVEL;
+                    params.m_max_partitions = BC7ENC_MAX_PARTITIONS;
+                break;
+            }
+
             return block_compress(image, is_srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK, [&](const u8* src, u8* dst) {
                 bc7enc_compress_block(dst, src, &params);
             });
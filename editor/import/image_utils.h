@@ -34,8 +34,8 @@ enum class ImageCompression {
     BC7,
 };
 
-[[nodiscard]] ImageData compute_mipmaps(const ImageData& image);
-[[nodiscard]] ImageData compress(const ImageData& image, ImageCompression compression);
+[[nodiscard]] ImageData compute_mipmaps(const ImageData& image, MipmapFilter filter = MipmapFilter::Box);
+[[nodiscard]] ImageData compress(const ImageData& image, ImageCompression compression, CompressionQuality quality = CompressionQuality::Normal);
 
 }
 }
@@ -24,6 +24,8 @@ SOFTWARE.
 #include "image_utils.h"
 
 #include <yave/meshes/Vertex.h>
+#include <yave/meshes/QuantizedVertexStreams.h>
+#include <yave/meshes/mesh_utils.h>
 #include <yave/graphics/images/ImageData.h>
 #include <yave/material/MaterialData.h>
 #include <yave/utils/FileSystemModel.h>
@@ -113,7 +115,7 @@ core::String clean_asset_name(const core::String& name) {
     return n.is_empty() ? core::String("unnamed") : n;
 }
 
-core::Result<ImageData> import_image(const core::String& filename, ImageImportFlags flags) {
+core::Result<ImageData> import_image(const core::String& filename, ImageImportFlags flags, const ImageImportSettings& settings) {
     if(auto file = io2::File::open(filename)) {
         core::Vector<u8> data;
         if(!file.unwrap().read_all(data)) {
@@ -121,14 +123,14 @@ core::Result<ImageData> import_image(const core::String& filename, ImageImportFl
             return core::Err();
         }
 
-        return import_image(data, flags);
+        return import_image(data, flags, settings);
     }
 
     log_msg(fmt_c_str("Unable to open image \"{}\"", filename), Log::Error);
     return core::Err();
 }
 
-core::Result<ImageData> import_image(core::Span<u8> image_data, ImageImportFlags flags) {
+core::Result<ImageData> import_image(core::Span<u8> image_data, ImageImportFlags flags, const ImageImportSettings& settings) {
     y_profile();
 
     const usize req_components = 4;
@@ -156,12 +158,12 @@ core::Result<ImageData> import_image(core::Span<u8> image_data, ImageImportFlags
 
     ImageData img(math::Vec2ui(width, height), stbi_data, format);
     if((flags & ImageImportFlags::GenerateMipmaps) == ImageImportFlags::GenerateMipmaps) {
-        img = compute_mipmaps(img);
+        img = compute_mipmaps(img, settings.mipmap_filter);
     }
 
     if((flags & ImageImportFlags::Compress) == ImageImportFlags::Compress) {
         const bool normal = (flags & ImageImportFlags::IsNormalMap) == ImageImportFlags::IsNormalMap;
-        img = compress(img, normal ? ImageCompression::BC5 : ImageCompression::BC7);
+        img = compress(img, normal ? ImageCompression::BC5 : ImageCompression::BC7, settings.compression_quality);
     }
 
     return core::Ok(std::move(img));
@@ -545,14 +547,18 @@ core::Result<ParsedScene> parse_scene(const core::String& filename) {
     return core::Ok(std::move(scene));
 }
 
-core::Result<MeshData> ParsedScene::create_mesh(int index) const {
+core::Result<MeshData> ParsedScene::create_mesh(int index, bool quantize_vertices) const {
     if(index < 0) {
         return core::Err();
     }
 
     const tinygltf::Mesh& mesh = gltf->meshes[index];
 
+    static constexpr usize max_lod_count = 4;
+
     MeshData mesh_data;
+    core::Vector<core::Vector<MeshLod>> primitive_lods;
+    core::Vector<u32> vertex_offsets;
     for(usize i = 0; i != mesh.primitives.size(); ++i) {
         const tinygltf::Primitive& primitive = mesh.primitives[i];
 
@@ -567,7 +573,75 @@ core::Result<MeshData> ParsedScene::create_mesh(int index) const {
             return core::Err();
         }
 
+        const usize vertex_count = vertex_streams.unwrap().vertex_count();
+        for(const IndexedTriangle& tri : triangles.unwrap()) {
+            if(tri[0] >= vertex_count || tri[1] >= vertex_count || tri[2] >= vertex_count) {
+                log_msg("Invalid vertex index", Log::Error);
+                return core::Err();
+            }
+        }
+
+        core::Vector<MeshData::Meshlet> meshlets;
+        const MeshOptimizationStats stats = optimize_mesh(vertex_streams.unwrap(), triangles.unwrap(), &meshlets);
+        log_msg(fmt("\"{}\"[{}]: {} -> {} vertices, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, {} meshlets",
+            mesh.name, i,
+            stats.vertex_count_before, stats.vertex_count_after,
+            stats.before.acmr, stats.after.acmr,
+            stats.before.atvr, stats.after.atvr,
+            meshlets.size()
+        ), Log::Perf);
+
+        primitive_lods << generate_lods(vertex_streams.unwrap().stream<VertexStreamType::Position>(), triangles.unwrap(), max_lod_count);
+        vertex_offsets << u32(mesh_data.vertex_streams().vertex_count());
+
         mesh_data.add_sub_mesh(std::move(vertex_streams.unwrap()), std::move(triangles.unwrap()));
+        mesh_data.add_meshlets(i, meshlets);
+    }
+
+    // Every LOD needs all the sub-meshes: primitives that could not be simplified as much reuse their coarsest LOD
+    usize lod_count = 1;
+    for(const core::Vector<MeshLod>& lods : primitive_lods) {
+        lod_count = std::max(lod_count, lods.size() + 1);
+    }
+
+    for(usize lod = 1; lod != lod_count; ++lod) {
+        float lod_error = 0.0f;
+        core::Vector<IndexedTriangle> lod_triangles;
+        core::Vector<MeshData::SubMesh> lod_sub_meshes;
+
+        for(usize i = 0; i != primitive_lods.size(); ++i) {
+            const u32 first_triangle = u32(lod_triangles.size());
+            if(primitive_lods[i].is_empty()) {
+                const MeshData::SubMesh sub_mesh = mesh_data.sub_meshes()[i];
+                const core::Span<IndexedTriangle> triangles = mesh_data.triangles();
+                std::copy_n(triangles.begin() + sub_mesh.first_triangle, sub_mesh.triangle_count, std::back_inserter(lod_triangles));
+            } else {
+                const MeshLod& mesh_lod = primitive_lods[i][std::min(lod, primitive_lods[i].size()) - 1];
+                for(const IndexedTriangle& tri : mesh_lod.triangles) {
+                    lod_triangles << IndexedTriangle{tri[0] + vertex_offsets[i], tri[1] + vertex_offsets[i], tri[2] + vertex_offsets[i]};
+                }
+                lod_error = std::max(lod_error, mesh_lod.error);
+            }
+            lod_sub_meshes << MeshData::SubMesh{u32(lod_triangles.size()) - first_triangle, first_triangle};
+        }
+
+        log_msg(fmt("\"{}\" LOD {}: {} triangles, error {:.4f}", mesh.name, lod, lod_triangles.size(), lod_error), Log::Perf);
+
+        mesh_data.add_lod(lod_error, lod_triangles, lod_sub_meshes);
+    }
+
+    if(quantize_vertices) {
+        // Only done to report the savings and errors, the actual quantization happens when the mesh is uploaded
+        const QuantizedVertexStreams quantized = QuantizedVertexStreams::quantize(mesh_data.vertex_streams());
+        const usize full_size = mesh_data.vertex_streams().vertex_count() * MeshVertexStreams::total_vertex_size;
+        log_msg(fmt("\"{}\" quantized: {} -> {} KB ({:.1f}% saved), max position error {:.6f}, max uv error {:.6f}",
+            mesh.name,
+            full_size / 1024, quantized.byte_size() / 1024,
+            full_size ? (1.0f - float(quantized.byte_size()) / float(full_size)) * 100.0f : 0.0f,
+            quantized.max_position_error(), quantized.max_uv_error()
+        ), Log::Perf);
+
+        mesh_data.set_quantized_vertices(true);
     }
 
     return core::Ok(std::move(mesh_data));
@@ -674,7 +748,7 @@ core::Result<MaterialData> ParsedScene::create_material(int index) const {
     return core::Ok(std::move(mat_data));
 }
 
-core::Result<ImageData> ParsedScene::create_image(int index, bool compress) const {
+core::Result<ImageData> ParsedScene::create_image(int index, bool compress, const ImageImportSettings& settings) const {
     if(index < 0) {
         return core::Err();
     }
@@ -702,12 +776,12 @@ core::Result<ImageData> ParsedScene::create_image(int index, bool compress) cons
         const FileSystemModel* fs = FileSystemModel::local_filesystem();
         const auto path = fs->parent_path(filename);
         const core::String image_path = path ? fs->join(path.unwrap(), image.uri) : core::String(image.uri);
-        return import_image(image_path, flags);
+        return import_image(image_path, flags, settings);
     }
 
     const tinygltf::BufferView& view = gltf->bufferViews[image.bufferView];
     const tinygltf::Buffer& buffer = gltf->buffers[view.buffer];
-    return import_image(core::Span<u8>(buffer.data.data() + view.byteOffset, view.byteLength), flags);
+    return import_image(core::Span<u8>(buffer.data.data() + view.byteOffset, view.byteLength), flags, settings);
 }
 
 core::String supported_scene_extensions() {
@@ -42,6 +42,23 @@ namespace import {
 // ----------------------------- UTILS -----------------------------
 core::String clean_asset_name(const core::String& name);
 
+enum class MipmapFilter {
+    Box,
+    Kaiser,     // Kaiser windowed sinc, sharper than box with little ringing
+    Lanczos,    // Lanczos 3, sharpest
+};
+
+enum class CompressionQuality {
+    Fast,
+    Normal,
+    Best,
+};
+
+struct ImageImportSettings {
+    MipmapFilter mipmap_filter = MipmapFilter::Box;
+    CompressionQuality compression_quality = CompressionQuality::Normal;
+};
+
 
 
 
@@ -103,9 +120,9 @@ struct ParsedScene : NonCopyable {
 
     std::unique_ptr<tinygltf::Model, std::function<void(tinygltf::Model*)>> gltf;
 
-    core::Result<MeshData> create_mesh(int index) const;
+    core::Result<MeshData> create_mesh(int index, bool quantize_vertices = false) const;
     core::Result<MaterialData> create_material(int index) const;
-    core::Result<ImageData> create_image(int index, bool compress = false) const;
+    core::Result<ImageData> create_image(int index, bool compress = false, const ImageImportSettings& settings = {}) const;
 };
 
 
@@ -127,8 +144,8 @@ enum class ImageImportFlags {
     IsNormalMap     = 0x08,
 };
 
-core::Result<ImageData> import_image(const core::String& filename, ImageImportFlags flags = ImageImportFlags::None);
-core::Result<ImageData> import_image(core::Span<u8> image_data, ImageImportFlags flags = ImageImportFlags::None);
+core::Result<ImageData> import_image(const core::String& filename, ImageImportFlags flags = ImageImportFlags::None, const ImageImportSettings& settings = {});
+core::Result<ImageData> import_image(core::Span<u8> image_data, ImageImportFlags flags = ImageImportFlags::None, const ImageImportSettings& settings = {});
 core::String supported_image_extensions();
 
 
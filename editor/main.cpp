@@ -55,6 +55,8 @@ static void parse_args(int argc, char** argv) {
             inst_params.validation_layers = true;
         } else if(arg == "--nort") {
             inst_params.raytracing = false;
+        } else if(arg == "--coldcache") {
+            inst_params.pipeline_cache = false;
         } else if(arg == "--nomv") {
             multi_viewport = false;
         } else if(arg == "--mv") {
@@ -71,7 +71,7 @@ static core::Result<void> export_to_obj(const MeshData& mesh, io2::Writer& write
 
     y_try_discard(write("s 0\n"));
 
-    for(const IndexedTriangle& triangle : mesh.triangles()) {
+    for(const IndexedTriangle& triangle : mesh.lod_triangles(0)) {
         const IndexedTriangle tri = {triangle[0] + 1, triangle[1] + 1, triangle[2] + 1};
         y_try_discard(write(fmt("f {}/{}/{} {}/{}/{} {}/{}/{}\n",
             tri[0], tri[0], tri[0],
@@ -223,7 +223,7 @@ void AssetStringifier::stringify(MeshData mesh) {
     };
 
     fmt_into(_vertices, "{}", vertices);
-    fmt_into(_triangles, "{}", mesh.triangles());
+    fmt_into(_triangles, "{}", mesh.lod_triangles(0));
 
     auto fix_brackets = [](char& c) {
             if(c == '[') {
@@ -29,6 +29,8 @@ SOFTWARE.
 
 #include <yave/scene/SceneView.h>
 #include <yave/graphics/device/MeshAllocator.h>
+#include <yave/graphics/device/MaterialAllocator.h>
+#include <yave/graphics/images/TextureLibrary.h>
 #include <yave/components/TransformableComponent.h>
 #include <yave/components/StaticMeshComponent.h>
 #include <yave/components/PointLightComponent.h>
@@ -262,6 +264,52 @@ class MeshAllocatorDebug : public Widget {
                 ImGui::ProgressBar(float(tris) / MeshAllocator::default_triangle_count, ImVec2(-1.0f, 0.0f),
                     fmt_c_str("{}k / {}k", tris / 1000, MeshAllocator::default_triangle_count / 1000)
                 );
+
+                ImGui::Text("Fragmentation: %.1f%% (%u free blocks)", mesh_allocator().fragmentation() * 100.0f, unsigned(mesh_allocator().free_blocks()));
+                if(ImGui::Button("Defragment")) {
+                    mesh_allocator().defragment();
+                }
+            }
+        }
+};
+
+
+class MaterialAllocatorDebug : public Widget {
+    editor_widget(MaterialAllocatorDebug, "View", "Debug")
+
+    public:
+        MaterialAllocatorDebug() : Widget("Material allocator debug") {
+        }
+
+    protected:
+        void on_gui() override {
+            const auto reuse_ratio = [](u64 reused, u64 total) {
+                return total ? float(reused) / float(total) * 100.0f : 0.0f;
+            };
+
+            {
+                const MaterialAllocator& materials = material_allocator();
+                const usize allocated = materials.allocated();
+                const usize capacity = materials.capacity();
+
+                ImGui::TextUnformatted("Material buffer:");
+                ImGui::SameLine();
+                ImGui::ProgressBar(float(allocated) / float(capacity), ImVec2(-1.0f, 0.0f), fmt_c_str("{} / {}", allocated, capacity));
+                ImGui::Text("Reused slots: %.1f%%", reuse_ratio(materials.reused_allocations(), materials.total_allocations()));
+            }
+
+            ImGui::Separator();
+
+            {
+                const TextureLibrary& textures = texture_library();
+                const u32 used = textures.used_descriptors();
+                const u32 capacity = textures.capacity();
+
+                ImGui::TextUnformatted("Texture library:");
+                ImGui::SameLine();
+                ImGui::ProgressBar(float(used) / float(capacity), ImVec2(-1.0f, 0.0f), fmt_c_str("{} / {}", used, capacity));
+                ImGui::Text("Reused slots: %.1f%%", reuse_ratio(textures.reused_allocations(), textures.total_allocations()));
+                ImGui::Text("Pending frees: %u", unsigned(textures.pending_frees()));
             }
         }
 };
@@ -211,6 +211,7 @@ void EngineView::draw(CmdBufferRecorder& recorder) {
         builder.add_uniform_input(gbuffer.normal);
         builder.add_uniform_input_with_default(renderer.renderer.ao.ao, Descriptor(white));
         builder.add_uniform_input_with_default(renderer.renderer.rtgi.gi, Descriptor(black));
+        builder.set_has_side_effects();
         builder.set_render_func([=, &output](CmdBufferRecorder& recorder, const FrameGraphPass* self) {
             {
                 auto render_pass = recorder.bind_framebuffer(self->framebuffer());
@@ -240,7 +241,7 @@ void EngineView::draw(CmdBufferRecorder& recorder) {
 
     {
         CmdTimestampPool* ts_pool = _timestamp_pools.emplace_back(std::make_unique<CmdTimestampPool>(recorder)).get();
-        framegraph.render(recorder, ts_pool);
+        framegraph.render(recorder, ts_pool, &job_system());
     }
 
     if(!output.is_null()) {
@@ -59,16 +59,22 @@ static constexpr u32 orientation_gizmo_alpha = 0xB0000000;
 
 
 
-static void move_recursive(EditorWorld& world, ecs::EntityId id, math::Transform<> old_parent_transform, math::Transform<> new_parent_transform) {
-    if(TransformableComponent* component = world.component_mut<TransformableComponent>(id)) {
+static void move_recursive(EditorWorld& world, ecs::EntityId id, math::Transform<> old_parent_transform, math::Transform<> new_parent_transform, bool is_root = true) {
+    if(const TransformableComponent* component = world.component<TransformableComponent>(id)) {
         const math::Transform<> tr = component->transform();
-        component->set_transform(new_parent_transform * old_parent_transform.inverse() * tr);
+        const math::Transform<> new_tr = new_parent_transform * old_parent_transform.inverse() * tr;
+
+        // Parent relative children will be moved by the TransformSystem
+        if(is_root || !component->is_parent_relative()) {
+            world.component_mut<TransformableComponent>(id)->set_transform(new_tr);
+        }
+
         old_parent_transform = tr;
-        new_parent_transform = component->transform();
+        new_parent_transform = new_tr;
     }
 
     for(const ecs::EntityId child : world.direct_children(id)) {
-        move_recursive(world, child, old_parent_transform, new_parent_transform);
+        move_recursive(world, child, old_parent_transform, new_parent_transform, false);
     }
 }
 
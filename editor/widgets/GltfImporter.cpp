@@ -84,6 +84,8 @@ struct PrefabImportSettings {
     core::String import_path;
     bool import_child_prefabs_as_assets;
     bool create_colliders;
+    bool quantize_vertices;
+    import::ImageImportSettings image_settings;
 };
 
 static AssetId import_node(import::ParsedScene& scene, int index, const PrefabImportSettings& settings);
@@ -168,7 +170,7 @@ static void import_all(concurrent::JobSystem& job_system, import::ParsedScene& s
     for(usize i = 0; i != scene.images.size(); ++i) {
         image_jobs.emplace_back(job_system.schedule([i, settings, &scene] {
             auto& image = scene.images[i];
-            if(const auto image_data = scene.create_image(int(i), true)) {
+            if(const auto image_data = scene.create_image(int(i), true, settings.image_settings)) {
                 image.set_id(import_asset(image.name, image_data.unwrap(), AssetType::Image, settings.import_path));
             }
         }));
@@ -186,7 +188,7 @@ static void import_all(concurrent::JobSystem& job_system, import::ParsedScene& s
     for(usize i = 0; i != scene.meshes.size(); ++i) {
         mesh_jobs.emplace_back(job_system.schedule([i, settings, &scene] {
             auto& mesh = scene.meshes[i];
-            if(const auto mesh_data = scene.create_mesh(int(i))) {
+            if(const auto mesh_data = scene.create_mesh(int(i), settings.quantize_vertices)) {
                 mesh.set_id(import_asset(mesh.name, mesh_data.unwrap(), AssetType::Mesh, settings.import_path));
             }
         }, material_jobs));
@@ -263,12 +265,43 @@ void GltfImporter::on_gui() {
 
             ImGui::Checkbox("Import children prefabs as assets", &_settings.import_child_prefabs_as_assets);
             ImGui::Checkbox("Create colliders", &_settings.create_colliders);
+            ImGui::Checkbox("Quantize vertices", &_settings.quantize_vertices);
+
+            {
+                const char* filters[] = {"Box", "Kaiser", "Lanczos"};
+                import::MipmapFilter& filter = _settings.image_settings.mipmap_filter;
+                if(ImGui::BeginCombo("Mipmap filter", filters[usize(filter)])) {
+                    for(usize i = 0; i != sizeof(filters) / sizeof(filters[0]); ++i) {
+                        const bool selected = usize(filter) == i;
+                        if(ImGui::Selectable(filters[i], selected)) {
+                            filter = import::MipmapFilter(i);
+                        }
+                    }
+                    ImGui::EndCombo();
+                }
+            }
+
+            {
+                const char* qualities[] = {"Fast", "Normal", "Best"};
+                import::CompressionQuality& quality = _settings.image_settings.compression_quality;
+                if(ImGui::BeginCombo("Texture compression", qualities[usize(quality)])) {
+                    for(usize i = 0; i != sizeof(qualities) / sizeof(qualities[0]); ++i) {
+                        const bool selected = usize(quality) == i;
+                        if(ImGui::Selectable(qualities[i], selected)) {
+                            quality = import::CompressionQuality(i);
+                        }
+                    }
+                    ImGui::EndCombo();
+                }
+            }
 
             if(ImGui::Button(ICON_FA_CHECK " Import")) {
                 const PrefabImportSettings settings {
                     _settings.import_path,
                     _settings.import_child_prefabs_as_assets,
                     _settings.create_colliders,
+                    _settings.quantize_vertices,
+                    _settings.image_settings,
                 };
                 import_all(_job_system, _scene.unwrap(), settings);
                 _state = State::Importing;
@@ -60,6 +60,8 @@ class GltfImporter final : public Widget {
             core::String import_path;
             bool import_child_prefabs_as_assets = false;
             bool create_colliders = false;
+            bool quantize_vertices = false;
+            import::ImageImportSettings image_settings;
         } _settings;
 
 
@@ -183,6 +183,7 @@ void Preview::on_gui() {
 
         const auto output_image = builder.declare_copy(renderer.lighting.lit);
         builder.add_input_usage(output_image, ImageUsage::TransferSrcBit);
+        builder.set_has_side_effects();
         builder.set_render_func([=, &output](CmdBufferRecorder& recorder, const FrameGraphPass* self) {
             const auto& src = self->resources().image_base(output_image);
             output = DstTexture(src.format(), src.image_size().to<2>());
@@ -0,0 +1,187 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <yave/animations/AnimationCompression.h>
+#include <yave/animations/BoundAnimation.h>
+
+#include <y/math/random.h>
+#include <y/test/test.h>
+
+#include <cmath>
+#include <random>
+
+namespace {
+using namespace yave;
+
+// Each stored component is off by at most half a quantization step (sqrt(0.5) / 32767),
+// the recomputed one by at most ~5 times that. The angle is about twice the chord length.
+static constexpr float max_quantization_error = 2.0e-4f;
+
+static float rotation_error(const math::Quaternion<>& a, const math::Quaternion<>& b) {
+    const math::Vec4 va = a.as_vec();
+    const math::Vec4 vb = va.dot(b.as_vec()) < 0.0f ? -b.as_vec() : b.as_vec();
+    return 4.0f * std::asin(std::min(1.0f, (va - vb).length() * 0.5f));
+}
+
+static math::Quaternion<> random_rotation(math::FastRandom& rng) {
+    std::uniform_real_distribution<float> distrib(-1.0f, 1.0f);
+    for(;;) {
+        const math::Vec4 v(distrib(rng), distrib(rng), distrib(rng), distrib(rng));
+        if(v.sq_length() > 0.01f) {
+            return math::Quaternion<>(v);
+        }
+    }
+}
+
+static Animation create_clip(usize key_count) {
+    const float duration = 4.0f;
+
+    core::Vector<AnimationChannel> channels;
+    for(usize c = 0; c != 4; ++c) {
+        core::Vector<AnimationChannel::BoneKey> keys;
+        for(usize k = 0; k != key_count; ++k) {
+            const float t = duration * float(k) / float(key_count - 1);
+
+            BoneTransform tr;
+            switch(c) {
+                case 0: // Constant
+                    tr.position = math::Vec3(1.0f, 2.0f, 3.0f);
+                break;
+
+                case 1: // Linear
+                    tr.position = math::Vec3(t, 0.0f, 0.0f);
+                break;
+
+                case 2:
+                    tr.rotation = math::Quaternion<>::from_axis_angle(math::Vec3(0.0f, 0.0f, 1.0f), std::sin(t * 3.0f));
+                break;
+
+                default:
+                    tr.position = math::Vec3(std::sin(t * 5.0f), std::cos(t * 2.0f), 0.0f);
+                    tr.scale = math::Vec3(1.0f + t * 0.1f);
+                break;
+            }
+
+            keys << AnimationChannel::BoneKey{t, tr};
+        }
+        const char name[] = {char('a' + c), 0};
+        channels.emplace_back(name, std::move(keys));
+    }
+
+    return Animation(duration, std::move(channels));
+}
+
+static Skeleton create_skeleton(const Animation& anim) {
+    core::Vector<Bone> bones;
+    for(const AnimationChannel& channel : anim.channels()) {
+        Bone& bone = bones.emplace_back();
+        bone.name = channel.name();
+        bone.parent = u32(-1);
+    }
+    return Skeleton(bones);
+}
+
+y_test_func("PackedRotation round trip") {
+    math::FastRandom rng;
+    for(usize i = 0; i != 10000; ++i) {
+        const math::Quaternion<> rot = random_rotation(rng);
+        const math::Quaternion<> unpacked = PackedRotation::pack(rot).unpack();
+
+        y_test_assert(rotation_error(rot, unpacked) <= max_quantization_error);
+        y_test_assert(std::abs(unpacked.as_vec().length() - 1.0f) < 1.0e-5f);
+    }
+}
+
+y_test_func("PackedRotation dropped component") {
+    // Every component index can be the dropped one, with either sign
+    for(usize i = 0; i != 4; ++i) {
+        for(const float sign : {1.0f, -1.0f}) {
+            math::Vec4 v(0.1f, -0.2f, 0.3f, -0.1f);
+            v[i] = sign * 0.9f;
+
+            const math::Quaternion<> rot(v);
+            y_test_assert(rotation_error(rot, PackedRotation::pack(rot).unpack()) <= max_quantization_error);
+
+            // q and -q are the same rotation
+            const PackedRotation a = PackedRotation::pack(rot);
+            const PackedRotation b = PackedRotation::pack(math::Quaternion<>(-v));
+            y_test_assert(a.bits == b.bits);
+        }
+    }
+
+    const math::Quaternion<> identity;
+    y_test_assert(rotation_error(identity, PackedRotation::pack(identity).unpack()) <= max_quantization_error);
+}
+
+y_test_func("Animation compression") {
+    const Animation anim = create_clip(120);
+
+    const AnimationCompressionSettings settings;
+    const CompressedAnimation compressed = compress_animation(anim, settings);
+
+    y_test_assert(compressed.original_key_count == 4 * 120);
+    y_test_assert(compressed.key_count < compressed.original_key_count);
+    y_test_assert(compressed.constant_channels == 1);
+    y_test_assert(compressed.compression_ratio() > 2.0f);
+
+    // Only the removed keys are accounted for, the stored ones are not packed
+    y_test_assert(compressed.original_byte_size == compressed.original_key_count * sizeof(AnimationChannel::BoneKey));
+    y_test_assert(compressed.compressed_byte_size == compressed.key_count * sizeof(AnimationChannel::BoneKey));
+
+    // Linear channel only needs its end points
+    y_test_assert(compressed.animation.channels()[1].keys().size() == 2);
+
+    y_test_assert(compressed.max_position_error <= settings.max_position_error);
+    y_test_assert(compressed.max_scale_error <= settings.max_scale_error);
+    y_test_assert(compressed.max_rotation_error <= settings.max_rotation_error + max_quantization_error);
+}
+
+y_test_func("Animation compression bound sampling") {
+    const Animation anim = create_clip(120);
+    const Skeleton skeleton = create_skeleton(anim);
+
+    const AnimationCompressionSettings settings;
+    const CompressedAnimation compressed = compress_animation(anim, settings);
+
+    const BoundAnimation bound(compressed.animation, skeleton);
+    y_test_assert(bound.track_count() == 3);
+
+    // Check the errors reported by compress_animation at every original key, as sampled by the engine
+    core::Vector<u32> cursors(bound.track_count(), 0u);
+    core::Vector<math::Transform<>> transforms(skeleton.bones().size(), math::Transform<>());
+
+    const core::Span<AnimationChannel> channels = anim.channels();
+    for(usize k = 0; k != channels[0].keys().size(); ++k) {
+        const float time = channels[0].keys()[k].time;
+        bound.sample(time, cursors, transforms);
+
+        for(usize c = 0; c != channels.size(); ++c) {
+            const BoneTransform& expected = channels[c].keys()[k].local_transform;
+            const auto [pos, rot, scale] = transforms[c].decompose();
+
+            y_test_assert((pos - expected.position).length() <= compressed.max_position_error + 1.0e-5f);
+            y_test_assert((scale - expected.scale).length() <= compressed.max_scale_error + 1.0e-5f);
+            y_test_assert(rotation_error(rot, expected.rotation) <= compressed.max_rotation_error + max_quantization_error);
+        }
+    }
+}
+
+}
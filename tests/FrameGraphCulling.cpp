@@ -0,0 +1,123 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <yave/framegraph/FrameGraphCulling.h>
+#include <y/test/test.h>
+
+namespace {
+using namespace yave;
+
+using ResourceKey = FrameGraphCulling::ResourceKey;
+
+static constexpr ResourceKey res_a = 1;
+static constexpr ResourceKey res_b = 2;
+static constexpr ResourceKey res_c = 3;
+static constexpr ResourceKey res_d = 4;
+
+y_test_func("FrameGraphCulling dead passes") {
+    FrameGraphCulling culling;
+
+    culling.add_use(0, res_a, true);
+    culling.add_use(1, res_b, true);
+    culling.add_output(res_b);
+
+    y_test_assert(culling.pass_count() == 2);
+    y_test_assert(culling.cull() == 1);
+
+    y_test_assert(!culling.is_alive(0));
+    y_test_assert(culling.is_alive(1));
+
+    y_test_assert(!culling.is_resource_alive(res_a));
+    y_test_assert(culling.is_resource_alive(res_b));
+}
+
+y_test_func("FrameGraphCulling side effects") {
+    FrameGraphCulling culling;
+
+    // Writes something nobody reads, but has side effects
+    culling.add_use(0, res_a, true);
+    culling.add_side_effects(0);
+
+    // Writes nothing the graph knows about
+    culling.add_use(1, res_a, false);
+    culling.add_pass(2);
+
+    // Only feeds a pass with side effects
+    culling.add_use(3, res_b, true);
+    culling.add_use(4, res_b, false);
+    culling.add_use(4, res_c, true);
+    culling.add_side_effects(4);
+
+    y_test_assert(culling.cull() == 0);
+    for(usize i = 0; i != culling.pass_count(); ++i) {
+        y_test_assert(culling.is_alive(i));
+    }
+    y_test_assert(culling.is_resource_alive(res_c));
+}
+
+y_test_func("FrameGraphCulling dependencies") {
+    FrameGraphCulling culling;
+
+    // 0 -> 1 -> 2 -> output, 3 reads from 0 but nobody reads from 3
+    culling.add_use(0, res_a, true);
+    culling.add_use(1, res_a, false);
+    culling.add_use(1, res_b, true);
+    culling.add_use(2, res_b, false);
+    culling.add_use(2, res_c, true);
+    culling.add_use(3, res_a, false);
+    culling.add_use(3, res_d, true);
+
+    // Writes to a live resource after its last live use
+    culling.add_use(4, res_b, true);
+
+    culling.add_output(res_c);
+
+    y_test_assert(culling.cull() == 2);
+
+    y_test_assert(culling.is_alive(0));
+    y_test_assert(culling.is_alive(1));
+    y_test_assert(culling.is_alive(2));
+    y_test_assert(!culling.is_alive(3));
+    y_test_assert(!culling.is_alive(4));
+
+    y_test_assert(culling.is_resource_alive(res_a));
+    y_test_assert(culling.is_resource_alive(res_b));
+    y_test_assert(!culling.is_resource_alive(res_d));
+}
+
+y_test_func("FrameGraphCulling hash") {
+    const auto hash_of = [](bool side_effects) {
+        FrameGraphCulling culling;
+        culling.add_use(0, res_a, true);
+        culling.add_use(1, res_a, false);
+        culling.add_use(1, res_b, true);
+        culling.add_output(res_b);
+        if(side_effects) {
+            culling.add_side_effects(0);
+        }
+        return culling.hash();
+    };
+
+    y_test_assert(hash_of(false) == hash_of(false));
+    y_test_assert(hash_of(false) != hash_of(true));
+}
+
+}
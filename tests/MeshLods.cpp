@@ -0,0 +1,211 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <yave/meshes/mesh_utils.h>
+
+#include <y/test/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace {
+using namespace yave;
+
+static constexpr float sphere_radius = 2.0f;
+
+struct Sphere {
+    core::Vector<math::Vec3> positions;
+    core::Vector<IndexedTriangle> triangles;
+};
+
+// Closed icosphere with shared vertices, so nothing is locked by the simplifier
+static Sphere create_sphere(usize subdivisions) {
+    const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+
+    Sphere sphere;
+    for(const math::Vec3& p : {
+            math::Vec3(-1.0f, t, 0.0f), math::Vec3(1.0f, t, 0.0f), math::Vec3(-1.0f, -t, 0.0f), math::Vec3(1.0f, -t, 0.0f),
+            math::Vec3(0.0f, -1.0f, t), math::Vec3(0.0f, 1.0f, t), math::Vec3(0.0f, -1.0f, -t), math::Vec3(0.0f, 1.0f, -t),
+            math::Vec3(t, 0.0f, -1.0f), math::Vec3(t, 0.0f, 1.0f), math::Vec3(-t, 0.0f, -1.0f), math::Vec3(-t, 0.0f, 1.0f)
+        }) {
+        sphere.positions << p.normalized() * sphere_radius;
+    }
+
+    sphere.triangles = {
+        {0, 11, 5}, {0, 5, 1}, {0, 1, 7}, {0, 7, 10}, {0, 10, 11},
+        {1, 5, 9}, {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+        {3, 9, 4}, {3, 4, 2}, {3, 2, 6}, {3, 6, 8}, {3, 8, 9},
+        {4, 9, 5}, {2, 4, 11}, {6, 2, 10}, {8, 6, 7}, {9, 8, 1},
+    };
+
+    for(usize s = 0; s != subdivisions; ++s) {
+        std::map<std::pair<u32, u32>, u32> midpoints;
+        const auto midpoint = [&](u32 a, u32 b) {
+            const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            if(const auto it = midpoints.find(key); it != midpoints.end()) {
+                return it->second;
+            }
+            const u32 index = u32(sphere.positions.size());
+            sphere.positions << (sphere.positions[a] + sphere.positions[b]).normalized() * sphere_radius;
+            midpoints[key] = index;
+            return index;
+        };
+
+        core::Vector<IndexedTriangle> subdivided;
+        for(const IndexedTriangle& tri : sphere.triangles) {
+            const u32 ab = midpoint(tri[0], tri[1]);
+            const u32 bc = midpoint(tri[1], tri[2]);
+            const u32 ca = midpoint(tri[2], tri[0]);
+            subdivided << IndexedTriangle{tri[0], ab, ca} << IndexedTriangle{tri[1], bc, ab} << IndexedTriangle{tri[2], ca, bc} << IndexedTriangle{ab, bc, ca};
+        }
+        sphere.triangles = std::move(subdivided);
+    }
+
+    return sphere;
+}
+
+static math::Vec3 triangle_normal(const Sphere& sphere, const IndexedTriangle& tri) {
+    const math::Vec3 a = sphere.positions[tri[0]];
+    return (sphere.positions[tri[1]] - a).cross(sphere.positions[tri[2]] - a);
+}
+
+}
+
+
+y_test_func("LOD generation") {
+    const Sphere sphere = create_sphere(4);
+    y_test_assert(sphere.triangles.size() == 5120);
+
+    const core::Vector<MeshLod> lods = generate_lods(sphere.positions, sphere.triangles, 5);
+    y_test_assert(lods.size() == 4);
+
+    usize prev_count = sphere.triangles.size();
+    float prev_error = 0.0f;
+    for(const MeshLod& lod : lods) {
+        // Triangle counts strictly decrease, by at least the ratio that makes a new LOD worth it
+        y_test_assert(lod.triangles.size() < prev_count);
+        y_test_assert(lod.triangles.size() * 5 <= prev_count * 4);
+        y_test_assert(lod.triangles.size() >= 16);
+
+        // Errors increase with the LOD index, and stay small compared to the mesh
+        y_test_assert(lod.error > prev_error);
+        y_test_assert(lod.error < sphere_radius * 0.25f);
+
+        for(const IndexedTriangle& tri : lod.triangles) {
+            y_test_assert(tri[0] < sphere.positions.size() && tri[1] < sphere.positions.size() && tri[2] < sphere.positions.size());
+            y_test_assert(tri[0] != tri[1] && tri[1] != tri[2] && tri[0] != tri[2]);
+
+            // No triangle gets flipped inside out
+            const math::Vec3 center = sphere.positions[tri[0]] + sphere.positions[tri[1]] + sphere.positions[tri[2]];
+            y_test_assert(triangle_normal(sphere, tri).dot(center) > 0.0f);
+        }
+
+        prev_count = lod.triangles.size();
+        prev_error = lod.error;
+    }
+}
+
+y_test_func("LOD generation limits") {
+    const Sphere sphere = create_sphere(4);
+    const core::Vector<MeshLod> lods = generate_lods(sphere.positions, sphere.triangles, 5);
+    y_test_assert(lods.size() == 4);
+
+    // LOD count limit, LOD 0 is not generated
+    y_test_assert(generate_lods(sphere.positions, sphere.triangles, 1).is_empty());
+    y_test_assert(generate_lods(sphere.positions, sphere.triangles, 3).size() == 2);
+
+    // Error limit: we stop before the first LOD over the limit, and the ones we keep are unchanged
+    for(usize i = 0; i != lods.size(); ++i) {
+        const float max_error = lods[i].error;
+        const core::Vector<MeshLod> limited = generate_lods(sphere.positions, sphere.triangles, 5, max_error);
+        y_test_assert(limited.size() == i + 1);
+        for(usize l = 0; l != limited.size(); ++l) {
+            y_test_assert(limited[l].error <= max_error);
+            y_test_assert(limited[l].error == lods[l].error);
+            y_test_assert(limited[l].triangles.size() == lods[l].triangles.size());
+        }
+    }
+    y_test_assert(generate_lods(sphere.positions, sphere.triangles, 5, 0.0f).is_empty());
+
+    // Too few triangles to be worth simplifying
+    const Sphere small = create_sphere(0);
+    y_test_assert(generate_lods(small.positions, small.triangles).is_empty());
+
+    // Every vertex is on the border of a strip, so nothing can be collapsed and simplification stalls
+    core::Vector<math::Vec3> strip_positions;
+    core::Vector<IndexedTriangle> strip;
+    for(u32 i = 0; i != 256; ++i) {
+        strip_positions << math::Vec3(float(i), 0.0f, float(i % 7)) << math::Vec3(float(i), 1.0f, float(i % 5));
+        if(i) {
+            const u32 a = (i - 1) * 2;
+            strip << IndexedTriangle{a, a + 2, a + 1} << IndexedTriangle{a + 1, a + 2, a + 3};
+        }
+    }
+    y_test_assert(generate_lods(strip_positions, strip).is_empty());
+}
+
+y_test_func("LOD selection") {
+    const Sphere sphere = create_sphere(4);
+    const core::Vector<MeshLod> lods = generate_lods(sphere.positions, sphere.triangles, 5);
+    y_test_assert(lods.size() == 4);
+
+    core::Vector<PackedVertex> vertices;
+    for(const math::Vec3& p : sphere.positions) {
+        vertices << PackedVertex{p, 0, 0, math::Vec2()};
+    }
+
+    MeshData mesh(vertices, sphere.triangles);
+    for(const MeshLod& lod : lods) {
+        const MeshData::SubMesh sub_mesh = {u32(lod.triangles.size()), 0};
+        mesh.add_lod(lod.error, lod.triangles, core::Span<MeshData::SubMesh>(&sub_mesh, 1));
+    }
+    y_test_assert(mesh.lod_count() == lods.size() + 1);
+
+    core::Vector<float> errors;
+    for(usize i = 0; i != mesh.lod_count(); ++i) {
+        errors << mesh.lod_error(i);
+        y_test_assert(mesh.lod_triangles(i).size() == (i ? lods[i - 1].triangles.size() : sphere.triangles.size()));
+    }
+    y_test_assert(errors[0] == 0.0f);
+
+    y_test_assert(select_lod(errors, 0.0f) == 0);
+    y_test_assert(select_lod(errors, errors[1] * 0.5f) == 0);
+    y_test_assert(select_lod(errors, std::numeric_limits<float>::max()) == lods.size());
+
+    for(usize i = 1; i != errors.size(); ++i) {
+        // The threshold is inclusive
+        y_test_assert(select_lod(errors, errors[i]) == i);
+        y_test_assert(select_lod(errors, std::nextafter(errors[i], 0.0f)) == i - 1);
+
+        // The selected LOD never goes over the threshold, and the next one always would
+        const float threshold = (errors[i - 1] + errors[i]) * 0.5f;
+        const usize selected = select_lod(errors, threshold);
+        y_test_assert(selected == i - 1);
+        y_test_assert(errors[selected] <= threshold);
+        y_test_assert(errors[selected + 1] > threshold);
+    }
+
+    // LOD 0 is always available
+    y_test_assert(select_lod(core::Span<float>(errors.data(), 1), 1.0f) == 0);
+    y_test_assert(select_lod(core::Span<float>(), 1.0f) == 0);
+}
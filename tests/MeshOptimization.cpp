@@ -0,0 +1,265 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <yave/meshes/mesh_utils.h>
+
+#include <y/math/random.h>
+#include <y/test/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace {
+using namespace yave;
+
+static constexpr usize grid_size = 48;
+
+static PackedVertex grid_vertex(usize x, usize y) {
+    const float fx = float(x) / float(grid_size - 1);
+    const float fy = float(y) / float(grid_size - 1);
+    return pack_vertex(FullVertex {
+        math::Vec3(fx * 10.0f, fy * 10.0f, std::sin(fx * 7.0f) * std::cos(fy * 5.0f)),
+        math::Vec3(fx - 0.5f, fy - 0.5f, 1.0f).normalized(),
+        math::Vec4(1.0f, 0.0f, 0.0f, x % 2 ? 1.0f : -1.0f),
+        math::Vec2(fx, fy)
+    });
+}
+
+static core::Vector<IndexedTriangle> grid_triangles() {
+    core::Vector<IndexedTriangle> triangles;
+    for(usize y = 0; y + 1 != grid_size; ++y) {
+        for(usize x = 0; x + 1 != grid_size; ++x) {
+            const u32 a = u32(y * grid_size + x);
+            const u32 b = a + 1;
+            const u32 c = a + u32(grid_size);
+            const u32 d = c + 1;
+            triangles << IndexedTriangle{a, b, d} << IndexedTriangle{a, d, c};
+        }
+    }
+    return triangles;
+}
+
+static MeshVertexStreams grid_streams() {
+    core::Vector<PackedVertex> vertices;
+    for(usize y = 0; y != grid_size; ++y) {
+        for(usize x = 0; x != grid_size; ++x) {
+            vertices << grid_vertex(x, y);
+        }
+    }
+    return MeshVertexStreams(vertices);
+}
+
+static void shuffle(core::MutableSpan<IndexedTriangle> triangles, u32 seed) {
+    math::FastRandom rng(seed);
+    for(usize i = triangles.size(); i > 1; --i) {
+        std::swap(triangles[i - 1], triangles[rng() % i]);
+    }
+}
+
+// Triangles as the bytes of their three vertices, rotated so that the smallest vertex comes first (which keeps the winding)
+using TriangleKey = std::array<std::string, 3>;
+
+static std::string vertex_key(const MeshVertexStreams& streams, u32 index) {
+    std::string key;
+    for(usize i = 0; i != MeshVertexStreams::stream_count; ++i) {
+        const VertexStreamType type = VertexStreamType(i);
+        key.append(static_cast<const char*>(streams.vertex_stream_data(type, index)), vertex_stream_element_size(type));
+    }
+    return key;
+}
+
+static std::map<TriangleKey, usize> triangle_multiset(const MeshVertexStreams& streams, core::Span<IndexedTriangle> triangles) {
+    std::map<TriangleKey, usize> multiset;
+    for(const IndexedTriangle& tri : triangles) {
+        TriangleKey key = {vertex_key(streams, tri[0]), vertex_key(streams, tri[1]), vertex_key(streams, tri[2])};
+        std::rotate(key.begin(), std::min_element(key.begin(), key.end()), key.end());
+        ++multiset[key];
+    }
+    return multiset;
+}
+
+static bool same_triangles(core::Span<IndexedTriangle> a, core::Span<IndexedTriangle> b) {
+    auto sorted = [](core::Span<IndexedTriangle> tris) {
+        core::Vector<IndexedTriangle> s(tris.begin(), tris.end());
+        for(IndexedTriangle& tri : s) {
+            std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+        }
+        std::sort(s.begin(), s.end());
+        return s;
+    };
+    return sorted(a) == sorted(b);
+}
+
+}
+
+
+y_test_func("Vertex cache analysis") {
+    const core::Vector<IndexedTriangle> triangles = {{0, 1, 2}, {2, 1, 3}, {0, 1, 2}};
+    const VertexCacheStats stats = analyze_vertex_cache(triangles, 4);
+    y_test_assert(stats.acmr == 4.0f / 3.0f);
+    y_test_assert(stats.atvr == 1.0f);
+
+    const VertexCacheStats tiny = analyze_vertex_cache(triangles, 4, 3);
+    y_test_assert(tiny.acmr == 7.0f / 3.0f);
+}
+
+y_test_func("Vertex cache optimization keeps triangles") {
+    core::Vector<IndexedTriangle> triangles = grid_triangles();
+    shuffle(triangles, 17);
+
+    const core::Vector<IndexedTriangle> original(triangles);
+    const usize vertex_count = grid_size * grid_size;
+    const VertexCacheStats before = analyze_vertex_cache(triangles, vertex_count);
+
+    core::Vector<u32> clusters;
+    optimize_vertex_cache(triangles, vertex_count, &clusters);
+    y_test_assert(same_triangles(original, triangles));
+    y_test_assert(!clusters.is_empty() && clusters[0] == 0);
+    y_test_assert(std::is_sorted(clusters.begin(), clusters.end()));
+
+    const VertexCacheStats after = analyze_vertex_cache(triangles, vertex_count);
+    y_test_assert(after.acmr < before.acmr);
+    y_test_assert(after.acmr < 0.8f);
+
+    optimize_overdraw(triangles, grid_streams().stream<VertexStreamType::Position>());
+    y_test_assert(same_triangles(original, triangles));
+
+    // The threshold bounds every split cluster (with a cold cache), not the reordered mesh as a whole
+    y_test_assert(analyze_vertex_cache(triangles, vertex_count).acmr <= after.acmr * 1.2f);
+}
+
+y_test_func("Mesh optimization does not degrade vertex cache") {
+    for(const bool shuffled : {false, true}) {
+        for(const bool with_meshlets : {false, true}) {
+            MeshVertexStreams streams = grid_streams();
+            core::Vector<IndexedTriangle> triangles = grid_triangles();
+            if(shuffled) {
+                shuffle(triangles, 42);
+            }
+
+            core::Vector<MeshData::Meshlet> meshlets;
+            const MeshOptimizationStats stats = optimize_mesh(streams, triangles, with_meshlets ? &meshlets : nullptr);
+
+            y_test_assert(stats.after.acmr <= stats.before.acmr);
+            y_test_assert(stats.after.atvr <= stats.before.atvr);
+            y_test_assert(stats.vertex_count_after == stats.vertex_count_before);
+
+            const VertexCacheStats check = analyze_vertex_cache(triangles, streams.vertex_count());
+            y_test_assert(check.acmr == stats.after.acmr);
+            y_test_assert(check.atvr == stats.after.atvr);
+        }
+    }
+}
+
+y_test_func("Mesh optimization keeps triangles and attributes") {
+    const MeshVertexStreams grid = grid_streams();
+    core::Vector<IndexedTriangle> grid_tris = grid_triangles();
+
+    // Append exact duplicates of the first row, a copy of the second row with different UVs (a seam) and a few unused vertices
+    core::Vector<PackedVertex> vertices;
+    for(usize i = 0; i != grid.vertex_count(); ++i) {
+        vertices << grid[i];
+    }
+
+    const u32 duplicate_offset = u32(vertices.size());
+    for(usize x = 0; x != grid_size; ++x) {
+        vertices << grid_vertex(x, 0);
+    }
+
+    const u32 seam_offset = u32(vertices.size());
+    for(usize x = 0; x != grid_size; ++x) {
+        PackedVertex v = grid_vertex(x, 1);
+        v.uv = math::Vec2(v.uv.x(), 1.0f);
+        vertices << v;
+    }
+
+    for(usize i = 0; i != 7; ++i) {
+        vertices << grid_vertex(i, i);
+    }
+
+    for(usize i = 0; i != grid_size * 2; ++i) {
+        IndexedTriangle& tri = grid_tris[i];
+        for(u32& v : tri) {
+            if(v < grid_size) {
+                v += duplicate_offset;
+            } else if(i % 2 && v < grid_size * 2) {
+                v = v - u32(grid_size) + seam_offset;
+            }
+        }
+    }
+    shuffle(grid_tris, 7);
+
+    const MeshVertexStreams original_streams(vertices);
+    MeshVertexStreams streams(vertices);
+    core::Vector<IndexedTriangle> triangles(grid_tris);
+
+    const auto expected = triangle_multiset(streams, triangles);
+    y_test_assert(expected.size() == triangles.size());
+
+    core::Vector<MeshData::Meshlet> meshlets;
+    const MeshOptimizationStats stats = optimize_mesh(streams, triangles, &meshlets);
+
+    y_test_assert(triangles.size() == grid_tris.size());
+    y_test_assert(triangle_multiset(streams, triangles) == expected);
+
+    // Duplicates and unused vertices are gone, the seam vertices are kept
+    y_test_assert(stats.vertex_count_before == vertices.size());
+    y_test_assert(stats.vertex_count_after == streams.vertex_count());
+    y_test_assert(streams.vertex_count() == grid_size * grid_size + grid_size);
+
+    // Every remaining vertex is one of the original ones, with all its attributes, and is used
+    std::map<std::string, usize> original_vertices;
+    for(u32 i = 0; i != u32(vertices.size()); ++i) {
+        original_vertices[vertex_key(original_streams, i)] = i;
+    }
+
+    core::Vector<u8> used(streams.vertex_count(), u8(0));
+    for(const IndexedTriangle& tri : triangles) {
+        for(const u32 v : tri) {
+            y_test_assert(v < streams.vertex_count());
+            used[v] = 1;
+        }
+    }
+
+    for(u32 i = 0; i != u32(streams.vertex_count()); ++i) {
+        y_test_assert(used[i]);
+        y_test_assert(original_vertices.contains(vertex_key(streams, i)));
+
+        const PackedVertex v = streams[i];
+        const PackedVertex& orig = vertices[original_vertices[vertex_key(streams, i)]];
+        y_test_assert(v.position == orig.position);
+        y_test_assert(v.packed_normal == orig.packed_normal);
+        y_test_assert(v.packed_tangent_sign == orig.packed_tangent_sign);
+        y_test_assert(v.uv == orig.uv);
+    }
+
+    // Vertex fetch order follows first use
+    u32 next_vertex = 0;
+    for(const IndexedTriangle& tri : triangles) {
+        for(const u32 v : tri) {
+            y_test_assert(v <= next_vertex);
+            next_vertex = std::max(next_vertex, v + 1);
+        }
+    }
+}
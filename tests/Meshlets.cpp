@@ -0,0 +1,225 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <yave/meshes/mesh_utils.h>
+
+#include <y/math/random.h>
+#include <y/math/Volume.h>
+#include <y/test/test.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+using namespace yave;
+
+struct TestMesh {
+    core::Vector<math::Vec3> positions;
+    core::Vector<IndexedTriangle> triangles;
+};
+
+// Latitude/longitude sphere, normals point in every direction
+static TestMesh create_sphere(usize rings, usize segments) {
+    TestMesh mesh;
+    for(usize r = 0; r <= rings; ++r) {
+        const float theta = math::pi<float> * float(r) / float(rings);
+        for(usize s = 0; s != segments; ++s) {
+            const float phi = 2.0f * math::pi<float> * float(s) / float(segments);
+            mesh.positions << math::Vec3(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)) * 3.0f;
+        }
+    }
+
+    for(usize r = 0; r != rings; ++r) {
+        for(usize s = 0; s != segments; ++s) {
+            const u32 a = u32(r * segments + s);
+            const u32 b = u32(r * segments + (s + 1) % segments);
+            const u32 c = a + u32(segments);
+            const u32 d = b + u32(segments);
+            if(r) {
+                mesh.triangles << IndexedTriangle{a, c, b};
+            }
+            if(r + 1 != rings) {
+                mesh.triangles << IndexedTriangle{b, c, d};
+            }
+        }
+    }
+    return mesh;
+}
+
+// Bumpy grid, mostly facing +Z
+static TestMesh create_terrain(usize size) {
+    TestMesh mesh;
+    for(usize y = 0; y != size; ++y) {
+        for(usize x = 0; x != size; ++x) {
+            mesh.positions << math::Vec3(float(x), float(y), std::sin(float(x) * 0.3f) * std::cos(float(y) * 0.2f));
+        }
+    }
+
+    for(usize y = 0; y + 1 != size; ++y) {
+        for(usize x = 0; x + 1 != size; ++x) {
+            const u32 a = u32(y * size + x);
+            const u32 c = a + u32(size);
+            mesh.triangles << IndexedTriangle{a, a + 1, c + 1} << IndexedTriangle{a, c + 1, c};
+        }
+    }
+    return mesh;
+}
+
+static core::Vector<IndexedTriangle> sorted_triangles(core::Span<IndexedTriangle> triangles) {
+    core::Vector<IndexedTriangle> sorted(triangles);
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+static math::Vec3 triangle_normal(const TestMesh& mesh, const IndexedTriangle& tri) {
+    const math::Vec3 a = mesh.positions[tri[0]];
+    const math::Vec3 n = (mesh.positions[tri[1]] - a).cross(mesh.positions[tri[2]] - a);
+    return n.normalized();
+}
+
+static bool check_bounds(const TestMesh& mesh, core::Span<IndexedTriangle> triangles, const MeshData::Meshlet& meshlet, math::FastRandom& rng) {
+    // Every vertex is inside the bounding sphere
+    for(const IndexedTriangle& tri : triangles) {
+        for(const u32 v : tri) {
+            if((mesh.positions[v] - meshlet.center).length() > meshlet.radius * 1.0001f) {
+                return false;
+            }
+        }
+    }
+
+    // Every triangle normal is inside the normal cone
+    const math::NormalCone<> cone(meshlet.cone_axis, meshlet.cone_cutoff);
+    if(!cone.is_degenerate()) {
+        if(std::abs(meshlet.cone_axis.length() - 1.0f) > 1.0e-4f) {
+            return false;
+        }
+        const float cos_half_angle = std::sqrt(1.0f - meshlet.cone_cutoff * meshlet.cone_cutoff);
+        for(const IndexedTriangle& tri : triangles) {
+            if(meshlet.cone_axis.dot(triangle_normal(mesh, tri)) < cos_half_angle - 1.0e-4f) {
+                return false;
+            }
+        }
+    }
+
+    // When the cone says the meshlet is back facing, every triangle is
+    std::uniform_real_distribution<float> distrib(-10.0f, 10.0f);
+    for(usize i = 0; i != 64; ++i) {
+        const math::Vec3 view_pos = meshlet.center + math::Vec3(distrib(rng), distrib(rng), distrib(rng));
+        if(!cone.is_backfacing(meshlet.center, meshlet.radius, view_pos)) {
+            continue;
+        }
+        for(const IndexedTriangle& tri : triangles) {
+            if((mesh.positions[tri[0]] - view_pos).dot(triangle_normal(mesh, tri)) < -1.0e-4f) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool check_meshlets(const TestMesh& mesh, usize max_vertex_count, usize max_triangle_count) {
+    core::Vector<IndexedTriangle> triangles(mesh.triangles);
+    const core::Vector<MeshData::Meshlet> meshlets = build_meshlets(triangles, mesh.positions, max_vertex_count, max_triangle_count);
+    if(meshlets.is_empty()) {
+        return false;
+    }
+
+    // Every triangle is emitted exactly once
+    if(sorted_triangles(triangles) != sorted_triangles(mesh.triangles)) {
+        return false;
+    }
+
+    math::FastRandom rng;
+    u32 next_triangle = 0;
+    for(const MeshData::Meshlet& meshlet : meshlets) {
+        // Meshlets are contiguous ranges that cover all the triangles, in order
+        if(meshlet.first_triangle != next_triangle || !meshlet.triangle_count || meshlet.triangle_count > max_triangle_count) {
+            return false;
+        }
+        next_triangle += meshlet.triangle_count;
+
+        const core::Span<IndexedTriangle> meshlet_triangles(triangles.data() + meshlet.first_triangle, meshlet.triangle_count);
+
+        core::Vector<u32> vertices;
+        for(const IndexedTriangle& tri : meshlet_triangles) {
+            for(const u32 v : tri) {
+                vertices << v;
+            }
+        }
+        std::sort(vertices.begin(), vertices.end());
+        const usize vertex_count = usize(std::unique(vertices.begin(), vertices.end()) - vertices.begin());
+        if(vertex_count > max_vertex_count) {
+            return false;
+        }
+
+        if(!check_bounds(mesh, meshlet_triangles, meshlet, rng)) {
+            return false;
+        }
+
+        const MeshData::Meshlet bounds = compute_meshlet_bounds(meshlet_triangles, mesh.positions);
+        if(bounds.center != meshlet.center || bounds.radius != meshlet.radius || bounds.cone_axis != meshlet.cone_axis || bounds.cone_cutoff != meshlet.cone_cutoff) {
+            return false;
+        }
+    }
+    return next_triangle == triangles.size();
+}
+
+}
+
+
+y_test_func("Meshlet limits and coverage") {
+    const TestMesh sphere = create_sphere(32, 48);
+    const TestMesh terrain = create_terrain(64);
+
+    y_test_assert(check_meshlets(sphere, MeshData::max_meshlet_vertex_count, MeshData::max_meshlet_triangle_count));
+    y_test_assert(check_meshlets(terrain, MeshData::max_meshlet_vertex_count, MeshData::max_meshlet_triangle_count));
+
+    // Limits that are hit by the triangle count first and by the vertex count first
+    y_test_assert(check_meshlets(terrain, 64, 16));
+    y_test_assert(check_meshlets(sphere, 8, 124));
+    y_test_assert(check_meshlets(sphere, 3, 1));
+}
+
+y_test_func("Meshlet bounds") {
+    const TestMesh terrain = create_terrain(4);
+    const core::Span<IndexedTriangle> all = terrain.triangles;
+
+    // A single triangle: its cone is its normal
+    const MeshData::Meshlet single = compute_meshlet_bounds(core::Span<IndexedTriangle>(all.data(), 1), terrain.positions);
+    y_test_assert((single.cone_axis - triangle_normal(terrain, all[0])).length() < 1.0e-5f);
+    y_test_assert(single.cone_cutoff < 1.0e-3f);
+
+    // Flat quad facing +Z
+    const core::Vector<math::Vec3> quad = {math::Vec3(0.0f, 0.0f, 1.0f), math::Vec3(2.0f, 0.0f, 1.0f), math::Vec3(0.0f, 2.0f, 1.0f), math::Vec3(2.0f, 2.0f, 1.0f)};
+    const core::Vector<IndexedTriangle> quad_tris = {{0, 1, 3}, {0, 3, 2}};
+    const MeshData::Meshlet flat = compute_meshlet_bounds(quad_tris, quad);
+    y_test_assert(flat.center == math::Vec3(1.0f, 1.0f, 1.0f));
+    y_test_assert(std::abs(flat.radius - std::sqrt(2.0f)) < 1.0e-5f);
+    y_test_assert(flat.cone_axis == math::Vec3(0.0f, 0.0f, 1.0f));
+    y_test_assert(flat.cone_cutoff < 1.0e-5f);
+
+    // Normals facing opposite ways can not be culled
+    const core::Vector<IndexedTriangle> two_sided = {{0, 1, 3}, {0, 3, 1}};
+    const MeshData::Meshlet degenerate = compute_meshlet_bounds(two_sided, quad);
+    y_test_assert(math::NormalCone<>(degenerate.cone_axis, degenerate.cone_cutoff).is_degenerate());
+}
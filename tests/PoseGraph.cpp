@@ -0,0 +1,199 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <yave/animations/PoseGraph.h>
+
+#include <y/test/test.h>
+
+#include <cmath>
+
+namespace {
+using namespace yave;
+
+static constexpr float epsilon = 1.0e-5f;
+
+static math::Quaternion<> rotation_z(float angle) {
+    return math::Quaternion<>::from_axis_angle(math::Vec3(0.0f, 0.0f, 1.0f), angle);
+}
+
+static bool is_same(const math::Vec3& a, const math::Vec3& b) {
+    return (a - b).length() < epsilon;
+}
+
+static bool is_same(const math::Quaternion<>& a, const math::Quaternion<>& b) {
+    return std::abs(std::abs(a.as_vec().dot(b.as_vec())) - 1.0f) < epsilon;
+}
+
+static bool is_same(const BoneTransform& a, const BoneTransform& b) {
+    return is_same(a.position, b.position) && is_same(a.rotation, b.rotation) && is_same(a.scale, b.scale);
+}
+
+static BoneTransform transform(const math::Vec3& position, float angle = 0.0f, float scale = 1.0f) {
+    BoneTransform tr;
+    tr.position = position;
+    tr.rotation = rotation_z(angle);
+    tr.scale = math::Vec3(scale);
+    return tr;
+}
+
+// Two bones, the second one with a non identity bind pose
+static std::shared_ptr<const Skeleton> create_skeleton() {
+    core::Vector<Bone> bones;
+    {
+        Bone& root = bones.emplace_back();
+        root.name = "root";
+        root.parent = u32(-1);
+    }
+    {
+        Bone& child = bones.emplace_back();
+        child.name = "child";
+        child.parent = 0;
+        child.local_transform = transform(math::Vec3(0.0f, 1.0f, 0.0f), 0.5f);
+    }
+    return std::make_shared<const Skeleton>(bones);
+}
+
+// Clip only animating the root bone
+static Animation create_root_clip(const BoneTransform& start, const BoneTransform& end) {
+    core::Vector<AnimationChannel::BoneKey> keys;
+    keys << AnimationChannel::BoneKey{0.0f, start};
+    keys << AnimationChannel::BoneKey{1.0f, end};
+
+    core::Vector<AnimationChannel> channels;
+    channels.emplace_back("root", std::move(keys));
+    return Animation(1.0f, std::move(channels));
+}
+
+y_test_func("Pose blend") {
+    Pose a(2);
+    Pose b(2);
+    a.set_bone(0, transform(math::Vec3(0.0f), 0.0f, 1.0f));
+    b.set_bone(0, transform(math::Vec3(2.0f, 0.0f, 0.0f), 1.0f, 3.0f));
+    b.set_bone(1, transform(math::Vec3(0.0f, 4.0f, 0.0f)));
+
+    Pose out(2);
+    Pose::blend(a, b, 0.5f, {}, out);
+    y_test_assert(is_same(out.bone(0), transform(math::Vec3(1.0f, 0.0f, 0.0f), 0.5f, 2.0f)));
+    y_test_assert(is_same(out.bone(1), transform(math::Vec3(0.0f, 2.0f, 0.0f))));
+
+    Pose::blend(a, b, 0.0f, {}, out);
+    y_test_assert(is_same(out.bone(0), a.bone(0)));
+
+    Pose::blend(a, b, 1.0f, {}, out);
+    y_test_assert(is_same(out.bone(0), b.bone(0)));
+}
+
+y_test_func("Pose additive") {
+    Pose base(2);
+    Pose additive(2);
+    base.set_bone(0, transform(math::Vec3(1.0f, 0.0f, 0.0f), 0.25f, 2.0f));
+    base.set_bone(1, transform(math::Vec3(0.0f, 1.0f, 0.0f), 0.5f));
+    additive.set_bone(0, transform(math::Vec3(0.0f, 1.0f, 0.0f), 0.5f, 1.5f));
+
+    Pose out(2);
+    Pose::add(base, additive, 1.0f, {}, out);
+    y_test_assert(is_same(out.bone(0), transform(math::Vec3(1.0f, 1.0f, 0.0f), 0.75f, 3.0f)));
+
+    // Identity bones add nothing
+    y_test_assert(is_same(out.bone(1), base.bone(1)));
+
+    Pose::add(base, additive, 0.5f, {}, out);
+    y_test_assert(is_same(out.bone(0), transform(math::Vec3(1.0f, 0.5f, 0.0f), 0.5f, 2.5f)));
+
+    Pose::add(base, additive, 0.0f, {}, out);
+    y_test_assert(is_same(out.bone(0), base.bone(0)));
+}
+
+y_test_func("Pose bone mask") {
+    Pose a(2);
+    Pose b(2);
+    b.set_bone(0, transform(math::Vec3(2.0f, 0.0f, 0.0f)));
+    b.set_bone(1, transform(math::Vec3(2.0f, 0.0f, 0.0f)));
+
+    const float mask[] = {1.0f, 0.0f};
+
+    Pose out(2);
+    Pose::blend(a, b, 0.5f, mask, out);
+    y_test_assert(is_same(out.bone(0).position, math::Vec3(1.0f, 0.0f, 0.0f)));
+    y_test_assert(is_same(out.bone(1).position, math::Vec3(0.0f)));
+
+    Pose::add(a, b, 1.0f, mask, out);
+    y_test_assert(is_same(out.bone(0).position, math::Vec3(2.0f, 0.0f, 0.0f)));
+    y_test_assert(is_same(out.bone(1).position, math::Vec3(0.0f)));
+}
+
+y_test_func("PoseGraph cross-fade") {
+    const auto skeleton = create_skeleton();
+
+    const Animation anim_a = create_root_clip(transform(math::Vec3(0.0f)), transform(math::Vec3(0.0f)));
+    const Animation anim_b = create_root_clip(transform(math::Vec3(1.0f, 0.0f, 0.0f)), transform(math::Vec3(1.0f, 0.0f, 0.0f)));
+    const BoundAnimation a(anim_a, *skeleton);
+    const BoundAnimation b(anim_b, *skeleton);
+
+    PoseGraph graph(skeleton);
+    const PoseGraph::NodeId clip_a = graph.add_clip(&a);
+    const PoseGraph::NodeId clip_b = graph.add_clip(&b);
+    const PoseGraph::NodeId blend = graph.add_blend(clip_a, clip_b);
+
+    y_test_assert(is_same(graph.evaluate().bone(0).position, math::Vec3(0.0f)));
+
+    graph.fade_to(blend, 1.0f, 1.0f);
+    graph.update(0.25f);
+    y_test_assert(std::abs(graph.weight(blend) - 0.25f) < epsilon);
+    y_test_assert(is_same(graph.evaluate().bone(0).position, math::Vec3(0.25f, 0.0f, 0.0f)));
+
+    // Fades stop at their target
+    graph.update(1.0f);
+    y_test_assert(graph.weight(blend) == 1.0f);
+    y_test_assert(is_same(graph.evaluate().bone(0).position, math::Vec3(1.0f, 0.0f, 0.0f)));
+
+    graph.fade_to(blend, 0.0f, 0.5f);
+    graph.update(0.25f);
+    y_test_assert(std::abs(graph.weight(blend) - 0.5f) < epsilon);
+
+    // Unanimated bones keep their bind pose
+    y_test_assert(is_same(graph.evaluate().bone(1), skeleton->bones()[1].local_transform));
+
+    graph.fade_to(blend, 1.0f, 0.0f);
+    y_test_assert(graph.weight(blend) == 1.0f);
+}
+
+y_test_func("PoseGraph additive clips are relative to identity") {
+    const auto skeleton = create_skeleton();
+
+    const Animation anim_base = create_root_clip(transform(math::Vec3(1.0f, 0.0f, 0.0f)), transform(math::Vec3(1.0f, 0.0f, 0.0f)));
+    const Animation anim_add = create_root_clip(transform(math::Vec3(0.0f, 1.0f, 0.0f), 0.5f), transform(math::Vec3(0.0f, 1.0f, 0.0f), 0.5f));
+    const BoundAnimation base(anim_base, *skeleton);
+    const BoundAnimation add(anim_add, *skeleton);
+
+    PoseGraph graph(skeleton);
+    const PoseGraph::NodeId clip_base = graph.add_clip(&base);
+    const PoseGraph::NodeId clip_add = graph.add_clip(&add);
+    graph.add_additive(clip_base, clip_add);
+
+    const Pose& pose = graph.evaluate();
+    y_test_assert(is_same(pose.bone(0), transform(math::Vec3(1.0f, 1.0f, 0.0f), 0.5f)));
+
+    // The child bone is not animated by the additive clip, so it should not get its bind pose applied twice
+    y_test_assert(is_same(pose.bone(1), skeleton->bones()[1].local_transform));
+}
+
+}
@@ -0,0 +1,231 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <yave/meshes/QuantizedVertexStreams.h>
+
+#include <y/core/Vector.h>
+#include <y/math/random.h>
+#include <y/test/test.h>
+
+#include <cmath>
+#include <random>
+
+namespace {
+using namespace yave;
+
+// Half a step on both octahedral axes, stretched by the octahedral mapping (measured at ~0.0021 rad)
+static constexpr float max_normal_error = 0.0025f;
+
+// Half an angle step, relative to the source tangent projected on the decoded normal plane
+static constexpr float max_tangent_error = math::pi<float> / 512.0f + 1.0e-4f;
+
+static float angle(const math::Vec3& a, const math::Vec3& b) {
+    return std::acos(std::clamp(a.normalized().dot(b.normalized()), -1.0f, 1.0f));
+}
+
+static math::Vec3 random_direction(math::FastRandom& rng) {
+    std::uniform_real_distribution<float> distrib(-1.0f, 1.0f);
+    for(;;) {
+        const math::Vec3 v(distrib(rng), distrib(rng), distrib(rng));
+        if(v.sq_length() > 0.01f && v.sq_length() <= 1.0f) {
+            return v.normalized();
+        }
+    }
+}
+
+static core::Vector<PackedVertex> create_vertices(usize count, const math::Vec3& center, const math::Vec3& extent, const math::Vec2& uv_min, const math::Vec2& uv_max) {
+    math::FastRandom rng;
+    std::uniform_real_distribution<float> distrib(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    core::Vector<PackedVertex> vertices;
+    for(usize i = 0; i != count; ++i) {
+        const math::Vec3 normal = random_direction(rng);
+        math::Vec3 tangent = random_direction(rng);
+        tangent = (tangent - normal * normal.dot(tangent)).normalized();
+
+        vertices << pack_vertex(FullVertex {
+            center + math::Vec3(distrib(rng), distrib(rng), distrib(rng)) * extent,
+            normal,
+            math::Vec4(tangent, i % 3 ? 1.0f : -1.0f),
+            uv_min + math::Vec2(unit(rng), unit(rng)) * (uv_max - uv_min)
+        });
+    }
+
+    // Axis aligned and diagonal normals are edge cases of the octahedral mapping
+    for(const math::Vec3& n : {
+            math::Vec3(1.0f, 0.0f, 0.0f), math::Vec3(-1.0f, 0.0f, 0.0f), math::Vec3(0.0f, 1.0f, 0.0f),
+            math::Vec3(0.0f, -1.0f, 0.0f), math::Vec3(0.0f, 0.0f, 1.0f), math::Vec3(0.0f, 0.0f, -1.0f),
+            math::Vec3(1.0f, 1.0f, -1.0f).normalized(), math::Vec3(-1.0f, 1.0f, 0.0f).normalized()
+        }) {
+        const math::Vec3 tangent = (std::abs(n.z()) < 0.9f ? math::Vec3(0.0f, 0.0f, 1.0f) : math::Vec3(1.0f, 0.0f, 0.0f)).cross(n).normalized();
+        for(const float sign : {1.0f, -1.0f}) {
+            vertices << pack_vertex(FullVertex{center + extent, n, math::Vec4(tangent, sign), uv_max});
+            vertices << pack_vertex(FullVertex{center - extent, n, math::Vec4(tangent, sign), uv_min});
+        }
+    }
+
+    return vertices;
+}
+
+}
+
+
+y_test_func("Vertex quantization snorm16 positions") {
+    const math::Vec3 center(100.0f, -5.0f, 0.25f);
+    const math::Vec3 extent(50.0f, 0.01f, 7.0f);
+
+    const MeshVertexStreams streams(create_vertices(4096, center, extent, math::Vec2(0.0f), math::Vec2(1.0f)));
+    const QuantizedVertexStreams quantized = QuantizedVertexStreams::quantize(streams);
+    y_test_assert(quantized.format(VertexStreamType::Position) == VertexStreamFormat::Snorm16);
+    y_test_assert(quantized.byte_size() == streams.vertex_count() * 16);
+
+    const float max_error = quantized.max_position_error();
+    y_test_assert(max_error > 0.0f);
+    y_test_assert(max_error < extent.length() / 32767.0f);
+
+    const core::Span<math::Vec3> positions = streams.stream<VertexStreamType::Position>();
+    for(usize i = 0; i != streams.vertex_count(); ++i) {
+        const math::Vec3 p = quantized.position(i);
+        for(usize k = 0; k != 3; ++k) {
+            // Half a step on every axis, plus float rounding of the decode
+            const float axis_error = quantized.position_scale()[k] / (2.0f * 32767.0f) + std::abs(positions[i][k]) * 4.0f * math::epsilon<float>;
+            y_test_assert(std::abs(p[k] - positions[i][k]) <= axis_error);
+        }
+        y_test_assert((p - positions[i]).length() <= max_error * 1.01f);
+    }
+
+    // Flat meshes do not have a scale on one axis
+    core::Vector<PackedVertex> flat = create_vertices(64, center, extent, math::Vec2(0.0f), math::Vec2(1.0f));
+    for(PackedVertex& v : flat) {
+        v.position.y() = 3.0f;
+    }
+    const QuantizedVertexStreams flat_quantized = QuantizedVertexStreams::quantize(MeshVertexStreams(flat));
+    for(usize i = 0; i != flat.size(); ++i) {
+        y_test_assert(flat_quantized.position(i).y() == 3.0f);
+    }
+}
+
+y_test_func("Vertex quantization octahedral normals and tangents") {
+    const core::Vector<PackedVertex> vertices = create_vertices(16384, math::Vec3(0.0f), math::Vec3(1.0f), math::Vec2(0.0f), math::Vec2(1.0f));
+    const MeshVertexStreams streams(vertices);
+    const QuantizedVertexStreams quantized = QuantizedVertexStreams::quantize(streams);
+    y_test_assert(quantized.format(VertexStreamType::NormalTangent) == VertexStreamFormat::Octahedral);
+
+    for(usize i = 0; i != vertices.size(); ++i) {
+        // Errors are relative to what was stored in the full precision stream
+        const math::Vec3 src_normal = unpack_2_10_10_10(vertices[i].packed_normal).to<3>().normalized();
+        const math::Vec4 src_tangent_sign = unpack_2_10_10_10(vertices[i].packed_tangent_sign);
+
+        const math::Vec3 normal = quantized.normal(i);
+        y_test_assert(std::abs(normal.length() - 1.0f) < 1.0e-5f);
+        y_test_assert(angle(normal, src_normal) <= max_normal_error);
+
+        const math::Vec4 tangent_sign = quantized.tangent_sign(i);
+        const math::Vec3 tangent = tangent_sign.to<3>();
+        y_test_assert(std::abs(tangent.length() - 1.0f) < 1.0e-5f);
+        y_test_assert(std::abs(tangent.dot(normal)) < 1.0e-5f);
+
+        const math::Vec3 src_tangent = src_tangent_sign.to<3>();
+        y_test_assert(angle(tangent, src_tangent - normal * normal.dot(src_tangent)) <= max_tangent_error);
+
+        // The bitangent sign is exact
+        y_test_assert(tangent_sign.w() == src_tangent_sign.w());
+        if(i < 16384) {
+            y_test_assert(tangent_sign.w() == (i % 3 ? 1.0f : -1.0f));
+        }
+    }
+}
+
+y_test_func("Vertex quantization unorm16 uvs") {
+    const math::Vec2 uv_min(-3.0f, 0.25f);
+    const math::Vec2 uv_max(5.0f, 0.75f);
+
+    const MeshVertexStreams streams(create_vertices(4096, math::Vec3(0.0f), math::Vec3(1.0f), uv_min, uv_max));
+    const QuantizedVertexStreams quantized = QuantizedVertexStreams::quantize(streams, VertexStreamFormat::Unorm16);
+    y_test_assert(quantized.format(VertexStreamType::Uv) == VertexStreamFormat::Unorm16);
+
+    const float max_error = quantized.max_uv_error();
+    y_test_assert(max_error > 0.0f);
+    y_test_assert(max_error <= (uv_max - uv_min).max_component() / 65535.0f);
+
+    const core::Span<math::Vec2> uvs = streams.stream<VertexStreamType::Uv>();
+    for(usize i = 0; i != streams.vertex_count(); ++i) {
+        const math::Vec2 uv = quantized.uv(i);
+        for(usize k = 0; k != 2; ++k) {
+            const float axis_error = (uv_max[k] - uv_min[k]) / (2.0f * 65535.0f) + 4.0f * math::epsilon<float> * std::abs(uvs[i][k]);
+            y_test_assert(std::abs(uv[k] - uvs[i][k]) <= axis_error);
+            y_test_assert(std::abs(uv[k] - uvs[i][k]) <= max_error * 1.01f);
+        }
+    }
+}
+
+y_test_func("Vertex quantization half uvs") {
+    core::Vector<PackedVertex> vertices = create_vertices(4096, math::Vec3(0.0f), math::Vec3(1.0f), math::Vec2(-8.0f), math::Vec2(8.0f));
+
+    // Exact values, the smallest normal half, a denormal and a value that rounds up to the next exponent
+    const float exact[] = {0.0f, 1.0f, 0.5f, -0.25f, 2.0f, 6.103515625e-5f, 1.0e-6f, 2047.9f / 1024.0f};
+    for(usize i = 0; i != sizeof(exact) / sizeof(exact[0]); ++i) {
+        vertices[i].uv = math::Vec2(exact[i], -exact[i]);
+    }
+
+    const MeshVertexStreams streams(vertices);
+    const QuantizedVertexStreams quantized = QuantizedVertexStreams::quantize(streams, VertexStreamFormat::Half);
+    y_test_assert(quantized.format(VertexStreamType::Uv) == VertexStreamFormat::Half);
+    y_test_assert(quantized.byte_size() == streams.vertex_count() * 16);
+
+    const float max_error = quantized.max_uv_error();
+    y_test_assert(max_error > 0.0f);
+    y_test_assert(max_error <= 8.0f / 2048.0f);
+
+    const core::Span<math::Vec2> uvs = streams.stream<VertexStreamType::Uv>();
+    for(usize i = 0; i != streams.vertex_count(); ++i) {
+        const math::Vec2 uv = quantized.uv(i);
+        for(usize k = 0; k != 2; ++k) {
+            // Half a ulp: relative for normal halfs, absolute for denormals
+            const float error = std::abs(uv[k] - uvs[i][k]);
+            y_test_assert(error <= std::max(std::abs(uvs[i][k]) / 2048.0f, 1.0f / float(1 << 25)));
+            y_test_assert(error <= max_error);
+        }
+    }
+
+    for(usize i = 0; i != 6; ++i) {
+        y_test_assert(quantized.uv(i) == math::Vec2(exact[i], -exact[i]));
+    }
+    y_test_assert(quantized.uv(7).x() == 2.0f);
+}
+
+y_test_func("Vertex quantization full precision") {
+    const MeshVertexStreams streams(create_vertices(256, math::Vec3(1.0f, 2.0f, 3.0f), math::Vec3(10.0f), math::Vec2(0.0f), math::Vec2(1.0f)));
+    const QuantizedVertexStreams full = QuantizedVertexStreams::full_precision(streams);
+
+    y_test_assert(full.max_position_error() == 0.0f);
+    y_test_assert(full.max_uv_error() == 0.0f);
+    y_test_assert(full.byte_size() == streams.vertex_count() * MeshVertexStreams::total_vertex_size);
+
+    for(usize i = 0; i != streams.vertex_count(); ++i) {
+        const PackedVertex v = streams[i];
+        y_test_assert(full.position(i) == v.position);
+        y_test_assert(full.uv(i) == v.uv);
+        y_test_assert(full.normal(i) == unpack_2_10_10_10(v.packed_normal).to<3>());
+        y_test_assert(full.tangent_sign(i) == unpack_2_10_10_10(v.packed_tangent_sign));
+    }
+}
@@ -0,0 +1,159 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include <yave/animations/PoseGraph.h>
+#include <yave/animations/AnimationCompression.h>
+
+#include <y/core/Chrono.h>
+
+#include <y/utils/log.h>
+#include <y/utils/format.h>
+
+#include <cmath>
+
+using namespace yave;
+
+// Compares BoundAnimation::evaluate with PoseGraph on a synthetic character, no device needed.
+// Also reports how well the clips compress and what it does to evaluation time.
+// Usage: animation_benchmark [bone count] [iterations]
+
+static constexpr float frame_time = 1.0f / 60.0f;
+
+static std::shared_ptr<const Skeleton> create_skeleton(usize bone_count) {
+    core::Vector<Bone> bones;
+    for(usize i = 0; i != bone_count; ++i) {
+        Bone& bone = bones.emplace_back();
+        bone.name = fmt_to_owned("bone_{}", i);
+        bone.parent = i ? u32((i - 1) / 2) : u32(-1);
+        bone.local_transform.position = math::Vec3(0.0f, 0.1f, 0.0f);
+        bone.local_transform.rotation = math::Quaternion<>::from_axis_angle(math::Vec3(1.0f, 0.0f, 0.0f), 0.05f * float(i % 7));
+    }
+    return std::make_shared<const Skeleton>(bones);
+}
+
+static Animation create_animation(const Skeleton& skeleton, float phase) {
+    const float duration = 2.0f;
+    const usize key_count = 60;
+
+    core::Vector<AnimationChannel> channels;
+    const core::Span<Bone> bones = skeleton.bones();
+    for(usize i = 0; i != bones.size(); ++i) {
+        const Bone& bone = bones[i];
+        core::Vector<AnimationChannel::BoneKey> keys;
+        for(usize k = 0; k != key_count; ++k) {
+            const float time = duration * float(k) / float(key_count - 1);
+            const float angle = std::sin(time * 3.0f + phase + float(i));
+
+            BoneTransform tr = bone.local_transform;
+            tr.rotation = tr.rotation * math::Quaternion<>::from_axis_angle(math::Vec3(0.0f, 0.0f, 1.0f), angle * 0.3f);
+            keys << AnimationChannel::BoneKey{time, tr};
+        }
+        channels.emplace_back(bone.name, std::move(keys));
+    }
+    return Animation(duration, std::move(channels));
+}
+
+template<typename F>
+static double bench(usize iterations, F&& func) {
+    core::StopWatch timer;
+    for(usize i = 0; i != iterations; ++i) {
+        func(float(i) * frame_time);
+    }
+    return timer.elapsed().to_micros() / double(iterations);
+}
+
+int main(int argc, char** argv) {
+    const usize bone_count = argc > 1 ? usize(std::max(1, std::atoi(argv[1]))) : 128;
+    const usize iterations = argc > 2 ? usize(std::max(1, std::atoi(argv[2]))) : 10000;
+
+    const auto skeleton = create_skeleton(std::min(bone_count, Skeleton::max_bones));
+    const usize bones = skeleton->bones().size();
+
+    const Animation walk_anim = create_animation(*skeleton, 0.0f);
+    const BoundAnimation walk(walk_anim, *skeleton);
+    const BoundAnimation run(create_animation(*skeleton, 1.0f), *skeleton);
+    const BoundAnimation wave(create_animation(*skeleton, 2.0f), *skeleton);
+
+    core::Vector<math::Transform<>> skinning(bones, math::Transform<>());
+
+    log_msg(fmt("{} bones, {} iterations", bones, iterations));
+
+    {
+        core::Vector<u32> cursors(walk.track_count(), 0u);
+        const double us = bench(iterations, [&](float time) {
+            walk.evaluate(*skeleton, std::fmod(time, walk.duration()), cursors, skinning);
+        });
+        log_msg(fmt("BoundAnimation::evaluate: {:.2f}us", us));
+    }
+
+    {
+        const CompressedAnimation compressed = compress_animation(walk_anim);
+        log_msg(fmt("Compression: {} -> {} keys ({} constant channels), {}KB -> {}KB ({:.2f}x)",
+            compressed.original_key_count, compressed.key_count, compressed.constant_channels,
+            compressed.original_byte_size / 1024, compressed.compressed_byte_size / 1024, compressed.compression_ratio()));
+        log_msg(fmt("Compression max error: position {}, rotation {}rad, scale {}",
+            compressed.max_position_error, compressed.max_rotation_error, compressed.max_scale_error));
+
+        const BoundAnimation compressed_walk(compressed.animation, *skeleton);
+        core::Vector<u32> cursors(compressed_walk.track_count(), 0u);
+        const double us = bench(iterations, [&](float time) {
+            compressed_walk.evaluate(*skeleton, std::fmod(time, compressed_walk.duration()), cursors, skinning);
+        });
+        log_msg(fmt("BoundAnimation::evaluate, compressed: {:.2f}us", us));
+    }
+
+    {
+        PoseGraph graph(skeleton);
+        graph.add_clip(&walk);
+        const double us = bench(iterations, [&](float) {
+            graph.update(frame_time);
+            graph.evaluate(skinning);
+        });
+        log_msg(fmt("PoseGraph, single clip: {:.2f}us", us));
+    }
+
+    {
+        // Upper body half of the bones
+        core::Vector<float> mask(bones, 0.0f);
+        std::fill(mask.begin() + bones / 2, mask.end(), 1.0f);
+
+        PoseGraph graph(skeleton);
+        const auto walk_node = graph.add_clip(&walk);
+        const auto run_node = graph.add_clip(&run);
+        const auto fade = graph.add_blend(walk_node, run_node);
+        const auto wave_node = graph.add_clip(&wave);
+        graph.add_additive(fade, wave_node, 0.5f, mask);
+
+        const double us = bench(iterations, [&](float) {
+            if(graph.weight(fade) == 0.0f) {
+                graph.fade_to(fade, 1.0f, 0.5f);
+            } else if(graph.weight(fade) == 1.0f) {
+                graph.fade_to(fade, 0.0f, 0.5f);
+            }
+            graph.update(frame_time);
+            graph.evaluate(skinning);
+        });
+        log_msg(fmt("PoseGraph, cross-fade + masked additive: {:.2f}us", us));
+    }
+
+    return 0;
+}
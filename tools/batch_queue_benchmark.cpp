@@ -0,0 +1,138 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include <y/concurrent/BatchQueue.h>
+#include <y/concurrent/Mutexed.h>
+#include <y/core/RingQueue.h>
+#include <y/core/Chrono.h>
+
+#include <y/utils/log.h>
+#include <y/utils/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace y;
+using namespace y::core;
+using namespace y::concurrent;
+
+// Compares BatchQueue with a locked queue when many threads defer destructions while one thread collects them.
+// Usage: batch_queue_benchmark [thread count] [handles per thread]
+
+// Stands in for a graphic handle, destroying it marks it in a table
+struct MockHandle {
+    u32 thread = 0;
+    u32 index = 0;
+};
+
+struct DestroyedTable {
+    DestroyedTable(usize thread_count, usize handles_per_thread) : destroyed(thread_count * handles_per_thread), per_thread(handles_per_thread) {
+    }
+
+    void destroy(const MockHandle& handle) {
+        ++destroyed[handle.thread * per_thread + handle.index];
+    }
+
+    bool all_destroyed_once() const {
+        return std::all_of(destroyed.begin(), destroyed.end(), [](u32 d) { return d == 1; });
+    }
+
+    std::vector<u32> destroyed;
+    usize per_thread = 0;
+};
+
+// Producers destroy handles tagged with a fence counter while the consumer collects everything up to the last fence
+template<typename Push, typename Consume>
+static double run_contention(usize thread_count, usize handles_per_thread, Push&& push, Consume&& consume) {
+    std::atomic<u64> fence = 0;
+    std::atomic<usize> running = thread_count;
+
+    const StopWatch timer;
+
+    std::vector<std::thread> producers;
+    for(usize t = 0; t != thread_count; ++t) {
+        producers.emplace_back([&, t] {
+            for(usize i = 0; i != handles_per_thread; ++i) {
+                push(fence.load(), MockHandle{u32(t), u32(i)});
+            }
+            --running;
+        });
+    }
+
+    while(running) {
+        consume(fence++);
+    }
+
+    for(auto& thread : producers) {
+        thread.join();
+    }
+
+    consume(u64(-1));
+
+    return timer.elapsed().to_secs();
+}
+
+int main(int argc, char** argv) {
+    const usize thread_count = argc > 1 ? usize(std::max(1, std::atoi(argv[1]))) : 8;
+    const usize handles_per_thread = argc > 2 ? usize(std::max(1, std::atoi(argv[2]))) : 32 * 1024;
+
+    log_msg(fmt("{} threads, {} handles", thread_count, thread_count * handles_per_thread));
+
+    {
+        DestroyedTable table(thread_count, handles_per_thread);
+        BatchQueue<MockHandle> queue;
+        const double secs = run_contention(thread_count, handles_per_thread,
+            [&](u64 tag, MockHandle handle) { queue.emplace(tag, handle); },
+            [&](u64 up_to) { queue.consume(up_to, [&](const MockHandle& handle) { table.destroy(handle); }); }
+        );
+        if(!table.all_destroyed_once()) {
+            log_msg("BatchQueue did not destroy every handle exactly once", Log::Error);
+            return 1;
+        }
+        log_msg(fmt("BatchQueue: {:.2f}ms", secs * 1000.0), Log::Perf);
+    }
+
+    {
+        DestroyedTable table(thread_count, handles_per_thread);
+        Mutexed<RingQueue<std::pair<u64, MockHandle>>> queue;
+        const double secs = run_contention(thread_count, handles_per_thread,
+            [&](u64 tag, MockHandle handle) { queue.locked([&](auto&& q) { q.emplace_back(tag, handle); }); },
+            [&](u64 up_to) {
+                queue.locked([&](auto&& q) {
+                    while(!q.is_empty() && q.first().first <= up_to) {
+                        table.destroy(q.pop_front().second);
+                    }
+                });
+            }
+        );
+        if(!table.all_destroyed_once()) {
+            log_msg("Locked queue did not destroy every handle exactly once", Log::Error);
+            return 1;
+        }
+        log_msg(fmt("Locked queue: {:.2f}ms", secs * 1000.0), Log::Perf);
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include <yave/graphics/shaders/ShaderBundle.h>
+
+#include <y/io2/File.h>
+
+#include <y/utils/log.h>
+#include <y/utils/format.h>
+
+#include <filesystem>
+
+using namespace yave;
+
+// Usage: shader_bundler <output> <spirv files...>
+// Shaders are named after their file, without the .spv extension
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        log_msg("Usage: shader_bundler <output> <spirv files...>", Log::Error);
+        return 1;
+    }
+
+    core::Vector<ShaderBundle::Shader> shaders;
+    for(int i = 2; i < argc; ++i) {
+        const std::filesystem::path path = argv[i];
+
+        auto file = io2::File::open(core::String(argv[i]));
+        if(!file) {
+            log_msg(fmt("Unable to open \"{}\"", argv[i]), Log::Error);
+            return 1;
+        }
+
+        ShaderBundle::Shader& shader = shaders.emplace_back();
+        shader.name = path.stem().string();
+        shader.spirv = SpirVData::deserialized(file.unwrap());
+    }
+
+    auto output = io2::File::create(core::String(argv[1]));
+    if(!output) {
+        log_msg(fmt("Unable to create \"{}\"", argv[1]), Log::Error);
+        return 1;
+    }
+
+    if(!ShaderBundle::write(output.unwrap(), shaders)) {
+        log_msg(fmt("Unable to write \"{}\"", argv[1]), Log::Error);
+        return 1;
+    }
+
+    log_msg(fmt("{} shaders written to \"{}\"", shaders.size(), argv[1]));
+
+    return 0;
+}
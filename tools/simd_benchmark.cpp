@@ -0,0 +1,209 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include <y/math/Transform.h>
+#include <y/math/Quaternion.h>
+#include <y/math/random.h>
+#include <y/core/Chrono.h>
+
+#include <y/utils/log.h>
+#include <y/utils/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+
+using namespace y;
+using namespace y::math;
+
+// Compares the SIMD Matrix4 and Quaternion paths with plain scalar loops.
+// Usage: simd_benchmark [iterations]
+
+static constexpr usize sample_count = 64;
+
+static float random_float(FastRandom& rng) {
+    return float(i32(rng() % 20001) - 10000) / 1000.0f;
+}
+
+static Vec4 random_vec(FastRandom& rng) {
+    Vec4 v;
+    for(float& x : v) {
+        x = random_float(rng);
+    }
+    return v;
+}
+
+static Matrix4<> random_mat(FastRandom& rng) {
+    Matrix4<> m;
+    for(usize i = 0; i != 4; ++i) {
+        m[i] = random_vec(rng);
+    }
+    return m;
+}
+
+static bool almost_equal(float a, float b) {
+    return std::abs(a - b) <= 1e-5f * std::max(1.0f, std::max(std::abs(a), std::abs(b)));
+}
+
+template<typename T>
+static bool almost_equal(const T& a, const T& b) {
+    for(usize i = 0; i != a.size(); ++i) {
+        if(!almost_equal(a.begin()[i], b.begin()[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Same loops as the scalar templates
+namespace scalar {
+static Matrix4<> mul(const Matrix4<>& a, const Matrix4<>& b) {
+    Matrix4<> mat;
+    for(usize i = 0; i != 4; ++i) {
+        for(usize j = 0; j != 4; ++j) {
+            float tmp = 0.0f;
+            for(usize k = 0; k != 4; ++k) {
+                tmp = tmp + a[k][i] * b[j][k];
+            }
+            mat[j][i] = tmp;
+        }
+    }
+    return mat;
+}
+
+static Matrix4<> transposed(const Matrix4<>& m) {
+    Matrix4<> tr;
+    for(usize i = 0; i != 4; ++i) {
+        for(usize j = 0; j != 4; ++j) {
+            tr[j][i] = m[i][j];
+        }
+    }
+    return tr;
+}
+
+static std::array<float, 4> slerp(const std::array<float, 4>& a, std::array<float, 4> b, float factor) {
+    float dot = 0.0f;
+    for(usize i = 0; i != 4; ++i) {
+        dot += a[i] * b[i];
+    }
+    if(dot < 0.0f) {
+        for(float& x : b) {
+            x = -x;
+        }
+        dot = -dot;
+    }
+
+    float p = 1.0f - factor;
+    float q = factor;
+    if(1.0f - dot > epsilon<float>) {
+        const float omega = std::acos(dot);
+        const float sin = std::sin(omega);
+        p = std::sin((1.0f - factor) * omega) / sin;
+        q = std::sin(factor * omega) / sin;
+    }
+
+    std::array<float, 4> r = {};
+    float len = 0.0f;
+    for(usize i = 0; i != 4; ++i) {
+        r[i] = a[i] * p + b[i] * q;
+        len += r[i] * r[i];
+    }
+    for(float& x : r) {
+        x /= std::sqrt(len);
+    }
+    return r;
+}
+}
+
+template<typename F>
+static double bench(usize iterations, F&& func) {
+    const core::StopWatch timer;
+    for(usize k = 0; k != iterations; ++k) {
+        func(k % sample_count);
+    }
+    return timer.elapsed().to_secs() * 1000.0;
+}
+
+int main(int argc, char** argv) {
+    const usize iterations = argc > 1 ? usize(std::max(1, std::atoi(argv[1]))) : 1024 * 1024;
+
+#ifdef Y_MATH_SIMD
+    log_msg(fmt("{} iterations", iterations));
+#else
+    log_msg(fmt("{} iterations, SIMD is disabled: both paths are scalar", iterations), Log::Warning);
+#endif
+
+    FastRandom rng;
+    std::array<Matrix4<>, sample_count> m = {};
+    std::array<Matrix4<>, sample_count> n = {};
+    std::array<Quaternion<>, sample_count> quats = {};
+    std::array<std::array<float, 4>, sample_count> scalar_quats = {};
+    for(usize i = 0; i != sample_count; ++i) {
+        m[i] = random_mat(rng);
+        n[i] = random_mat(rng);
+        quats[i] = Quaternion<>(random_vec(rng));
+        std::copy(quats[i].as_vec().begin(), quats[i].as_vec().end(), scalar_quats[i].begin());
+    }
+
+    std::array<Matrix4<>, sample_count> simd_mats = {};
+    std::array<Matrix4<>, sample_count> scalar_mats = {};
+
+    const double simd_mul = bench(iterations, [&](usize i) { simd_mats[i] = m[i] * n[(i + 1) % sample_count]; });
+    const double scalar_mul = bench(iterations, [&](usize i) { scalar_mats[i] = scalar::mul(m[i], n[(i + 1) % sample_count]); });
+    for(usize i = 0; i != sample_count; ++i) {
+        if(!almost_equal(simd_mats[i], scalar_mats[i])) {
+            log_msg("Matrix4 multiply results do not match", Log::Error);
+            return 1;
+        }
+    }
+
+    const double simd_transpose = bench(iterations, [&](usize i) { simd_mats[i] = m[i].transposed(); });
+    const double scalar_transpose = bench(iterations, [&](usize i) { scalar_mats[i] = scalar::transposed(m[i]); });
+    if(simd_mats != scalar_mats) {
+        log_msg("Matrix4 transpose results do not match", Log::Error);
+        return 1;
+    }
+
+    const double simd_inverse = bench(iterations, [&](usize i) { simd_mats[i] = m[i].inverse(); });
+    const double affine_inverse = bench(iterations, [&](usize i) { scalar_mats[i] = Transform<>(m[i]).inverse(); });
+
+    std::array<Quaternion<>, sample_count> simd_slerped = {};
+    std::array<std::array<float, 4>, sample_count> scalar_slerped = {};
+
+    const double simd_slerp = bench(iterations, [&](usize i) { simd_slerped[i] = quats[i].slerp(quats[(i + 1) % sample_count], 0.3f); });
+    const double scalar_slerp = bench(iterations, [&](usize i) { scalar_slerped[i] = scalar::slerp(scalar_quats[i], scalar_quats[(i + 1) % sample_count], 0.3f); });
+    for(usize i = 0; i != sample_count; ++i) {
+        const auto& q = scalar_slerped[i];
+        if(!almost_equal(simd_slerped[i].as_vec(), Vec4(q[0], q[1], q[2], q[3]))) {
+            log_msg("Quaternion slerp results do not match", Log::Error);
+            return 1;
+        }
+    }
+
+    log_msg(fmt("Matrix4 multiply: SIMD {:.3f}ms, scalar {:.3f}ms", simd_mul, scalar_mul), Log::Perf);
+    log_msg(fmt("Matrix4 transpose: SIMD {:.3f}ms, scalar {:.3f}ms", simd_transpose, scalar_transpose), Log::Perf);
+    log_msg(fmt("Matrix4 inverse: SIMD {:.3f}ms, Transform::inverse {:.3f}ms", simd_inverse, affine_inverse), Log::Perf);
+    log_msg(fmt("Quaternion slerp: SIMD {:.3f}ms, scalar {:.3f}ms", simd_slerp, scalar_slerp), Log::Perf);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <y/concurrent/BatchQueue.h>
+#include <y/test/test.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+using namespace y;
+using namespace y::core;
+using namespace y::concurrent;
+
+// Stands in for a graphic handle
+struct MockHandle {
+    u32 thread = 0;
+    u32 index = 0;
+};
+
+y_test_func("BatchQueue consume") {
+    BatchQueue<int> queue;
+
+    for(int i = 0; i != 10; ++i) {
+        queue.emplace(0, i);
+    }
+
+    int sum = 0;
+    y_test_assert(queue.consume(0, [&](int i) { sum += i; }) == 10);
+    y_test_assert(sum == 45);
+    y_test_assert(queue.size() == 0);
+
+    for(int i = 0; i != 5; ++i) {
+        queue.emplace(2, i);
+    }
+
+    y_test_assert(queue.consume(1, [](int) {}) == 0);
+    y_test_assert(queue.size() == 5);
+    y_test_assert(queue.consume(2, [](int) {}) == 5);
+    y_test_assert(queue.size() == 0);
+}
+
+y_test_func("BatchQueue full batches") {
+    BatchQueue<int, 4> queue;
+
+    for(int i = 0; i != 10; ++i) {
+        queue.emplace(i / 4, i);
+    }
+
+    // Only full batches have been published
+    y_test_assert(queue.size() == 8);
+
+    core::Vector<int> consumed;
+    y_test_assert(queue.consume(1, [&](int i) { consumed << i; }) == 8);
+    y_test_assert(queue.consume(1, [&](int i) { consumed << i; }) == 0);
+    y_test_assert(queue.consume(2, [&](int i) { consumed << i; }) == 2);
+
+    std::sort(consumed.begin(), consumed.end());
+    for(int i = 0; i != 10; ++i) {
+        y_test_assert(consumed[i] == i);
+    }
+}
+
+y_test_func("BatchQueue multiple queues") {
+    BatchQueue<int> a;
+    BatchQueue<int> b;
+
+    for(int i = 0; i != 100; ++i) {
+        a.emplace(0, i);
+        b.emplace(0, -i);
+    }
+
+    int sum_a = 0;
+    int sum_b = 0;
+    y_test_assert(a.consume(0, [&](int i) { sum_a += i; }) == 100);
+    y_test_assert(b.consume(0, [&](int i) { sum_b += i; }) == 100);
+    y_test_assert(sum_a == 4950);
+    y_test_assert(sum_b == -4950);
+}
+
+// Correctness only, see tools/batch_queue_benchmark.cpp for the performance comparison
+y_test_func("BatchQueue concurrent") {
+    static constexpr usize thread_count = 4;
+    static constexpr usize handles_per_thread = 1024;
+
+    std::vector<u32> destroyed(thread_count * handles_per_thread, 0);
+
+    BatchQueue<MockHandle> queue;
+    std::atomic<u64> fence = 0;
+    std::atomic<usize> running = thread_count;
+
+    std::vector<std::thread> producers;
+    for(usize t = 0; t != thread_count; ++t) {
+        producers.emplace_back([&, t] {
+            for(usize i = 0; i != handles_per_thread; ++i) {
+                queue.emplace(fence.load(), MockHandle{u32(t), u32(i)});
+            }
+            --running;
+        });
+    }
+
+    const auto destroy = [&](const MockHandle& handle) {
+        ++destroyed[handle.thread * handles_per_thread + handle.index];
+    };
+
+    while(running) {
+        queue.consume(fence++, destroy);
+    }
+
+    for(auto& thread : producers) {
+        thread.join();
+    }
+
+    queue.consume(u64(-1), destroy);
+
+    y_test_assert(queue.size() == 0);
+    y_test_assert(std::all_of(destroyed.begin(), destroyed.end(), [](u32 d) { return d == 1; }));
+}
+
+}
@@ -23,6 +23,8 @@ SOFTWARE.
 #include <y/math/Matrix.h>
 #include <y/test/test.h>
 
+#include <cmath>
+
 namespace {
 using namespace y;
 using namespace y::math;
@@ -69,6 +71,88 @@ y_test_func("Matrix inverse") {
 }
 
 
+float max_error(const Matrix4<>& a, const Matrix4<>& b) {
+    float err = 0.0f;
+    for(usize i = 0; i != a.size(); ++i) {
+        err = std::max(err, std::abs(a.begin()[i] - b.begin()[i]));
+    }
+    return err;
+}
+
+bool is_finite(const Matrix4<>& m) {
+    return std::all_of(m.begin(), m.end(), [](float x) { return std::isfinite(x); });
+}
+
+y_test_func("Matrix4 determinant") {
+    constexpr Matrix4<> mat(2, 0, 1, 3,
+                            1, 4, 0, 2,
+                            0, 1, 5, 1,
+                            3, 2, 0, 6);
+
+    static_assert(mat.determinant() == 60.0f);
+    y_test_assert(mat.determinant() == 60.0f);
+    y_test_assert(mat.transposed().determinant() == 60.0f);
+}
+
+y_test_func("Matrix4 inverse") {
+    constexpr Matrix4<> mat(2, 0, 1, 3,
+                            1, 4, 0, 2,
+                            0, 1, 5, 1,
+                            3, 2, 0, 6);
+
+    // Constant evaluation uses the scalar path
+    constexpr Matrix4<> scalar_inv = mat.inverse();
+    const Matrix4<> inv = mat.inverse();
+
+    y_test_assert(max_error(inv, scalar_inv) < 1e-6f);
+    y_test_assert(max_error(mat * inv, Matrix4<>::identity()) < 1e-5f);
+    y_test_assert(max_error(inv * mat, Matrix4<>::identity()) < 1e-5f);
+    y_test_assert(max_error(inv.inverse(), mat) < 1e-4f);
+
+    // 60 * inverse only has integer coefficients
+    y_test_assert(max_error(scalar_inv * 60.0f, Matrix4<>(100,  34, -20, -58,
+                                                            0,  18,   0,  -6,
+                                                           10,   1,  10,  -7,
+                                                          -50, -23,  10,  41)) < 1e-4f);
+}
+
+y_test_func("Matrix4 inverse singular") {
+    // Third row is the sum of the first two
+    constexpr Matrix4<> mat(1, 2, 3, 4,
+                            5, 6, 7, 8,
+                            6, 8, 10, 12,
+                            1, 0, 0, 1);
+
+    constexpr Matrix4<> scalar_inv = mat.inverse();
+
+    y_test_assert(mat.determinant() == 0.0f);
+    y_test_assert(scalar_inv == Matrix4<>());
+    y_test_assert(mat.inverse() == Matrix4<>());
+    y_test_assert(Matrix4<>().inverse() == Matrix4<>());
+}
+
+y_test_func("Matrix4 inverse near singular") {
+    for(const float eps : {1e-2f, 1e-3f, 1e-4f}) {
+        // Rows are almost linearly dependent: the condition number is about 1 / eps
+        const Matrix4<> mat(1, 2, 3, 4,
+                            5, 6, 7, 8,
+                            6, 8, 10, 12 + eps,
+                            1, 0, 0, 1);
+
+        const Matrix4<> inv = mat.inverse();
+        y_test_assert(inv != Matrix4<>());
+        y_test_assert(is_finite(inv));
+
+        const float tolerance = 1e-5f / eps;
+        y_test_assert(max_error(mat * inv, Matrix4<>::identity()) < tolerance);
+        y_test_assert(max_error(inv * mat, Matrix4<>::identity()) < tolerance);
+    }
+
+    // Tiny but well conditioned
+    const Matrix4<> tiny = Matrix4<>::identity() * 1e-8f;
+    y_test_assert(max_error(tiny.inverse() * 1e-8f, Matrix4<>::identity()) < 1e-5f);
+}
+
 y_test_func("Matrix asymmetrical") {
     const Matrix<2, 3, float> mat(1, 2, 3, 4, 5, 6);
 
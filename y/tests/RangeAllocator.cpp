@@ -0,0 +1,125 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include <y/core/RangeAllocator.h>
+#include <y/test/test.h>
+
+#include <random>
+
+namespace {
+using namespace y;
+using namespace y::core;
+
+y_test_func("RangeAllocator alloc") {
+    RangeAllocator allocator(1024);
+
+    y_test_assert(allocator.alloc(100) == 0);
+    y_test_assert(allocator.alloc(24) == 100);
+    y_test_assert(allocator.alloc(900) == 124);
+
+    y_test_assert(allocator.available() == 0);
+    y_test_assert(allocator.allocated() == 1024);
+    y_test_assert(allocator.free_range_count() == 0);
+    y_test_assert(allocator.alloc(1) == RangeAllocator::invalid_offset);
+}
+
+y_test_func("RangeAllocator free merge") {
+    RangeAllocator allocator(1024);
+
+    const u64 a = allocator.alloc(256);
+    const u64 b = allocator.alloc(256);
+    const u64 c = allocator.alloc(256);
+
+    allocator.free(a, 256);
+    allocator.free(c, 256);
+    y_test_assert(allocator.free_range_count() == 2);
+    y_test_assert(allocator.available() == 768);
+
+    allocator.free(b, 256);
+    y_test_assert(allocator.free_range_count() == 1);
+    y_test_assert(allocator.largest_free_range() == 1024);
+    y_test_assert(allocator.fragmentation() == 0.0f);
+}
+
+y_test_func("RangeAllocator fragmentation") {
+    RangeAllocator allocator(1024);
+
+    u64 offsets[8] = {};
+    for(u64& offset : offsets) {
+        offset = allocator.alloc(128);
+    }
+
+    for(usize i = 0; i != 8; i += 2) {
+        allocator.free(offsets[i], 128);
+    }
+
+    y_test_assert(allocator.available() == 512);
+    y_test_assert(allocator.largest_free_range() == 128);
+    y_test_assert(allocator.fragmentation() == 0.75f);
+
+    // Enough space, but not in a single range
+    y_test_assert(allocator.alloc(256) == RangeAllocator::invalid_offset);
+    y_test_assert(allocator.alloc(128) == 0);
+}
+
+y_test_func("RangeAllocator random") {
+    const u64 size = 1 << 16;
+    RangeAllocator allocator(size);
+
+    std::mt19937 rng(4);
+    Vector<RangeAllocator::Range> allocated;
+
+    for(usize i = 0; i != 4096; ++i) {
+        if(allocated.is_empty() || rng() % 3) {
+            const u64 alloc_size = 1 + rng() % 256;
+            const u64 offset = allocator.alloc(alloc_size);
+            if(offset != RangeAllocator::invalid_offset) {
+                allocated << RangeAllocator::Range{offset, alloc_size};
+            }
+        } else {
+            const usize index = rng() % allocated.size();
+            allocator.free(allocated[index].offset, allocated[index].size);
+            allocated.erase_unordered(allocated.begin() + index);
+        }
+
+        u64 total = 0;
+        for(const auto& range : allocated) {
+            total += range.size;
+        }
+        y_test_assert(allocator.allocated() == total);
+    }
+
+    const auto free_ranges = allocator.free_ranges();
+    for(usize i = 1; i < free_ranges.size(); ++i) {
+        // Sorted, and never adjacent
+        y_test_assert(free_ranges[i - 1].end() < free_ranges[i].offset);
+    }
+
+    for(const auto& range : allocated) {
+        allocator.free(range.offset, range.size);
+    }
+
+    y_test_assert(allocator.free_range_count() == 1);
+    y_test_assert(allocator.available() == size);
+}
+
+}
@@ -27,6 +27,46 @@ namespace {
 using namespace y;
 using namespace y::math;
 
+float max_error(const Matrix4<>& a, const Matrix4<>& b) {
+    float err = 0.0f;
+    for(usize i = 0; i != a.size(); ++i) {
+        err = std::max(err, std::abs(a.begin()[i] - b.begin()[i]));
+    }
+    return err;
+}
+
+y_test_func("Transform inverse") {
+    const Transform<> rigid(Vec3(1.0f, -7.0f, 9.0f), Quaternion<>::from_euler(to_rad(30.0f), to_rad(-60.0f), to_rad(45.0f)));
+    const Transform<> scaled(Vec3(-3.0f, 2.0f, 0.5f), Quaternion<>::from_euler(to_rad(-10.0f), to_rad(80.0f), to_rad(5.0f)), Vec3(0.5f, 2.0f, 4.0f));
+
+    // Rotation inside a non uniformly scaled parent: the axes are not orthogonal anymore
+    const Transform<> sheared = scaled * rigid;
+
+    for(const Transform<>& tr : {rigid, scaled, sheared}) {
+        const Matrix4<> inv = tr.inverse();
+        y_test_assert(max_error(tr * inv, Matrix4<>::identity()) < 1e-5f);
+        y_test_assert(max_error(inv, tr.matrix().inverse()) < 1e-5f);
+    }
+
+    for(const Transform<>& tr : {rigid, scaled}) {
+        const Matrix4<> inv = tr.rigid_inverse();
+        y_test_assert(max_error(tr * inv, Matrix4<>::identity()) < 1e-5f);
+        y_test_assert(max_error(inv, tr.inverse()) < 1e-5f);
+    }
+
+    y_test_assert(max_error(sheared * sheared.rigid_inverse(), Matrix4<>::identity()) > 0.1f);
+}
+
+y_test_func("Transform inverse singular") {
+    const Transform<> flat(Vec3(1.0f, 2.0f, 3.0f), Quaternion<>::from_euler(to_rad(30.0f), 0.0f, 0.0f), Vec3(1.0f, 1.0f, 0.0f));
+    y_test_assert(flat.inverse() == Matrix4<>());
+
+    const Transform<> thin(Vec3(1.0f, 2.0f, 3.0f), Quaternion<>::from_euler(to_rad(30.0f), 0.0f, 0.0f), Vec3(1.0f, 1.0f, 1e-4f));
+    const Matrix4<> inv = thin.inverse();
+    y_test_assert(std::all_of(inv.begin(), inv.end(), [](float x) { return std::isfinite(x); }));
+    y_test_assert(max_error(thin * inv, Matrix4<>::identity()) < 1e-3f);
+}
+
 y_test_func("Transform decompose basic") {
     const auto quat = Quaternion<>::from_euler(to_rad(90.0f), 0.0f, to_rad(90.0f));
     const Vec3 scale(5.0f);
@@ -0,0 +1,112 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <y/math/Volume.h>
+#include <y/math/random.h>
+#include <y/test/test.h>
+
+#include <array>
+
+namespace {
+using namespace y;
+using namespace y::math;
+
+y_test_func("NormalCone flat") {
+    const std::array<Vec3, 3> normals = {Vec3(0.0f, 0.0f, 1.0f), Vec3(0.0f, 0.0f, 1.0f), Vec3(0.0f, 0.0f, 1.0f)};
+    const NormalCone<> cone = NormalCone<>::from_normals(normals.begin(), normals.end());
+
+    y_test_assert(!cone.is_degenerate());
+    y_test_assert((cone.axis() - Vec3(0.0f, 0.0f, 1.0f)).length() < 0.0001f);
+    y_test_assert(std::abs(cone.cutoff()) < 0.0001f);
+
+    y_test_assert(cone.is_backfacing(Vec3(0.0f), 1.0f, Vec3(0.0f, 0.0f, -10.0f)));
+    y_test_assert(!cone.is_backfacing(Vec3(0.0f), 1.0f, Vec3(0.0f, 0.0f, 10.0f)));
+
+    // Grazing view, the sphere still reaches the front side
+    y_test_assert(!cone.is_backfacing(Vec3(0.0f), 1.0f, Vec3(10.0f, 0.0f, -0.5f)));
+
+    y_test_assert(cone.is_backfacing(Vec3(0.0f, 0.0f, 1.0f)));
+    y_test_assert(!cone.is_backfacing(Vec3(0.0f, 0.0f, -1.0f)));
+}
+
+y_test_func("NormalCone degenerate") {
+    {
+        const std::array<Vec3, 2> normals = {Vec3(0.0f, 0.0f, 1.0f), Vec3(0.0f, 0.0f, -1.0f)};
+        const NormalCone<> cone = NormalCone<>::from_normals(normals.begin(), normals.end());
+        y_test_assert(cone.is_degenerate());
+    }
+    {
+        const std::array<Vec3, 3> normals = {Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f), Vec3(-1.0f, 0.0f, 0.0f)};
+        const NormalCone<> cone = NormalCone<>::from_normals(normals.begin(), normals.end());
+        y_test_assert(cone.is_degenerate());
+    }
+
+    const NormalCone<> cone;
+    for(const Vec3 pos : {Vec3(0.0f, 0.0f, 10.0f), Vec3(0.0f, 0.0f, -10.0f), Vec3(0.0f, 10.0f, 0.0f)}) {
+        y_test_assert(!cone.is_backfacing(Vec3(0.0f), 0.0f, pos));
+        y_test_assert(!cone.is_backfacing(-pos.normalized()));
+    }
+}
+
+y_test_func("NormalCone is conservative") {
+    FastRandom rng;
+    auto random_float = [&] { return float(rng() % 10001) / 10000.0f; };
+    auto random_dir = [&] { return Vec3(random_float() * 2.0f - 1.0f, random_float() * 2.0f - 1.0f, random_float() * 2.0f - 1.0f).normalized(); };
+
+    usize culled = 0;
+    for(usize i = 0; i != 1000; ++i) {
+        // Normals around a random axis
+        const Vec3 axis = random_dir();
+        const float spread = random_float();
+        std::array<Vec3, 8> normals;
+        for(Vec3& n : normals) {
+            n = (axis + random_dir() * spread).normalized();
+        }
+
+        // Points on the cluster
+        std::array<Vec3, 8> points;
+        for(Vec3& p : points) {
+            p = random_dir() * random_float();
+        }
+
+        const NormalCone<> cone = NormalCone<>::from_normals(normals.begin(), normals.end());
+        for(const Vec3& n : normals) {
+            y_test_assert(n.dot(cone.axis()) >= std::sqrt(1.0f - cone.cutoff() * cone.cutoff()) - 0.0001f);
+        }
+
+        for(usize k = 0; k != 16; ++k) {
+            const Vec3 view_pos = random_dir() * (1.0f + random_float() * 10.0f);
+            if(!cone.is_backfacing(Vec3(0.0f), 1.0f, view_pos)) {
+                continue;
+            }
+
+            ++culled;
+            for(const Vec3& p : points) {
+                for(const Vec3& n : normals) {
+                    y_test_assert((p - view_pos).dot(n) >= -0.0001f);
+                }
+            }
+        }
+    }
+
+    y_test_assert(culled > 0);
+}
+}
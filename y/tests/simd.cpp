@@ -0,0 +1,258 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include <y/math/Transform.h>
+#include <y/math/Quaternion.h>
+#include <y/math/random.h>
+#include <y/test/test.h>
+
+#include <array>
+
+namespace {
+using namespace y;
+using namespace y::math;
+
+static constexpr usize sample_count = 64;
+
+constexpr float random_float(FastRandom& rng) {
+    return float(i32(rng() % 20001) - 10000) / 1000.0f;
+}
+
+constexpr Vec4 random_vec(FastRandom& rng) {
+    Vec4 v;
+    for(float& x : v) {
+        x = random_float(rng);
+    }
+    return v;
+}
+
+constexpr Matrix4<> random_mat(FastRandom& rng) {
+    Matrix4<> m;
+    for(usize i = 0; i != 4; ++i) {
+        m[i] = random_vec(rng);
+    }
+    return m;
+}
+
+// Bypasses the constructor, which normalizes
+constexpr Quaternion<> as_quat(const Vec4& v) {
+    Quaternion<> q;
+    q.as_vec() = v;
+    return q;
+}
+
+struct Samples {
+    std::array<Vec4, sample_count> a;
+    std::array<Vec4, sample_count> b;
+    std::array<Matrix4<>, sample_count> m;
+    std::array<Matrix4<>, sample_count> n;
+};
+
+constexpr Samples samples = [] {
+    FastRandom rng;
+    Samples s;
+    for(usize i = 0; i != sample_count; ++i) {
+        s.a[i] = random_vec(rng);
+        s.b[i] = random_vec(rng);
+        s.m[i] = random_mat(rng);
+        s.n[i] = random_mat(rng);
+    }
+    return s;
+}();
+
+struct Results {
+    std::array<Vec4, sample_count> add;
+    std::array<Vec4, sample_count> sub;
+    std::array<Vec4, sample_count> mul;
+    std::array<Vec4, sample_count> div;
+    std::array<Vec4, sample_count> scale;
+    std::array<Vec4, sample_count> neg;
+    std::array<Vec4, sample_count> abs;
+    std::array<Vec4, sample_count> min;
+    std::array<Vec4, sample_count> max;
+    std::array<float, sample_count> dot;
+    std::array<Matrix4<>, sample_count> mat_mul;
+    std::array<Vec4, sample_count> mat_vec;
+    std::array<Matrix4<>, sample_count> transposed;
+    std::array<Matrix4<>, sample_count> inverse;
+    std::array<Vec4, sample_count> quat_mul;
+};
+
+constexpr Results compute_results() {
+    Results r;
+    for(usize i = 0; i != sample_count; ++i) {
+        const Vec4& a = samples.a[i];
+        const Vec4& b = samples.b[i];
+        r.add[i] = a + b;
+        r.sub[i] = a - b;
+        r.mul[i] = a * b;
+        r.div[i] = a / b;
+        r.scale[i] = a * b.x();
+        r.neg[i] = -a;
+        r.abs[i] = a.abs();
+        r.min[i] = a.min(b);
+        r.max[i] = a.max(b);
+        r.dot[i] = a.dot(b);
+        r.mat_mul[i] = samples.m[i] * samples.n[i];
+        r.mat_vec[i] = samples.m[i] * a;
+        r.transposed[i] = samples.m[i].transposed();
+        r.inverse[i] = samples.m[i].inverse();
+        r.quat_mul[i] = (as_quat(a) *= as_quat(b)).as_vec();
+    }
+    return r;
+}
+
+// Constant evaluation always uses the scalar implementations
+constexpr Results scalar_results = compute_results();
+
+bool almost_equal(float a, float b) {
+    return std::abs(a - b) <= 1e-5f * std::max(1.0f, std::max(std::abs(a), std::abs(b)));
+}
+
+template<typename T>
+bool almost_equal(const T& a, const T& b) {
+    for(usize i = 0; i != a.size(); ++i) {
+        if(!almost_equal(a.begin()[i], b.begin()[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T, usize N>
+bool almost_equal(const std::array<T, N>& a, const std::array<T, N>& b) {
+    for(usize i = 0; i != N; ++i) {
+        if(!almost_equal(a[i], b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+y_test_func("SIMD Vec4 matches scalar") {
+    const Results simd_results = compute_results();
+
+    y_test_assert(simd_results.add == scalar_results.add);
+    y_test_assert(simd_results.sub == scalar_results.sub);
+    y_test_assert(simd_results.mul == scalar_results.mul);
+    y_test_assert(simd_results.div == scalar_results.div);
+    y_test_assert(simd_results.scale == scalar_results.scale);
+    y_test_assert(simd_results.neg == scalar_results.neg);
+    y_test_assert(simd_results.abs == scalar_results.abs);
+    y_test_assert(simd_results.min == scalar_results.min);
+    y_test_assert(simd_results.max == scalar_results.max);
+
+    // Horizontal sums are not done in the same order
+    y_test_assert(almost_equal(simd_results.dot, scalar_results.dot));
+}
+
+y_test_func("SIMD Matrix4 matches scalar") {
+    const Results simd_results = compute_results();
+
+    y_test_assert(almost_equal(simd_results.mat_mul, scalar_results.mat_mul));
+    y_test_assert(almost_equal(simd_results.mat_vec, scalar_results.mat_vec));
+    y_test_assert(simd_results.transposed == scalar_results.transposed);
+
+    for(usize i = 0; i != sample_count; ++i) {
+        // Blockwise and cofactor inversions do not round the same way, compare relative to the inverse magnitude
+        float max_coef = 0.0f;
+        float max_diff = 0.0f;
+        for(usize k = 0; k != 16; ++k) {
+            max_coef = std::max(max_coef, std::abs(scalar_results.inverse[i].begin()[k]));
+            max_diff = std::max(max_diff, std::abs(simd_results.inverse[i].begin()[k] - scalar_results.inverse[i].begin()[k]));
+        }
+        y_test_assert(max_diff <= max_coef * 1e-4f);
+    }
+}
+
+y_test_func("SIMD Quaternion matches scalar") {
+    const Results simd_results = compute_results();
+
+    y_test_assert(almost_equal(simd_results.quat_mul, scalar_results.quat_mul));
+
+    for(usize i = 0; i != sample_count; ++i) {
+        const Quaternion<> a = samples.a[i];
+        const Quaternion<> b = samples.b[i];
+        for(const float t : {0.0f, 0.25f, 0.5f, 1.0f}) {
+            const Quaternion<> q = a.slerp(b, t);
+            y_test_assert(std::abs(q.as_vec().length() - 1.0f) < 1e-5f);
+        }
+        y_test_assert(almost_equal(a.slerp(b, 0.0f).as_vec(), a.as_vec()));
+        y_test_assert(almost_equal(a.slerp(b, 1.0f).as_vec(), b.as_vec()) || almost_equal(a.slerp(b, 1.0f).as_vec(), -b.as_vec()));
+    }
+}
+
+
+
+// Same loop as the scalar template, for comparison
+namespace scalar {
+std::array<float, 4> slerp(const std::array<float, 4>& a, std::array<float, 4> b, float factor) {
+    float dot = 0.0f;
+    for(usize i = 0; i != 4; ++i) {
+        dot += a[i] * b[i];
+    }
+    if(dot < 0.0f) {
+        for(float& x : b) {
+            x = -x;
+        }
+        dot = -dot;
+    }
+
+    float p = 1.0f - factor;
+    float q = factor;
+    if(1.0f - dot > epsilon<float>) {
+        const float omega = std::acos(dot);
+        const float sin = std::sin(omega);
+        p = std::sin((1.0f - factor) * omega) / sin;
+        q = std::sin(factor * omega) / sin;
+    }
+
+    std::array<float, 4> r = {};
+    float len = 0.0f;
+    for(usize i = 0; i != 4; ++i) {
+        r[i] = a[i] * p + b[i] * q;
+        len += r[i] * r[i];
+    }
+    for(float& x : r) {
+        x /= std::sqrt(len);
+    }
+    return r;
+}
+}
+
+y_test_func("SIMD slerp matches scalar") {
+    for(usize i = 0; i != sample_count; ++i) {
+        const Quaternion<> a = samples.a[i];
+        const Quaternion<> b = samples.b[(i + 1) % sample_count];
+
+        std::array<float, 4> scalar_a = {};
+        std::array<float, 4> scalar_b = {};
+        std::copy(a.as_vec().begin(), a.as_vec().end(), scalar_a.begin());
+        std::copy(b.as_vec().begin(), b.as_vec().end(), scalar_b.begin());
+
+        for(const float t : {0.1f, 0.3f, 0.5f, 0.9f}) {
+            const std::array<float, 4> q = scalar::slerp(scalar_a, scalar_b, t);
+            y_test_assert(almost_equal(a.slerp(b, t).as_vec(), Vec4(q[0], q[1], q[2], q[3])));
+        }
+    }
+}
+
+}
@@ -0,0 +1,195 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef Y_CONCURRENT_BATCHQUEUE_H
+#define Y_CONCURRENT_BATCHQUEUE_H
+
+#include <y/core/Vector.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace y {
+namespace concurrent {
+
+namespace detail {
+inline std::atomic<u64> next_batch_queue_id = 1;
+
+struct BatchQueueSlotCache {
+    u64 queue_id = 0;
+    void* slot = nullptr;
+};
+
+inline thread_local BatchQueueSlotCache batch_queue_slot_cache;
+}
+
+// Multiple producers, single consumer queue of tagged items.
+// Each thread fills its own batch without synchronization, full batches are handed to the consumer with a single atomic push.
+// Batches left in idle threads are picked up by the consumer.
+// A batch is tagged with the highest tag of its items: consume(up_to) might return an item later than its tag allows, never earlier.
+template<typename T, usize BatchSize = 64>
+class BatchQueue : NonMovable {
+    struct Batch : NonMovable {
+        Batch* next = nullptr;
+        u64 tag = 0;
+        core::SmallVector<T, BatchSize> items;
+    };
+
+    struct Slot : NonMovable {
+        std::atomic<Batch*> batch = nullptr;
+        std::thread::id thread;
+    };
+
+    public:
+        static constexpr usize batch_size = BatchSize;
+
+        BatchQueue() = default;
+
+        ~BatchQueue() {
+            for(Batch* batch : _pending) {
+                delete batch;
+            }
+            delete_list(_published.exchange(nullptr));
+            for(const auto& slot : _slots) {
+                delete slot->batch.exchange(nullptr);
+            }
+        }
+
+        template<typename... Args>
+        void emplace(u64 tag, Args&&... args) {
+            Slot& slot = local_slot();
+
+            // Nobody else can touch the batch while the slot is empty
+            Batch* batch = slot.batch.exchange(nullptr, std::memory_order_acquire);
+            if(!batch) {
+                batch = new Batch();
+            }
+
+            batch->tag = std::max(batch->tag, tag);
+            batch->items.emplace_back(y_fwd(args)...);
+
+            if(batch->items.size() >= batch_size) {
+                publish(batch);
+            } else {
+                slot.batch.store(batch, std::memory_order_release);
+            }
+        }
+
+        // Only items handed to the consumer are counted
+        usize size() const {
+            return _size.load(std::memory_order_relaxed);
+        }
+
+        template<typename F>
+        usize consume(u64 up_to, F&& func) {
+            const auto lock = std::unique_lock(_consumer_lock);
+
+            steal_parked_batches();
+
+            for(Batch* batch = _published.exchange(nullptr, std::memory_order_acquire); batch;) {
+                Batch* next = batch->next;
+                _pending << batch;
+                batch = next;
+            }
+
+            // Oldest last
+            std::sort(_pending.begin(), _pending.end(), [](const Batch* a, const Batch* b) { return a->tag > b->tag; });
+
+            usize consumed = 0;
+            while(!_pending.is_empty() && _pending.last()->tag <= up_to) {
+                std::unique_ptr<Batch> batch(_pending.pop());
+                for(T& item : batch->items) {
+                    func(item);
+                }
+                consumed += batch->items.size();
+            }
+
+            _size.fetch_sub(consumed, std::memory_order_relaxed);
+            return consumed;
+        }
+
+    private:
+        static void delete_list(Batch* batch) {
+            while(batch) {
+                delete std::exchange(batch, batch->next);
+            }
+        }
+
+        void publish(Batch* batch) {
+            _size.fetch_add(batch->items.size(), std::memory_order_relaxed);
+
+            Batch* head = _published.load(std::memory_order_relaxed);
+            do {
+                batch->next = head;
+            } while(!_published.compare_exchange_weak(head, batch, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        void steal_parked_batches() {
+            const auto lock = std::unique_lock(_slots_lock);
+            for(const auto& slot : _slots) {
+                if(Batch* batch = slot->batch.exchange(nullptr, std::memory_order_acquire)) {
+                    publish(batch);
+                }
+            }
+        }
+
+        Slot& local_slot() {
+            detail::BatchQueueSlotCache& cache = detail::batch_queue_slot_cache;
+            if(cache.queue_id == _id) {
+                return *static_cast<Slot*>(cache.slot);
+            }
+
+            const auto lock = std::unique_lock(_slots_lock);
+
+            const std::thread::id thread = std::this_thread::get_id();
+            auto it = std::find_if(_slots.begin(), _slots.end(), [&](const auto& slot) { return slot->thread == thread; });
+            if(it == _slots.end()) {
+                _slots.emplace_back(std::make_unique<Slot>());
+                _slots.last()->thread = thread;
+                it = _slots.end() - 1;
+            }
+
+            cache.queue_id = _id;
+            cache.slot = it->get();
+            return **it;
+        }
+
+        std::atomic<Batch*> _published = nullptr;
+        std::atomic<usize> _size = 0;
+
+        // Only touched by the consumer
+        core::Vector<Batch*> _pending;
+        std::mutex _consumer_lock;
+
+        // Only locked the first time a thread uses the queue (or after using another queue) and by the consumer
+        core::Vector<std::unique_ptr<Slot>> _slots;
+        std::mutex _slots_lock;
+
+        const u64 _id = detail::next_batch_queue_id++;
+};
+
+}
+}
+
+#endif // Y_CONCURRENT_BATCHQUEUE_H
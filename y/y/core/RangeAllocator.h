@@ -0,0 +1,157 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef Y_CORE_RANGEALLOCATOR_H
+#define Y_CORE_RANGEALLOCATOR_H
+
+#include "Vector.h"
+#include "Span.h"
+
+#include <algorithm>
+
+namespace y {
+namespace core {
+
+// First fit allocator for ranges of an external resource (buffer, heap...)
+// Free ranges are kept sorted and merged, so freeing is O(free range count)
+class RangeAllocator {
+    public:
+        static constexpr u64 invalid_offset = u64(-1);
+
+        struct Range {
+            u64 offset = 0;
+            u64 size = 0;
+
+            u64 end() const {
+                return offset + size;
+            }
+        };
+
+        RangeAllocator() = default;
+
+        RangeAllocator(u64 size) : _size(size), _available(size) {
+            if(size) {
+                _free << Range{0, size};
+            }
+        }
+
+        // Returns invalid_offset if no free range is big enough
+        u64 alloc(u64 size) {
+            y_debug_assert(size);
+
+            for(usize i = 0; i != _free.size(); ++i) {
+                Range& range = _free[i];
+                if(range.size < size) {
+                    continue;
+                }
+
+                const u64 offset = range.offset;
+                range.offset += size;
+                range.size -= size;
+                if(!range.size) {
+                    _free.erase(_free.begin() + i);
+                }
+
+                _available -= size;
+                return offset;
+            }
+
+            return invalid_offset;
+        }
+
+        void free(u64 offset, u64 size) {
+            y_debug_assert(size);
+            y_debug_assert(offset + size <= _size);
+
+            const auto it = std::lower_bound(_free.begin(), _free.end(), offset, [](const Range& range, u64 off) {
+                return range.offset < off;
+            });
+
+            const usize index = it - _free.begin();
+
+            const bool merge_prev = index && _free[index - 1].end() == offset;
+            const bool merge_next = index != _free.size() && _free[index].offset == offset + size;
+
+            y_debug_assert(!index || _free[index - 1].end() <= offset);
+            y_debug_assert(index == _free.size() || _free[index].offset >= offset + size);
+
+            if(merge_prev && merge_next) {
+                _free[index - 1].size += size + _free[index].size;
+                _free.erase(_free.begin() + index);
+            } else if(merge_prev) {
+                _free[index - 1].size += size;
+            } else if(merge_next) {
+                _free[index].offset = offset;
+                _free[index].size += size;
+            } else {
+                _free.insert(_free.begin() + index, Range{offset, size});
+            }
+
+            _available += size;
+        }
+
+        u64 size() const {
+            return _size;
+        }
+
+        u64 available() const {
+            return _available;
+        }
+
+        u64 allocated() const {
+            return _size - _available;
+        }
+
+        u64 largest_free_range() const {
+            u64 largest = 0;
+            for(const Range& range : _free) {
+                largest = std::max(largest, range.size);
+            }
+            return largest;
+        }
+
+        usize free_range_count() const {
+            return _free.size();
+        }
+
+        Span<Range> free_ranges() const {
+            return _free;
+        }
+
+        // 0 when all the free space is in a single range, tends toward 1 as it gets split in small ranges
+        float fragmentation() const {
+            if(!_available) {
+                return 0.0f;
+            }
+            return 1.0f - float(double(largest_free_range()) / double(_available));
+        }
+
+    private:
+        Vector<Range> _free;
+
+        u64 _size = 0;
+        u64 _available = 0;
+};
+
+}
+}
+
+#endif // Y_CORE_RANGEALLOCATOR_H
@@ -24,6 +24,7 @@ SOFTWARE.
 
 #include <y/utils.h>
 #include "Vec.h"
+#include "simd.h"
 
 #include <algorithm>
 
@@ -38,9 +39,15 @@ namespace detail {
     template<typename T, usize N>
     inline constexpr T determinant(const Matrix<N, N, T>& mat);
 
+    template<typename T>
+    inline constexpr T determinant(const Matrix<4, 4, T>& mat);
+
     template<typename T>
     inline constexpr T determinant(const Matrix<2, 2, T>& mat);
 
+    template<typename T>
+    inline constexpr Matrix<4, 4, T> inverse(const Matrix<4, 4, T>& mat);
+
     template<typename T>
     inline constexpr T determinant(const Matrix<1, 1, T>& mat);
 }
@@ -143,6 +150,14 @@ class Matrix {
 
         inline constexpr Matrix<M, N, T> transposed() const {
             Matrix<M, N, T> tr;
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_mat<N, M, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::transpose_mat4(begin(), tr.begin());
+                    return tr;
+                }
+            }
+#endif
             for(usize i = 0; i != vec_count; ++i) {
                 for(usize j = 0; j != vec_size; ++j) {
                     tr._vecs[j][i] = _vecs[i][j];
@@ -186,7 +201,12 @@ class Matrix {
             return detail::determinant(*this);
         }
 
+        // Returns a zero matrix if the matrix is singular
         inline constexpr Matrix inverse() const {
+            if constexpr(N == 4 && M == 4) {
+                return detail::inverse(*this);
+            }
+
             T d = determinant();
             if(d == 0) {
                 return Matrix();
@@ -237,6 +257,14 @@ class Matrix {
 
         inline constexpr Column operator*(const Row& v) const {
             Column tr;
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_mat<N, M, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::mul_mat4_vec4(begin(), v.data(), tr.data());
+                    return tr;
+                }
+            }
+#endif
             for(usize i = 0; i != M; ++i) {
                 tr += column(i) * v[i];
             }
@@ -246,6 +274,14 @@ class Matrix {
         template<typename U, usize P>
         inline constexpr auto operator*(const Matrix<M, P, U>& m) const {
             Matrix<N, P, decltype(std::declval<T>() * std::declval<U>())> mat;
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_mat<N, M, T> && simd::is_simd_mat<M, P, U>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::mul_mat4(begin(), m.begin(), mat.begin());
+                    return mat;
+                }
+            }
+#endif
             for(usize i = 0; i != N; ++i) {
                 for(usize j = 0; j != P; ++j) {
                     decltype(std::declval<T>() * std::declval<U>()) tmp(0);
@@ -298,6 +334,81 @@ namespace detail {
         return d;
     }
 
+    // 2x2 minors of the two top rows (s) and of the two bottom rows (c), indexed by column pairs (01, 02, 03, 12, 13, 23)
+    template<typename T>
+    struct Minors4 {
+        T s[6];
+        T c[6];
+
+        inline constexpr Minors4(const Matrix<4, 4, T>& mat) {
+            usize k = 0;
+            for(usize i = 0; i != 4; ++i) {
+                for(usize j = i + 1; j != 4; ++j) {
+                    s[k] = mat[i][0] * mat[j][1] - mat[j][0] * mat[i][1];
+                    c[k] = mat[i][2] * mat[j][3] - mat[j][2] * mat[i][3];
+                    ++k;
+                }
+            }
+        }
+
+        inline constexpr T determinant() const {
+            return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+        }
+    };
+
+    template<typename T>
+    constexpr T determinant(const Matrix<4, 4, T>& mat) {
+        return Minors4<T>(mat).determinant();
+    }
+
+    template<typename T>
+    constexpr Matrix<4, 4, T> inverse(const Matrix<4, 4, T>& mat) {
+        Matrix<4, 4, T> inv;
+
+#ifdef Y_MATH_SIMD
+        if constexpr(simd::is_simd_mat<4, 4, T>) {
+            if(!std::is_constant_evaluated()) {
+                simd::inverse_mat4(mat.begin(), inv.begin());
+                return inv;
+            }
+        }
+#endif
+
+        // Laplace expansion along the two top rows, every cofactor reuses the shared 2x2 minors
+        const Minors4<T> minors(mat);
+        const T det = minors.determinant();
+        if(det == 0) {
+            return inv;
+        }
+
+        const T* s = minors.s;
+        const T* c = minors.c;
+        const auto a = [&](usize row, usize col) { return mat[col][row]; };
+
+        const T inv_det = T(1) / det;
+        inv[0][0] = ( a(1, 1) * c[5] - a(1, 2) * c[4] + a(1, 3) * c[3]) * inv_det;
+        inv[0][1] = (-a(1, 0) * c[5] + a(1, 2) * c[2] - a(1, 3) * c[1]) * inv_det;
+        inv[0][2] = ( a(1, 0) * c[4] - a(1, 1) * c[2] + a(1, 3) * c[0]) * inv_det;
+        inv[0][3] = (-a(1, 0) * c[3] + a(1, 1) * c[1] - a(1, 2) * c[0]) * inv_det;
+
+        inv[1][0] = (-a(0, 1) * c[5] + a(0, 2) * c[4] - a(0, 3) * c[3]) * inv_det;
+        inv[1][1] = ( a(0, 0) * c[5] - a(0, 2) * c[2] + a(0, 3) * c[1]) * inv_det;
+        inv[1][2] = (-a(0, 0) * c[4] + a(0, 1) * c[2] - a(0, 3) * c[0]) * inv_det;
+        inv[1][3] = ( a(0, 0) * c[3] - a(0, 1) * c[1] + a(0, 2) * c[0]) * inv_det;
+
+        inv[2][0] = ( a(3, 1) * s[5] - a(3, 2) * s[4] + a(3, 3) * s[3]) * inv_det;
+        inv[2][1] = (-a(3, 0) * s[5] + a(3, 2) * s[2] - a(3, 3) * s[1]) * inv_det;
+        inv[2][2] = ( a(3, 0) * s[4] - a(3, 1) * s[2] + a(3, 3) * s[0]) * inv_det;
+        inv[2][3] = (-a(3, 0) * s[3] + a(3, 1) * s[1] - a(3, 2) * s[0]) * inv_det;
+
+        inv[3][0] = (-a(2, 1) * s[5] + a(2, 2) * s[4] - a(2, 3) * s[3]) * inv_det;
+        inv[3][1] = ( a(2, 0) * s[5] - a(2, 2) * s[2] + a(2, 3) * s[1]) * inv_det;
+        inv[3][2] = (-a(2, 0) * s[4] + a(2, 1) * s[2] - a(2, 3) * s[0]) * inv_det;
+        inv[3][3] = ( a(2, 0) * s[3] - a(2, 1) * s[1] + a(2, 2) * s[0]) * inv_det;
+
+        return inv;
+    }
+
     template<typename T>
     constexpr T determinant(const Matrix<2, 2, T>& mat) {
         return mat[0][0] * mat[1][1] - mat[0][1] * mat[1][0];
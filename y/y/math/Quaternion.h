@@ -24,6 +24,7 @@ SOFTWARE.
 
 #include "math.h"
 #include "Vec.h"
+#include "simd.h"
 
 #include <limits>
 
@@ -105,6 +106,14 @@ class Quaternion {
         }
 
         inline constexpr Quaternion& operator*=(const Quaternion& q) {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<4, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::mul_quat(_quat.data(), q._quat.data(), _quat.data());
+                    return *this;
+                }
+            }
+#endif
             _quat = {w() * q.x() + x() * q.w() + y() * q.z() - z() * q.y(),
                      w() * q.y() + y() * q.w() + z() * q.x() - x() * q.z(),
                      w() * q.z() + z() * q.w() + x() * q.y() - y() * q.x(),
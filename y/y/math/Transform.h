@@ -29,6 +29,19 @@ SOFTWARE.
 namespace y {
 namespace math {
 
+namespace detail {
+// Inverse of an affine transform given the rows of the inverse of its 3x3 part
+template<typename T>
+inline constexpr Matrix4<T> affine_inverse(const Vec<3, T>& x, const Vec<3, T>& y, const Vec<3, T>& z, const Vec<3, T>& pos) {
+    return Matrix4<T>(
+        x, -x.dot(pos),
+        y, -y.dot(pos),
+        z, -z.dot(pos),
+        0, 0, 0, 1
+    );
+}
+}
+
 template<typename T = float>
 struct Transform : Matrix4<T> {
 
@@ -70,6 +83,31 @@ struct Transform : Matrix4<T> {
             this->column(2).template to<3>() * p.z();
     }
 
+    // Assumes the last row is (0, 0, 0, 1), returns a zero matrix if the transform is singular
+    inline constexpr Transform inverse() const {
+        const Vec<3, T>& x = this->column(0).template to<3>();
+        const Vec<3, T>& y = this->column(1).template to<3>();
+        const Vec<3, T>& z = this->column(2).template to<3>();
+
+        // Rows of the inverse of the 3x3 part are the cross products of its columns
+        const Vec<3, T> yz = y.cross(z);
+        const T det = x.dot(yz);
+        if(det == 0) {
+            return Matrix4<T>();
+        }
+
+        const T inv_det = T(1) / det;
+        return detail::affine_inverse(yz * inv_det, z.cross(x) * inv_det, x.cross(y) * inv_det, position());
+    }
+
+    // Faster inverse for transforms with orthogonal axes (rotation, translation and per axis scale, but no shear): the rotation is transposed
+    inline constexpr Transform rigid_inverse() const {
+        const Vec<3, T>& x = this->column(0).template to<3>();
+        const Vec<3, T>& y = this->column(1).template to<3>();
+        const Vec<3, T>& z = this->column(2).template to<3>();
+        return detail::affine_inverse(x / x.sq_length(), y / y.sq_length(), z / z.sq_length(), position());
+    }
+
     // Y forward
     inline constexpr const auto& forward() const {
         return this->column(2).template to<3>();
@@ -23,9 +23,11 @@ SOFTWARE.
 #define Y_MATH_VEC_H
 
 #include <y/utils.h>
+#include "simd.h"
 
 #include <concepts>
 #include <cmath>
+#include <type_traits>
 
 namespace y {
 namespace math {
@@ -118,6 +120,13 @@ class Vec
         }
 
         inline constexpr T dot(const Vec& o) const {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    return simd::dot4(_vec, o._vec);
+                }
+            }
+#endif
             T sum = 0;
             for(usize i = 0; i != N; ++i) {
                 sum += _vec[i] * o._vec[i];
@@ -147,6 +156,15 @@ class Vec
 
         inline constexpr Vec abs() const {
             static_assert(std::is_signed_v<T>, "Vec<T>::abs makes no sense for T unsigned");
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    Vec v;
+                    simd::store(v._vec, simd::abs(simd::load(_vec)));
+                    return v;
+                }
+            }
+#endif
             Vec v;
             for(usize i = 0; i != N; ++i) {
                 v[i] = _vec[i] < 0 ? -_vec[i] : _vec[i];
@@ -163,6 +181,16 @@ class Vec
         }
 
         inline constexpr Vec max(const Vec& v) const {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    // Same result as std::max for equal values and NaNs
+                    Vec m;
+                    simd::store(m._vec, _mm_max_ps(simd::load(v._vec), simd::load(_vec)));
+                    return m;
+                }
+            }
+#endif
             Vec m;
             for(usize i = 0; i != N; ++i) {
                 m[i] = std::max(_vec[i], v[i]);
@@ -171,6 +199,15 @@ class Vec
         }
 
         inline constexpr Vec min(const Vec& v) const {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    Vec m;
+                    simd::store(m._vec, _mm_min_ps(simd::load(v._vec), simd::load(_vec)));
+                    return m;
+                }
+            }
+#endif
             Vec m;
             for(usize i = 0; i != N; ++i) {
                 m[i] = std::min(_vec[i], v[i]);
@@ -324,6 +361,15 @@ class Vec
         }
 
         inline constexpr Vec operator-() const {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    Vec t;
+                    simd::store(t._vec, _mm_xor_ps(simd::load(_vec), _mm_set1_ps(-0.0f)));
+                    return t;
+                }
+            }
+#endif
             Vec t;
             for(usize i = 0; i != N; ++i) {
                 t[i] = -_vec[i];
@@ -332,6 +378,14 @@ class Vec
         }
 
         inline constexpr Vec& operator*=(const T& t) {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::store(_vec, _mm_mul_ps(simd::load(_vec), _mm_set1_ps(t)));
+                    return *this;
+                }
+            }
+#endif
             for(usize i = 0; i != N; ++i) {
                 _vec[i] *= t;
             }
@@ -339,6 +393,14 @@ class Vec
         }
 
         inline constexpr Vec& operator/=(const T& t) {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::store(_vec, _mm_div_ps(simd::load(_vec), _mm_set1_ps(t)));
+                    return *this;
+                }
+            }
+#endif
             for(usize i = 0; i != N; ++i) {
                 _vec[i] /= t;
             }
@@ -346,6 +408,14 @@ class Vec
         }
 
         inline constexpr Vec& operator+=(const T& t) {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::store(_vec, _mm_add_ps(simd::load(_vec), _mm_set1_ps(t)));
+                    return *this;
+                }
+            }
+#endif
             for(usize i = 0; i != N; ++i) {
                 _vec[i] += t;
             }
@@ -353,6 +423,14 @@ class Vec
         }
 
         inline constexpr Vec& operator-=(const T& t) {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::store(_vec, _mm_sub_ps(simd::load(_vec), _mm_set1_ps(t)));
+                    return *this;
+                }
+            }
+#endif
             for(usize i = 0; i != N; ++i) {
                 _vec[i] -= t;
             }
@@ -362,6 +440,14 @@ class Vec
 
 
         inline constexpr Vec& operator*=(const Vec& v) {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::store(_vec, _mm_mul_ps(simd::load(_vec), simd::load(v._vec)));
+                    return *this;
+                }
+            }
+#endif
             for(usize i = 0; i != N; ++i) {
                 _vec[i] *= v[i];
             }
@@ -369,6 +455,14 @@ class Vec
         }
 
         inline constexpr Vec& operator/=(const Vec& v) {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::store(_vec, _mm_div_ps(simd::load(_vec), simd::load(v._vec)));
+                    return *this;
+                }
+            }
+#endif
             for(usize i = 0; i != N; ++i) {
                 _vec[i] /= v[i];
             }
@@ -376,6 +470,14 @@ class Vec
         }
 
         inline constexpr Vec& operator+=(const Vec& v) {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::store(_vec, _mm_add_ps(simd::load(_vec), simd::load(v._vec)));
+                    return *this;
+                }
+            }
+#endif
             for(usize i = 0; i != N; ++i) {
                 _vec[i] += v[i];
             }
@@ -383,6 +485,14 @@ class Vec
         }
 
         inline constexpr Vec& operator-=(const Vec& v) {
+#ifdef Y_MATH_SIMD
+            if constexpr(simd::is_simd_vec<N, T>) {
+                if(!std::is_constant_evaluated()) {
+                    simd::store(_vec, _mm_sub_ps(simd::load(_vec), simd::load(v._vec)));
+                    return *this;
+                }
+            }
+#endif
             for(usize i = 0; i != N; ++i) {
                 _vec[i] -= v[i];
             }
@@ -24,6 +24,8 @@ SOFTWARE.
 
 #include "Vec.h"
 
+#include <algorithm>
+
 namespace y {
 namespace math {
 
@@ -97,6 +99,76 @@ class Sphere final : public Volume<T> {
         T _radius;
 };
 
+// Cone bounding a set of normals. Clusters of triangles can be culled as a whole when they all face away from the viewer.
+// The default cone contains every direction and never culls.
+template<typename T = float>
+class NormalCone {
+    public:
+        NormalCone() = default;
+
+        NormalCone(const Vec<3, T>& axis, T cutoff) : _axis(axis), _cutoff(cutoff) {
+        }
+
+        // Normals should be normalized (zero normals are ignored)
+        template<typename It>
+        static NormalCone from_normals(It begin, It end) {
+            Vec<3, T> axis;
+            for(It it = begin; it != end; ++it) {
+                axis += *it;
+            }
+
+            const T length = axis.length();
+            if(length <= T(0)) {
+                return NormalCone();
+            }
+            axis /= length;
+
+            T min_dot = T(1);
+            for(It it = begin; it != end; ++it) {
+                if(it->sq_length() > T(0)) {
+                    min_dot = std::min(min_dot, axis.dot(*it));
+                }
+            }
+
+            // Half angle of 90° or more: some normals face every direction
+            if(min_dot <= T(0)) {
+                return NormalCone();
+            }
+
+            NormalCone cone;
+            cone._axis = axis;
+            cone._cutoff = std::sqrt(T(1) - min_dot * min_dot); // sin of the half angle
+            return cone;
+        }
+
+        // Conservative test for a cluster contained in a sphere seen from view_pos: every triangle faces away from the viewer
+        bool is_backfacing(const Vec<3, T>& center, T radius, const Vec<3, T>& view_pos) const {
+            const Vec<3, T> dir = center - view_pos;
+            return dir.dot(_axis) >= _cutoff * dir.length() + radius;
+        }
+
+        // Same as above for an orthographic projection looking along view_dir (normalized)
+        bool is_backfacing(const Vec<3, T>& view_dir) const {
+            return view_dir.dot(_axis) >= _cutoff;
+        }
+
+        bool is_degenerate() const {
+            return _cutoff >= T(1);
+        }
+
+        const Vec<3, T>& axis() const {
+            return _axis;
+        }
+
+        T cutoff() const {
+            return _cutoff;
+        }
+
+    private:
+        Vec<3, T> _axis;
+        T _cutoff = T(1);
+};
+
 }
 }
 
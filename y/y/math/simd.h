@@ -0,0 +1,238 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef Y_MATH_SIMD_H
+#define Y_MATH_SIMD_H
+
+#include <y/utils.h>
+
+#include <type_traits>
+
+// Define Y_NO_MATH_SIMD to only use the scalar implementations
+#if defined(Y_SSE) && !defined(Y_NO_MATH_SIMD)
+#define Y_MATH_SIMD
+#include <emmintrin.h>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#endif
+
+namespace y {
+namespace math {
+namespace simd {
+
+// Vec<4, float>, Matrix<4, 4, float> and Quaternion<float> use these at runtime, constant evaluation always uses the scalar code.
+// Operations are done in the same order as the scalar code (no FMA) so that results only differ for horizontal sums (dot products).
+template<usize N, typename T>
+inline constexpr bool is_simd_vec =
+#ifdef Y_MATH_SIMD
+    N == 4 && std::is_same_v<T, float>;
+#else
+    false;
+#endif
+
+template<usize N, usize M, typename T>
+inline constexpr bool is_simd_mat = is_simd_vec<N, T> && N == M;
+
+
+#ifdef Y_MATH_SIMD
+y_force_inline __m128 load(const float* v) {
+    return _mm_loadu_ps(v);
+}
+
+y_force_inline void store(float* v, __m128 x) {
+    _mm_storeu_ps(v, x);
+}
+
+template<int X, int Y, int Z, int W>
+y_force_inline __m128 shuffle(__m128 v) {
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+template<int I>
+y_force_inline __m128 splat(__m128 v) {
+    return shuffle<I, I, I, I>(v);
+}
+
+// (x + y) + (z + w)
+y_force_inline float hsum(__m128 v) {
+    const __m128 shuf = shuffle<1, 0, 3, 2>(v);
+    const __m128 sums = _mm_add_ps(v, shuf);
+    return _mm_cvtss_f32(_mm_add_ss(sums, _mm_movehl_ps(shuf, sums)));
+}
+
+y_force_inline float dot4(const float* a, const float* b) {
+    return hsum(_mm_mul_ps(load(a), load(b)));
+}
+
+y_force_inline __m128 abs(__m128 v) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+// Column major: out = m * v
+y_force_inline void mul_mat4_vec4(const float* m, const float* v, float* out) {
+    const __m128 x = load(v);
+    __m128 r = _mm_mul_ps(load(m), splat<0>(x));
+    r = _mm_add_ps(r, _mm_mul_ps(load(m + 4), splat<1>(x)));
+    r = _mm_add_ps(r, _mm_mul_ps(load(m + 8), splat<2>(x)));
+    r = _mm_add_ps(r, _mm_mul_ps(load(m + 12), splat<3>(x)));
+    store(out, r);
+}
+
+// Column major: out = a * b, out can not alias a or b
+y_force_inline void mul_mat4(const float* a, const float* b, float* out) {
+#ifdef __AVX__
+    // Two columns of the result at a time
+    const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+    const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+    const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+    const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+    for(usize j = 0; j != 16; j += 8) {
+        const __m256 bb = _mm256_loadu_ps(b + j);
+        __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(bb, bb, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_shuffle_ps(bb, bb, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_shuffle_ps(bb, bb, _MM_SHUFFLE(2, 2, 2, 2))));
+        r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_shuffle_ps(bb, bb, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm256_storeu_ps(out + j, r);
+    }
+#else
+    const __m128 a0 = load(a);
+    const __m128 a1 = load(a + 4);
+    const __m128 a2 = load(a + 8);
+    const __m128 a3 = load(a + 12);
+    for(usize j = 0; j != 16; j += 4) {
+        const __m128 bj = load(b + j);
+        __m128 r = _mm_mul_ps(a0, splat<0>(bj));
+        r = _mm_add_ps(r, _mm_mul_ps(a1, splat<1>(bj)));
+        r = _mm_add_ps(r, _mm_mul_ps(a2, splat<2>(bj)));
+        r = _mm_add_ps(r, _mm_mul_ps(a3, splat<3>(bj)));
+        store(out + j, r);
+    }
+#endif
+}
+
+y_force_inline void transpose_mat4(const float* m, float* out) {
+    __m128 c0 = load(m);
+    __m128 c1 = load(m + 4);
+    __m128 c2 = load(m + 8);
+    __m128 c3 = load(m + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    store(out, c0);
+    store(out + 4, c1);
+    store(out + 8, c2);
+    store(out + 12, c3);
+}
+
+template<int X, int Y, int Z, int W>
+y_force_inline __m128 shuffle(__m128 a, __m128 b) {
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+// 2x2 matrices stored in a __m128 as (m00, m01, m10, m11), A * B
+y_force_inline __m128 mul_mat2(__m128 a, __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, shuffle<0, 3, 0, 3>(b)), _mm_mul_ps(shuffle<1, 0, 3, 2>(a), shuffle<2, 1, 2, 1>(b)));
+}
+
+// adj(A) * B
+y_force_inline __m128 adj_mul_mat2(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(shuffle<3, 3, 0, 0>(a), b), _mm_mul_ps(shuffle<1, 1, 2, 2>(a), shuffle<2, 3, 0, 1>(b)));
+}
+
+// A * adj(B)
+y_force_inline __m128 mul_adj_mat2(__m128 a, __m128 b) {
+    return _mm_sub_ps(_mm_mul_ps(a, shuffle<3, 0, 3, 0>(b)), _mm_mul_ps(shuffle<1, 0, 3, 2>(a), shuffle<2, 1, 2, 1>(b)));
+}
+
+// Blockwise inversion using 2x2 sub-matrices, see https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+// Works on rows, which gives transpose(inverse(transpose(M))) = inverse(M) for column major matrices.
+// Returns false and leaves out untouched if the matrix is singular
+y_force_inline bool inverse_mat4(const float* m, float* out) {
+    const __m128 r0 = load(m);
+    const __m128 r1 = load(m + 4);
+    const __m128 r2 = load(m + 8);
+    const __m128 r3 = load(m + 12);
+
+    const __m128 a = _mm_movelh_ps(r0, r1);
+    const __m128 b = _mm_movehl_ps(r1, r0);
+    const __m128 c = _mm_movelh_ps(r2, r3);
+    const __m128 d = _mm_movehl_ps(r3, r2);
+
+    // (|A|, |B|, |C|, |D|)
+    const __m128 det_sub = _mm_sub_ps(
+        _mm_mul_ps(shuffle<0, 2, 0, 2>(r0, r2), shuffle<1, 3, 1, 3>(r1, r3)),
+        _mm_mul_ps(shuffle<1, 3, 1, 3>(r0, r2), shuffle<0, 2, 0, 2>(r1, r3))
+    );
+    const __m128 det_a = splat<0>(det_sub);
+    const __m128 det_b = splat<1>(det_sub);
+    const __m128 det_c = splat<2>(det_sub);
+    const __m128 det_d = splat<3>(det_sub);
+
+    const __m128 d_c = adj_mul_mat2(d, c);
+    const __m128 a_b = adj_mul_mat2(a, b);
+
+    const __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mul_mat2(b, d_c));
+    const __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mul_mat2(c, a_b));
+    const __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mul_adj_mat2(d, a_b));
+    const __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mul_adj_mat2(a, d_c));
+
+    // |M| = |A| |D| + |B| |C| - tr(adj(A) B adj(D) C)
+    __m128 tr = _mm_mul_ps(a_b, shuffle<0, 2, 1, 3>(d_c));
+    tr = _mm_add_ps(tr, shuffle<1, 0, 3, 2>(tr));
+    tr = _mm_add_ps(tr, shuffle<2, 3, 0, 1>(tr));
+    const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), tr);
+
+    if(_mm_cvtss_f32(det) == 0.0f) {
+        return false;
+    }
+
+    const __m128 inv_det = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+    const __m128 ix = _mm_mul_ps(x, inv_det);
+    const __m128 iy = _mm_mul_ps(y, inv_det);
+    const __m128 iz = _mm_mul_ps(z, inv_det);
+    const __m128 iw = _mm_mul_ps(w, inv_det);
+
+    store(out, shuffle<3, 1, 3, 1>(ix, iy));
+    store(out + 4, shuffle<2, 0, 2, 0>(ix, iy));
+    store(out + 8, shuffle<3, 1, 3, 1>(iz, iw));
+    store(out + 12, shuffle<2, 0, 2, 0>(iz, iw));
+    return true;
+}
+
+// Quaternions are stored as (x, y, z, w), out = a * b
+y_force_inline void mul_quat(const float* a, const float* b, float* out) {
+    const __m128 qa = load(a);
+    const __m128 qb = load(b);
+    const __m128 neg_w = _mm_set_ps(-0.0f, 0.0f, 0.0f, 0.0f);
+
+    __m128 r = _mm_mul_ps(splat<3>(qa), qb);
+    r = _mm_add_ps(r, _mm_xor_ps(_mm_mul_ps(shuffle<0, 1, 2, 0>(qa), shuffle<3, 3, 3, 0>(qb)), neg_w));
+    r = _mm_add_ps(r, _mm_xor_ps(_mm_mul_ps(shuffle<1, 2, 0, 1>(qa), shuffle<2, 0, 1, 1>(qb)), neg_w));
+    r = _mm_sub_ps(r, _mm_mul_ps(shuffle<2, 0, 1, 2>(qa), shuffle<1, 2, 0, 2>(qb)));
+    store(out, r);
+}
+
+#endif
+
+}
+}
+}
+
+#endif // Y_MATH_SIMD_H
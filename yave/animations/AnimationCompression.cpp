@@ -0,0 +1,242 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "AnimationCompression.h"
+
+#include <y/math/simd.h>
+
+namespace yave {
+
+// Smallest three components are in [-1/sqrt(2), 1/sqrt(2)]
+static constexpr float packed_range = 0.70710678f;
+static constexpr u32 packed_max = (1 << 15) - 1;
+
+static u16 pack_component(float x) {
+    const float normalized = std::clamp((x / packed_range) * 0.5f + 0.5f, 0.0f, 1.0f);
+    return u16(std::round(normalized * packed_max));
+}
+
+static float unpack_component(u16 x) {
+    return ((float(x & packed_max) / packed_max) * 2.0f - 1.0f) * packed_range;
+}
+
+PackedRotation PackedRotation::pack(const math::Quaternion<>& rot) {
+    math::Vec4 q = rot.as_vec();
+
+    usize largest = 0;
+    for(usize i = 1; i != 4; ++i) {
+        if(std::abs(q[i]) > std::abs(q[largest])) {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation, make sure the dropped component is positive
+    if(q[largest] < 0.0f) {
+        q = -q;
+    }
+
+    PackedRotation packed;
+    for(usize i = 0, k = 0; i != 4; ++i) {
+        if(i != largest) {
+            packed.bits[k++] = pack_component(q[i]);
+        }
+    }
+
+    // Index of the dropped component goes in the high bits of the first two values
+    packed.bits[0] |= u16((largest >> 1) << 15);
+    packed.bits[1] |= u16((largest & 1) << 15);
+
+    return packed;
+}
+
+math::Quaternion<> PackedRotation::unpack() const {
+    const usize largest = ((bits[0] >> 15) << 1) | (bits[1] >> 15);
+
+#ifdef Y_MATH_SIMD
+    {
+        // Stored components are expanded as (a, b, c, 0), the dropped one is then computed and moved to its index
+        const __m128i ints = _mm_and_si128(_mm_setr_epi32(bits[0], bits[1], bits[2], 0), _mm_setr_epi32(packed_max, packed_max, packed_max, 0));
+        const __m128 normalized = _mm_mul_ps(_mm_cvtepi32_ps(ints), _mm_set1_ps(1.0f / packed_max));
+        const __m128 abc = _mm_and_ps(
+            _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(normalized, _mm_set1_ps(2.0f)), _mm_set1_ps(1.0f)), _mm_set1_ps(packed_range)),
+            _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0))
+        );
+
+        const float sq_sum = math::simd::hsum(_mm_mul_ps(abc, abc));
+        const __m128 dropped = _mm_set1_ps(std::sqrt(std::max(0.0f, 1.0f - sq_sum)));
+
+        // (a, b, c, dropped)
+        const __m128 abcd = math::simd::shuffle<0, 1, 0, 1>(abc, _mm_unpackhi_ps(abc, dropped));
+
+        __m128 q;
+        switch(largest) {
+            case 0:  q = math::simd::shuffle<3, 0, 1, 2>(abcd); break;
+            case 1:  q = math::simd::shuffle<0, 3, 1, 2>(abcd); break;
+            case 2:  q = math::simd::shuffle<0, 1, 3, 2>(abcd); break;
+            default: q = abcd; break;
+        }
+
+        math::Vec4 v;
+        math::simd::store(v.data(), q);
+        return math::Quaternion<>(v);
+    }
+#endif
+
+    math::Vec4 q;
+    float sq_sum = 0.0f;
+    for(usize i = 0, k = 0; i != 4; ++i) {
+        if(i != largest) {
+            q[i] = unpack_component(bits[k++]);
+            sq_sum += q[i] * q[i];
+        }
+    }
+    q[largest] = std::sqrt(std::max(0.0f, 1.0f - sq_sum));
+
+    return math::Quaternion<>(q);
+}
+
+
+
+// Angle between the two rotations, computed from the chord length as acos is too imprecise for small angles
+static float rotation_error(const math::Quaternion<>& a, const math::Quaternion<>& b) {
+    const math::Vec4 va = a.as_vec();
+    const math::Vec4 vb = va.dot(b.as_vec()) < 0.0f ? -b.as_vec() : b.as_vec();
+    return 4.0f * std::asin(std::min(1.0f, (va - vb).length() * 0.5f));
+}
+
+static BoneTransform interpolate(const BoneTransform& a, const BoneTransform& b, float factor) {
+    BoneTransform tr;
+    tr.position = a.position + (b.position - a.position) * factor;
+    tr.rotation = a.rotation.slerp(b.rotation, factor);
+    tr.scale = a.scale + (b.scale - a.scale) * factor;
+    return tr;
+}
+
+static math::Vec3 compute_error(const BoneTransform& a, const BoneTransform& b) {
+    return math::Vec3(
+        (a.position - b.position).length(),
+        rotation_error(a.rotation, b.rotation),
+        (a.scale - b.scale).length()
+    );
+}
+
+static bool is_within_bounds(const math::Vec3& error, const AnimationCompressionSettings& settings) {
+    return error.x() <= settings.max_position_error &&
+           error.y() <= settings.max_rotation_error &&
+           error.z() <= settings.max_scale_error;
+}
+
+static BoneTransform sample_keys(core::Span<AnimationChannel::BoneKey> keys, float time) {
+    const auto it = std::upper_bound(keys.begin(), keys.end(), time, [](float t, const auto& key) { return t < key.time; });
+    if(it == keys.begin()) {
+        return keys[0].local_transform;
+    }
+    if(it == keys.end()) {
+        return keys[keys.size() - 1].local_transform;
+    }
+    const auto& prev = *(it - 1);
+    return interpolate(prev.local_transform, it->local_transform, (time - prev.time) / (it->time - prev.time));
+}
+
+static core::Vector<AnimationChannel::BoneKey> reduce_keys(core::Span<AnimationChannel::BoneKey> keys, const AnimationCompressionSettings& settings) {
+    y_debug_assert(!keys.is_empty());
+
+    core::Vector<AnimationChannel::BoneKey> reduced;
+    reduced << keys[0];
+
+    const bool is_constant = std::all_of(keys.begin(), keys.end(), [&](const auto& key) {
+        return is_within_bounds(compute_error(keys[0].local_transform, key.local_transform), settings);
+    });
+
+    if(is_constant) {
+        return reduced;
+    }
+
+    // Greedily extend the segment starting at the last kept key for as long as every skipped key stays within bounds
+    usize anchor = 0;
+    for(usize end = 2; end < keys.size(); ++end) {
+        const auto& a = keys[anchor];
+        const auto& b = keys[end];
+
+        bool fits = true;
+        for(usize k = anchor + 1; k != end && fits; ++k) {
+            const float factor = (keys[k].time - a.time) / (b.time - a.time);
+            fits = is_within_bounds(compute_error(interpolate(a.local_transform, b.local_transform, factor), keys[k].local_transform), settings);
+        }
+
+        if(!fits) {
+            anchor = end - 1;
+            reduced << keys[anchor];
+        }
+    }
+
+    if(keys.size() > 1) {
+        reduced << keys[keys.size() - 1];
+    }
+
+    return reduced;
+}
+
+float CompressedAnimation::compression_ratio() const {
+    return compressed_byte_size ? float(original_byte_size) / float(compressed_byte_size) : 1.0f;
+}
+
+CompressedAnimation compress_animation(const Animation& anim, const AnimationCompressionSettings& settings) {
+    y_profile();
+
+    const usize key_size = sizeof(AnimationChannel::BoneKey);
+
+    CompressedAnimation compressed;
+
+    core::Vector<AnimationChannel> channels;
+    for(const AnimationChannel& channel : anim.channels()) {
+        core::Vector<AnimationChannel::BoneKey> keys(channel.keys());
+        for(auto& key : keys) {
+            key.local_transform.rotation = PackedRotation::pack(key.local_transform.rotation).unpack();
+        }
+
+        core::Vector<AnimationChannel::BoneKey> reduced = reduce_keys(keys, settings);
+
+        for(const AnimationChannel::BoneKey& key : channel.keys()) {
+            const math::Vec3 error = compute_error(sample_keys(reduced, key.time), key.local_transform);
+            compressed.max_position_error = std::max(compressed.max_position_error, error.x());
+            compressed.max_rotation_error = std::max(compressed.max_rotation_error, error.y());
+            compressed.max_scale_error = std::max(compressed.max_scale_error, error.z());
+        }
+
+        compressed.original_key_count += keys.size();
+        compressed.key_count += reduced.size();
+        compressed.original_byte_size += keys.size() * key_size;
+        compressed.compressed_byte_size += reduced.size() * key_size;
+
+        if(reduced.size() == 1) {
+            ++compressed.constant_channels;
+        }
+
+        channels.emplace_back(channel.name(), std::move(reduced));
+    }
+
+    compressed.animation = Animation(anim.duration(), std::move(channels));
+    return compressed;
+}
+
+}
@@ -0,0 +1,72 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_ANIMATIONS_ANIMATIONCOMPRESSION_H
+#define YAVE_ANIMATIONS_ANIMATIONCOMPRESSION_H
+
+#include "Animation.h"
+
+namespace yave {
+
+// Unit quaternion stored in 48 bits using the "smallest three" method:
+// the largest component is dropped (and recomputed from the others), the other three are stored on 15 bits each.
+struct PackedRotation {
+    std::array<u16, 3> bits = {};
+
+    static PackedRotation pack(const math::Quaternion<>& rot);
+    math::Quaternion<> unpack() const;
+};
+
+static_assert(sizeof(PackedRotation) == 6);
+
+
+struct AnimationCompressionSettings {
+    float max_position_error = 0.0005f;
+    float max_rotation_error = 0.0005f; // In radians
+    float max_scale_error = 0.0005f;
+};
+
+struct CompressedAnimation {
+    Animation animation;
+
+    usize original_key_count = 0;
+    usize key_count = 0;
+    usize constant_channels = 0;
+
+    // Keys as stored by Animation: rotations are only packed once bound, so this does not account for quantization
+    usize original_byte_size = 0;
+    usize compressed_byte_size = 0;
+
+    // Measured at every original key, including quantization
+    float max_position_error = 0.0f;
+    float max_rotation_error = 0.0f;
+    float max_scale_error = 0.0f;
+
+    float compression_ratio() const;
+};
+
+// Removes keys that can be interpolated from their neighbours within the error bounds, collapses constant channels to a single key
+// and quantizes rotations so that they are not altered further when bound.
+CompressedAnimation compress_animation(const Animation& anim, const AnimationCompressionSettings& settings = {});
+
+}
+
+#endif // YAVE_ANIMATIONS_ANIMATIONCOMPRESSION_H
@@ -0,0 +1,80 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "BonePalette.h"
+
+#include <yave/graphics/graphics.h>
+#include <yave/graphics/device/LifetimeManager.h>
+
+namespace yave {
+
+BonePalette::~BonePalette() {
+    // Frames might still be in flight: buffers go through destroy_graphic_resource, which defers their destruction
+    // until every cmd buffer created so far has been collected, so retired ones can be dropped right away.
+    _retired.make_empty();
+}
+
+void BonePalette::next_frame(usize bone_count) {
+    y_profile();
+
+    if(!_current.buffer.is_null()) {
+        // Anything that used the buffer has been recorded before now
+        _current.fence = lifetime_manager().next_fence();
+        _retired.push_back(std::move(_current));
+    }
+
+    while(!_retired.is_empty() && lifetime_manager().is_collected(_retired.first().fence)) {
+        _free.push_back(_retired.pop_front());
+    }
+
+    // Drop buffers that are too small, they will be replaced by bigger ones
+    for(usize i = 0; i != _free.size();) {
+        if(_free[i].buffer.size() < bone_count) {
+            _free.erase_unordered(_free.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+
+    if(_free.is_empty()) {
+        _current.buffer = PaletteBuffer(std::max(min_capacity, next_pow_of_2(bone_count)));
+    } else {
+        _current = _free.pop();
+    }
+
+    _bone_count = bone_count;
+}
+
+BonePalette::PaletteSubBuffer BonePalette::buffer() const {
+    y_debug_assert(!_current.buffer.is_null());
+    return PaletteSubBuffer(_current.buffer, std::max(usize(1), _bone_count), 0);
+}
+
+usize BonePalette::bone_count() const {
+    return _bone_count;
+}
+
+usize BonePalette::buffer_count() const {
+    return _retired.size() + _free.size() + (_current.buffer.is_null() ? 0 : 1);
+}
+
+}
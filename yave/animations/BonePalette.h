@@ -0,0 +1,70 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_ANIMATIONS_BONEPALETTE_H
+#define YAVE_ANIMATIONS_BONEPALETTE_H
+
+#include <yave/graphics/buffers/Buffer.h>
+#include <yave/graphics/buffers/buffers.h>
+#include <yave/graphics/commands/CmdBufferData.h>
+
+#include <y/core/RingQueue.h>
+#include <y/math/Transform.h>
+
+namespace yave {
+
+// Bone transforms of every animated instance for a frame, packed in a single buffer.
+// A new buffer is used every frame, old ones are recycled once the GPU is done with them.
+class BonePalette : NonMovable {
+    public:
+        static constexpr usize min_capacity = 1024;
+
+        using PaletteBuffer = TypedBuffer<math::Transform<>, BufferUsage::StorageBit, MemoryType::CpuVisible>;
+        using PaletteSubBuffer = TypedSubBuffer<math::Transform<>, BufferUsage::StorageBit, MemoryType::CpuVisible>;
+
+        BonePalette() = default;
+        ~BonePalette();
+
+        // Retires the current buffer and gets one that can hold bone_count transforms
+        void next_frame(usize bone_count);
+
+        // Only contains the bones of the current frame
+        PaletteSubBuffer buffer() const;
+
+        usize bone_count() const;
+        usize buffer_count() const;
+
+    private:
+        struct Frame {
+            PaletteBuffer buffer;
+            ResourceFence fence;
+        };
+
+        core::RingQueue<Frame> _retired;
+        core::Vector<Frame> _free;
+        Frame _current;
+
+        usize _bone_count = 0;
+};
+
+}
+
+#endif // YAVE_ANIMATIONS_BONEPALETTE_H
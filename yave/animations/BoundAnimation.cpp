@@ -0,0 +1,170 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "BoundAnimation.h"
+
+#include <y/core/HashMap.h>
+
+namespace yave {
+
+// Returns the index of the last key at or before time, times is assumed to be sorted
+static u32 find_key(core::Span<float> times, float time, u32 cursor) {
+    y_debug_assert(!times.is_empty());
+
+    if(cursor < times.size() && times[cursor] <= time) {
+        // Common case: playing forward, we usually don't go further than the next key
+        while(cursor + 1 < times.size() && times[cursor + 1] <= time) {
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    const auto it = std::upper_bound(times.begin(), times.end(), time);
+    return it == times.begin() ? 0 : u32(std::distance(times.begin(), it) - 1);
+}
+
+BoundAnimation::BoundAnimation(const Animation& anim, const Skeleton& skeleton) : _duration(anim.duration()) {
+    y_profile();
+
+    const core::Span<Bone> bones = skeleton.bones();
+
+    core::FlatHashMap<core::String, u32> bone_indices;
+    for(usize i = 0; i != bones.size(); ++i) {
+        bone_indices.emplace(bones[i].name, u32(i));
+    }
+
+    for(const AnimationChannel& channel : anim.channels()) {
+        const auto it = bone_indices.find(channel.name());
+        if(it == bone_indices.end()) {
+            continue;
+        }
+
+        const core::Span<AnimationChannel::BoneKey> keys = channel.keys();
+
+        if(keys.size() == 1) {
+            _constant_tracks << ConstantTrack{it->second, keys[0].local_transform};
+            continue;
+        }
+
+        Track& track = _tracks.emplace_back();
+        track.bone = it->second;
+        track.first_key = u32(_times.size());
+        track.key_count = u32(keys.size());
+
+        for(const AnimationChannel::BoneKey& key : keys) {
+            _times << key.time;
+            _positions << key.local_transform.position;
+            _rotations << PackedRotation::pack(key.local_transform.rotation);
+            _scales << key.local_transform.scale;
+        }
+    }
+
+    // Tracks are sampled in bone order
+    std::sort(_tracks.begin(), _tracks.end(), [](const Track& a, const Track& b) { return a.bone < b.bone; });
+    std::sort(_constant_tracks.begin(), _constant_tracks.end(), [](const ConstantTrack& a, const ConstantTrack& b) { return a.bone < b.bone; });
+}
+
+bool BoundAnimation::is_empty() const {
+    return _tracks.is_empty() && _constant_tracks.is_empty();
+}
+
+float BoundAnimation::duration() const {
+    return _duration;
+}
+
+usize BoundAnimation::track_count() const {
+    return _tracks.size();
+}
+
+BoneTransform BoundAnimation::sample_track(usize index, float time, core::MutableSpan<u32> cursors) const {
+    const Track& track = _tracks[index];
+    const core::Span<float> times(_times.data() + track.first_key, track.key_count);
+
+    const u32 key = find_key(times, time, cursors[index]);
+    cursors[index] = key;
+
+    const usize a = track.first_key + key;
+    if(key + 1 == track.key_count || time <= times[key]) {
+        return BoneTransform{_positions[a], _scales[a], _rotations[a].unpack()};
+    }
+
+    const usize b = a + 1;
+    const float factor = (time - times[key]) / (times[key + 1] - times[key]);
+    const float q = 1.0f - factor;
+    return BoneTransform{
+        _positions[a] * q + _positions[b] * factor,
+        _scales[a] * q + _scales[b] * factor,
+        _rotations[a].unpack().slerp(_rotations[b].unpack(), factor)
+    };
+}
+
+void BoundAnimation::sample(float time, core::MutableSpan<u32> cursors, core::MutableSpan<math::Transform<>> local_transforms) const {
+    y_debug_assert(cursors.size() == _tracks.size());
+
+    for(const ConstantTrack& track : _constant_tracks) {
+        y_debug_assert(track.bone < local_transforms.size());
+        local_transforms[track.bone] = track.transform.to_transform();
+    }
+
+    for(usize i = 0; i != _tracks.size(); ++i) {
+        y_debug_assert(_tracks[i].bone < local_transforms.size());
+        local_transforms[_tracks[i].bone] = sample_track(i, time, cursors).to_transform();
+    }
+}
+
+void BoundAnimation::sample(float time, core::MutableSpan<u32> cursors, Pose& pose) const {
+    y_debug_assert(cursors.size() == _tracks.size());
+
+    for(const ConstantTrack& track : _constant_tracks) {
+        pose.set_bone(track.bone, track.transform);
+    }
+
+    for(usize i = 0; i != _tracks.size(); ++i) {
+        pose.set_bone(_tracks[i].bone, sample_track(i, time, cursors));
+    }
+}
+
+void BoundAnimation::evaluate(const Skeleton& skeleton, float time, core::MutableSpan<u32> cursors, core::MutableSpan<math::Transform<>> skinning_transforms) const {
+    const core::Span<Bone> bones = skeleton.bones();
+    const core::Span<math::Transform<>> bind_pose = skeleton.bone_transforms();
+    const core::Span<math::Transform<>> inverses = skeleton.inverse_absolute_transforms();
+
+    y_debug_assert(skinning_transforms.size() >= bones.size());
+
+    // Bones without animation track keep their bind pose
+    std::copy(bind_pose.begin(), bind_pose.end(), skinning_transforms.begin());
+    sample(time, cursors, skinning_transforms);
+
+    // Parents always come before their children
+    for(usize i = 0; i != bones.size(); ++i) {
+        const Bone& bone = bones[i];
+        if(bone.has_parent()) {
+            skinning_transforms[i] = skinning_transforms[bone.parent] * skinning_transforms[i];
+        }
+    }
+
+    for(usize i = 0; i != bones.size(); ++i) {
+        skinning_transforms[i] *= inverses[i];
+    }
+}
+
+}
@@ -0,0 +1,86 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_ANIMATIONS_BOUNDANIMATION_H
+#define YAVE_ANIMATIONS_BOUNDANIMATION_H
+
+#include "AnimationCompression.h"
+#include "Pose.h"
+
+#include <yave/meshes/Skeleton.h>
+
+namespace yave {
+
+// Animation with its channels remapped to the bones of a skeleton, so sampling does not need any name lookup.
+// Constant channels are split from animated ones. Keys are stored as separate arrays (times, positions, packed rotations and scales)
+// so that searching times only touches a few cache lines.
+class BoundAnimation {
+    public:
+        BoundAnimation() = default;
+        BoundAnimation(const Animation& anim, const Skeleton& skeleton);
+
+        bool is_empty() const;
+
+        float duration() const;
+
+        // Number of animated (non constant) tracks
+        usize track_count() const;
+
+        // Writes the local transforms of all animated bones, others are left untouched.
+        // cursors should contain track_count() elements (zero initialized) and be kept between calls:
+        // when time moves forward cursors only need to advance by a key or two.
+        void sample(float time, core::MutableSpan<u32> cursors, core::MutableSpan<math::Transform<>> local_transforms) const;
+
+        // Same as above, for poses used by PoseGraph
+        void sample(float time, core::MutableSpan<u32> cursors, Pose& pose) const;
+
+        // Samples the animation and computes the skinning transforms (model space times inverse bind pose) of every bone.
+        // skeleton should be the one the animation was bound to.
+        void evaluate(const Skeleton& skeleton, float time, core::MutableSpan<u32> cursors, core::MutableSpan<math::Transform<>> skinning_transforms) const;
+
+    private:
+        struct Track {
+            u32 bone = 0;
+            u32 first_key = 0;
+            u32 key_count = 0;
+        };
+
+        struct ConstantTrack {
+            u32 bone = 0;
+            BoneTransform transform;
+        };
+
+        BoneTransform sample_track(usize index, float time, core::MutableSpan<u32> cursors) const;
+
+        float _duration = 0.0f;
+
+        core::Vector<Track> _tracks;
+        core::Vector<ConstantTrack> _constant_tracks;
+
+        core::Vector<float> _times;
+        core::Vector<math::Vec3> _positions;
+        core::Vector<PackedRotation> _rotations;
+        core::Vector<math::Vec3> _scales;
+};
+
+}
+
+#endif // YAVE_ANIMATIONS_BOUNDANIMATION_H
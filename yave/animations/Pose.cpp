@@ -0,0 +1,261 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "Pose.h"
+
+#include <y/core/ScratchPad.h>
+#include <y/utils/memory.h>
+
+namespace yave {
+
+// Per bone blend weights, padded so loops can run on whole simd_width blocks
+static core::ScratchPad<float> bone_weights(usize stride, usize bone_count, float weight, core::Span<float> bone_mask) {
+    y_debug_assert(bone_mask.is_empty() || bone_mask.size() == bone_count);
+
+    core::ScratchPad<float> weights(stride);
+    for(usize i = 0; i != stride; ++i) {
+        weights[i] = (i < bone_mask.size()) ? bone_mask[i] * weight : weight;
+    }
+    return weights;
+}
+
+Pose::Pose(usize bone_count) : _bone_count(bone_count), _stride(align_up_to(std::max(bone_count, usize(1)), simd_width)) {
+    _data = core::Vector<float>(_stride * ComponentCount, 0.0f);
+    std::fill_n(data(RotationW), _stride, 1.0f);
+    std::fill_n(data(ScaleX), _stride * 3, 1.0f);
+}
+
+Pose Pose::bind_pose(const Skeleton& skeleton) {
+    const core::Span<Bone> bones = skeleton.bones();
+
+    Pose pose(bones.size());
+    for(usize i = 0; i != bones.size(); ++i) {
+        pose.set_bone(i, bones[i].local_transform);
+    }
+    return pose;
+}
+
+usize Pose::bone_count() const {
+    return _bone_count;
+}
+
+float* Pose::data(Component c) {
+    y_debug_assert(c < ComponentCount);
+    return _data.data() + c * _stride;
+}
+
+const float* Pose::data(Component c) const {
+    y_debug_assert(c < ComponentCount);
+    return _data.data() + c * _stride;
+}
+
+core::MutableSpan<float> Pose::component(Component c) {
+    return core::MutableSpan<float>(data(c), _bone_count);
+}
+
+core::Span<float> Pose::component(Component c) const {
+    return core::Span<float>(data(c), _bone_count);
+}
+
+BoneTransform Pose::bone(usize index) const {
+    y_debug_assert(index < _bone_count);
+
+    BoneTransform tr;
+    tr.position = math::Vec3(data(PositionX)[index], data(PositionY)[index], data(PositionZ)[index]);
+    tr.rotation = math::Quaternion<>(data(RotationX)[index], data(RotationY)[index], data(RotationZ)[index], data(RotationW)[index]);
+    tr.scale = math::Vec3(data(ScaleX)[index], data(ScaleY)[index], data(ScaleZ)[index]);
+    return tr;
+}
+
+void Pose::set_bone(usize index, const BoneTransform& tr) {
+    y_debug_assert(index < _bone_count);
+
+    for(usize i = 0; i != 3; ++i) {
+        data(Component(PositionX + i))[index] = tr.position[i];
+        data(Component(ScaleX + i))[index] = tr.scale[i];
+    }
+
+    data(RotationX)[index] = tr.rotation.x();
+    data(RotationY)[index] = tr.rotation.y();
+    data(RotationZ)[index] = tr.rotation.z();
+    data(RotationW)[index] = tr.rotation.w();
+}
+
+void Pose::blend(const Pose& a, const Pose& b, float weight, core::Span<float> bone_mask, Pose& out) {
+    y_debug_assert(a._stride == b._stride && a._stride == out._stride);
+
+    const usize stride = out._stride;
+    const core::ScratchPad<float> weights = bone_weights(stride, out._bone_count, weight, bone_mask);
+    const float* w = weights.data();
+
+    for(const Component c : {PositionX, PositionY, PositionZ, ScaleX, ScaleY, ScaleZ}) {
+        const float* src_a = a.data(c);
+        const float* src_b = b.data(c);
+        float* dst = out.data(c);
+        for(usize i = 0; i != stride; ++i) {
+            dst[i] = src_a[i] + (src_b[i] - src_a[i]) * w[i];
+        }
+    }
+
+    {
+        const float* ax = a.data(RotationX);
+        const float* ay = a.data(RotationY);
+        const float* az = a.data(RotationZ);
+        const float* aw = a.data(RotationW);
+        const float* bx = b.data(RotationX);
+        const float* by = b.data(RotationY);
+        const float* bz = b.data(RotationZ);
+        const float* bw = b.data(RotationW);
+
+        float* x = out.data(RotationX);
+        float* y = out.data(RotationY);
+        float* z = out.data(RotationZ);
+        float* qw = out.data(RotationW);
+
+        for(usize i = 0; i != stride; ++i) {
+            // Take the shortest path
+            const float d = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i] + aw[i] * bw[i];
+            const float wb = d < 0.0f ? -w[i] : w[i];
+            const float wa = 1.0f - w[i];
+
+            const float rx = ax[i] * wa + bx[i] * wb;
+            const float ry = ay[i] * wa + by[i] * wb;
+            const float rz = az[i] * wa + bz[i] * wb;
+            const float rw = aw[i] * wa + bw[i] * wb;
+
+            const float inv_len = 1.0f / std::sqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+            x[i] = rx * inv_len;
+            y[i] = ry * inv_len;
+            z[i] = rz * inv_len;
+            qw[i] = rw * inv_len;
+        }
+    }
+}
+
+void Pose::add(const Pose& base, const Pose& additive, float weight, core::Span<float> bone_mask, Pose& out) {
+    y_debug_assert(base._stride == additive._stride && base._stride == out._stride);
+
+    const usize stride = out._stride;
+    const core::ScratchPad<float> weights = bone_weights(stride, out._bone_count, weight, bone_mask);
+    const float* w = weights.data();
+
+    for(usize c = 0; c != 3; ++c) {
+        const float* base_pos = base.data(Component(PositionX + c));
+        const float* add_pos = additive.data(Component(PositionX + c));
+        float* dst_pos = out.data(Component(PositionX + c));
+        for(usize i = 0; i != stride; ++i) {
+            dst_pos[i] = base_pos[i] + add_pos[i] * w[i];
+        }
+
+        const float* base_scale = base.data(Component(ScaleX + c));
+        const float* add_scale = additive.data(Component(ScaleX + c));
+        float* dst_scale = out.data(Component(ScaleX + c));
+        for(usize i = 0; i != stride; ++i) {
+            dst_scale[i] = base_scale[i] * (1.0f + (add_scale[i] - 1.0f) * w[i]);
+        }
+    }
+
+    {
+        const float* bx = base.data(RotationX);
+        const float* by = base.data(RotationY);
+        const float* bz = base.data(RotationZ);
+        const float* bw = base.data(RotationW);
+        const float* ax = additive.data(RotationX);
+        const float* ay = additive.data(RotationY);
+        const float* az = additive.data(RotationZ);
+        const float* aw = additive.data(RotationW);
+
+        float* x = out.data(RotationX);
+        float* y = out.data(RotationY);
+        float* z = out.data(RotationZ);
+        float* qw = out.data(RotationW);
+
+        for(usize i = 0; i != stride; ++i) {
+            // Scale the additive rotation by lerping it from identity
+            const float s = aw[i] < 0.0f ? -w[i] : w[i];
+            float rx = ax[i] * s;
+            float ry = ay[i] * s;
+            float rz = az[i] * s;
+            float rw = 1.0f - w[i] + aw[i] * s;
+
+            const float inv_len = 1.0f / std::sqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+            rx *= inv_len;
+            ry *= inv_len;
+            rz *= inv_len;
+            rw *= inv_len;
+
+            // base * additive
+            const float ox = bw[i] * rx + bx[i] * rw + by[i] * rz - bz[i] * ry;
+            const float oy = bw[i] * ry - bx[i] * rz + by[i] * rw + bz[i] * rx;
+            const float oz = bw[i] * rz + bx[i] * ry - by[i] * rx + bz[i] * rw;
+            const float ow = bw[i] * rw - bx[i] * rx - by[i] * ry - bz[i] * rz;
+
+            x[i] = ox;
+            y[i] = oy;
+            z[i] = oz;
+            qw[i] = ow;
+        }
+    }
+}
+
+void Pose::compute_skinning(const Skeleton& skeleton, core::MutableSpan<math::Transform<>> skinning_transforms) const {
+    const core::Span<Bone> bones = skeleton.bones();
+    const core::Span<math::Transform<>> inverses = skeleton.inverse_absolute_transforms();
+
+    y_debug_assert(bones.size() == _bone_count);
+    y_debug_assert(skinning_transforms.size() >= _bone_count);
+
+    const float* px = data(PositionX);
+    const float* py = data(PositionY);
+    const float* pz = data(PositionZ);
+    const float* rx = data(RotationX);
+    const float* ry = data(RotationY);
+    const float* rz = data(RotationZ);
+    const float* rw = data(RotationW);
+    const float* sx = data(ScaleX);
+    const float* sy = data(ScaleY);
+    const float* sz = data(ScaleZ);
+
+    for(usize i = 0; i != _bone_count; ++i) {
+        // Rotations are already normalized, so we build the matrix directly
+        const float x = rx[i];
+        const float y = ry[i];
+        const float z = rz[i];
+        const float w = rw[i];
+
+        math::Transform<> local;
+        local.column(0) = math::Vec4((1.0f - 2.0f * (y * y + z * z)) * sx[i], (2.0f * (x * y + w * z)) * sx[i], (2.0f * (x * z - w * y)) * sx[i], 0.0f);
+        local.column(1) = math::Vec4((2.0f * (x * y - w * z)) * sy[i], (1.0f - 2.0f * (x * x + z * z)) * sy[i], (2.0f * (y * z + w * x)) * sy[i], 0.0f);
+        local.column(2) = math::Vec4((2.0f * (x * z + w * y)) * sz[i], (2.0f * (y * z - w * x)) * sz[i], (1.0f - 2.0f * (x * x + y * y)) * sz[i], 0.0f);
+        local.column(3) = math::Vec4(px[i], py[i], pz[i], 1.0f);
+
+        // Parents always come before their children
+        const Bone& bone = bones[i];
+        skinning_transforms[i] = bone.has_parent() ? skinning_transforms[bone.parent] * local : local;
+    }
+
+    for(usize i = 0; i != _bone_count; ++i) {
+        skinning_transforms[i] *= inverses[i];
+    }
+}
+
+}
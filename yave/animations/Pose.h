@@ -0,0 +1,87 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_ANIMATIONS_POSE_H
+#define YAVE_ANIMATIONS_POSE_H
+
+#include <yave/meshes/Skeleton.h>
+
+#include <y/core/Vector.h>
+
+namespace yave {
+
+// Local bone transforms stored with one array per component so that blending loops can be vectorized.
+// Arrays are padded to a multiple of simd_width bones.
+class Pose {
+    public:
+        static constexpr usize simd_width = 8;
+
+        enum Component : usize {
+            PositionX,
+            PositionY,
+            PositionZ,
+            RotationX,
+            RotationY,
+            RotationZ,
+            RotationW,
+            ScaleX,
+            ScaleY,
+            ScaleZ,
+
+            ComponentCount
+        };
+
+        Pose() = default;
+
+        // Identity pose
+        explicit Pose(usize bone_count);
+
+        static Pose bind_pose(const Skeleton& skeleton);
+
+        usize bone_count() const;
+
+        core::MutableSpan<float> component(Component c);
+        core::Span<float> component(Component c) const;
+
+        BoneTransform bone(usize index) const;
+        void set_bone(usize index, const BoneTransform& tr);
+
+        // out = a blended toward b by weight (scaled per bone by bone_mask if not empty). Rotations are normalized lerped.
+        static void blend(const Pose& a, const Pose& b, float weight, core::Span<float> bone_mask, Pose& out);
+
+        // out = base with additive applied on top of it, weight (and bone_mask) scales the additive pose
+        static void add(const Pose& base, const Pose& additive, float weight, core::Span<float> bone_mask, Pose& out);
+
+        // Converts to model space and multiplies by the inverse bind pose
+        void compute_skinning(const Skeleton& skeleton, core::MutableSpan<math::Transform<>> skinning_transforms) const;
+
+    private:
+        float* data(Component c);
+        const float* data(Component c) const;
+
+        usize _bone_count = 0;
+        usize _stride = 0;
+        core::Vector<float> _data;
+};
+
+}
+
+#endif // YAVE_ANIMATIONS_POSE_H
@@ -0,0 +1,179 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "PoseGraph.h"
+
+namespace yave {
+
+PoseGraph::PoseGraph(std::shared_ptr<const Skeleton> skeleton) : _skeleton(std::move(skeleton)), _bind_pose(Pose::bind_pose(*_skeleton)), _identity_pose(_bind_pose.bone_count()) {
+}
+
+usize PoseGraph::node_count() const {
+    return _nodes.size();
+}
+
+bool PoseGraph::is_empty() const {
+    return _nodes.is_empty();
+}
+
+PoseGraph::NodeId PoseGraph::add_node(Node node) {
+    y_debug_assert(_skeleton);
+
+    node.pose = _bind_pose;
+    _nodes.emplace_back(std::move(node));
+    return NodeId(_nodes.size() - 1);
+}
+
+void PoseGraph::mark_additive(NodeId node) {
+    Node& n = _nodes[node];
+    n.additive = true;
+    if(n.type != NodeType::Clip) {
+        mark_additive(n.inputs[0]);
+        mark_additive(n.inputs[1]);
+    }
+}
+
+PoseGraph::NodeId PoseGraph::add_clip(const BoundAnimation* anim, bool loop) {
+    y_debug_assert(anim);
+
+    Node node;
+    node.type = NodeType::Clip;
+    node.anim = anim;
+    node.cursors = core::Vector<u32>(anim->track_count(), 0u);
+    node.loop = loop;
+    return add_node(std::move(node));
+}
+
+PoseGraph::NodeId PoseGraph::add_blend(NodeId a, NodeId b, float weight, core::Span<float> bone_mask) {
+    y_debug_assert(a < _nodes.size() && b < _nodes.size());
+    y_debug_assert(bone_mask.is_empty() || bone_mask.size() == _bind_pose.bone_count());
+
+    Node node;
+    node.type = NodeType::Blend;
+    node.inputs[0] = a;
+    node.inputs[1] = b;
+    node.bone_mask = core::Vector<float>(bone_mask);
+    node.weight = node.fade_target = weight;
+    return add_node(std::move(node));
+}
+
+PoseGraph::NodeId PoseGraph::add_additive(NodeId base, NodeId additive, float weight, core::Span<float> bone_mask) {
+    y_debug_assert(base < _nodes.size() && additive < _nodes.size());
+    y_debug_assert(bone_mask.is_empty() || bone_mask.size() == _bind_pose.bone_count());
+
+    Node node;
+    node.type = NodeType::Additive;
+    node.inputs[0] = base;
+    node.inputs[1] = additive;
+    node.bone_mask = core::Vector<float>(bone_mask);
+    node.weight = node.fade_target = weight;
+
+    mark_additive(additive);
+    return add_node(std::move(node));
+}
+
+void PoseGraph::set_time(NodeId clip, float time) {
+    y_debug_assert(_nodes[clip].type == NodeType::Clip);
+    _nodes[clip].time = time;
+}
+
+void PoseGraph::set_speed(NodeId clip, float speed) {
+    y_debug_assert(_nodes[clip].type == NodeType::Clip);
+    _nodes[clip].speed = speed;
+}
+
+void PoseGraph::set_weight(NodeId node, float weight) {
+    y_debug_assert(_nodes[node].type != NodeType::Clip);
+    _nodes[node].weight = _nodes[node].fade_target = weight;
+    _nodes[node].fade_speed = 0.0f;
+}
+
+float PoseGraph::weight(NodeId node) const {
+    return _nodes[node].weight;
+}
+
+void PoseGraph::fade_to(NodeId node, float target, float duration) {
+    y_debug_assert(_nodes[node].type != NodeType::Clip);
+
+    Node& n = _nodes[node];
+    if(duration <= 0.0f) {
+        set_weight(node, target);
+        return;
+    }
+
+    n.fade_target = target;
+    n.fade_speed = std::abs(target - n.weight) / duration;
+}
+
+void PoseGraph::update(float dt) {
+    for(Node& node : _nodes) {
+        if(node.type == NodeType::Clip) {
+            const float duration = node.anim->duration();
+            node.time += dt * node.speed;
+            if(node.loop && duration > 0.0f) {
+                node.time = std::fmod(node.time, duration);
+                if(node.time < 0.0f) {
+                    node.time += duration;
+                }
+            } else {
+                node.time = std::clamp(node.time, 0.0f, duration);
+            }
+        } else if(node.weight != node.fade_target) {
+            const float step = node.fade_speed * dt;
+            node.weight = node.weight < node.fade_target
+                ? std::min(node.weight + step, node.fade_target)
+                : std::max(node.weight - step, node.fade_target);
+        }
+    }
+}
+
+const Pose& PoseGraph::evaluate() {
+    y_profile();
+
+    y_debug_assert(!_nodes.is_empty());
+
+    for(Node& node : _nodes) {
+        switch(node.type) {
+            case NodeType::Clip:
+                // Bones without animation track keep their bind pose, or add nothing for additive clips
+                node.pose = node.additive ? _identity_pose : _bind_pose;
+                node.anim->sample(node.time, node.cursors, node.pose);
+            break;
+
+            case NodeType::Blend:
+                Pose::blend(_nodes[node.inputs[0]].pose, _nodes[node.inputs[1]].pose, node.weight, node.bone_mask, node.pose);
+            break;
+
+            case NodeType::Additive:
+                Pose::add(_nodes[node.inputs[0]].pose, _nodes[node.inputs[1]].pose, node.weight, node.bone_mask, node.pose);
+            break;
+        }
+    }
+
+    return _nodes.last().pose;
+}
+
+void PoseGraph::evaluate(core::MutableSpan<math::Transform<>> skinning_transforms) {
+    evaluate().compute_skinning(*_skeleton, skinning_transforms);
+}
+
+}
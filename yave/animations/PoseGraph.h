@@ -0,0 +1,105 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_ANIMATIONS_POSEGRAPH_H
+#define YAVE_ANIMATIONS_POSEGRAPH_H
+
+#include "BoundAnimation.h"
+
+namespace yave {
+
+// Evaluates a small graph of clips, blends and additive layers into a single pose.
+// Nodes can only take earlier nodes as inputs, so evaluating them in order is enough and the last node is the output.
+class PoseGraph {
+    public:
+        using NodeId = u32;
+
+        PoseGraph() = default;
+        PoseGraph(std::shared_ptr<const Skeleton> skeleton);
+
+        usize node_count() const;
+        bool is_empty() const;
+
+        // anim should be bound to the graph skeleton and must outlive the graph
+        NodeId add_clip(const BoundAnimation* anim, bool loop = true);
+
+        // Blends from a (weight = 0) to b (weight = 1). bone_mask is either empty or contains one weight per bone
+        NodeId add_blend(NodeId a, NodeId b, float weight = 0.0f, core::Span<float> bone_mask = {});
+
+        // Applies additive on top of base, additive should be a clip authored relative to the identity.
+        // Clips feeding additive (directly or through other nodes) are sampled on top of the identity pose rather than the bind pose,
+        // so they should not also be used as regular inputs.
+        NodeId add_additive(NodeId base, NodeId additive, float weight = 1.0f, core::Span<float> bone_mask = {});
+
+        void set_time(NodeId clip, float time);
+        void set_speed(NodeId clip, float speed);
+
+        void set_weight(NodeId node, float weight);
+        float weight(NodeId node) const;
+
+        // Moves the weight of a blend or additive node toward target over duration seconds
+        void fade_to(NodeId node, float target, float duration);
+
+        // Advances clip times and fades
+        void update(float dt);
+
+        const Pose& evaluate();
+        void evaluate(core::MutableSpan<math::Transform<>> skinning_transforms);
+
+    private:
+        enum class NodeType {
+            Clip,
+            Blend,
+            Additive,
+        };
+
+        struct Node {
+            NodeType type = NodeType::Clip;
+
+            const BoundAnimation* anim = nullptr;
+            core::Vector<u32> cursors;
+            float time = 0.0f;
+            float speed = 1.0f;
+            bool loop = true;
+            bool additive = false;
+
+            NodeId inputs[2] = {};
+            core::Vector<float> bone_mask;
+            float weight = 0.0f;
+            float fade_target = 0.0f;
+            float fade_speed = 0.0f;
+
+            Pose pose;
+        };
+
+        NodeId add_node(Node node);
+        void mark_additive(NodeId node);
+
+        std::shared_ptr<const Skeleton> _skeleton;
+        Pose _bind_pose;
+        Pose _identity_pose;
+
+        core::Vector<Node> _nodes;
+};
+
+}
+
+#endif // YAVE_ANIMATIONS_POSEGRAPH_H
@@ -35,6 +35,9 @@ SkeletonInstance::SkeletonInstance(const Skeleton* skeleton) :
 void SkeletonInstance::animate(const AssetPtr<Animation>& anim) {
     _animation = anim;
     _anim_timer.reset();
+
+    _bound_animation = BoundAnimation();
+    _needs_binding = true;
 }
 
 void SkeletonInstance::update() {
@@ -42,32 +45,25 @@ void SkeletonInstance::update() {
         return;
     }
 
-    const float time = std::fmod(float(_anim_timer.elapsed().to_secs()), _animation->duration());
-
-    const auto& anim = *_animation;
-    const auto& bones = _skeleton->bones();
-    const auto& bone_transforms = _skeleton->bone_transforms();
-    const auto& invs = _skeleton->inverse_absolute_transforms();
-
-    auto& out_transforms = *_bone_transforms;
-
+    if(_needs_binding) {
+        _bound_animation = BoundAnimation(*_animation, *_skeleton);
+        _key_cursors = core::Vector<u32>(_bound_animation.track_count(), 0);
+        _needs_binding = false;
+    }
 
-    for(usize i = 0; i != bones.size(); ++i) {
-        const auto& bone = bones[i];
-        auto bone_tr = anim.bone_transform(bone.name, time).value_or(bone_transforms[i]);
+    const float time = std::fmod(float(_anim_timer.elapsed().to_secs()), _bound_animation.duration());
 
-        out_transforms[i] = (bone.has_parent() ? out_transforms[bone.parent] * bone_tr : bone_tr);
-    }
-    for(usize i = 0; i != bones.size(); ++i) {
-        out_transforms[i] *= invs[i];
-    }
+    _bound_animation.evaluate(*_skeleton, time, _key_cursors, *_bone_transforms);
 
     flush_data();
 }
 
 void SkeletonInstance::flush_data() {
+    // Only the bones actually used by the skeleton need to be uploaded
+    const usize bone_count = _skeleton ? _skeleton->bones().size() : _bone_transforms->size();
+
     auto map = _bone_transform_buffer.map(MappingAccess::WriteOnly);
-    std::copy(_bone_transforms->begin(), _bone_transforms->end(), map.begin());
+    std::copy_n(_bone_transforms->begin(), bone_count, map.begin());
 }
 
 }
@@ -28,7 +28,7 @@ SOFTWARE.
 #include <yave/meshes/Skeleton.h>
 #include <yave/graphics/buffers/Buffer.h>
 
-#include "Animation.h"
+#include "BoundAnimation.h"
 
 namespace yave {
 
@@ -55,6 +55,11 @@ class SkeletonInstance {
         AssetPtr<Animation> _animation;
         core::StopWatch _anim_timer;
 
+        // Bound lazily as the animation might not be loaded yet
+        BoundAnimation _bound_animation;
+        core::Vector<u32> _key_cursors;
+        bool _needs_binding = false;
+
 };
 
 }
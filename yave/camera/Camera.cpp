@@ -22,6 +22,8 @@ SOFTWARE.
 
 #include "Camera.h"
 
+#include <y/math/Transform.h>
+
 namespace yave {
 
 bool Camera::is_proj_orthographic(const math::Matrix4<>& proj) {
@@ -191,7 +193,7 @@ Camera::operator shader::Camera() const {
     camera_data.inv_proj = camera_data.proj.inverse();
 
     camera_data.view = view_matrix();
-    camera_data.inv_view = camera_data.view.inverse();
+    camera_data.inv_view = math::Transform<>(camera_data.view).rigid_inverse();
 
     camera_data.position = position();
     camera_data.prev_position = camera_data.position;
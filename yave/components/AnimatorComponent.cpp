@@ -0,0 +1,68 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "AnimatorComponent.h"
+
+namespace yave {
+
+AnimatorComponent::AnimatorComponent(std::shared_ptr<const Skeleton> skeleton, const AssetPtr<Animation>& anim) {
+    set_skeleton(std::move(skeleton));
+    set_animation(anim);
+}
+
+void AnimatorComponent::set_skeleton(std::shared_ptr<const Skeleton> skeleton) {
+    _skeleton = std::move(skeleton);
+    _pose.make_empty();
+    _needs_binding = true;
+}
+
+void AnimatorComponent::set_animation(const AssetPtr<Animation>& anim) {
+    _animation = anim;
+    _time = 0.0f;
+    _needs_binding = true;
+}
+
+const Skeleton* AnimatorComponent::skeleton() const {
+    return _skeleton.get();
+}
+
+const AssetPtr<Animation>& AnimatorComponent::animation() const {
+    return _animation;
+}
+
+float AnimatorComponent::time() const {
+    return _time;
+}
+
+u32 AnimatorComponent::bone_offset() const {
+    return _bone_offset;
+}
+
+u32 AnimatorComponent::bone_count() const {
+    return _skeleton ? u32(_skeleton->bones().size()) : 0;
+}
+
+u32 AnimatorComponent::update_interval() const {
+    return _update_interval;
+}
+
+}
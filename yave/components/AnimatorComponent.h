@@ -0,0 +1,73 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_COMPONENTS_ANIMATORCOMPONENT_H
+#define YAVE_COMPONENTS_ANIMATORCOMPONENT_H
+
+#include <yave/ecs/ecs.h>
+
+#include <yave/animations/BoundAnimation.h>
+#include <yave/assets/AssetPtr.h>
+
+namespace yave {
+
+// Plays an animation on a skeleton, driven by the AnimationSystem
+class AnimatorComponent final : public ecs::RequireComponent<TransformableComponent> {
+    public:
+        AnimatorComponent() = default;
+        AnimatorComponent(std::shared_ptr<const Skeleton> skeleton, const AssetPtr<Animation>& anim = {});
+
+        void set_skeleton(std::shared_ptr<const Skeleton> skeleton);
+        void set_animation(const AssetPtr<Animation>& anim);
+
+        const Skeleton* skeleton() const;
+        const AssetPtr<Animation>& animation() const;
+
+        float time() const;
+
+        // Offset of the first bone in the AnimationSystem's bone palette for this frame, u32(-1) if not animated
+        u32 bone_offset() const;
+        u32 bone_count() const;
+
+        // Number of frames between two pose evaluations, depends on the distance to the viewer
+        u32 update_interval() const;
+
+        y_no_serde3()
+
+    private:
+        friend class AnimationSystem;
+
+        std::shared_ptr<const Skeleton> _skeleton;
+        AssetPtr<Animation> _animation;
+
+        BoundAnimation _bound_animation;
+        core::Vector<u32> _key_cursors;
+        core::Vector<math::Transform<>> _pose;
+        bool _needs_binding = false;
+
+        float _time = 0.0f;
+        u32 _bone_offset = u32(-1);
+        u32 _update_interval = 1;
+};
+
+}
+
+#endif // YAVE_COMPONENTS_ANIMATORCOMPONENT_H
@@ -94,7 +94,7 @@ void StaticMeshComponent::inspect(ecs::ComponentInspector* inspector) {
     inspector->inspect("Materials", core::MutableSpan<AssetPtr<Material>>(_materials));
 
     if(_mesh) {
-        const usize slots = _mesh->sub_meshes().size();
+        const usize slots = _mesh->sub_mesh_count();
         if(slots != _materials.size()) {
             _materials = core::Vector<AssetPtr<Material>>(slots, AssetPtr<Material>());
         }
@@ -31,16 +31,39 @@ TransformableComponent::TransformableComponent(const math::Transform<>& transfor
 
 void TransformableComponent::set_transform(const math::Transform<>& tr) {
     _transform = tr;
+    _sync_local = _parent_relative;
 }
 
 void TransformableComponent::set_position(const math::Vec3& pos) {
     _transform.position() = pos;
+    _sync_local = _parent_relative;
 }
 
 const math::Transform<>& TransformableComponent::transform() const {
     return _transform;
 }
 
+void TransformableComponent::set_local_transform(const math::Transform<>& tr) {
+    _local_transform = tr;
+    _sync_local = false;
+}
+
+const math::Transform<>& TransformableComponent::local_transform() const {
+    return _local_transform;
+}
+
+void TransformableComponent::set_parent_relative(bool relative) {
+    if(relative != _parent_relative) {
+        _parent_relative = relative;
+        // Keep the world transform, the local one will be computed from the parent
+        _sync_local = relative;
+    }
+}
+
+bool TransformableComponent::is_parent_relative() const {
+    return _parent_relative;
+}
+
 const math::Vec3& TransformableComponent::forward() const {
     return _transform.forward();
 }
@@ -71,7 +94,19 @@ AABB TransformableComponent::to_global(const AABB& aabb) const {
 }
 
 void TransformableComponent::inspect(ecs::ComponentInspector* inspector) {
-    inspector->inspect("Transform", _transform);
+    bool relative = _parent_relative;
+    inspector->inspect("Parent relative", relative);
+    set_parent_relative(relative);
+
+    if(_parent_relative && !_sync_local) {
+        inspector->inspect("Local transform", _local_transform);
+    } else {
+        const math::Transform<> tr = _transform;
+        inspector->inspect("Transform", _transform);
+        if(tr != _transform) {
+            _sync_local = _parent_relative;
+        }
+    }
 }
 
 }
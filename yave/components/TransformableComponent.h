@@ -32,11 +32,19 @@ class TransformableComponent final {
     public:
         TransformableComponent(const math::Transform<>& transform = {});
 
+        // Sets the world transform. For parent relative components the local transform is recomputed by the TransformSystem
         void set_transform(const math::Transform<>& tr);
         void set_position(const math::Vec3& pos);
 
         const math::Transform<>& transform() const;
 
+        // Only used for parent relative components, the world transform is updated by the TransformSystem
+        void set_local_transform(const math::Transform<>& tr);
+        const math::Transform<>& local_transform() const;
+
+        void set_parent_relative(bool relative);
+        bool is_parent_relative() const;
+
         const math::Vec3& forward() const;
         const math::Vec3& right() const;
         const math::Vec3& up() const;
@@ -48,10 +56,16 @@ class TransformableComponent final {
 
         void inspect(ecs::ComponentInspector* inspector);
 
-        y_reflect(TransformableComponent, _transform)
+        y_reflect(TransformableComponent, _transform, _local_transform, _parent_relative)
 
     private:
+        friend class TransformSystem;
+
         math::Transform<> _transform;
+        math::Transform<> _local_transform;
+
+        bool _parent_relative = false;
+        bool _sync_local = false;
 };
 
 }
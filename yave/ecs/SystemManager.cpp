@@ -47,6 +47,10 @@ SystemScheduler::ArgumentResolver::operator SystemScheduler::FirstTime() const {
     return FirstTime { _parent->_world->tick_id() == _parent->_first_tick };
 }
 
+SystemScheduler::ArgumentResolver::operator concurrent::JobSystem*() const {
+    return _parent->_manager->_job_system;
+}
+
 SystemScheduler::SystemScheduler(System* sys, SystemManager* manager, EntityWorld *world) : _system(sys), _manager(manager), _world(world), _first_tick(_world->tick_id().next()) {
 }
 
@@ -91,6 +95,9 @@ void SystemManager::run_schedule_mt(concurrent::JobSystem& job_system) const {
 
     run_stage_seq(SystemSchedule::TickSequential);
 
+    _job_system = &job_system;
+    y_defer(_job_system = nullptr);
+
     usize task_count = 0;
     usize max_tasks = 0;
     {
@@ -96,6 +96,9 @@ class SystemScheduler : NonMovable {
                 operator const EntityWorld&() const;
                 operator FirstTime() const;
 
+                // Null when the schedule is run sequentially
+                operator concurrent::JobSystem*() const;
+
                 template<typename... Ts>
                 operator EntityGroup<Ts...>() const;
 
@@ -182,6 +185,8 @@ class SystemManager : NonMovable {
 
 
     private:
+        friend class SystemScheduler;
+
         void run_stage_seq(SystemSchedule schedule) const;
 
         void setup_system(System *system);
@@ -190,6 +195,8 @@ class SystemManager : NonMovable {
         core::Vector<std::unique_ptr<System>> _systems;
         u32 _next_handle = 0;
 
+        mutable concurrent::JobSystem* _job_system = nullptr;
+
         EntityWorld* _world = nullptr;
 };
 
@@ -24,15 +24,22 @@ SOFTWARE.
 #include "FrameGraphPass.h"
 #include "FrameGraphFrameResources.h"
 #include "FrameGraphResourcePool.h"
+#include "FrameGraphPlan.h"
 
 #include <yave/graphics/commands/CmdQueue.h>
+#include <yave/graphics/commands/CmdBufferPool.h>
+#include <yave/graphics/commands/CmdBufferRecorder.h>
+#include <yave/graphics/device/DeviceProperties.h>
 
 #include <yave/utils/color.h>
 
+#include <y/concurrent/JobSystem.h>
 #include <y/core/ScratchPad.h>
 #include <y/utils/log.h>
 #include <y/utils/format.h>
 
+#include <optional>
+
 namespace yave {
 
 static void check_usage_io(ImageUsage usage, bool is_output) {
@@ -90,8 +97,26 @@ static auto&& check_exists(C& c, T t) {
     y_fatal("Resource doesn't exist");
 }
 
+static FrameGraphCulling::ResourceKey culling_key(FrameGraphImageId res) {
+    return u64(res.id());
+}
+
+static FrameGraphCulling::ResourceKey culling_key(FrameGraphVolumeId res) {
+    return (u64(1) << 32) | u64(res.id());
+}
+
+static FrameGraphCulling::ResourceKey culling_key(FrameGraphBufferId res) {
+    return (u64(2) << 32) | u64(res.id());
+}
+
+template<typename C>
+static void remove_culled(C& c, const FrameGraphCulling& culling) {
+    const auto end = std::remove_if(c.begin(), c.end(), [&](const auto& e) { return !culling.is_alive(e.pass_index); });
+    c.shrink_to(end - c.begin());
+}
+
 template<typename C, typename B, typename H>
-static void build_barriers(const C& resources, B& barriers, H& to_barrier, const FrameGraphFrameResources& frame_res) {
+static void compile_barriers(const C& resources, B& barriers, H& to_barrier) {
     for(auto&& [res, info] : resources) {
         // barrier around attachments are handled by the renderpass
         const PipelineStage stage = info.stage & ~PipelineStage::AllAttachmentOutBit;
@@ -99,7 +124,7 @@ static void build_barriers(const C& resources, B& barriers, H& to_barrier, const
             const auto it = to_barrier.find(res);
             const bool exists = it != to_barrier.end();
             if(exists) {
-                barriers.emplace_back(frame_res.barrier(res, it->second, info.stage));
+                barriers.push_back({res, it->second, info.stage});
                 to_barrier.erase(it);
             }
 
@@ -110,9 +135,17 @@ static void build_barriers(const C& resources, B& barriers, H& to_barrier, const
     }
 }
 
+template<typename C, typename B>
+static void compile_aliasing_barriers(const C& placed, usize& index, usize pass_index, B& aliased) {
+    // Placed resources might use memory previously used by other resources (from this frame or previous ones)
+    for(; index < placed.size() && placed[index].first_use <= pass_index; ++index) {
+        aliased.push_back(placed[index].res);
+    }
+}
+
 template<typename H>
-static void copy_image(CmdBufferRecorder& recorder, FrameGraphImageId src, FrameGraphMutableImageId dst,
-                       H& to_barrier, const FrameGraphFrameResources& frame_res) {
+static void compile_image_copy(FrameGraphPlan::Pass& compiled, FrameGraphImageId src, FrameGraphMutableImageId dst,
+                               H& to_barrier, const FrameGraphFrameResources& frame_res) {
 
     Y_TODO(We might end up inserting barriers twice here)
     if(frame_res.are_aliased(src, dst)) {
@@ -123,37 +156,60 @@ static void copy_image(CmdBufferRecorder& recorder, FrameGraphImageId src, Frame
     } else {
         to_barrier.erase(src);
         to_barrier.erase(dst);
-        recorder.copy(frame_res.image_base(src), frame_res.image_base(dst));
+        compiled.image_copies.push_back({src, dst});
     }
 }
 
 template<typename H, typename B>
-static void copy_buffer(CmdBufferRecorder& recorder, FrameGraphBufferId src, FrameGraphMutableBufferId dst,
-                        H& to_barrier, const B& pass_buffers, const FrameGraphFrameResources& frame_res) {
+static void compile_buffer_copy(FrameGraphPlan::Pass& compiled, FrameGraphBufferId src, FrameGraphMutableBufferId dst,
+                                H& to_barrier, const B& pass_buffers) {
+
+    FrameGraphPlan::BufferCopy copy{src, dst};
 
     if(const auto src_it = to_barrier.find(src); src_it != to_barrier.end()) {
         const auto dst_it = pass_buffers.find(dst);
         y_debug_assert(dst_it != pass_buffers.end());
-        recorder.barriers(frame_res.barrier(src, src_it->second, dst_it->second.stage));
+        copy.src_barrier = {src, src_it->second, dst_it->second.stage};
         to_barrier.erase(src_it);
     }
 
     auto& dst_stage = to_barrier[dst];
-    if(dst_stage != PipelineStage::None) {
-        recorder.barriers(frame_res.barrier(dst, dst_stage, PipelineStage::TransferBit));
-    }
-
-    recorder.unbarriered_copy(frame_res.buffer<BufferUsage::TransferSrcBit>(src), frame_res.buffer<BufferUsage::TransferDstBit>(dst));
-
+    copy.dst_stage = dst_stage;
     dst_stage = PipelineStage::TransferBit;
+
+    compiled.buffer_copies.push_back(copy);
 }
 
 template<typename H>
-static void clear_image(CmdBufferRecorder& recorder, FrameGraphMutableImageId dst,
-                        H& to_barrier, const FrameGraphFrameResources& frame_res) {
-
+static void compile_image_clear(FrameGraphPlan::Pass& compiled, FrameGraphMutableImageId dst, H& to_barrier) {
     to_barrier.erase(dst);
-    recorder.clear(frame_res.image_base(dst));
+    compiled.image_clears.push_back(dst);
+}
+
+template<typename C, typename B>
+static void build_barriers(const C& compiled, B& barriers, const FrameGraphFrameResources& frame_res) {
+    for(const auto& barrier : compiled) {
+        barriers.emplace_back(frame_res.barrier(barrier.res, barrier.src, barrier.dst));
+    }
+}
+
+template<typename C, typename B>
+static void build_aliasing_barriers(const C& aliased, B& barriers, const FrameGraphFrameResources& frame_res) {
+    for(const auto& res : aliased) {
+        barriers.emplace_back(frame_res.aliasing_barrier(res));
+    }
+}
+
+static void copy_buffer(CmdBufferRecorder& recorder, const FrameGraphPlan::BufferCopy& copy, const FrameGraphFrameResources& frame_res) {
+    if(copy.src_barrier.src != PipelineStage::None) {
+        recorder.barriers(frame_res.barrier(copy.src_barrier.res, copy.src_barrier.src, copy.src_barrier.dst));
+    }
+
+    if(copy.dst_stage != PipelineStage::None) {
+        recorder.barriers(frame_res.barrier(copy.dst, copy.dst_stage, PipelineStage::TransferBit));
+    }
+
+    recorder.unbarriered_copy(frame_res.buffer<BufferUsage::TransferSrcBit>(copy.src), frame_res.buffer<BufferUsage::TransferDstBit>(copy.dst));
 }
 
 
@@ -169,6 +225,9 @@ FrameGraph::FrameGraph(std::shared_ptr<FrameGraphResourcePool> pool) : _resource
 }
 
 FrameGraph::~FrameGraph() {
+    if(_plan) {
+        _resources->_pool->release(std::move(_plan));
+    }
 }
 
 u64 FrameGraph::frame_id() const {
@@ -179,6 +238,10 @@ const FrameGraphFrameResources& FrameGraph::resources() const {
     return *_resources;
 }
 
+const FrameGraph::CompileStats& FrameGraph::compile_stats() const {
+    return _stats;
+}
+
 FrameGraphRegion FrameGraph::region(std::string_view name) {
     const usize index = _regions.size();
     _regions.emplace_back(Region{name, _pass_index + 1, _pass_index + 1});
@@ -192,9 +255,8 @@ void FrameGraph::end_region(usize index) {
 
 
 
-void FrameGraph::render(CmdBufferRecorder& recorder, CmdTimestampPool* ts_pool) {
+void FrameGraph::render(CmdBufferRecorder& recorder, CmdTimestampPool* ts_pool, concurrent::JobSystem* job_system) {
     y_profile();
-    Y_TODO(Pass culling)
     Y_TODO(Ensure that passes are always recorded in order)
 
     // -------------------- region stuff --------------------
@@ -220,13 +282,12 @@ void FrameGraph::render(CmdBufferRecorder& recorder, CmdTimestampPool* ts_pool)
     };
 
     auto begin_pass_region = [&](const FrameGraphPass& pass) {
-        while(true) {
-            if(next_region_index < _regions.size() && _regions[next_region_index].begin_pass == pass._index) {
+        // Regions might start on a culled pass, or have been culled entirely
+        while(next_region_index < _regions.size() && _regions[next_region_index].begin_pass <= pass._index) {
+            const Region& region = _regions[next_region_index++];
+            if(region.end_pass >= pass._index) {
                 const math::Vec4 color = next_color();
-                regions.emplace_back(RuntimeRegion{_regions[next_region_index], recorder.region(_regions[next_region_index].name.data(), ts_pool, color), color});
-                ++next_region_index;
-            } else {
-                break;
+                regions.emplace_back(RuntimeRegion{region, recorder.region(region.name.data(), ts_pool, color), color});
             }
         }
 
@@ -246,78 +307,141 @@ void FrameGraph::render(CmdBufferRecorder& recorder, CmdTimestampPool* ts_pool)
 
 
     // -------------------- resource management --------------------
-    alloc_resources();
+    {
+        y_profile_zone("compile");
 
-    usize image_copy_index = 0;
-    std::sort(_image_copies.begin(), _image_copies.end(), [&](const auto& a, const auto& b) { return a.pass_index < b.pass_index; });
+        // Graphs with the same topology reuse the same culling, memory placement, barriers and framebuffers
+        _plan = _resources->_pool->create_plan(topology_hash());
 
-    usize buffer_copy_index = 0;
-    std::sort(_buffer_copies.begin(), _buffer_copies.end(), [&](const auto& a, const auto& b) { return a.pass_index < b.pass_index; });
+        cull_passes();
+        alloc_resources();
 
-    usize image_clear_index = 0;
-    std::sort(_image_clears.begin(), _image_clears.end(), [&](const auto& a, const auto& b) { return a.pass_index < b.pass_index; });
+        if(!_plan->is_compiled()) {
+            compile_passes();
+        }
 
-    using hash_t = std::hash<FrameGraphResourceId>;
-    core::FlatHashMap<FrameGraphBufferId, PipelineStage, hash_t> buffers_to_barrier;
-    core::FlatHashMap<FrameGraphVolumeId, PipelineStage, hash_t> volumes_to_barrier;
-    core::FlatHashMap<FrameGraphImageId, PipelineStage, hash_t> images_to_barrier;
-    buffers_to_barrier.set_min_capacity(_buffers.size());
-    volumes_to_barrier.set_min_capacity(_volumes.size());
-    images_to_barrier.set_min_capacity(_images.size());
+        _resources->init_staging_buffer(recorder);
+    }
 
     {
         y_profile_zone("init");
-        for(const auto& pass : _passes) {
+        for(FrameGraphPlan::Pass& compiled : _plan->_passes) {
+            FrameGraphPass* pass = _passes[compiled.index - 1].get();
+            y_debug_assert(pass->_index == compiled.index);
+
             y_profile_dyn_zone(pass->name().data());
-            pass->init_framebuffer(*_resources);
+            pass->init_framebuffer(*_resources, compiled.cache_framebuffer ? &compiled.framebuffer : nullptr);
             pass->init_descriptor_sets(*_resources);
+
+            // Done before any recording starts so that parallel passes don't race with it
+            for(const auto& [res, data] : pass->_map_data) {
+                auto mapping = _resources->map_buffer_bytes(res);
+                std::memcpy(mapping.data(), data.data(), data.size() * sizeof(decltype(data)::value_type));
+            }
+        }
+    }
+
+    // -------------------- parallel recording --------------------
+    struct ParallelPass {
+        core::Vector<std::optional<CmdBufferRecorder>> secondaries;
+        core::Vector<concurrent::JobSystem::JobHandle> jobs;
+    };
+
+    // Barriers are all in the plan and recorded in the primary, so parallel passes are independent
+    // and can all be recorded at once, while the main thread records the other passes.
+    core::Vector<ParallelPass> parallel_passes;
+    if(job_system) {
+        y_profile_zone("schedule parallel passes");
+
+        parallel_passes.set_min_capacity(_plan->_passes.size());
+        for(const FrameGraphPlan::Pass& compiled : _plan->_passes) {
+            ParallelPass& parallel = parallel_passes.emplace_back();
+
+            const FrameGraphPass* pass = _passes[compiled.index - 1].get();
+            if(!pass->is_parallel()) {
+                continue;
+            }
+
+            for(usize i = 0; i != pass->split_count(); ++i) {
+                parallel.secondaries.emplace_back();
+            }
+
+            CmdQueue* queue = recorder.queue();
+            for(usize i = 0; i != pass->split_count(); ++i) {
+                std::optional<CmdBufferRecorder>* secondary = &parallel.secondaries[i];
+                parallel.jobs << job_system->schedule([=] {
+                    y_profile_dyn_zone(pass->name().data());
+                    CmdBufferRecorder& cmd_buffer = secondary->emplace(queue->cmd_pool_for_thread().create_secondary_cmd_buffer(pass->framebuffer()));
+                    pass->render_split(cmd_buffer, i);
+                    cmd_buffer.end_secondary();
+                });
+            }
         }
     }
 
     {
         y_profile_zone("render");
-        for(const auto& pass : _passes) {
+        for(usize p = 0; p != _plan->_passes.size(); ++p) {
+            const FrameGraphPlan::Pass& compiled = _plan->_passes[p];
+            FrameGraphPass* pass = _passes[compiled.index - 1].get();
+
             y_profile_dyn_zone(pass->name().data());
             const auto region = begin_pass_region(*pass);
 
+            if constexpr(allow_memory_aliasing) {
+                core::ScratchVector<BufferBarrier> buffer_barriers(compiled.aliased_buffers.size());
+                core::ScratchVector<ImageBarrier> image_barriers(compiled.aliased_images.size() + compiled.aliased_volumes.size());
+                build_aliasing_barriers(compiled.aliased_buffers, buffer_barriers, *_resources);
+                build_aliasing_barriers(compiled.aliased_volumes, image_barriers, *_resources);
+                build_aliasing_barriers(compiled.aliased_images, image_barriers, *_resources);
+                recorder.barriers(buffer_barriers, image_barriers);
+            }
+
             {
                 y_profile_zone("prepare");
-                for(const auto& [res, data] : pass->_map_data) {
-                    auto mapping = _resources->map_buffer_bytes(res);
-                    std::memcpy(mapping.data(), data.data(), data.size() * sizeof(decltype(data)::value_type));
-                }
 
-                while(image_copy_index < _image_copies.size() && _image_copies[image_copy_index].pass_index == pass->_index) {
-                    // copy_image will not do anything if the two are aliased
-                    copy_image(recorder, _image_copies[image_copy_index].src, _image_copies[image_copy_index].dst, images_to_barrier, *_resources);
-                    ++image_copy_index;
+                // Copies between aliased images have been removed during compilation
+                for(const auto& copy : compiled.image_copies) {
+                    recorder.copy(_resources->image_base(copy.src), _resources->image_base(copy.dst));
                 }
 
-                while(buffer_copy_index < _buffer_copies.size() && _buffer_copies[buffer_copy_index].pass_index == pass->_index) {
-                    copy_buffer(recorder, _buffer_copies[buffer_copy_index].src, _buffer_copies[buffer_copy_index].dst, buffers_to_barrier, pass->_buffers, *_resources);
-                    ++buffer_copy_index;
+                for(const auto& copy : compiled.buffer_copies) {
+                    copy_buffer(recorder, copy, *_resources);
                 }
 
-                while(image_clear_index < _image_clears.size() && _image_clears[image_clear_index].pass_index == pass->_index) {
-                    clear_image(recorder, _image_clears[image_clear_index].dst, images_to_barrier, *_resources);
-                    ++image_clear_index;
+                for(const auto& dst : compiled.image_clears) {
+                    recorder.clear(_resources->image_base(dst));
                 }
             }
 
             {
                 y_profile_zone("barriers");
 
-                core::ScratchVector<BufferBarrier> buffer_barriers(pass->_buffers.size());
-                core::ScratchVector<ImageBarrier> image_barriers(pass->_images.size() + pass->_volumes.size());
-                build_barriers(pass->_buffers, buffer_barriers, buffers_to_barrier, *_resources);
-                build_barriers(pass->_volumes, image_barriers, volumes_to_barrier, *_resources);
-                build_barriers(pass->_images, image_barriers, images_to_barrier, *_resources);
+                core::ScratchVector<BufferBarrier> buffer_barriers(compiled.buffer_barriers.size());
+                core::ScratchVector<ImageBarrier> image_barriers(compiled.image_barriers.size() + compiled.volume_barriers.size());
+                build_barriers(compiled.buffer_barriers, buffer_barriers, *_resources);
+                build_barriers(compiled.volume_barriers, image_barriers, *_resources);
+                build_barriers(compiled.image_barriers, image_barriers, *_resources);
                 recorder.barriers(buffer_barriers, image_barriers);
             }
 
-            {
+            if(parallel_passes.is_empty() || !pass->is_parallel()) {
                 y_profile_zone("render");
                 pass->render(recorder);
+            } else {
+                ParallelPass& parallel = parallel_passes[p];
+                {
+                    y_profile_zone("wait");
+                    job_system->wait(parallel.jobs);
+                }
+
+                y_profile_zone("execute");
+                core::ScratchVector<CmdBufferRecorder> secondaries(parallel.secondaries.size());
+                for(auto& secondary : parallel.secondaries) {
+                    y_debug_assert(secondary);
+                    secondaries.emplace_back(std::move(*secondary));
+                }
+                recorder.execute(pass->framebuffer(), secondaries);
             }
 
             end_pass_region(*pass);
@@ -334,6 +458,67 @@ void FrameGraph::render(CmdBufferRecorder& recorder, CmdTimestampPool* ts_pool)
     Y_TODO(Put resource barriers at the end of the graph to prevent clash with whatever comes after)
 }
 
+void FrameGraph::cull_passes() {
+    y_profile();
+
+    const bool is_compiled = _plan->is_compiled();
+    if(is_compiled) {
+        y_debug_assert(_plan->_culling.pass_count() == _culling.pass_count());
+        _stats = _plan->_stats;
+    } else {
+        _stats = {};
+
+        if constexpr(!allow_pass_culling) {
+            for(const auto& pass : _passes) {
+                _culling.add_side_effects(pass->_index);
+            }
+        }
+
+        _stats.culled_passes = _culling.cull();
+        _plan->_culling = std::move(_culling);
+    }
+
+    if(!_stats.culled_passes) {
+        return;
+    }
+
+    const FrameGraphCulling& culling = _plan->_culling;
+
+    auto cull_resources = [&](auto& resources) {
+        usize culled = 0;
+        for(auto&& [res, info] : resources) {
+            if(res.is_valid() && !info.is_prev && !info.is_persistent() && !culling.is_resource_alive(culling_key(res))) {
+                info.is_culled = true;
+                ++culled;
+            }
+        }
+        return culled;
+    };
+
+    // Resources, copies and clears are per frame, so they need to be culled even if the plan is already compiled
+    const usize culled_images = cull_resources(_images);
+    const usize culled_volumes = cull_resources(_volumes);
+    const usize culled_buffers = cull_resources(_buffers);
+
+    remove_culled(_image_copies, culling);
+    remove_culled(_buffer_copies, culling);
+    remove_culled(_image_clears, culling);
+
+    if(is_compiled) {
+        return;
+    }
+
+    for(const auto& pass : _passes) {
+        if(!culling.is_alive(pass->_index)) {
+            y_profile_msg(fmt_c_str("Culled pass: {}", pass->name()));
+        }
+    }
+
+    _stats.culled_images = culled_images;
+    _stats.culled_volumes = culled_volumes;
+    _stats.culled_buffers = culled_buffers;
+}
+
 void FrameGraph::alloc_resources() {
     y_profile();
 
@@ -366,10 +551,25 @@ void FrameGraph::alloc_resources() {
         }
     }
 
+    // Transient resources are placed in shared heaps, resources that are never alive at the same time can share memory
+    // Placement only has to be computed once per plan
+    const bool is_compiled = _plan->is_compiled();
+    FrameGraphHeapPacker packer;
+    auto can_be_placed = [](const ResourceCreateInfo& info) {
+        return allow_memory_aliasing && !info.is_persistent();
+    };
+
+    auto add_to_packer = [&](const ResourceCreateInfo& info, const VkMemoryRequirements& requirements) {
+        return packer.add_resource(requirements.size, requirements.alignment, requirements.memoryTypeBits, info.first_use, info.last_use());
+    };
+
     core::ScratchVector<std::pair<FrameGraphImageId, ImageCreateInfo>> images(_images.size());
-    std::copy_if(_images.begin(), _images.end(), std::back_inserter(images), [](const auto& p) { return p.first.is_valid(); });
+    std::copy_if(_images.begin(), _images.end(), std::back_inserter(images), [](const auto& p) { return p.first.is_valid() && !p.second.is_culled; });
     std::sort(images.begin(), images.end(), [](const auto& a, const auto& b) { return a.second.first_use < b.second.first_use; });
 
+    // Aliased images might be placed, so we need to wait for them to exist
+    core::ScratchVector<std::pair<FrameGraphImageId, FrameGraphImageId>> aliases(images.size());
+
     for(auto&& [res, info] : images) {
         if(info.is_prev) {
             y_debug_assert(_resources->is_alive(res));
@@ -378,18 +578,31 @@ void FrameGraph::alloc_resources() {
 
         if(info.alias.is_valid()) {
             y_debug_assert(allow_image_aliasing);
-            _resources->create_alias(res, info.alias);
+            aliases.emplace_back(res, info.alias);
         } else {
             if(!info.has_usage()) {
                 log_msg(fmt("Image declared by {} has no usage", pass_name(info.first_use)), Log::Warning);
                 // All images should support texturing, hopefully
                 info.usage = info.usage | ImageUsage::TextureBit;
             }
-            _resources->create_image(res, info.format, info.size.to<2>(), info.mips, info.usage, info.persistents);
+
+            if(can_be_placed(info)) {
+                if(!is_compiled) {
+                    const VkMemoryRequirements requirements = TransientImage::memory_requirements(info.format, info.usage, info.size.to<2>(), info.mips);
+                    _placed_images.emplace_back(PlacedResourceInfo<FrameGraphImageId>{info.first_use, res, add_to_packer(info, requirements)});
+                }
+                check_exists(_images, res).usage = info.usage;
+            } else {
+                _resources->create_image(res, info.format, info.size.to<2>(), info.mips, info.usage, info.persistents);
+            }
         }
     }
 
     for(auto&& [res, info] : _volumes) {
+        if(info.is_culled) {
+            continue;
+        }
+
         if(info.is_prev) {
             y_debug_assert(_resources->is_alive(res));
             continue;
@@ -401,11 +614,22 @@ void FrameGraph::alloc_resources() {
             // All images should support texturing, hopefully
             info.usage = info.usage | ImageUsage::TextureBit;
         }
-        _resources->create_volume(res, info.format, info.size, info.usage, info.persistents);
+
+        if(can_be_placed(info)) {
+            if(!is_compiled) {
+                const VkMemoryRequirements requirements = TransientVolume::memory_requirements(info.format, info.usage, info.size, 1);
+                _placed_volumes.emplace_back(PlacedResourceInfo<FrameGraphVolumeId>{info.first_use, res, add_to_packer(info, requirements)});
+            }
+        } else {
+            _resources->create_volume(res, info.format, info.size, info.usage, info.persistents);
+        }
     }
 
 
     auto init_buffer = [&](FrameGraphMutableBufferId& res, BufferCreateInfo& info, bool exact) {
+        if(info.is_culled) {
+            return true;
+        }
         if(info.is_prev) {
             y_debug_assert(_resources->is_alive(res));
             return true;
@@ -417,6 +641,16 @@ void FrameGraph::alloc_resources() {
             log_msg("Unused frame graph buffer resource", Log::Warning);
             info.usage = info.usage | BufferUsage::StorageBit;
         }
+
+        // Mapped buffers are uploaded before the frame starts, so they can not share memory
+        if(can_be_placed(info) && !is_cpu_visible(info.memory_type)) {
+            if(!is_compiled) {
+                const VkMemoryRequirements requirements = TransientBuffer::memory_requirements(info.byte_size, info.usage);
+                _placed_buffers.emplace_back(PlacedResourceInfo<FrameGraphBufferId>{info.first_use, res, add_to_packer(info, requirements)});
+            }
+            return true;
+        }
+
         return _resources->create_buffer(res, info.byte_size, info.usage, info.memory_type, info.persistents, exact);
     };
 
@@ -433,7 +667,238 @@ void FrameGraph::alloc_resources() {
         y_always_assert(init_buffer(res, info, false), "Unable to allocate buffer");
     }
 
-    _resources->init_staging_buffer();
+    if(!is_compiled) {
+        alloc_placed_resources(packer);
+    }
+
+    for(const auto& placed : _plan->_placed_images) {
+        _resources->set_image(placed.res, placed.resource);
+    }
+
+    for(const auto& placed : _plan->_placed_volumes) {
+        _resources->set_volume(placed.res, placed.resource);
+    }
+
+    for(const auto& placed : _plan->_placed_buffers) {
+        _resources->set_buffer(placed.res, placed.resource, check_exists(_buffers, placed.res).memory_type);
+    }
+
+    for(const auto& [res, alias] : aliases) {
+        _resources->create_alias(res, alias);
+    }
+}
+
+void FrameGraph::alloc_placed_resources(FrameGraphHeapPacker& packer) {
+    y_profile();
+
+    if(!packer.resource_count()) {
+        return;
+    }
+
+    packer.pack(device_properties().buffer_image_granularity);
+
+    const u64 frame_id = _resources->frame_id();
+    y_debug_assert(_plan->_heaps.is_empty());
+    for(const FrameGraphHeapPacker::Heap& heap : packer.heaps()) {
+        _plan->_heaps.emplace_back(_resources->_pool->create_heap(heap.byte_size, heap.alignment, heap.memory_type_bits));
+    }
+
+    auto heap = [&](const FrameGraphHeapPacker::Placement& placement) -> TransientHeap& {
+        return _plan->_heaps[placement.heap_index];
+    };
+
+    for(const auto& placed : _placed_images) {
+        const auto& info = check_exists(_images, placed.res);
+        const auto& placement = packer.placement(placed.packer_index);
+        _plan->_placed_images.push_back({placed.res, heap(placement).create_image(info.format, info.size.to<2>(), info.mips, info.usage, placement.offset, frame_id)});
+    }
+
+    for(const auto& placed : _placed_volumes) {
+        const auto& info = check_exists(_volumes, placed.res);
+        const auto& placement = packer.placement(placed.packer_index);
+        _plan->_placed_volumes.push_back({placed.res, heap(placement).create_volume(info.format, info.size, info.usage, placement.offset, frame_id)});
+    }
+
+    for(const auto& placed : _placed_buffers) {
+        const auto& info = check_exists(_buffers, placed.res);
+        const auto& placement = packer.placement(placed.packer_index);
+        _plan->_placed_buffers.push_back({placed.res, heap(placement).create_buffer(info.byte_size, info.usage, placement.offset, frame_id)});
+    }
+
+    // Aliasing barriers are emitted before the first use of each resource
+    const auto by_first_use = [](const auto& a, const auto& b) { return a.first_use < b.first_use; };
+    std::sort(_placed_images.begin(), _placed_images.end(), by_first_use);
+    std::sort(_placed_volumes.begin(), _placed_volumes.end(), by_first_use);
+    std::sort(_placed_buffers.begin(), _placed_buffers.end(), by_first_use);
+
+    _stats.placed_resources = packer.resource_count();
+    _stats.transient_memory = packer.heap_byte_size();
+    _stats.unaliased_transient_memory = packer.total_byte_size();
+    _stats.peak_transient_memory = packer.peak_byte_size();
+
+    y_profile_msg(fmt_c_str("Transient memory: {}KB (peak {}KB, {}KB without aliasing)", _stats.transient_memory / 1024, _stats.peak_transient_memory / 1024, _stats.unaliased_transient_memory / 1024));
+}
+
+void FrameGraph::compile_passes() {
+    y_profile();
+
+    y_debug_assert(_plan->_passes.is_empty());
+
+    usize image_copy_index = 0;
+    std::sort(_image_copies.begin(), _image_copies.end(), [&](const auto& a, const auto& b) { return a.pass_index < b.pass_index; });
+
+    usize buffer_copy_index = 0;
+    std::sort(_buffer_copies.begin(), _buffer_copies.end(), [&](const auto& a, const auto& b) { return a.pass_index < b.pass_index; });
+
+    usize image_clear_index = 0;
+    std::sort(_image_clears.begin(), _image_clears.end(), [&](const auto& a, const auto& b) { return a.pass_index < b.pass_index; });
+
+    usize placed_image_index = 0;
+    usize placed_volume_index = 0;
+    usize placed_buffer_index = 0;
+
+    using hash_t = std::hash<FrameGraphResourceId>;
+    core::FlatHashMap<FrameGraphBufferId, PipelineStage, hash_t> buffers_to_barrier;
+    core::FlatHashMap<FrameGraphVolumeId, PipelineStage, hash_t> volumes_to_barrier;
+    core::FlatHashMap<FrameGraphImageId, PipelineStage, hash_t> images_to_barrier;
+    buffers_to_barrier.set_min_capacity(_buffers.size());
+    volumes_to_barrier.set_min_capacity(_volumes.size());
+    images_to_barrier.set_min_capacity(_images.size());
+
+    // Framebuffers are only cached if their attachments live as long as the plan
+    auto is_placed = [&](FrameGraphImageId res) {
+        while(check_exists(_images, res).alias.is_valid()) {
+            res = check_exists(_images, res).alias;
+        }
+        return std::any_of(_plan->_placed_images.begin(), _plan->_placed_images.end(), [&](const auto& placed) { return placed.res == res; });
+    };
+
+    for(const auto& pass : _passes) {
+        if(!_plan->_culling.is_alive(pass->_index)) {
+            continue;
+        }
+
+        FrameGraphPlan::Pass& compiled = _plan->_passes.emplace_back();
+        compiled.index = pass->_index;
+
+        if constexpr(allow_memory_aliasing) {
+            compile_aliasing_barriers(_placed_buffers, placed_buffer_index, pass->_index, compiled.aliased_buffers);
+            compile_aliasing_barriers(_placed_volumes, placed_volume_index, pass->_index, compiled.aliased_volumes);
+            compile_aliasing_barriers(_placed_images, placed_image_index, pass->_index, compiled.aliased_images);
+        }
+
+        while(image_copy_index < _image_copies.size() && _image_copies[image_copy_index].pass_index == pass->_index) {
+            // copies between aliased images are dropped
+            compile_image_copy(compiled, _image_copies[image_copy_index].src, _image_copies[image_copy_index].dst, images_to_barrier, *_resources);
+            ++image_copy_index;
+        }
+
+        while(buffer_copy_index < _buffer_copies.size() && _buffer_copies[buffer_copy_index].pass_index == pass->_index) {
+            compile_buffer_copy(compiled, _buffer_copies[buffer_copy_index].src, _buffer_copies[buffer_copy_index].dst, buffers_to_barrier, pass->_buffers);
+            ++buffer_copy_index;
+        }
+
+        while(image_clear_index < _image_clears.size() && _image_clears[image_clear_index].pass_index == pass->_index) {
+            compile_image_clear(compiled, _image_clears[image_clear_index].dst, images_to_barrier);
+            ++image_clear_index;
+        }
+
+        compile_barriers(pass->_buffers, compiled.buffer_barriers, buffers_to_barrier);
+        compile_barriers(pass->_volumes, compiled.volume_barriers, volumes_to_barrier);
+        compile_barriers(pass->_images, compiled.image_barriers, images_to_barrier);
+
+        const bool has_attachments = pass->_depth.image.is_valid() || !pass->_colors.is_empty();
+        compiled.cache_framebuffer = has_attachments &&
+            (!pass->_depth.image.is_valid() || is_placed(pass->_depth.image)) &&
+            std::all_of(pass->_colors.begin(), pass->_colors.end(), [&](const auto& color) { return is_placed(color.image); });
+    }
+
+    _plan->_stats = _stats;
+    _plan->_is_compiled = true;
+}
+
+u64 FrameGraph::topology_hash() const {
+    y_profile();
+
+    u64 h = _culling.hash();
+    const auto combine = [&](u64 value) {
+        hash_combine(h, u64(hash_u64(value)));
+    };
+
+    const auto combine_resource = [&](FrameGraphResourceId res, const ResourceCreateInfo& info) {
+        combine(res.id());
+        combine(info.first_use);
+        combine(info.last_read);
+        combine(info.last_write);
+        combine(info.is_prev);
+        for(const FrameGraphPersistentResourceId persistent : info.persistents) {
+            combine(persistent.id());
+        }
+    };
+
+    const auto combine_image = [&](FrameGraphResourceId res, const ImageCreateInfo& info) {
+        combine_resource(res, info);
+        combine(u64(info.size.x()) << 32 | info.size.y());
+        combine(u64(info.size.z()) << 32 | info.mips);
+        combine(u64(info.format.vk_format()));
+        combine(u64(info.usage));
+        combine(u64(info.last_usage));
+        combine(info.copy_src.id());
+    };
+
+    // Pass resources are stored in hash maps, so their hash must not depend on the iteration order
+    const auto usage_hash = [](const auto& resources) {
+        u64 sum = 0;
+        for(const auto& [res, info] : resources) {
+            u64 r = hash_u64(res.id());
+            hash_combine(r, u64(hash_u64(u64(info.stage) << 1 | u64(info.written_to))));
+            sum += r;
+        }
+        return sum;
+    };
+
+    for(const auto& [res, info] : _images) {
+        combine_image(res, info);
+    }
+
+    for(const auto& [res, info] : _volumes) {
+        combine_image(res, info);
+    }
+
+    for(const auto& [res, info] : _buffers) {
+        combine_resource(res, info);
+        combine(info.byte_size);
+        combine(u64(info.usage));
+        combine(u64(info.memory_type));
+    }
+
+    for(const auto& copy : _image_copies) {
+        combine(copy.pass_index);
+        combine(u64(copy.dst.id()) << 32 | copy.src.id());
+    }
+
+    for(const auto& copy : _buffer_copies) {
+        combine(copy.pass_index);
+        combine(u64(copy.dst.id()) << 32 | copy.src.id());
+    }
+
+    for(const auto& clear : _image_clears) {
+        combine(clear.pass_index);
+        combine(clear.dst.id());
+    }
+
+    for(const auto& pass : _passes) {
+        combine(pass->_index);
+        combine(usage_hash(pass->_images));
+        combine(usage_hash(pass->_volumes));
+        combine(usage_hash(pass->_buffers));
+        combine(u64(pass->_depth.image.id()) << 32 | pass->_depth.mip);
+        for(const auto& color : pass->_colors) {
+            combine(u64(color.image.id()) << 32 | color.mip);
+        }
+    }
+
+    return h;
 }
 
 const core::String& FrameGraph::pass_name(usize pass_index) const {
@@ -502,6 +967,7 @@ std::pair<const TransientBuffer&, bool> FrameGraph::create_scratch_buffer(u64 by
 
 FrameGraphPass* FrameGraph::create_pass(std::string_view name) {
     auto pass = std::make_unique<FrameGraphPass>(name, this, ++_pass_index);
+    _culling.add_pass(pass->_index);
     FrameGraphPass* ptr = pass.get();
     _passes << std::move(pass);
     return ptr;
@@ -576,6 +1042,7 @@ void FrameGraph::register_usage(FrameGraphImageId res, ImageUsage usage, bool is
     const bool is_last = info.last_use() < pass->_index;
     info.last_usage = is_last ? usage : (info.last_usage | usage);
     info.register_use(pass->_index, is_written);
+    _culling.add_use(pass->_index, culling_key(res), is_written);
 }
 
 void FrameGraph::register_usage(FrameGraphVolumeId res, ImageUsage usage, bool is_written, const FrameGraphPass* pass) {
@@ -588,6 +1055,7 @@ void FrameGraph::register_usage(FrameGraphVolumeId res, ImageUsage usage, bool i
     const bool is_last = info.last_use() < pass->_index;
     info.last_usage = is_last ? usage : (info.last_usage | usage);
     info.register_use(pass->_index, is_written);
+    _culling.add_use(pass->_index, culling_key(res), is_written);
 }
 
 void FrameGraph::register_usage(FrameGraphBufferId res, BufferUsage usage, bool is_written, const FrameGraphPass* pass) {
@@ -598,6 +1066,7 @@ void FrameGraph::register_usage(FrameGraphBufferId res, BufferUsage usage, bool
     info.usage = info.usage | usage;
 
     info.register_use(pass->_index, is_written);
+    _culling.add_use(pass->_index, culling_key(res), is_written);
 }
 
 void FrameGraph::register_image_copy(FrameGraphMutableImageId dst, FrameGraphImageId src, const FrameGraphPass* pass) {
@@ -640,6 +1109,7 @@ static auto& alloc_prev(C& c, T new_res) {
 
 FrameGraphImageId FrameGraph::make_persistent_and_get_prev(FrameGraphImageId res, FrameGraphPersistentResourceId persistent_id) {
     make_persistent(_images, _persistents, res, persistent_id);
+    _culling.add_output(culling_key(res));
 
     if(!_resources->has_prev_image(persistent_id)) {
         return {};
@@ -661,6 +1131,7 @@ FrameGraphImageId FrameGraph::make_persistent_and_get_prev(FrameGraphImageId res
 
 FrameGraphBufferId FrameGraph::make_persistent_and_get_prev(FrameGraphBufferId res, FrameGraphPersistentResourceId persistent_id) {
     make_persistent(_buffers, _persistents, res, persistent_id);
+    _culling.add_output(culling_key(res));
 
     if(!_resources->has_prev_buffer(persistent_id)) {
         return {};
@@ -706,6 +1177,11 @@ void FrameGraph::map_buffer(FrameGraphMutableBufferId res, const FrameGraphPass*
     info.usage = info.usage | BufferUsage::TransferDstBit;
     info.memory_type = MemoryType::Staging;
     info.register_use(pass->_index, true);
+    _culling.add_use(pass->_index, culling_key(res), true);
+}
+
+void FrameGraph::register_side_effects(const FrameGraphPass* pass) {
+    _culling.add_side_effects(pass->_index);
 }
 
 bool FrameGraph::is_attachment(FrameGraphImageId res) const {
@@ -23,6 +23,8 @@ SOFTWARE.
 #define YAVE_FRAMEGRAPH_FRAMEGRAPH_H
 
 #include "FrameGraphPassBuilder.h"
+#include "FrameGraphCulling.h"
+#include "FrameGraphHeapPacker.h"
 
 #include <y/core/Vector.h>
 #include <y/core/String.h>
@@ -61,6 +63,7 @@ class FrameGraph : NonMovable {
 
         core::SmallVector<FrameGraphPersistentResourceId, 4> persistents;  // Persistent
         bool is_prev = false;
+        bool is_culled = false;
 
         bool is_persistent() const;
         usize last_use() const;
@@ -105,6 +108,13 @@ class FrameGraph : NonMovable {
         FrameGraphBufferId src;
     };
 
+    template<typename T>
+    struct PlacedResourceInfo {
+        usize first_use = 0;
+        T res;
+        usize packer_index = 0;
+    };
+
     struct InlineStorage {
         InlineStorage(usize size) : storage(size) {}
 
@@ -113,17 +123,34 @@ class FrameGraph : NonMovable {
     };
 
     static constexpr bool allow_image_aliasing = true;
+    static constexpr bool allow_pass_culling = true;
+    static constexpr bool allow_memory_aliasing = true;
 
     public:
+        struct CompileStats {
+            usize culled_passes = 0;
+            usize culled_images = 0;
+            usize culled_volumes = 0;
+            usize culled_buffers = 0;
+
+            // Transient resources placed in shared heaps
+            usize placed_resources = 0;
+            u64 transient_memory = 0;
+            u64 unaliased_transient_memory = 0;
+            u64 peak_transient_memory = 0;
+        };
+
         FrameGraph(std::shared_ptr<FrameGraphResourcePool> pool);
         ~FrameGraph();
 
         u64 frame_id() const;
         const FrameGraphFrameResources& resources() const;
+        const CompileStats& compile_stats() const;
 
         FrameGraphRegion region(std::string_view name);
 
-        void render(CmdBufferRecorder& recorder, CmdTimestampPool* ts_pool = nullptr);
+        // If job_system is not null, parallel passes are recorded on it into secondary cmd buffers
+        void render(CmdBufferRecorder& recorder, CmdTimestampPool* ts_pool = nullptr, concurrent::JobSystem* job_system = nullptr);
 
         FrameGraphPassBuilder add_pass(std::string_view name);
         FrameGraphComputePassBuilder add_compute_pass(std::string_view name);
@@ -189,6 +216,8 @@ class FrameGraph : NonMovable {
 
         void map_buffer(FrameGraphMutableBufferId res, const FrameGraphPass* pass);
 
+        void register_side_effects(const FrameGraphPass* pass);
+
         bool is_attachment(FrameGraphImageId res) const;
 
     private:
@@ -196,9 +225,15 @@ class FrameGraph : NonMovable {
 
         FrameGraphPass* create_pass(std::string_view name);
 
+        u64 topology_hash() const;
+
+        void cull_passes();
         void alloc_resources();
+        void alloc_placed_resources(FrameGraphHeapPacker& packer);
+        void compile_passes();
 
         std::unique_ptr<FrameGraphFrameResources> _resources;
+        std::unique_ptr<FrameGraphPlan> _plan;
 
         core::Vector<std::unique_ptr<FrameGraphPass>> _passes;
 
@@ -219,6 +254,13 @@ class FrameGraph : NonMovable {
 
         core::Vector<FrameGraphResourceId> _persistents;
 
+        FrameGraphCulling _culling;
+        CompileStats _stats;
+
+        core::Vector<PlacedResourceInfo<FrameGraphImageId>> _placed_images;
+        core::Vector<PlacedResourceInfo<FrameGraphVolumeId>> _placed_volumes;
+        core::Vector<PlacedResourceInfo<FrameGraphBufferId>> _placed_buffers;
+
 };
 
 }
@@ -0,0 +1,145 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "FrameGraphCulling.h"
+
+#include <y/utils/hash.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace yave {
+
+void FrameGraphCulling::add_pass(usize pass_index) {
+    _passes.set_min_size(pass_index + 1);
+}
+
+void FrameGraphCulling::add_side_effects(usize pass_index) {
+    add_pass(pass_index);
+    _passes[pass_index].side_effects = true;
+}
+
+void FrameGraphCulling::add_use(usize pass_index, ResourceKey res, bool is_written) {
+    add_pass(pass_index);
+    _passes[pass_index].has_writes |= is_written;
+    _uses.emplace_back(Use{res, pass_index, is_written});
+}
+
+void FrameGraphCulling::add_output(ResourceKey res) {
+    _outputs.push_back(res);
+}
+
+usize FrameGraphCulling::cull() {
+    y_profile();
+
+    std::sort(_uses.begin(), _uses.end(), [](const Use& a, const Use& b) {
+        return std::tie(a.res, a.pass_index) < std::tie(b.res, b.pass_index);
+    });
+
+    const auto uses_of = [&](ResourceKey res) {
+        const auto begin = std::lower_bound(_uses.begin(), _uses.end(), res, [](const Use& u, ResourceKey r) { return u.res < r; });
+        const auto end = std::upper_bound(begin, _uses.end(), res, [](ResourceKey r, const Use& u) { return r < u.res; });
+        return core::Span<Use>(begin, end - begin);
+    };
+
+    core::Vector<usize> to_visit;
+    const auto mark_alive = [&](usize pass_index) {
+        PassInfo& pass = _passes[pass_index];
+        if(!pass.alive) {
+            pass.alive = true;
+            to_visit.push_back(pass_index);
+        }
+    };
+
+    for(usize i = 0; i != _passes.size(); ++i) {
+        // Passes that write nothing the graph knows about can only be useful through their side effects
+        if(_passes[i].side_effects || !_passes[i].has_writes) {
+            mark_alive(i);
+        }
+    }
+
+    for(const ResourceKey res : _outputs) {
+        for(const Use& use : uses_of(res)) {
+            if(use.is_written) {
+                mark_alive(use.pass_index);
+            }
+        }
+    }
+
+    core::Vector<usize> by_pass(_uses.size(), 0);
+    std::iota(by_pass.begin(), by_pass.end(), 0);
+    std::stable_sort(by_pass.begin(), by_pass.end(), [&](usize a, usize b) { return _uses[a].pass_index < _uses[b].pass_index; });
+
+    // Every pass that wrote to a resource before a live pass used it is live too
+    while(!to_visit.is_empty()) {
+        const usize pass_index = to_visit.pop();
+        const auto first = std::lower_bound(by_pass.begin(), by_pass.end(), pass_index, [&](usize u, usize p) { return _uses[u].pass_index < p; });
+        for(auto it = first; it != by_pass.end() && _uses[*it].pass_index == pass_index; ++it) {
+            for(const Use& other : uses_of(_uses[*it].res)) {
+                if(other.pass_index >= pass_index) {
+                    break;
+                }
+                if(other.is_written) {
+                    mark_alive(other.pass_index);
+                }
+            }
+        }
+    }
+
+    _alive_resources.make_empty();
+    for(const Use& use : _uses) {
+        if(_passes[use.pass_index].alive && (_alive_resources.is_empty() || _alive_resources.last() != use.res)) {
+            _alive_resources.push_back(use.res);
+        }
+    }
+
+    return std::count_if(_passes.begin(), _passes.end(), [](const PassInfo& p) { return !p.alive; });
+}
+
+bool FrameGraphCulling::is_alive(usize pass_index) const {
+    return pass_index < _passes.size() && _passes[pass_index].alive;
+}
+
+bool FrameGraphCulling::is_resource_alive(ResourceKey res) const {
+    return std::binary_search(_alive_resources.begin(), _alive_resources.end(), res);
+}
+
+usize FrameGraphCulling::pass_count() const {
+    return _passes.size();
+}
+
+u64 FrameGraphCulling::hash() const {
+    u64 h = hash_u64(_passes.size());
+    for(const PassInfo& pass : _passes) {
+        hash_combine(h, u64(pass.side_effects));
+    }
+    for(const Use& use : _uses) {
+        hash_combine(h, u64(hash_u64(use.res)));
+        hash_combine(h, u64(use.pass_index << 1 | use.is_written));
+    }
+    for(const ResourceKey res : _outputs) {
+        hash_combine(h, u64(hash_u64(res)));
+    }
+    return h;
+}
+
+}
@@ -0,0 +1,77 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_FRAMEGRAPH_FRAMEGRAPHCULLING_H
+#define YAVE_FRAMEGRAPH_FRAMEGRAPHCULLING_H
+
+#include <yave/yave.h>
+
+#include <y/core/Vector.h>
+
+namespace yave {
+
+// Pure CPU dependency graph used to find passes that do not contribute to any output.
+// Passes are identified by their index in the frame graph, resources by an opaque key.
+class FrameGraphCulling : NonCopyable {
+    public:
+        using ResourceKey = u64;
+
+        FrameGraphCulling() = default;
+
+        void add_pass(usize pass_index);
+        void add_side_effects(usize pass_index);
+        void add_use(usize pass_index, ResourceKey res, bool is_written);
+        void add_output(ResourceKey res);
+
+        // Walks the graph backward from outputs and side effects, returns the number of culled passes
+        usize cull();
+
+        bool is_alive(usize pass_index) const;
+        bool is_resource_alive(ResourceKey res) const;
+
+        usize pass_count() const;
+
+        // Hash of the graph inputs, graphs with the same hash cull the same passes
+        u64 hash() const;
+
+    private:
+        struct Use {
+            ResourceKey res = 0;
+            usize pass_index = 0;
+            bool is_written = false;
+        };
+
+        struct PassInfo {
+            bool side_effects = false;
+            bool has_writes = false;
+            bool alive = false;
+        };
+
+        core::Vector<PassInfo> _passes;
+        core::Vector<Use> _uses;
+        core::Vector<ResourceKey> _outputs;
+
+        core::Vector<ResourceKey> _alive_resources;
+};
+
+}
+
+#endif // YAVE_FRAMEGRAPH_FRAMEGRAPHCULLING_H
@@ -68,6 +68,14 @@ FrameGraphDescriptorBinding FrameGraphDescriptorBinding::create_uniform_binding(
     return FrameGraphDescriptorBinding(BindingType::InputImage, res, sampler);
 }
 
+bool FrameGraphDescriptorBinding::is_external_storage() const {
+    if(_type != BindingType::External) {
+        return false;
+    }
+    const VkDescriptorType type = _external.vk_descriptor_type();
+    return type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER || type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+}
+
 Descriptor FrameGraphDescriptorBinding::create_descriptor(const FrameGraphFrameResources& resources) const {
     switch(_type) {
         case BindingType::External:
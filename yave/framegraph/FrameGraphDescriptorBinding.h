@@ -57,6 +57,9 @@ class FrameGraphDescriptorBinding {
 
         Descriptor create_descriptor(const FrameGraphFrameResources& resources) const;
 
+        // Raw storage descriptors might be written to by the pass
+        bool is_external_storage() const;
+
     private:
         FrameGraphDescriptorBinding(BindingType type, FrameGraphBufferId res);
         FrameGraphDescriptorBinding(BindingType type, FrameGraphVolumeId res, SamplerType sampler = SamplerType::LinearRepeat);
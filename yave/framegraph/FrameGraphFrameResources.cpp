@@ -26,7 +26,7 @@ SOFTWARE.
 #include <yave/graphics/commands/CmdBufferRecorder.h>
 #include <yave/graphics/buffers/Buffer.h>
 #include <yave/graphics/device/DeviceProperties.h>
-#include <yave/graphics/device/DebugUtils.h>
+#include <yave/graphics/device/UploadRing.h>
 
 #include <y/utils/memory.h>
 
@@ -64,53 +64,64 @@ u32 FrameGraphFrameResources::create_buffer_id() {
     return _next_buffer_id++;
 }
 
-void FrameGraphFrameResources::init_staging_buffer() {
+void FrameGraphFrameResources::init_staging_buffer(const CmdBufferRecorderBase& recorder) {
     y_profile();
     
     if(_staging_buffer_len) {
-        _staging_buffer = StagingBuffer(_staging_buffer_len);
-
-#ifdef Y_DEBUG
-        if(const auto* debug = debug_utils()) {
-            debug->set_resource_name(_staging_buffer.vk_buffer(), "Frame graph staging buffer");
-        }
-#endif
+        _staging_buffer = upload_ring().allocate(recorder, _staging_buffer_len);
     }
 }
 
-void FrameGraphFrameResources::create_image(FrameGraphImageId res, TransientImage&& image, core::Span<FrameGraphPersistentResourceId> persistent_ids) {
+void FrameGraphFrameResources::set_image(FrameGraphImageId res, TransientImage* image) {
     res.check_valid();
-    y_debug_assert(!image.is_null());
-
-    auto* ptr = &_image_storage.emplace_back(std::move(image), persistent_ids).first;
+    y_debug_assert(!image->is_null());
 
     _images.set_min_size(res.id() + 1);
     y_always_assert(!_images[res.id()], "Image already exists");
-    _images[res.id()] = ptr;
+    _images[res.id()] = image;
 }
 
-void FrameGraphFrameResources::create_volume(FrameGraphVolumeId res, TransientVolume&& volume, core::Span<FrameGraphPersistentResourceId> persistent_ids) {
+void FrameGraphFrameResources::set_volume(FrameGraphVolumeId res, TransientVolume* volume) {
     res.check_valid();
-    y_debug_assert(!volume.is_null());
-
-    auto* ptr = &_volume_storage.emplace_back(std::move(volume), persistent_ids).first;
+    y_debug_assert(!volume->is_null());
 
     _volumes.set_min_size(res.id() + 1);
     y_always_assert(!_volumes[res.id()], "Volume already exists");
-    _volumes[res.id()] = ptr;
+    _volumes[res.id()] = volume;
 }
 
-FrameGraphFrameResources::BufferData& FrameGraphFrameResources::create_buffer(FrameGraphBufferId res, TransientBuffer&& buffer, core::Span<FrameGraphPersistentResourceId> persistent_ids) {
+FrameGraphFrameResources::BufferData& FrameGraphFrameResources::set_buffer(FrameGraphBufferId res, TransientBuffer* buffer, MemoryType memory) {
     res.check_valid();
-    y_debug_assert(!buffer.is_null());
-
-    auto* ptr = &_buffer_storage.emplace_back(std::move(buffer), persistent_ids).first;
+    y_debug_assert(!buffer->is_null());
 
     _buffers.set_min_size(res.id() + 1);
     y_always_assert(!_buffers[res.id()].buffer, "Buffer already exists");
-    _buffers[res.id()].buffer = ptr;
 
-    return _buffers[res.id()];
+    BufferData& data = _buffers[res.id()];
+    data.buffer = buffer;
+
+    if(is_cpu_visible(memory)) {
+        y_debug_assert(_staging_buffer.is_null());
+        data.staging_buffer_offset = _staging_buffer_len;
+        _staging_buffer_len += align_up_to(buffer->exposed_byte_size(), device_properties().non_coherent_atom_size);
+    }
+
+    return data;
+}
+
+void FrameGraphFrameResources::create_image(FrameGraphImageId res, TransientImage&& image, core::Span<FrameGraphPersistentResourceId> persistent_ids) {
+    y_debug_assert(!image.is_null());
+    set_image(res, &_image_storage.emplace_back(std::move(image), persistent_ids).first);
+}
+
+void FrameGraphFrameResources::create_volume(FrameGraphVolumeId res, TransientVolume&& volume, core::Span<FrameGraphPersistentResourceId> persistent_ids) {
+    y_debug_assert(!volume.is_null());
+    set_volume(res, &_volume_storage.emplace_back(std::move(volume), persistent_ids).first);
+}
+
+FrameGraphFrameResources::BufferData& FrameGraphFrameResources::create_buffer(FrameGraphBufferId res, TransientBuffer&& buffer, core::Span<FrameGraphPersistentResourceId> persistent_ids) {
+    y_debug_assert(!buffer.is_null());
+    return set_buffer(res, &_buffer_storage.emplace_back(std::move(buffer), persistent_ids).first, MemoryType::DeviceLocal);
 }
 
 void FrameGraphFrameResources::create_image(FrameGraphImageId res, ImageFormat format, const math::Vec2ui& size, u32 mips, ImageUsage usage, core::Span<FrameGraphPersistentResourceId> persistent_ids) {
@@ -127,14 +138,7 @@ bool FrameGraphFrameResources::create_buffer(FrameGraphBufferId res, u64 byte_si
         return false;
     }
 
-    const u64 transient_byte_size = transient.exposed_byte_size();
-    BufferData& buffer = create_buffer(res, std::move(transient), persistent_ids);
-
-    if(is_cpu_visible(memory)) {
-        y_debug_assert(_staging_buffer.is_null());
-        buffer.staging_buffer_offset = _staging_buffer_len;
-        _staging_buffer_len += align_up_to(transient_byte_size, device_properties().non_coherent_atom_size);
-    }
+    set_buffer(res, &_buffer_storage.emplace_back(std::move(transient), persistent_ids).first, memory);
 
     return true;
 }
@@ -184,6 +188,18 @@ BufferBarrier FrameGraphFrameResources::barrier(FrameGraphBufferId res, Pipeline
     return BufferBarrier(*_buffers[res.id()].buffer, src, dst);
 }
 
+ImageBarrier FrameGraphFrameResources::aliasing_barrier(FrameGraphImageId res) const {
+    return ImageBarrier::aliasing_barrier(find(res));
+}
+
+ImageBarrier FrameGraphFrameResources::aliasing_barrier(FrameGraphVolumeId res) const {
+    return ImageBarrier::aliasing_barrier(find(res));
+}
+
+BufferBarrier FrameGraphFrameResources::aliasing_barrier(FrameGraphBufferId res) const {
+    return BufferBarrier::aliasing_barrier(find(res));
+}
+
 const ImageBase& FrameGraphFrameResources::image_base(FrameGraphImageId res) const {
     return find(res);
 }
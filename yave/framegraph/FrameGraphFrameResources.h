@@ -59,6 +59,10 @@ class FrameGraphFrameResources final : NonMovable {
         ImageBarrier barrier(FrameGraphVolumeId res, PipelineStage src, PipelineStage dst) const;
         BufferBarrier barrier(FrameGraphBufferId res, PipelineStage src, PipelineStage dst) const;
 
+        ImageBarrier aliasing_barrier(FrameGraphImageId res) const;
+        ImageBarrier aliasing_barrier(FrameGraphVolumeId res) const;
+        BufferBarrier aliasing_barrier(FrameGraphBufferId res) const;
+
         const ImageBase& image_base(FrameGraphImageId res) const;
         const ImageBase& volume_base(FrameGraphVolumeId res) const;
         const BufferBase& buffer_base(FrameGraphBufferId res) const;
@@ -96,7 +100,7 @@ class FrameGraphFrameResources final : NonMovable {
     private:
         friend class FrameGraph;
 
-        void init_staging_buffer();
+        void init_staging_buffer(const CmdBufferRecorderBase& recorder);
 
         u32 create_image_id();
         u32 create_volume_id();
@@ -129,6 +133,10 @@ class FrameGraphFrameResources final : NonMovable {
         void create_volume(FrameGraphVolumeId res, TransientVolume&& volume, core::Span<FrameGraphPersistentResourceId> persistent_ids);
         BufferData& create_buffer(FrameGraphBufferId res, TransientBuffer&& buffer, core::Span<FrameGraphPersistentResourceId> persistent_ids);
 
+        void set_image(FrameGraphImageId res, TransientImage* image);
+        void set_volume(FrameGraphVolumeId res, TransientVolume* volume);
+        BufferData& set_buffer(FrameGraphBufferId res, TransientBuffer* buffer, MemoryType memory);
+
         StagingSubBuffer staging_buffer(FrameGraphMutableBufferId res) const;
         StagingSubBuffer staging_buffer(const BufferData& buffer) const;
 
@@ -147,7 +155,7 @@ class FrameGraphFrameResources final : NonMovable {
         std::deque<std::pair<TransientVolume, core::FixedArray<FrameGraphPersistentResourceId>>> _volume_storage;
         std::deque<std::pair<TransientBuffer, core::FixedArray<FrameGraphPersistentResourceId>>> _buffer_storage;
 
-        StagingBuffer _staging_buffer;
+        StagingSubBuffer _staging_buffer;
         u64 _staging_buffer_len = 0;
 };
 
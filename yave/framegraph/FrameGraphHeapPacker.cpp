@@ -0,0 +1,152 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "FrameGraphHeapPacker.h"
+
+#include <y/utils/memory.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace yave {
+
+usize FrameGraphHeapPacker::add_resource(u64 byte_size, u64 alignment, u32 memory_type_bits, usize first_use, usize last_use) {
+    y_debug_assert(first_use <= last_use);
+    y_debug_assert(memory_type_bits);
+
+    const usize index = _resources.size();
+    _resources.emplace_back(Resource{byte_size, std::max(alignment, u64(1)), memory_type_bits, first_use, last_use});
+    return index;
+}
+
+void FrameGraphHeapPacker::pack(u64 min_alignment) {
+    y_profile();
+
+    _heaps.make_empty();
+    _placements.make_empty();
+    _placements.set_min_size(_resources.size());
+
+    // Place biggest resources first, they are the hardest to fit
+    core::Vector<usize> order(_resources.size(), 0);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](usize a, usize b) {
+        return std::tie(_resources[b].byte_size, _resources[a].first_use) < std::tie(_resources[a].byte_size, _resources[b].first_use);
+    });
+
+    const auto overlaps = [](const Resource& a, const Resource& b) {
+        return a.first_use <= b.last_use && b.first_use <= a.last_use;
+    };
+
+    core::Vector<std::pair<u64, u64>> occupied;
+    core::Vector<usize> placed;
+    for(const usize index : order) {
+        const Resource& res = _resources[index];
+        const u64 alignment = std::max(res.alignment, min_alignment);
+
+        usize heap_index = 0;
+        for(; heap_index != _heaps.size(); ++heap_index) {
+            if(_heaps[heap_index].memory_type_bits & res.memory_type_bits) {
+                break;
+            }
+        }
+
+        if(heap_index == _heaps.size()) {
+            _heaps.emplace_back(Heap{0, 1, res.memory_type_bits});
+        }
+
+        // Collect the memory ranges used by resources alive at the same time in this heap
+        occupied.make_empty();
+        for(const usize other : placed) {
+            if(_placements[other].heap_index == heap_index && overlaps(res, _resources[other])) {
+                occupied.emplace_back(_placements[other].offset, _placements[other].offset + _resources[other].byte_size);
+            }
+        }
+        std::sort(occupied.begin(), occupied.end());
+
+        // First fit
+        u64 offset = 0;
+        for(const auto& [begin, end] : occupied) {
+            if(align_up_to(offset, alignment) + res.byte_size <= begin) {
+                break;
+            }
+            offset = std::max(offset, end);
+        }
+        offset = align_up_to(offset, alignment);
+
+        Heap& heap = _heaps[heap_index];
+        heap.byte_size = std::max(heap.byte_size, offset + res.byte_size);
+        heap.alignment = std::max(heap.alignment, alignment);
+        heap.memory_type_bits &= res.memory_type_bits;
+
+        _placements[index] = Placement{heap_index, offset};
+        placed.push_back(index);
+    }
+}
+
+const FrameGraphHeapPacker::Placement& FrameGraphHeapPacker::placement(usize index) const {
+    y_debug_assert(index < _placements.size());
+    return _placements[index];
+}
+
+core::Span<FrameGraphHeapPacker::Heap> FrameGraphHeapPacker::heaps() const {
+    return _heaps;
+}
+
+usize FrameGraphHeapPacker::resource_count() const {
+    return _resources.size();
+}
+
+u64 FrameGraphHeapPacker::heap_byte_size() const {
+    u64 total = 0;
+    for(const Heap& heap : _heaps) {
+        total += heap.byte_size;
+    }
+    return total;
+}
+
+u64 FrameGraphHeapPacker::total_byte_size() const {
+    u64 total = 0;
+    for(const Resource& res : _resources) {
+        total += res.byte_size;
+    }
+    return total;
+}
+
+u64 FrameGraphHeapPacker::peak_byte_size() const {
+    // Resources are released after their last use, so ends are processed before begins of the following passes
+    core::Vector<std::pair<usize, i64>> events;
+    for(const Resource& res : _resources) {
+        events.emplace_back(res.first_use * 2 + 1, i64(res.byte_size));
+        events.emplace_back(res.last_use * 2 + 2, -i64(res.byte_size));
+    }
+    std::sort(events.begin(), events.end());
+
+    i64 current = 0;
+    i64 peak = 0;
+    for(const auto& [time, size] : events) {
+        current += size;
+        peak = std::max(peak, current);
+    }
+    return u64(peak);
+}
+
+}
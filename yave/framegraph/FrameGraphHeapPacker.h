@@ -0,0 +1,85 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_FRAMEGRAPH_FRAMEGRAPHHEAPPACKER_H
+#define YAVE_FRAMEGRAPH_FRAMEGRAPHHEAPPACKER_H
+
+#include <yave/yave.h>
+
+#include <y/core/Vector.h>
+#include <y/core/Span.h>
+
+namespace yave {
+
+// Pure CPU interval packing used to place transient resources in shared heaps.
+// Resources whose lifetimes ([first_use, last_use], in pass indices) do not overlap can share memory.
+class FrameGraphHeapPacker : NonCopyable {
+    public:
+        struct Heap {
+            u64 byte_size = 0;
+            u64 alignment = 1;
+            u32 memory_type_bits = 0;
+        };
+
+        struct Placement {
+            usize heap_index = 0;
+            u64 offset = 0;
+        };
+
+        FrameGraphHeapPacker() = default;
+
+        // Returns the index of the resource, used to query its placement
+        usize add_resource(u64 byte_size, u64 alignment, u32 memory_type_bits, usize first_use, usize last_use);
+
+        // min_alignment is applied to every resource, to avoid buffer/image granularity conflicts
+        void pack(u64 min_alignment = 1);
+
+        const Placement& placement(usize index) const;
+        core::Span<Heap> heaps() const;
+
+        usize resource_count() const;
+
+        // Sum of the sizes of all heaps
+        u64 heap_byte_size() const;
+
+        // Memory needed if no resources were aliased
+        u64 total_byte_size() const;
+
+        // Maximum amount of memory used by resources alive at the same time
+        u64 peak_byte_size() const;
+
+    private:
+        struct Resource {
+            u64 byte_size = 0;
+            u64 alignment = 1;
+            u32 memory_type_bits = 0;
+            usize first_use = 0;
+            usize last_use = 0;
+        };
+
+        core::Vector<Resource> _resources;
+        core::Vector<Placement> _placements;
+        core::Vector<Heap> _heaps;
+};
+
+}
+
+#endif // YAVE_FRAMEGRAPH_FRAMEGRAPHHEAPPACKER_H
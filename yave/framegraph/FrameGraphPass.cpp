@@ -44,10 +44,10 @@ const FrameGraphFrameResources& FrameGraphPass::resources() const {
 }
 
 const Framebuffer& FrameGraphPass::framebuffer() const {
-    if(_framebuffer.is_null()) {
+    if(!_framebuffer || _framebuffer->is_null()) {
         y_fatal("Pass has no framebuffer");
     }
-    return _framebuffer;
+    return *_framebuffer;
 }
 
 DescriptorSetProxy FrameGraphPass::descriptor_set(usize index) const {
@@ -56,19 +56,45 @@ DescriptorSetProxy FrameGraphPass::descriptor_set(usize index) const {
 
 void FrameGraphPass::render(CmdBufferRecorder& recorder) {
     if(_compute_render) {
-        y_debug_assert(!_render);
+        y_debug_assert(!_render && !_parallel_render);
         _compute_render(recorder, this);
     } else if(_render) {
-        y_debug_assert(!_compute_render);
-        y_debug_assert(!_framebuffer.is_null());
-        RenderPassRecorder render_pass = recorder.bind_framebuffer(_framebuffer);
+        y_debug_assert(!_compute_render && !_parallel_render);
+        RenderPassRecorder render_pass = recorder.bind_framebuffer(framebuffer());
         _render(render_pass, this);
+    } else if(_parallel_render) {
+        y_debug_assert(!_compute_render && !_render);
+        RenderPassRecorder render_pass = recorder.bind_framebuffer(framebuffer());
+        for(usize i = 0; i != _split_count; ++i) {
+            _parallel_render(render_pass, this, i);
+        }
     }
 }
 
-void FrameGraphPass::init_framebuffer(const FrameGraphFrameResources& resources) {
+bool FrameGraphPass::is_parallel() const {
+    return _parallel_render != nullptr;
+}
+
+usize FrameGraphPass::split_count() const {
+    return _split_count;
+}
+
+void FrameGraphPass::render_split(CmdBufferRecorder& secondary, usize split_index) const {
+    y_debug_assert(is_parallel());
+    y_debug_assert(split_index < _split_count);
+
+    RenderPassRecorder render_pass = secondary.bind_framebuffer(framebuffer());
+    _parallel_render(render_pass, this, split_index);
+}
+
+void FrameGraphPass::init_framebuffer(const FrameGraphFrameResources& resources, Framebuffer* cached) {
     y_profile();
 
+    if(cached && !cached->is_null()) {
+        _framebuffer = cached;
+        return;
+    }
+
     if(_depth.image.is_valid() || _colors.size()) {
         auto declared_here = [&](FrameGraphImageId id) {
             const auto& info = _parent->info(id);
@@ -97,12 +123,14 @@ void FrameGraphPass::init_framebuffer(const FrameGraphFrameResources& resources)
             colors[i] = Framebuffer::ColorAttachment(resources.image<ImageUsage::ColorBit>(_colors[i].image), declared_here(_colors[i].image) ? Framebuffer::LoadOp::Clear : Framebuffer::LoadOp::Load);
             set_image_name(_colors[i].image, "RT");
         }
-        _framebuffer = Framebuffer(depth, colors);
+        Framebuffer& storage = cached ? *cached : _frame_framebuffer;
+        storage = Framebuffer(depth, colors);
+        _framebuffer = &storage;
 
 #ifdef Y_DEBUG
         if(const auto* debug = debug_utils()) {
-            debug->set_resource_name(_framebuffer.vk_framebuffer(), fmt_c_str("{} Framebuffer", _name));
-            debug->set_resource_name(_framebuffer.render_pass().vk_render_pass(), fmt_c_str("{} RenderPass", _name));
+            debug->set_resource_name(storage.vk_framebuffer(), fmt_c_str("{} Framebuffer", _name));
+            debug->set_resource_name(storage.render_pass().vk_render_pass(), fmt_c_str("{} RenderPass", _name));
         }
 #endif
     }
@@ -49,6 +49,7 @@ class FrameGraphPass final : NonMovable {
 
         using render_func = std::function<void(RenderPassRecorder&, const FrameGraphPass*)>;
         using compute_render_func = std::function<void(CmdBufferRecorder&, const FrameGraphPass*)>;
+        using parallel_render_func = std::function<void(RenderPassRecorder&, const FrameGraphPass*, usize)>;
 
         FrameGraphPass(std::string_view name, FrameGraph* parent, usize index);
 
@@ -60,11 +61,18 @@ class FrameGraphPass final : NonMovable {
 
         void render(CmdBufferRecorder& recorder);
 
+        bool is_parallel() const;
+        usize split_count() const;
+
+        // Records a single split into a secondary cmd buffer created for framebuffer(), can be called concurrently
+        void render_split(CmdBufferRecorder& secondary, usize split_index) const;
+
     private:
         friend class FrameGraph;
         friend class FrameGraphPassBuilderBase;
 
-        void init_framebuffer(const FrameGraphFrameResources& resources);
+        // If cached is not null, the framebuffer is stored there and reused as long as it isn't null
+        void init_framebuffer(const FrameGraphFrameResources& resources, Framebuffer* cached);
         void init_descriptor_sets(const FrameGraphFrameResources& resources);
 
         ResourceUsageInfo& info(FrameGraphImageId res);
@@ -73,6 +81,8 @@ class FrameGraphPass final : NonMovable {
 
         render_func _render = nullptr;
         compute_render_func _compute_render = nullptr;
+        parallel_render_func _parallel_render = nullptr;
+        usize _split_count = 0;
 
         core::String _name;
 
@@ -92,7 +102,8 @@ class FrameGraphPass final : NonMovable {
         Attachment _depth;
         core::SmallVector<Attachment, 6> _colors;
 
-        Framebuffer _framebuffer;
+        const Framebuffer* _framebuffer = nullptr;
+        Framebuffer _frame_framebuffer;
 };
 
 }
@@ -46,15 +46,21 @@ FrameGraphPassBuilderBase::FrameGraphPassBuilderBase(FrameGraphPass* pass, Pipel
 }
 
 void FrameGraphPassBuilderBase::set_render_func(render_func&& func) {
-    y_debug_assert(_pass->_compute_render == nullptr && _pass->_render == nullptr);
+    y_debug_assert(_pass->_compute_render == nullptr && _pass->_render == nullptr && _pass->_parallel_render == nullptr);
     _pass->_render = std::move(func);
 }
 
 void FrameGraphPassBuilderBase::set_compute_render_func(compute_render_func &&func) {
-    y_debug_assert(_pass->_compute_render == nullptr && _pass->_render == nullptr);
+    y_debug_assert(_pass->_compute_render == nullptr && _pass->_render == nullptr && _pass->_parallel_render == nullptr);
     _pass->_compute_render = std::move(func);
 }
 
+void FrameGraphPassBuilderBase::set_parallel_render_func(parallel_render_func&& func, usize split_count) {
+    y_debug_assert(_pass->_compute_render == nullptr && _pass->_render == nullptr && _pass->_parallel_render == nullptr);
+    _pass->_parallel_render = std::move(func);
+    _pass->_split_count = split_count;
+}
+
 PipelineStage FrameGraphPassBuilderBase::or_default(PipelineStage stage) const {
     return stage == PipelineStage::None ? _default_stage : stage;
 }
@@ -229,7 +235,13 @@ void FrameGraphPassBuilderBase::add_inline_input(InlineDescriptor desc, i32 ds_i
 Y_TODO(external framegraph resources are not synchronized)
 void FrameGraphPassBuilderBase::add_external_input(Descriptor desc, PipelineStage, i32 ds_index) {
     y_debug_assert(!desc.is_inline_block());
-    add_descriptor_binding(desc, ds_index);
+    add_descriptor_binding(FrameGraphDescriptorBinding(desc), ds_index);
+}
+
+void FrameGraphPassBuilderBase::add_external_output(Descriptor desc, PipelineStage, i32 ds_index) {
+    y_debug_assert(!desc.is_inline_block());
+    set_has_side_effects();
+    add_descriptor_binding(FrameGraphDescriptorBinding(desc), ds_index);
 }
 
 
@@ -254,6 +266,10 @@ void FrameGraphPassBuilderBase::clear_before_pass(FrameGraphMutableImageId res)
     parent()->register_image_clear(res, _pass);
 }
 
+void FrameGraphPassBuilderBase::set_has_side_effects() {
+    parent()->register_side_effects(_pass);
+}
+
 void FrameGraphPassBuilderBase::add_descriptor_binding(Descriptor desc, i32 ds_index) {
     add_descriptor_binding(FrameGraphDescriptorBinding(desc), ds_index);
 }
@@ -297,6 +313,11 @@ void FrameGraphPassBuilderBase::add_to_pass(FrameGraphBufferId res, BufferUsage
 }
 
 void FrameGraphPassBuilderBase::add_descriptor_binding(FrameGraphDescriptorBinding binding, i32 ds_index) {
+    // Every binding goes through here: we can't know what the pass does with raw storage descriptors, so assume that they are written to
+    if(binding.is_external_storage()) {
+        set_has_side_effects();
+    }
+
     auto& bindings = _pass->_bindings;
     if(ds_index < 0) {
         bindings.set_min_size(-ds_index);
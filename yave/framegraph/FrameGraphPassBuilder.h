@@ -44,6 +44,7 @@ class FrameGraphPassBuilderBase {
 
         using render_func = std::function<void(RenderPassRecorder&, const FrameGraphPass*)>;
         using compute_render_func = std::function<void(CmdBufferRecorder&, const FrameGraphPass*)>;
+        using parallel_render_func = std::function<void(RenderPassRecorder&, const FrameGraphPass*, usize)>;
 
         FrameGraphMutableImageId declare_image(ImageFormat format, const math::Vec2ui& size, u32 mips = 1);
         FrameGraphMutableVolumeId declare_volume(ImageFormat format, const math::Vec3ui& size);
@@ -85,6 +86,7 @@ class FrameGraphPassBuilderBase {
 
         void add_inline_input(InlineDescriptor desc, i32 ds_index = -1);
         void add_external_input(Descriptor desc, PipelineStage stage = PipelineStage::None, i32 ds_index = -1);
+        void add_external_output(Descriptor desc, PipelineStage stage = PipelineStage::None, i32 ds_index = -1);
 
         void add_attrib_input(FrameGraphBufferId res, PipelineStage stage = PipelineStage::VertexInputBit);
         void add_index_input(FrameGraphBufferId res, PipelineStage stage = PipelineStage::VertexInputBit);
@@ -93,6 +95,9 @@ class FrameGraphPassBuilderBase {
 
         void clear_before_pass(FrameGraphMutableImageId res);
 
+        // Passes that write outside of the frame graph (readbacks, copies to external images, etc) should never be culled
+        void set_has_side_effects();
+
         template<typename T>
         void add_inline_input(const T& t, i32 ds_index = -1) {
             add_inline_input(InlineDescriptor(t), ds_index);
@@ -117,6 +122,7 @@ class FrameGraphPassBuilderBase {
 
         void set_render_func(render_func&& func);
         void set_compute_render_func(compute_render_func&& func);
+        void set_parallel_render_func(parallel_render_func&& func, usize split_count);
 
     private:
         void add_to_pass(FrameGraphImageId res, ImageUsage usage, bool is_written, PipelineStage stage);
@@ -143,6 +149,12 @@ class FrameGraphPassBuilder : public FrameGraphPassBuilderBase {
             FrameGraphPassBuilderBase::set_render_func(render_func(std::move(func)));
         }
 
+        // func is called once per split with the split index, possibly concurrently from different threads
+        template<typename F>
+        void set_parallel_render_func(F&& func, usize split_count) {
+            FrameGraphPassBuilderBase::set_parallel_render_func(parallel_render_func(std::move(func)), split_count);
+        }
+
     private:
         friend class FrameGraph;
 
@@ -0,0 +1,112 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_FRAMEGRAPH_FRAMEGRAPHPLAN_H
+#define YAVE_FRAMEGRAPH_FRAMEGRAPHPLAN_H
+
+#include "FrameGraph.h"
+#include "TransientHeap.h"
+
+#include <yave/graphics/framebuffer/Framebuffer.h>
+#include <yave/graphics/barriers/PipelineStage.h>
+
+namespace yave {
+
+// Result of a frame graph compilation: culling, memory placement, barriers and framebuffers.
+// Plans are kept by the resource pool and reused by frame graphs with the same topology,
+// so only per-frame data (inline blocks, mapped buffers, descriptors) needs to be rebuilt.
+class FrameGraphPlan : NonMovable {
+    public:
+        template<typename T>
+        struct ResourceBarrier {
+            T res;
+            PipelineStage src = PipelineStage::None;
+            PipelineStage dst = PipelineStage::None;
+        };
+
+        struct ImageCopy {
+            FrameGraphImageId src;
+            FrameGraphMutableImageId dst;
+        };
+
+        struct BufferCopy {
+            FrameGraphBufferId src;
+            FrameGraphMutableBufferId dst;
+
+            // No barrier if src is PipelineStage::None
+            ResourceBarrier<FrameGraphBufferId> src_barrier;
+            PipelineStage dst_stage = PipelineStage::None;
+        };
+
+        struct Pass {
+            usize index = 0;
+
+            core::Vector<FrameGraphImageId> aliased_images;
+            core::Vector<FrameGraphVolumeId> aliased_volumes;
+            core::Vector<FrameGraphBufferId> aliased_buffers;
+
+            core::Vector<ImageCopy> image_copies;
+            core::Vector<BufferCopy> buffer_copies;
+            core::Vector<FrameGraphMutableImageId> image_clears;
+
+            core::Vector<ResourceBarrier<FrameGraphImageId>> image_barriers;
+            core::Vector<ResourceBarrier<FrameGraphVolumeId>> volume_barriers;
+            core::Vector<ResourceBarrier<FrameGraphBufferId>> buffer_barriers;
+
+            // Framebuffers can only be kept if all attachments are owned by the plan
+            bool cache_framebuffer = false;
+            Framebuffer framebuffer;
+        };
+
+        template<typename T, typename R>
+        struct PlacedResource {
+            T res;
+            R* resource = nullptr;
+        };
+
+        FrameGraphPlan(u64 hash);
+        ~FrameGraphPlan();
+
+        u64 hash() const;
+        bool is_compiled() const;
+
+    private:
+        friend class FrameGraph;
+        friend class FrameGraphResourcePool;
+
+        u64 _hash = 0;
+        bool _is_compiled = false;
+
+        FrameGraphCulling _culling;
+        FrameGraph::CompileStats _stats;
+
+        core::Vector<TransientHeap> _heaps;
+        core::Vector<PlacedResource<FrameGraphImageId, TransientImage>> _placed_images;
+        core::Vector<PlacedResource<FrameGraphVolumeId, TransientVolume>> _placed_volumes;
+        core::Vector<PlacedResource<FrameGraphBufferId, TransientBuffer>> _placed_buffers;
+
+        // Alive passes, in order
+        core::Vector<Pass> _passes;
+};
+
+}
+
+#endif // YAVE_FRAMEGRAPH_FRAMEGRAPHPLAN_H
@@ -21,12 +21,19 @@ SOFTWARE.
 **********************************/
 
 #include "FrameGraphResourcePool.h"
+#include "FrameGraphPlan.h"
 
 #include <y/utils/log.h>
 #include <y/utils/format.h>
+#include <y/utils/memory.h>
 
 namespace yave {
 
+static constexpr u64 max_col_count = 6;
+
+// Heaps are rounded up so they can be reused when resources are slightly resized
+static constexpr u64 heap_size_granularity = 16 * 1024 * 1024;
+
 template<typename U>
 static void check_usage(U u) {
     if(u == U::None) {
@@ -94,6 +101,62 @@ TransientBuffer FrameGraphResourcePool::create_buffer(u64 byte_size, BufferUsage
     return buffer;
 }
 
+TransientHeap FrameGraphResourcePool::create_heap(u64 byte_size, u64 alignment, u32 memory_type_bits) {
+    y_profile();
+
+    y_debug_assert(byte_size);
+
+    const u64 heap_size = align_up_to(byte_size, heap_size_granularity);
+
+    TransientHeap heap = _heaps.locked([&](auto&& heaps) {
+        auto best = heaps.end();
+        for(auto it = heaps.begin(); it != heaps.end(); ++it) {
+            const TransientHeap& h = it->first;
+            if(h.byte_size() >= byte_size && h.byte_size() <= heap_size * 2 &&
+               h.alignment() >= alignment && h.is_compatible(memory_type_bits)) {
+                if(best == heaps.end() || h.byte_size() < best->first.byte_size()) {
+                    best = it;
+                }
+            }
+        }
+
+        TransientHeap found;
+        if(best != heaps.end()) {
+            found = std::move(best->first);
+            heaps.erase(best);
+        }
+        return found;
+    });
+
+    if(!heap.is_null()) {
+        return heap;
+    }
+
+    y_profile_zone("create heap");
+    return TransientHeap(heap_size, alignment, memory_type_bits);
+}
+
+std::unique_ptr<FrameGraphPlan> FrameGraphResourcePool::create_plan(u64 hash) {
+    y_profile();
+
+    std::unique_ptr<FrameGraphPlan> plan = _plans.locked([&](auto&& plans) {
+        for(auto it = plans.begin(); it != plans.end(); ++it) {
+            if(it->first->hash() == hash) {
+                std::unique_ptr<FrameGraphPlan> found = std::move(it->first);
+                plans.erase(it);
+                return found;
+            }
+        }
+        return std::unique_ptr<FrameGraphPlan>();
+    });
+
+    if(plan) {
+        return plan;
+    }
+
+    return std::make_unique<FrameGraphPlan>(hash);
+}
+
 std::pair<const TransientBuffer&, bool> FrameGraphResourcePool::create_scratch_buffer(u64 byte_size, BufferUsage usage, FrameGraphPersistentResourceId persistent_id) {
     return _persistent_buffers.locked([&](auto&& buffers) {
         const usize index = persistent_id.id();
@@ -224,6 +287,24 @@ void FrameGraphResourcePool::release(TransientBuffer buffer, core::Span<FrameGra
     }
 }
 
+void FrameGraphResourcePool::release(TransientHeap heap) {
+    y_debug_assert(!heap.is_null());
+    heap.recycle(_frame_id, max_col_count);
+    _heaps.locked([&](auto&& heaps) { heaps.emplace_back(std::move(heap), _frame_id); });
+}
+
+void FrameGraphResourcePool::release(std::unique_ptr<FrameGraphPlan> plan) {
+    y_debug_assert(plan);
+    if(!plan->is_compiled()) {
+        // Compilation never finished, the placed resources might be in any state
+        for(auto&& heap : plan->_heaps) {
+            release(std::move(heap));
+        }
+        return;
+    }
+    _plans.locked([&](auto&& plans) { plans.emplace_back(std::move(plan), _frame_id); });
+}
+
 bool FrameGraphResourcePool::has_persistent_image(FrameGraphPersistentResourceId persistent_id) const {
     return _persistent_images.locked([&](auto&& images) {
         return persistent_id.id() < images.size() && !images[persistent_id.id()].is_null();
@@ -259,7 +340,6 @@ TransientBuffer FrameGraphResourcePool::persistent_buffer(FrameGraphPersistentRe
 void FrameGraphResourcePool::garbage_collect() {
     y_profile();
 
-    const u64 max_col_count = 6;
     const u64 frame_id = _frame_id++;
 
     _images.locked([&](auto&& images) {
@@ -288,6 +368,33 @@ void FrameGraphResourcePool::garbage_collect() {
             }
         }
     });
+
+    // Heaps of unused plans go back to the pool so they can be used by other plans
+    core::Vector<std::unique_ptr<FrameGraphPlan>> unused_plans;
+    _plans.locked([&](auto&& plans) {
+        for(usize i = 0; i < plans.size(); ++i) {
+            if(plans[i].second + max_col_count < frame_id) {
+                unused_plans.emplace_back(std::move(plans[i].first));
+                plans.erase(plans.begin() + i);
+                --i;
+            }
+        }
+    });
+
+    for(auto&& plan : unused_plans) {
+        for(auto&& heap : plan->_heaps) {
+            release(std::move(heap));
+        }
+    }
+
+    _heaps.locked([&](auto&& heaps) {
+        for(usize i = 0; i < heaps.size(); ++i) {
+            if(heaps[i].second + max_col_count < frame_id) {
+                heaps.erase(heaps.begin() + i);
+                --i;
+            }
+        }
+    });
 }
 
 u64 FrameGraphResourcePool::frame_id() const {
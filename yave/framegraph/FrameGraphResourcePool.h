@@ -24,11 +24,13 @@ SOFTWARE.
 
 #include "TransientBuffer.h"
 #include "TransientImage.h"
+#include "TransientHeap.h"
 #include "FrameGraphResourceId.h"
 
 #include <y/core/Vector.h>
 
 #include <atomic>
+#include <memory>
 
 namespace yave {
 
@@ -42,11 +44,18 @@ class FrameGraphResourcePool : NonMovable {
         TransientVolume create_volume(ImageFormat format, const math::Vec3ui& size, ImageUsage usage);
         TransientBuffer create_buffer(u64 byte_size, BufferUsage usage, MemoryType memory, bool exact = true);
 
+        TransientHeap create_heap(u64 byte_size, u64 alignment, u32 memory_type_bits);
+
+        // Returns a compiled plan with the given topology hash if one is available, or an empty one
+        std::unique_ptr<FrameGraphPlan> create_plan(u64 hash);
+
         std::pair<const TransientBuffer&, bool> create_scratch_buffer(u64 byte_size, BufferUsage usage, FrameGraphPersistentResourceId persistent_id);
 
         void release(TransientImage image, core::Span<FrameGraphPersistentResourceId> persistent_ids = {});
         void release(TransientVolume volume, core::Span<FrameGraphPersistentResourceId> persistent_ids = {});
         void release(TransientBuffer buffer, core::Span<FrameGraphPersistentResourceId> persistent_ids = {});
+        void release(TransientHeap heap);
+        void release(std::unique_ptr<FrameGraphPlan> plan);
 
         bool has_persistent_image(FrameGraphPersistentResourceId persistent_id) const;
         bool has_persistent_buffer(FrameGraphPersistentResourceId persistent_id) const;
@@ -67,6 +76,8 @@ class FrameGraphResourcePool : NonMovable {
         ProfiledMutexed<core::Vector<std::pair<TransientImage, u64>>, std::recursive_mutex> _images;
         ProfiledMutexed<core::Vector<std::pair<TransientVolume, u64>>, std::recursive_mutex> _volumes;
         ProfiledMutexed<core::Vector<std::pair<TransientBuffer, u64>>, std::recursive_mutex> _buffers;
+        ProfiledMutexed<core::Vector<std::pair<TransientHeap, u64>>, std::recursive_mutex> _heaps;
+        ProfiledMutexed<core::Vector<std::pair<std::unique_ptr<FrameGraphPlan>, u64>>, std::recursive_mutex> _plans;
 
         ProfiledMutexed<core::Vector<TransientImage>, std::recursive_mutex> _persistent_images;
         ProfiledMutexed<core::Vector<TransientBuffer>, std::recursive_mutex> _persistent_buffers;
@@ -41,6 +41,12 @@ class TransientBuffer final : public BufferBase {
             set_exposed_byte_size(byte_size);
         }
 
+        TransientBuffer(usize byte_size, BufferUsage usage, const DeviceMemory& heap, u64 heap_offset) :
+                BufferBase(byte_size, usage, heap, heap_offset),
+                _memory_type(MemoryType::DeviceLocal) {
+            set_exposed_byte_size(byte_size);
+        }
+
         MemoryType memory_type() const {
             return _memory_type;
         }
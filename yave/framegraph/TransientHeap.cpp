@@ -0,0 +1,138 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "TransientHeap.h"
+
+namespace yave {
+
+template<typename T, typename C, typename F, typename... Args>
+static T* find_or_create(C& placed, u64 offset, u64 frame_id, F&& matches, Args&&... args) {
+    for(auto& p : placed) {
+        if(!p.in_use && p.offset == offset && matches(*p.resource)) {
+            p.in_use = true;
+            p.last_used = frame_id;
+            return p.resource.get();
+        }
+    }
+
+    y_profile_zone("create placed resource");
+    auto& p = placed.emplace_back();
+    p.resource = std::make_unique<T>(std::forward<Args>(args)...);
+    p.offset = offset;
+    p.last_used = frame_id;
+    p.in_use = true;
+    return p.resource.get();
+}
+
+template<typename C>
+static void recycle_placed(C& placed, u64 frame_id, u64 max_age) {
+    for(usize i = 0; i < placed.size(); ++i) {
+        if(placed[i].last_used + max_age < frame_id) {
+            placed.erase_unordered(placed.begin() + i);
+            --i;
+        } else {
+            placed[i].in_use = false;
+        }
+    }
+}
+
+
+
+TransientHeap::TransientHeap(u64 byte_size, u64 alignment, u32 memory_type_bits) : _byte_size(byte_size), _alignment(alignment) {
+    y_profile();
+
+    VkMemoryRequirements requirements = {};
+    {
+        requirements.size = byte_size;
+        requirements.alignment = alignment;
+        requirements.memoryTypeBits = memory_type_bits;
+    }
+
+    VmaAllocationCreateInfo create_info = {};
+    {
+        create_info.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    }
+
+    VmaAllocation alloc = {};
+    VmaAllocationInfo alloc_info = {};
+    vk_check(vmaAllocateMemory(device_allocator(), &requirements, &create_info, &alloc, &alloc_info));
+
+    _memory = DeviceMemory(alloc);
+    _memory_type_index = alloc_info.memoryType;
+}
+
+TransientHeap::~TransientHeap() {
+    // Placed resources need to be destroyed before the memory they live in
+    _images.clear();
+    _volumes.clear();
+    _buffers.clear();
+
+    destroy_graphic_resource(std::move(_memory));
+}
+
+bool TransientHeap::is_null() const {
+    return _memory.is_null();
+}
+
+u64 TransientHeap::byte_size() const {
+    return _byte_size;
+}
+
+u64 TransientHeap::alignment() const {
+    return _alignment;
+}
+
+bool TransientHeap::is_compatible(u32 memory_type_bits) const {
+    return !is_null() && (memory_type_bits & (u32(1) << _memory_type_index));
+}
+
+TransientImage* TransientHeap::create_image(ImageFormat format, const math::Vec2ui& size, u32 mips, ImageUsage usage, u64 offset, u64 frame_id) {
+    y_debug_assert(!is_null());
+    return find_or_create<TransientImage>(_images, offset, frame_id,
+        [&](const TransientImage& img) { return img.format() == format && img.size() == size && img.mipmaps() == mips && img.usage() == usage; },
+        format, usage, size, mips, _memory, offset
+    );
+}
+
+TransientVolume* TransientHeap::create_volume(ImageFormat format, const math::Vec3ui& size, ImageUsage usage, u64 offset, u64 frame_id) {
+    y_debug_assert(!is_null());
+    return find_or_create<TransientVolume>(_volumes, offset, frame_id,
+        [&](const TransientVolume& vol) { return vol.format() == format && vol.size() == size && vol.usage() == usage; },
+        format, usage, size, 1, _memory, offset
+    );
+}
+
+TransientBuffer* TransientHeap::create_buffer(u64 byte_size, BufferUsage usage, u64 offset, u64 frame_id) {
+    y_debug_assert(!is_null());
+    return find_or_create<TransientBuffer>(_buffers, offset, frame_id,
+        [&](const TransientBuffer& buffer) { return buffer.byte_size() == byte_size && buffer.usage() == usage; },
+        byte_size, usage, _memory, offset
+    );
+}
+
+void TransientHeap::recycle(u64 frame_id, u64 max_age) {
+    recycle_placed(_images, frame_id, max_age);
+    recycle_placed(_volumes, frame_id, max_age);
+    recycle_placed(_buffers, frame_id, max_age);
+}
+
+}
@@ -0,0 +1,81 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_FRAMEGRAPH_TRANSIENTHEAP_H
+#define YAVE_FRAMEGRAPH_TRANSIENTHEAP_H
+
+#include "TransientImage.h"
+#include "TransientBuffer.h"
+
+#include <y/core/Vector.h>
+
+#include <memory>
+
+namespace yave {
+
+// Device memory shared by transient resources with disjoint lifetimes.
+// Placed resources are cached and reused as long as they are requested with the same description and offset.
+class TransientHeap : NonCopyable {
+    template<typename T>
+    struct Placed {
+        std::unique_ptr<T> resource;
+        u64 offset = 0;
+        u64 last_used = 0;
+        bool in_use = false;
+    };
+
+    public:
+        TransientHeap() = default;
+        TransientHeap(u64 byte_size, u64 alignment, u32 memory_type_bits);
+
+        ~TransientHeap();
+
+        TransientHeap(TransientHeap&&) = default;
+        TransientHeap& operator=(TransientHeap&&) = default;
+
+        bool is_null() const;
+
+        u64 byte_size() const;
+        u64 alignment() const;
+        bool is_compatible(u32 memory_type_bits) const;
+
+        TransientImage* create_image(ImageFormat format, const math::Vec2ui& size, u32 mips, ImageUsage usage, u64 offset, u64 frame_id);
+        TransientVolume* create_volume(ImageFormat format, const math::Vec3ui& size, ImageUsage usage, u64 offset, u64 frame_id);
+        TransientBuffer* create_buffer(u64 byte_size, BufferUsage usage, u64 offset, u64 frame_id);
+
+        // Releases all placed resources and destroys the ones that haven't been used since max_age frames
+        void recycle(u64 frame_id, u64 max_age);
+
+    private:
+        DeviceMemory _memory;
+
+        u64 _byte_size = 0;
+        u64 _alignment = 0;
+        u32 _memory_type_index = 0;
+
+        core::Vector<Placed<TransientImage>> _images;
+        core::Vector<Placed<TransientVolume>> _volumes;
+        core::Vector<Placed<TransientBuffer>> _buffers;
+};
+
+}
+
+#endif // YAVE_FRAMEGRAPH_TRANSIENTHEAP_H
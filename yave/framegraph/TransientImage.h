@@ -46,6 +46,10 @@ class TransientImageBase final : public ImageBase {
         TransientImageBase(ImageFormat format, ImageUsage usage, const size_type& image_size, u32 mips) : ImageBase(format, usage, to_3d_size(image_size), Type, 1, mips) {
         }
 
+        TransientImageBase(ImageFormat format, ImageUsage usage, const size_type& image_size, u32 mips, const DeviceMemory& heap, u64 heap_offset) :
+                ImageBase(format, usage, to_3d_size(image_size), Type, 1, mips, heap, heap_offset) {
+        }
+
         TransientImageBase(TransientImageBase&&) = default;
         TransientImageBase& operator=(TransientImageBase&&) = default;
 
@@ -63,6 +67,12 @@ class TransientImageBase final : public ImageBase {
         const size_type& size() const {
             return image_size().template to<size_type::size()>();
         }
+
+        static VkMemoryRequirements memory_requirements(ImageFormat format, ImageUsage usage, const size_type& image_size, u32 mips) {
+            math::Vec3ui size(1);
+            size.to<size_type::size()>() = image_size;
+            return ImageBase::memory_requirements(format, usage, size, Type, 1, mips);
+        }
 };
 
 template<ImageUsage Usage, ImageType Type = ImageType::TwoD>
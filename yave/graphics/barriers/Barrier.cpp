@@ -223,6 +223,17 @@ ImageBarrier ImageBarrier::transition_from_barrier(const ImageBase& image, VkIma
     return transition_barrier(image, src_layout, vk_image_layout(image.usage()));
 }
 
+ImageBarrier ImageBarrier::aliasing_barrier(const ImageBase& image) {
+    ImageBarrier barrier;
+    barrier._barrier = create_barrier(image.vk_image(), image.format(), image.layers(), image.mipmaps(), VK_IMAGE_LAYOUT_UNDEFINED, vk_image_layout(image.usage()));
+    barrier._barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier._barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    barrier._src = PipelineStage::All;
+    barrier._dst = PipelineStage::All;
+
+    return barrier;
+}
+
 VkImageMemoryBarrier ImageBarrier::vk_barrier() const {
     return _barrier;
 }
@@ -247,6 +258,24 @@ BufferBarrier::BufferBarrier(const SubBufferBase& buffer, PipelineStage src, Pip
         _src(src), _dst(dst) {
 }
 
+BufferBarrier BufferBarrier::aliasing_barrier(const BufferBase& buffer) {
+    BufferBarrier barrier;
+    barrier._barrier = vk_struct();
+    {
+        barrier._barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier._barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        barrier._barrier.buffer = buffer.vk_buffer();
+        barrier._barrier.size = buffer.byte_size();
+        barrier._barrier.offset = 0;
+        barrier._barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier._barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    }
+    barrier._src = PipelineStage::All;
+    barrier._dst = PipelineStage::All;
+
+    return barrier;
+}
+
 VkBufferMemoryBarrier BufferBarrier::vk_barrier() const {
     return _barrier;
 }
@@ -40,6 +40,9 @@ class ImageBarrier {
         static ImageBarrier transition_to_barrier(const ImageBase& image, VkImageLayout dst_layout);
         static ImageBarrier transition_from_barrier(const ImageBase& image, VkImageLayout src_layout);
 
+        // discards the content of an image placed in memory that was previously used by another resource
+        static ImageBarrier aliasing_barrier(const ImageBase& image);
+
 
         VkImageMemoryBarrier vk_barrier() const;
 
@@ -59,6 +62,7 @@ class BufferBarrier {
         BufferBarrier(const BufferBase& buffer, PipelineStage src, PipelineStage dst);
         BufferBarrier(const SubBufferBase& buffer, PipelineStage src, PipelineStage dst);
 
+        static BufferBarrier aliasing_barrier(const BufferBase& buffer);
 
         VkBufferMemoryBarrier vk_barrier() const;
 
@@ -66,6 +70,8 @@ class BufferBarrier {
         PipelineStage src_stage() const;
 
     private:
+        BufferBarrier() = default;
+
         VkBufferMemoryBarrier _barrier;
         PipelineStage _src;
         PipelineStage _dst;
@@ -46,11 +46,15 @@ u64 buffer_alignment_for_usage(BufferUsage usage) {
 }
 
 
-static std::tuple<VkHandle<VkBuffer>, DeviceMemory> alloc_buffer(u64 buffer_size, BufferUsage usage, MemoryType type, MemoryAllocFlags flags) {
-    y_profile();
+static BufferUsage supported_usage(BufferUsage usage) {
+    const u64 raytracing_bits = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
+    usage = raytracing_enabled() ? usage : (usage & BufferUsage(~raytracing_bits));
 
-    unused(flags);
+    y_debug_assert(usage != BufferUsage::None);
+    return usage;
+}
 
+static VkBufferCreateInfo buffer_create_info(u64 buffer_size, BufferUsage usage) {
     y_debug_assert(buffer_size);
 
     y_always_assert(
@@ -59,18 +63,28 @@ static std::tuple<VkHandle<VkBuffer>, DeviceMemory> alloc_buffer(u64 buffer_size
         "Uniform buffer size exceeds maxUniformBufferRange ({})", device_properties().max_uniform_buffer_size
     );
 
+    VkBufferCreateInfo create_info = vk_struct();
+    {
+        create_info.size = buffer_size;
+        create_info.usage = VkBufferUsageFlags(supported_usage(usage)) | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+    return create_info;
+}
 
-    const u64 raytracing_bits = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR;
-    usage = raytracing_enabled() ? usage : (usage & BufferUsage(~raytracing_bits));
+static VkDeviceAddress buffer_device_address(VkBuffer buffer) {
+    VkBufferDeviceAddressInfo info = vk_struct();
+    info.buffer = buffer;
 
-    y_debug_assert(usage != BufferUsage::None);
+    return vkGetBufferDeviceAddress(vk_device(), &info);
+}
 
-    VkBufferCreateInfo buffer_create_info = vk_struct();
-    {
-        buffer_create_info.size = buffer_size;
-        buffer_create_info.usage = VkBufferUsageFlags(usage) | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
-        buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    }
+static std::tuple<VkHandle<VkBuffer>, DeviceMemory> alloc_buffer(u64 buffer_size, BufferUsage usage, MemoryType type, MemoryAllocFlags flags) {
+    y_profile();
+
+    unused(flags);
+
+    const VkBufferCreateInfo buffer_create_info = buffer_create_info(buffer_size, usage);
 
     VmaAllocationCreateInfo alloc_create_info = {};
     switch(type) {
@@ -178,13 +192,19 @@ bool SubBufferBase::operator!=(const SubBufferBase& other) const {
 
 BufferBase::BufferBase(u64 byte_size, BufferUsage usage, MemoryType type, MemoryAllocFlags alloc_flags) : _size(byte_size), _usage(usage) {
     std::tie(_buffer, _memory) = alloc_buffer(byte_size, usage, type, alloc_flags);
+    _address = buffer_device_address(_buffer);
+}
 
-    {
-        VkBufferDeviceAddressInfo info = vk_struct();
-        info.buffer = _buffer;
+BufferBase::BufferBase(u64 byte_size, BufferUsage usage, const DeviceMemory& heap, u64 heap_offset) : _size(byte_size), _usage(usage) {
+    y_profile();
 
-        _address = vkGetBufferDeviceAddress(vk_device(), &info);
-    }
+    y_debug_assert(!heap.is_null());
+    y_debug_assert(heap_offset % buffer_alignment_for_usage(usage) == 0);
+
+    const VkBufferCreateInfo create_info = buffer_create_info(byte_size, usage);
+    vk_check(vmaCreateAliasingBuffer2(device_allocator(), heap._alloc, heap_offset, &create_info, _buffer.get_ptr_for_init()));
+
+    _address = buffer_device_address(_buffer);
 }
 
 BufferBase::~BufferBase() {
@@ -192,6 +212,21 @@ BufferBase::~BufferBase() {
     destroy_graphic_resource(std::move(_memory));
 }
 
+VkMemoryRequirements BufferBase::memory_requirements(u64 byte_size, BufferUsage usage) {
+    const VkBufferCreateInfo create_info = buffer_create_info(byte_size, usage);
+
+    VkDeviceBufferMemoryRequirements info = vk_struct();
+    {
+        info.pCreateInfo = &create_info;
+    }
+
+    VkMemoryRequirements2 requirements = vk_struct();
+    vkGetDeviceBufferMemoryRequirements(vk_device(), &info, &requirements);
+
+    requirements.memoryRequirements.alignment = std::max(requirements.memoryRequirements.alignment, buffer_alignment_for_usage(usage));
+    return requirements.memoryRequirements;
+}
+
 BufferUsage BufferBase::usage() const {
     return _usage;
 }
@@ -80,6 +80,8 @@ class BufferBase : NonCopyable {
 
         VkDescriptorBufferInfo vk_descriptor_info() const;
 
+        static VkMemoryRequirements memory_requirements(u64 byte_size, BufferUsage usage);
+
     protected:
         BufferBase() = default;
         BufferBase(BufferBase&&) = default;
@@ -87,6 +89,9 @@ class BufferBase : NonCopyable {
 
         BufferBase(u64 byte_size, BufferUsage usage, MemoryType type, MemoryAllocFlags alloc_flags = MemoryAllocFlags::None);
 
+        // Placed buffer, created in memory owned by someone else
+        BufferBase(u64 byte_size, BufferUsage usage, const DeviceMemory& heap, u64 heap_offset);
+
     private:
         u64 _size = 0;
         BufferUsage _usage = BufferUsage::None;
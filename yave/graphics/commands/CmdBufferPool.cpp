@@ -46,21 +46,25 @@ static VkHandle<VkCommandPool> create_pool(u32 queue_family_index) {
 }
 
 
-CmdBufferPool::CmdBufferPool(CmdQueue* queue) :
+CmdBufferPool::CmdBufferPool(CmdQueue* queue, bool thread_bound) :
         _pool(create_pool(queue->family_index())),
         _primary(VK_COMMAND_BUFFER_LEVEL_PRIMARY),
         _secondary(VK_COMMAND_BUFFER_LEVEL_SECONDARY),
         _queue(queue) {
 
 #ifdef Y_DEBUG
-    _thread_id = std::this_thread::get_id();
+    if(thread_bound) {
+        _thread_id = std::this_thread::get_id();
+    }
+#else
+    unused(thread_bound);
 #endif
 }
 
 CmdBufferPool::~CmdBufferPool() {
     y_profile();
 
-    y_debug_assert(_thread_id == std::this_thread::get_id());
+    y_debug_assert(_thread_id == std::thread::id() || _thread_id == std::this_thread::get_id());
 
     auto wait_for_level = [&](auto& level) {
         for(;;) {
@@ -103,7 +107,7 @@ void CmdBufferPool::release(CmdBufferData* data) {
 CmdBufferData* CmdBufferPool::alloc(Level& level) {
     y_profile();
 
-    y_debug_assert(_thread_id == std::this_thread::get_id());
+    y_debug_assert(_thread_id == std::thread::id() || _thread_id == std::this_thread::get_id());
 
     CmdBufferData* ready = nullptr;
     level.released.locked([&](auto&& released) {
@@ -156,6 +160,10 @@ CmdBufferRecorder CmdBufferPool::create_cmd_buffer(bool secondary) {
     return CmdBufferRecorder(alloc(secondary ? _secondary : _primary));
 }
 
+CmdBufferRecorder CmdBufferPool::create_secondary_cmd_buffer(const Framebuffer& framebuffer) {
+    return CmdBufferRecorder(alloc(_secondary), framebuffer);
+}
+
 ComputeCmdBufferRecorder CmdBufferPool::create_compute_cmd_buffer() {
     return ComputeCmdBufferRecorder(alloc(_primary));
 }
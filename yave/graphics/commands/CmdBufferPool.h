@@ -37,12 +37,14 @@ class CmdBufferPool : NonMovable {
     public:
         using InlineUniformBuffer = CmdBufferData::InlineUniformBuffer;
 
-        CmdBufferPool(CmdQueue* queue);
+        // Pools that are not bound to a thread need to be externally synchronized
+        CmdBufferPool(CmdQueue* queue, bool thread_bound = true);
         ~CmdBufferPool();
 
         CmdQueue* queue() const;
 
         CmdBufferRecorder create_cmd_buffer(bool secondary = false);
+        CmdBufferRecorder create_secondary_cmd_buffer(const Framebuffer& framebuffer);
         ComputeCmdBufferRecorder create_compute_cmd_buffer();
         TransferCmdBufferRecorder create_transfer_cmd_buffer();
 
@@ -121,9 +121,20 @@ RenderPassRecorder::~RenderPassRecorder() {
 }
 
 void RenderPassRecorder::bind_material_template(const MaterialTemplate* material_template, core::Span<DescriptorSetProxy> descriptor_sets) {
+    bind_pipeline(material_template->compile(*_cmd_buffer._render_pass), descriptor_sets);
+}
+
+bool RenderPassRecorder::try_bind_material_template(const MaterialTemplate* material_template, core::Span<DescriptorSetProxy> descriptor_sets) {
+    if(const GraphicPipeline* pipeline = material_template->try_compile(*_cmd_buffer._render_pass)) {
+        bind_pipeline(*pipeline, descriptor_sets);
+        return true;
+    }
+    return false;
+}
+
+void RenderPassRecorder::bind_pipeline(const GraphicPipeline& pipeline, core::Span<DescriptorSetProxy> descriptor_sets) {
     Y_VK_CMD
 
-    const GraphicPipeline& pipeline = material_template->compile(*_cmd_buffer._render_pass);
     vkCmdBindPipeline(vk_cmd_buffer(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.vk_pipeline());
 
     for(usize i = 0; i != descriptor_sets.size(); ++i) {
@@ -266,16 +277,37 @@ CmdBufferRecorderBase::CmdBufferRecorderBase(CmdBufferData* data) : _data(data)
     vk_check(vkBeginCommandBuffer(vk_cmd_buffer(), &begin_info));
 }
 
+CmdBufferRecorderBase::CmdBufferRecorderBase(CmdBufferData* data, const Framebuffer& framebuffer) : _data(data), _inherited_framebuffer(&framebuffer) {
+    y_debug_assert(_data->is_secondary());
+
+    VkCommandBufferInheritanceInfo inheritance_info = vk_struct();
+    {
+        inheritance_info.renderPass = framebuffer.render_pass().vk_render_pass();
+        inheritance_info.subpass = 0;
+        inheritance_info.framebuffer = framebuffer.vk_framebuffer();
+    }
+
+    VkCommandBufferBeginInfo begin_info = vk_struct();
+    {
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        begin_info.pInheritanceInfo = &inheritance_info;
+    }
+
+    vk_check(vkBeginCommandBuffer(vk_cmd_buffer(), &begin_info));
+}
+
 CmdBufferRecorderBase::~CmdBufferRecorderBase() {
     check_no_renderpass();
     y_always_assert(!_data, "CmdBufferRecorder has not been submitted");
 }
 
 void CmdBufferRecorderBase::swap(CmdBufferRecorderBase& other) {
-    y_debug_assert(_data->is_secondary() == other._data->is_secondary());
+    y_debug_assert(!_data || !other._data || _data->is_secondary() == other._data->is_secondary());
 
     std::swap(_data, other._data);
     std::swap(_render_pass, other._render_pass);
+    std::swap(_inherited_framebuffer, other._inherited_framebuffer);
+    std::swap(_is_ended, other._is_ended);
 }
 
 CmdQueue* CmdBufferRecorderBase::queue() const {
@@ -283,6 +315,11 @@ CmdQueue* CmdBufferRecorderBase::queue() const {
     return _data->queue();
 }
 
+ResourceFence CmdBufferRecorderBase::resource_fence() const {
+    y_debug_assert(_data);
+    return _data->resource_fence();
+}
+
 VkCommandBuffer CmdBufferRecorderBase::vk_cmd_buffer() const {
     y_debug_assert(_data);
     return _data->vk_cmd_buffer();
@@ -306,7 +343,10 @@ void CmdBufferRecorderBase::end_renderpass() {
 
     y_debug_assert(_render_pass);
 
-    vkCmdEndRenderPass(vk_cmd_buffer());
+    // Inherited render passes are ended by the primary
+    if(!_inherited_framebuffer) {
+        vkCmdEndRenderPass(vk_cmd_buffer());
+    }
     _render_pass = nullptr;
 }
 
@@ -651,11 +691,7 @@ void CmdBufferRecorderBase::submit_async() {
 
 // -------------------------------------------------- CmdBufferRecorder --------------------------------------------------
 
-RenderPassRecorder CmdBufferRecorder::bind_framebuffer(const Framebuffer& framebuffer) {
-    Y_VK_CMD
-
-    check_no_renderpass();
-
+static void begin_renderpass(VkCommandBuffer cmd_buffer, const Framebuffer& framebuffer, VkSubpassContents contents) {
     auto clear_values = core::ScratchPad<VkClearValue>(framebuffer.attachment_count() + 1);
     for(usize i = 0; i != framebuffer.attachment_count(); ++i) {
         clear_values[i] = VkClearValue{};
@@ -677,7 +713,20 @@ RenderPassRecorder CmdBufferRecorder::bind_framebuffer(const Framebuffer& frameb
     }
 
 
-    vkCmdBeginRenderPass(vk_cmd_buffer(), &begin_info, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(cmd_buffer, &begin_info, contents);
+}
+
+RenderPassRecorder CmdBufferRecorder::bind_framebuffer(const Framebuffer& framebuffer) {
+    Y_VK_CMD
+
+    check_no_renderpass();
+
+    if(_inherited_framebuffer) {
+        y_always_assert(_inherited_framebuffer == &framebuffer, "Secondary cmd buffer can only bind the framebuffer it was created for");
+    } else {
+        begin_renderpass(vk_cmd_buffer(), framebuffer, VK_SUBPASS_CONTENTS_INLINE);
+    }
+
     _render_pass = &framebuffer.render_pass();
 
     return RenderPassRecorder(*this, Viewport(framebuffer.size()));
@@ -691,13 +740,38 @@ void CmdBufferRecorder::execute(CmdBufferRecorder&& other) {
     y_always_assert(!_data->is_secondary(), "execute should only be called on primary cmd buffers");
     y_always_assert(other._data->is_secondary(), "execute should only be used with secondary cmd buffers");
 
-    const VkCommandBuffer secondary = other._data->vk_cmd_buffer();
-    vk_check(vkEndCommandBuffer(secondary));
+    other.end_secondary();
 
+    const VkCommandBuffer secondary = other._data->vk_cmd_buffer();
     vkCmdExecuteCommands(vk_cmd_buffer(), 1, &secondary);
 
     _data->push_secondary(std::exchange(other._data, nullptr));
 }
 
+void CmdBufferRecorder::execute(const Framebuffer& framebuffer, core::MutableSpan<CmdBufferRecorder> secondaries) {
+    Y_VK_CMD
+
+    check_no_renderpass();
+
+    begin_renderpass(vk_cmd_buffer(), framebuffer, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+    for(CmdBufferRecorder& secondary : secondaries) {
+        y_debug_assert(secondary._inherited_framebuffer == &framebuffer);
+        execute(std::move(secondary));
+    }
+
+    vkCmdEndRenderPass(vk_cmd_buffer());
+}
+
+void CmdBufferRecorder::end_secondary() {
+    y_debug_assert(_data && _data->is_secondary());
+    check_no_renderpass();
+
+    if(!_is_ended) {
+        vk_check(vkEndCommandBuffer(vk_cmd_buffer()));
+        _is_ended = true;
+    }
+}
+
 }
 
@@ -62,6 +62,9 @@ class RenderPassRecorder final : NonMovable {
         // specific
         void bind_material_template(const MaterialTemplate* material_template, core::Span<DescriptorSetProxy> descriptor_sets);
 
+        // Does nothing and returns false if the pipeline is still being compiled
+        bool try_bind_material_template(const MaterialTemplate* material_template, core::Span<DescriptorSetProxy> descriptor_sets);
+
         void draw(const MeshDrawData& draw_data, u32 instance_count = 1, u32 instance_index = 0);
 
         void draw(const VkDrawIndexedIndirectCommand& indirect);
@@ -91,6 +94,8 @@ class RenderPassRecorder final : NonMovable {
 
         RenderPassRecorder(CmdBufferRecorder& cmd_buffer, const Viewport& viewport);
 
+        void bind_pipeline(const GraphicPipeline& pipeline, core::Span<DescriptorSetProxy> descriptor_sets);
+
         CmdBufferRecorder& _cmd_buffer;
         Viewport _viewport;
 };
@@ -106,6 +111,7 @@ class CmdBufferRecorderBase : NonMovable {
         ~CmdBufferRecorderBase();
 
         CmdQueue* queue() const;
+        ResourceFence resource_fence() const;
 
         VkCommandBuffer vk_cmd_buffer() const;
         const CmdBufferFence& create_fence();
@@ -142,6 +148,9 @@ class CmdBufferRecorderBase : NonMovable {
         CmdBufferRecorderBase() = default;
         CmdBufferRecorderBase(CmdBufferData* data);
 
+        // Secondary cmd buffer that continues the render pass of framebuffer
+        CmdBufferRecorderBase(CmdBufferData* data, const Framebuffer& framebuffer);
+
         void swap(CmdBufferRecorderBase& other);
 
         void bind_descriptor_set(VkPipelineBindPoint bind_point, VkPipelineLayout layout, u32 set_index, const DescriptorSetProxy& ds);
@@ -153,6 +162,9 @@ class CmdBufferRecorderBase : NonMovable {
         CmdBufferData* _data = nullptr;
         // this could be in RenderPassRecorder, but putting it here makes erroring easier
         const RenderPass* _render_pass = nullptr;
+
+        const Framebuffer* _inherited_framebuffer = nullptr;
+        bool _is_ended = false;
 };
 
 
@@ -175,6 +187,9 @@ class ComputeCapableCmdBufferRecorder : public CmdBufferRecorderBase {
     public:
         using CmdBufferRecorderBase::dispatch;
         using CmdBufferRecorderBase::dispatch_threads;
+
+    protected:
+        ComputeCapableCmdBufferRecorder(CmdBufferData* data, const Framebuffer& framebuffer) : CmdBufferRecorderBase(data, framebuffer) {}
 };
 
 class TransferCmdBufferRecorder final : public CmdBufferRecorderBase {
@@ -199,10 +214,19 @@ class CmdBufferRecorder final : public ComputeCapableCmdBufferRecorder {
     public:
         using CmdBufferRecorderBase::raytrace;
 
+        // For secondaries created for a framebuffer, this continues the inherited render pass
         RenderPassRecorder bind_framebuffer(const Framebuffer& framebuffer);
 
         void execute(CmdBufferRecorder&& other);
 
+        // Begins a render pass for framebuffer, executes all the secondaries (which must inherit framebuffer) and ends the render pass
+        void execute(const Framebuffer& framebuffer, core::MutableSpan<CmdBufferRecorder> secondaries);
+
+        // Ends recording of a secondary, needs to be called from the recording thread if executed from another thread
+        void end_secondary();
+
+    private:
+        CmdBufferRecorder(CmdBufferData* data, const Framebuffer& framebuffer) : ComputeCapableCmdBufferRecorder(data, framebuffer) {}
 };
 
 static_assert(sizeof(ComputeCapableCmdBufferRecorder) == sizeof(CmdBufferRecorderBase));
@@ -25,6 +25,7 @@ SOFTWARE.
 #include <yave/graphics/device/DebugUtils.h>
 #include <yave/graphics/commands/CmdBufferPool.h>
 #include <yave/graphics/device/LifetimeManager.h>
+#include <yave/graphics/device/UploadQueue.h>
 #include <y/core/ScratchPad.h>
 
 #include <y/utils/log.h>
@@ -170,13 +171,25 @@ void CmdQueue::submit_async_start(CmdBufferData* data) {
         data->_semaphore = create_cmd_buffer_semaphore();
     }
 
+    flush_uploads();
     submit_internal(data, {}, {}, {}, false);
 }
 
 TimelineFence CmdQueue::submit(CmdBufferData* data) {
+    flush_uploads();
     return submit_internal(data);
 }
 
+void CmdQueue::flush_uploads() {
+    // The upload batch is itself submitted with submit_async_start, which must not flush again
+    static thread_local bool is_flushing = false;
+    if(_upload_queue && !is_flushing) {
+        is_flushing = true;
+        y_defer(is_flushing = false);
+        _upload_queue->flush();
+    }
+}
+
 
 VkResult CmdQueue::present(CmdBufferRecorder&& recorder, const FrameToken& token, const Swapchain::FrameSyncObjects& swaphain_sync) {
     y_profile();
@@ -185,6 +198,8 @@ VkResult CmdQueue::present(CmdBufferRecorder&& recorder, const FrameToken& token
     TracyVkCollect(_profiling_ctx, recorder.vk_cmd_buffer());
 #endif
 
+    flush_uploads();
+
     submit_internal(std::exchange(recorder._data, nullptr), swaphain_sync.image_available, swaphain_sync.render_complete, swaphain_sync.fence);
 
     return _queue.locked([&](auto&& queue) {
@@ -80,6 +80,7 @@ class CmdQueue final : NonMovable {
 
     private:
         friend class CmdBufferRecorderBase;
+        friend class UploadQueue;
 
         struct AsyncSubmitData {
             TimelineFence current_fence;
@@ -96,6 +97,9 @@ class CmdQueue final : NonMovable {
 
         void clear_thread(u32 thread_id);
 
+        // Pending uploads are submitted before anything else so that everything submitted afterward waits on them
+        void flush_uploads();
+
 
         ProfiledMutexed<VkQueue> _queue = {};
         ProfiledMutexed<AsyncSubmitData> _async_submit_data;
@@ -106,6 +110,9 @@ class CmdQueue final : NonMovable {
 
         const u32 _family_index = u32(-1);
 
+        // Only set on device creation and destruction
+        UploadQueue* _upload_queue = nullptr;
+
 #ifdef YAVE_GPU_PROFILING
         TracyVkCtx _profiling_ctx;
 #endif
@@ -24,6 +24,7 @@ SOFTWARE.
 
 #include <yave/graphics/device/DebugUtils.h>
 #include <yave/graphics/device/DeviceProperties.h>
+#include <yave/graphics/device/LifetimeManager.h>
 
 #include <y/core/ScratchPad.h>
 #include <y/utils/format.h>
@@ -163,6 +164,31 @@ VkDescriptorSetLayout DescriptorArray::descriptor_set_layout() const {
     return _layout;
 }
 
+u32 DescriptorArray::capacity() const {
+    const auto lock = std::unique_lock(_set_lock);
+    return _capacity;
+}
+
+u32 DescriptorArray::used_descriptors() const {
+    const auto lock = std::unique_lock(_set_lock);
+    return _first_unused - u32(_free.size() + _pending_frees.size());
+}
+
+u32 DescriptorArray::pending_frees() const {
+    const auto lock = std::unique_lock(_set_lock);
+    return u32(_pending_frees.size());
+}
+
+u64 DescriptorArray::reused_allocations() const {
+    const auto lock = std::unique_lock(_set_lock);
+    return _reused;
+}
+
+u64 DescriptorArray::total_allocations() const {
+    const auto lock = std::unique_lock(_set_lock);
+    return _allocated;
+}
+
 void DescriptorArray::alloc_set(u32 size) {
     y_profile();
 
@@ -182,10 +208,6 @@ void DescriptorArray::alloc_set(u32 size) {
         vkUpdateDescriptorSets(vk_device(), 0, nullptr, 1, &copy);
     }
 
-    for(u32 i = _capacity; i < size; ++i) {
-        _free << i;
-    }
-
     _capacity = size;
     _set = new_set;
     destroy_graphic_resource(std::exchange(_pool, std::move(new_pool)));
@@ -196,11 +218,21 @@ u32 DescriptorArray::add_descriptor(const Descriptor& desc) {
 
     const auto lock = std::unique_lock(_set_lock);
 
-    if(_free.is_empty()) {
-        alloc_set(2 << log2ui(_capacity + 1));
+    collect_pending_frees();
+
+    u32 index = 0;
+    if(!_free.is_empty()) {
+        index = _free.pop();
+        ++_reused;
+    } else {
+        if(_first_unused == _capacity) {
+            alloc_set(2 << log2ui(_capacity + 1));
+        }
+        index = _first_unused++;
     }
 
-    const u32 index = _free.pop();
+    ++_allocated;
+
     add_descriptor_to_set(desc, index);
     return index;
 }
@@ -208,8 +240,22 @@ u32 DescriptorArray::add_descriptor(const Descriptor& desc) {
 void DescriptorArray::remove_descriptor(u32 index) {
     const auto lock = std::unique_lock(_set_lock);
 
+    y_debug_assert(index < _first_unused);
     y_debug_assert(std::find(_free.begin(), _free.end(), index) == _free.end());
-    _free << index;
+    y_debug_assert(std::find_if(_pending_frees.begin(), _pending_frees.end(), [&](const PendingFree& p) { return p.index == index; }) == _pending_frees.end());
+
+    _pending_frees.emplace_back(PendingFree{lifetime_manager().next_fence(), index});
+}
+
+void DescriptorArray::collect_pending_frees() {
+    while(!_pending_frees.is_empty()) {
+        const PendingFree& pending = _pending_frees.first();
+        if(!lifetime_manager().is_collected(pending.fence)) {
+            break;
+        }
+        _free << pending.index;
+        _pending_frees.pop_front();
+    }
 }
 
 void DescriptorArray::add_descriptor_to_set(const Descriptor& desc, u32 index) {
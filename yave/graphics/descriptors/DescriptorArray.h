@@ -23,9 +23,11 @@ SOFTWARE.
 #define YAVE_GRAPHICS_DESCRIPTORS_DESCRIPTORARRAY_H
 
 #include <yave/graphics/descriptors/DescriptorSetProxy.h>
+#include <yave/graphics/commands/CmdBufferData.h>
 
 #include <y/core/HashMap.h>
 #include <y/core/Vector.h>
+#include <y/core/RingQueue.h>
 
 namespace yave {
 
@@ -42,6 +44,14 @@ class DescriptorArray : NonMovable {
 
         VkDescriptorSetLayout descriptor_set_layout() const;
 
+        u32 capacity() const;
+        u32 used_descriptors() const;
+        u32 pending_frees() const;
+
+        // Number of descriptors that were allocated in a recycled slot
+        u64 reused_allocations() const;
+        u64 total_allocations() const;
+
     protected:
         DescriptorArray(VkDescriptorType type, u32 starting_capacity = 1024);
 
@@ -51,14 +61,28 @@ class DescriptorArray : NonMovable {
         void add_descriptor_to_set(const Descriptor& desc, u32 index);
 
     private:
+        struct PendingFree {
+            ResourceFence fence;
+            u32 index = 0;
+        };
+
         VkWriteDescriptorSet descriptor_write(VkDescriptorSet set, const Descriptor& desc, u32 index) const;
 
         void alloc_set(u32 size);
+        void collect_pending_frees();
 
         std::atomic<VkDescriptorSet> _set = {};
         u32 _capacity = 0;
 
+        // Slots at or above this have never been allocated
+        u32 _first_unused = 0;
+
+        // Removed slots might still be read by in flight cmd buffers and can only be reused once those have completed
         core::Vector<u32> _free;
+        core::RingQueue<PendingFree> _pending_frees;
+
+        u64 _allocated = 0;
+        u64 _reused = 0;
 
         VkHandle<VkDescriptorSetLayout> _layout;
         VkHandle<VkDescriptorPool> _pool;
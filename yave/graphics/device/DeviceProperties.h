@@ -33,6 +33,7 @@ struct DeviceProperties {
     u64 uniform_buffer_alignment;
     u64 storage_buffer_alignment;
     u64 acceleration_structure_buffer_alignment;
+    u64 buffer_image_granularity;
 
     u32 max_memory_allocations;
 
@@ -25,6 +25,7 @@ SOFTWARE.
 #include "DebugUtils.h"
 
 #include <yave/graphics/shaders/SpirVData.h>
+#include <yave/graphics/shaders/ShaderBundle.h>
 #include <yave/graphics/shaders/ShaderModule.h>
 #include <yave/graphics/shaders/ShaderProgram.h>
 #include <yave/graphics/shaders/ComputeProgram.h>
@@ -38,7 +39,6 @@ SOFTWARE.
 
 #include <y/math/random.h>
 #include <y/core/Chrono.h>
-#include <y/io2/File.h>
 #include <y/utils/log.h>
 #include <y/utils/format.h>
 
@@ -229,13 +229,13 @@ DeviceResources::DeviceResources() {
         }
     }
 
+    const ShaderBundle bundle = ShaderBundle::open_default();
+
     core::FlatHashMap<core::String, SpirVData> spirvs;
     auto load_spirv = [&](std::string_view name) -> const SpirVData& {
-        y_debug_assert(!name.empty());
-        const core::String filename = fmt_to_owned("{}.spv", name);
-        auto& spirv = spirvs[filename];
+        auto& spirv = spirvs[name];
         if(spirv.is_empty()) {
-            spirv = SpirVData::deserialized(io2::File::open(filename).expected(fmt_c_str("Unable to open SPIR-V file ({})", filename)));
+            spirv = bundle.load(name);
         }
         return spirv;
     };
@@ -37,6 +37,9 @@ struct InstanceParams {
     bool debug_utils = true;
     bool raytracing = true;
 
+    // Start from the pipeline cache saved by the previous run instead of an empty one
+    bool pipeline_cache = true;
+
 };
 
 class Instance : NonMovable {
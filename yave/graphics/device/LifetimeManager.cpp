@@ -81,12 +81,8 @@ LifetimeManager::~LifetimeManager() {
     y_debug_assert(_create_counter == _next_to_collect);
     y_always_assert(_in_flight.locked([](auto&& in_flight) { return in_flight.is_empty(); }), "CmdBuffer still in flight");
 
-    _to_destroy.locked([&](auto&& to_destroy) {
-        for(auto& res : to_destroy) {
-            y_always_assert(res.first == _next_to_collect, "Resource is still waiting on unsignaled fence");
-            destroy_resource(res.second);
-        }
-    });
+    clear_resources(_next_to_collect);
+    y_always_assert(_to_destroy.size() == 0, "Resource is still waiting on unsignaled fence");
 }
 
 void LifetimeManager::shutdown_collector_thread() {
@@ -196,19 +192,13 @@ void LifetimeManager::clear_resources(u64 up_to) {
 
     {
         y_profile_zone("collection");
-        _to_destroy.locked([&](auto&& to_destroy) {
-            y_debug_assert(std::is_sorted(to_destroy.begin(), to_destroy.end(), [](const auto& a, const auto& b) { return a.first < b.first; }));
-            while(!to_destroy.is_empty() && to_destroy.first().first <= up_to) {
-                to_delete.push_back(std::move(to_destroy.first().second));
-                to_destroy.pop_front();
-            }
+        _to_destroy.consume(up_to, [&](ManagedResource& res) {
+            to_delete.push_back(std::move(res));
         });
     }
 
     y_profile_zone("clear");
-    for(auto& res : to_delete) {
-        destroy_resource(res);
-    }
+    destroy_resources(to_delete);
 }
 
 
@@ -220,11 +210,40 @@ usize LifetimeManager::pending_cmd_buffers() const {
     return _in_flight.locked([](auto&& in_flight) { return in_flight.size(); });
 }
 
+ResourceFence LifetimeManager::next_fence() const {
+    return _create_counter.load();
+}
+
+bool LifetimeManager::is_collected(ResourceFence fence) const {
+    return _in_flight.locked([&](auto&&) { return fence._value < _next_to_collect; });
+}
+
 usize LifetimeManager::pending_deletions() const {
-    return _to_destroy.locked([](auto&& to_destroy) { return to_destroy.size(); });
+    return _to_destroy.size();
 }
 
 
+void LifetimeManager::destroy_resources(core::MutableSpan<ManagedResource> resources) const {
+    y_profile();
+
+    // Destroy resources of the same type together, this lets us free all the memory in a single call
+    std::sort(resources.begin(), resources.end(), [](const ManagedResource& a, const ManagedResource& b) { return a.index() < b.index(); });
+
+    core::ScratchVector<VmaAllocation> allocations(resources.size());
+    for(ManagedResource& res : resources) {
+        if(DeviceMemory* memory = std::get_if<DeviceMemory>(&res)) {
+            y_debug_assert(!memory->is_null());
+            allocations.emplace_back(std::exchange(memory->_alloc, {}));
+        } else {
+            destroy_resource(res);
+        }
+    }
+
+    if(!allocations.is_empty()) {
+        vmaFreeMemoryPages(device_allocator(), allocations.size(), allocations.data());
+    }
+}
+
 void LifetimeManager::destroy_resource(ManagedResource& resource) const {
     std::visit(
         [](auto&& res) {
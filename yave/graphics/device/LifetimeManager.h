@@ -29,6 +29,7 @@ SOFTWARE.
 #include <yave/meshes/MeshDrawData.h>
 
 #include <y/core/RingQueue.h>
+#include <y/concurrent/BatchQueue.h>
 
 #include <variant>
 #include <mutex>
@@ -56,17 +57,22 @@ YAVE_GRAPHIC_HANDLE_TYPES(YAVE_GENERATE_RT_VARIANT)
 
         void shutdown_collector_thread();
 
+        // Does not count resources still batched by their destroying thread
         usize pending_deletions() const;
         usize pending_cmd_buffers() const;
 
+        // True once every cmd buffer up to fence has completed and been collected
+        bool is_collected(ResourceFence fence) const;
+
+        // Fence of the next cmd buffer to be created, once collected everything created before has completed
+        ResourceFence next_fence() const;
+
         void collect_cmd_buffers();
         void wait_cmd_buffers();
 
 #define YAVE_GENERATE_DESTROY(T)                                                        \
         void destroy_later(T&& t) {                                                     \
-            _to_destroy.locked([&](auto& to_destroy) {                                  \
-                to_destroy.emplace_back(_create_counter, ManagedResource(y_fwd(t)));    \
-            });                                                                         \
+            _to_destroy.emplace(_create_counter.load(), ManagedResource(y_fwd(t)));     \
         }
 YAVE_GRAPHIC_HANDLE_TYPES(YAVE_GENERATE_DESTROY)
 #undef YAVE_GENERATE_DESTROY
@@ -80,9 +86,11 @@ YAVE_GRAPHIC_HANDLE_TYPES(YAVE_GENERATE_DESTROY)
 
     private:
         void clear_resources(u64 up_to);
+        void destroy_resources(core::MutableSpan<ManagedResource> resources) const;
         void destroy_resource(ManagedResource& resource) const;
 
-        ProfiledMutexed<core::RingQueue<std::pair<u64, ManagedResource>>> _to_destroy;
+        // Resources are batched per destroying thread and tagged with _create_counter
+        concurrent::BatchQueue<ManagedResource> _to_destroy;
         ProfiledMutexed<core::RingQueue<CmdBufferData*>, std::recursive_mutex> _in_flight;
 
         std::atomic<u64> _create_counter = 0;
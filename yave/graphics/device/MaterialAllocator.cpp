@@ -23,14 +23,13 @@ SOFTWARE.
 #include "MaterialAllocator.h"
 
 #include <yave/graphics/device/DeviceResources.h>
+#include <yave/graphics/device/UploadQueue.h>
 #include <yave/graphics/images/TextureLibrary.h>
 
 #include <yave/material/MaterialData.h>
 
 #include <yave/graphics/device/DebugUtils.h>
 
-#include <numeric>
-
 #include <y/utils/log.h>
 #include <y/utils/format.h>
 
@@ -56,23 +55,81 @@ static std::array<TextureView, MaterialData::max_texture_count> material_texture
 }
 
 
-MaterialAllocator::MaterialAllocator() : _materials(max_materials) {
-    _free.locked([&](auto&& free) {
-        free.set_min_size(_materials.size());
-        std::iota(free.begin(), free.end(), 0);
-    });
+MaterialAllocator::MaterialAllocator() {
+    const auto lock = std::unique_lock(_lock);
+    grow(default_material_count);
+}
+
+MaterialAllocator::~MaterialAllocator() {
+    const auto lock = std::unique_lock(_lock);
+    y_always_assert(_free.size() == _cpu_materials.size(), "Not all materials have been released");
+}
+
+TypedSubBuffer<shader::MaterialData, BufferUsage::StorageBit> MaterialAllocator::material_buffer() const {
+    const auto lock = std::unique_lock(_lock);
+    return _materials;
+}
+
+usize MaterialAllocator::capacity() const {
+    const auto lock = std::unique_lock(_lock);
+    return _cpu_materials.size();
+}
+
+usize MaterialAllocator::allocated() const {
+    const auto lock = std::unique_lock(_lock);
+    return _cpu_materials.size() - _free.size();
+}
+
+u64 MaterialAllocator::reused_allocations() const {
+    const auto lock = std::unique_lock(_lock);
+    return _reused;
+}
+
+u64 MaterialAllocator::total_allocations() const {
+    const auto lock = std::unique_lock(_lock);
+    return _allocated;
+}
+
+void MaterialAllocator::grow(usize new_capacity) {
+    y_profile();
+
+    y_debug_assert(!_lock.try_lock());
+    y_debug_assert(_free.is_empty());
+    y_debug_assert(new_capacity > _cpu_materials.size());
+    y_debug_assert(new_capacity % material_page_size == 0);
+
+    const u32 old_capacity = u32(_cpu_materials.size());
+
+    _materials = MaterialBuffer(new_capacity);
+    _cpu_materials.set_min_size(new_capacity);
 
 #ifdef Y_DEBUG
     if(const auto* debug = debug_utils()) {
         debug->set_resource_name(_materials.vk_buffer(), "Material allocator material buffer");
     }
 #endif
+
+    // The previous buffer is kept alive by the lifetime manager until in flight frames are done with it.
+    // We only grow once every slot is live, so the new buffer is filled with a single upload from the CPU copy.
+    if(old_capacity) {
+        upload_range(0, old_capacity);
+    }
+
+    // So that the lowest indices are allocated first
+    for(usize i = new_capacity; i != old_capacity; --i) {
+        _free << u32(i - 1);
+    }
 }
 
-MaterialAllocator::~MaterialAllocator() {
-    _free.locked([&](auto&& free) {
-        y_always_assert(free.size() == _materials.size(), "Not all materials have been released");
-    });
+void MaterialAllocator::upload_range(u32 first, u32 count) {
+    y_debug_assert(!_lock.try_lock());
+    y_debug_assert(first + count <= _materials.size());
+
+    const u64 item_size = sizeof(shader::MaterialData);
+    upload_queue().upload(
+        SubBuffer<BufferUsage::TransferDstBit>(_materials, item_size * count, item_size * first),
+        core::Span<u8>(reinterpret_cast<const u8*>(_cpu_materials.data() + first), item_size * count)
+    );
 }
 
 MaterialDrawData MaterialAllocator::allocate_material(const MaterialData& material) {
@@ -94,15 +151,23 @@ MaterialDrawData MaterialAllocator::allocate_material(const MaterialData& materi
         }
     }
 
-    const u32 index = _free.locked([&](auto&& free) {
-        y_always_assert(!free.is_empty(), "Max number of materials reached");
-        return free.pop();
-    });
-
+    u32 index = 0;
     {
-        Y_TODO(does map need to be synchronized?)
-        auto mapping = _materials.map(MappingAccess::ReadWrite);
-        mapping[index] = data;
+        const auto lock = std::unique_lock(_lock);
+
+        if(_free.is_empty()) {
+            grow(_cpu_materials.size() * 2);
+        }
+
+        index = _free.pop();
+        if(index < _high_water) {
+            ++_reused;
+        }
+        _high_water = std::max(_high_water, index + 1);
+        ++_allocated;
+
+        _cpu_materials[index] = data;
+        upload_range(index, 1);
     }
 
     MaterialDrawData draw_data;
@@ -116,9 +181,10 @@ void MaterialAllocator::recycle(MaterialDrawData* data) {
     y_debug_assert(!data->is_null());
     y_debug_assert(data->_parent == this);
 
-    _free.locked([&](auto&& free) {
-        free << data->_index;
-    });
+    {
+        const auto lock = std::unique_lock(_lock);
+        _free << data->_index;
+    }
 
     for(const auto& tex : data->_textures) {
         texture_library().remove_texture(tex);
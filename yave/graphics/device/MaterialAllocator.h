@@ -31,30 +31,55 @@ SOFTWARE.
 
 #include <y/core/Vector.h>
 
+#include <mutex>
+
 
 namespace yave {
 
 class MaterialAllocator : NonMovable {
+
+    using MaterialBuffer = TypedBuffer<shader::MaterialData, BufferUsage::StorageBit | BufferUsage::TransferDstBit, MemoryType::DeviceLocal>;
+
     public:
-        static constexpr usize max_materials = 2 * 1024;
+        static constexpr usize material_page_size = 1024;
+        static constexpr usize default_material_count = 2 * material_page_size;
 
         MaterialAllocator();
         ~MaterialAllocator();
 
         MaterialDrawData allocate_material(const MaterialData& material);
 
-        TypedSubBuffer<shader::MaterialData, BufferUsage::StorageBit> material_buffer() const {
-            return _materials;
-        }
+        // The buffer is reallocated when it grows: it should not be kept across frames.
+        // It never shrinks, but materials allocated after it was fetched can have indices past its end:
+        // indices should be checked against the size of the buffer that is actually bound (see CollectBatchesSubPass).
+        TypedSubBuffer<shader::MaterialData, BufferUsage::StorageBit> material_buffer() const;
+
+        usize capacity() const;
+        usize allocated() const;
+
+        // Number of materials that were allocated in a recycled slot
+        u64 reused_allocations() const;
+        u64 total_allocations() const;
 
     private:
         friend class MaterialDrawData;
 
         void recycle(MaterialDrawData* data);
 
-        TypedBuffer<shader::MaterialData, BufferUsage::StorageBit, MemoryType::CpuVisible> _materials;
-        ProfiledMutexed<core::Vector<u32>> _free;
+        void grow(usize new_capacity);
+        void upload_range(u32 first, u32 count);
+
+        MaterialBuffer _materials;
+
+        // CPU side copy of _materials, used to fill the buffer when it grows
+        core::Vector<shader::MaterialData> _cpu_materials;
+        core::Vector<u32> _free;
+
+        u32 _high_water = 0;
+        u64 _allocated = 0;
+        u64 _reused = 0;
 
+        mutable ProfiledLock<> _lock;
 };
 
 }
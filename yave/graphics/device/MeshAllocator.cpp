@@ -22,23 +22,21 @@ SOFTWARE.
 
 #include "MeshAllocator.h"
 
-#include <yave/graphics/commands/CmdQueue.h>
+#include <yave/graphics/device/UploadQueue.h>
 #include <yave/graphics/graphics.h>
 
 #include <yave/graphics/device/DebugUtils.h>
+#include <yave/graphics/device/LifetimeManager.h>
+#include <yave/graphics/barriers/Barrier.h>
 
-#include <y/core/FixedArray.h>
+#include <y/core/ScratchPad.h>
 #include <y/utils/memory.h>
 
 #include <y/utils/format.h>
 
 namespace yave {
 
-MeshAllocator::MeshAllocator() : _triangle_buffer(default_triangle_count) {
-
-    _free_blocks << FreeBlock {
-        0, default_triangle_count
-    };
+MeshAllocator::MeshAllocator() : _triangle_buffer(default_triangle_count), _triangle_allocator(default_triangle_count) {
 
 #ifdef Y_DEBUG
     if(const auto* debug = debug_utils()) {
@@ -50,12 +48,17 @@ MeshAllocator::MeshAllocator() : _triangle_buffer(default_triangle_count) {
 MeshAllocator::~MeshAllocator() {
     const auto lock = std::unique_lock(_lock);
 
-    sort_and_compact_blocks();
+    // All cmd buffers have completed at this point
+    collect_pending_frees(true);
+
+    y_always_assert(_triangle_allocator.available() == _triangle_allocator.size(), "Not all mesh memory has been released");
+}
 
-    y_always_assert(_free_blocks.size() == 1, "Not all mesh memory has been released: mesh heap fragmented");
+MeshDrawData MeshAllocator::alloc_mesh(const MeshVertexStreams& streams, core::Span<IndexedTriangle> triangles, bool quantize) {
+    return alloc_mesh(quantize ? QuantizedVertexStreams::quantize(streams) : QuantizedVertexStreams::full_precision(streams), triangles);
 }
 
-MeshDrawData MeshAllocator::alloc_mesh(const MeshVertexStreams& streams, core::Span<IndexedTriangle> triangles) {
+MeshDrawData MeshAllocator::alloc_mesh(const QuantizedVertexStreams& streams, core::Span<IndexedTriangle> triangles) {
     y_profile();
 
     const u64 triangle_count = triangles.size();
@@ -64,20 +67,12 @@ MeshDrawData MeshAllocator::alloc_mesh(const MeshVertexStreams& streams, core::S
     MeshDrawData mesh_data;
     mesh_data._parent = this;
     mesh_data._vertex_count = u32(streams.vertex_count());
-    mesh_data._cmd.index_count = u32(triangles.size() * 3);
+    mesh_data._mesh_buffers.position_decode = streams.position_decode_transform();
 
     const u64 triangle_begin = alloc_block(triangle_count);
-    y_always_assert(triangle_begin + triangle_count <= _triangle_buffer.size(), "Triangle buffer pool is full");
+    y_debug_assert(triangle_begin + triangle_count <= _triangle_buffer.size());
 
-    TransferCmdBufferRecorder recorder = create_disposable_transfer_cmd_buffer();
-
-    auto staged_copy = [&](const SubBuffer<BufferUsage::TransferDstBit>& dst, const void* data) {
-        y_debug_assert(data);
-        const u64 dst_size = dst.byte_size();
-        const StagingBuffer buffer(dst_size);
-        std::memcpy(buffer.map_bytes(MappingAccess::WriteOnly).raw_data(), data, dst_size);
-        recorder.unbarriered_copy(buffer, dst);
-    };
+    UploadQueue& uploads = upload_queue();
 
     {
         /*
@@ -85,8 +80,7 @@ MeshDrawData MeshAllocator::alloc_mesh(const MeshVertexStreams& streams, core::S
          * Locking in triangle_buffer might be the best option
          */
         MutableTriangleSubBuffer triangle_buffer(_triangle_buffer, triangle_count * sizeof(IndexedTriangle), triangle_begin * sizeof(IndexedTriangle));
-        staged_copy(triangle_buffer, triangles.data());
-        mesh_data._cmd.first_index = u32(triangle_begin * 3);
+        uploads.upload(triangle_buffer, core::Span<u8>(reinterpret_cast<const u8*>(triangles.data()), triangles.size() * sizeof(IndexedTriangle)));
     }
 
     {
@@ -97,7 +91,7 @@ MeshDrawData MeshAllocator::alloc_mesh(const MeshVertexStreams& streams, core::S
         if(_free.is_empty()) {
             const usize new_size = std::max(1024_uu, _mesh_datas.size() * 2);
             TypedDataBuffer<shader::StaticMeshData> new_mesh_datas(new_size);
-            recorder.unbarriered_copy(_mesh_datas, SubBuffer<BufferUsage::TransferDstBit>(new_mesh_datas, _mesh_datas.byte_size(), 0));
+            uploads.copy(_mesh_datas, SubBuffer<BufferUsage::TransferDstBit>(new_mesh_datas, _mesh_datas.byte_size(), 0));
             for(usize i = new_mesh_datas.size(); i != _mesh_datas.size(); --i) {
                 _free << u32(i - 1);
             }
@@ -109,6 +103,12 @@ MeshDrawData MeshAllocator::alloc_mesh(const MeshVertexStreams& streams, core::S
         mesh_data._mesh_data_index = index;
 
         _mesh_buffers.set_min_size(index + 1);
+        _triangle_ranges.set_min_size(index + 1);
+
+        // Only registered once the upload has been recorded, so that defragmentation can not move it before
+        y_debug_assert(!_triangle_ranges[index]);
+        _triangle_ranges[index] = std::make_unique<MeshTriangleRange>(u32(triangle_begin), u32(triangle_count));
+        mesh_data._triangles = _triangle_ranges[index].get();
 
         Buffers& buffers = _mesh_buffers[index];
         for(usize i = 0; i != stream_count; ++i) {
@@ -116,7 +116,8 @@ MeshDrawData MeshAllocator::alloc_mesh(const MeshVertexStreams& streams, core::S
             y_debug_assert(!data.is_empty());
 
             mesh_data._mesh_buffers.attribs[i] = (buffers[i] = VertexBuffer(data.size()));
-            staged_copy(buffers[i], data.data());
+            mesh_data._mesh_buffers.formats[i] = streams.format(VertexStreamType(i));
+            uploads.upload(buffers[i], data);
 
 #ifdef Y_DEBUG
             if(const auto* debug = debug_utils()) {
@@ -125,19 +126,26 @@ MeshDrawData MeshAllocator::alloc_mesh(const MeshVertexStreams& streams, core::S
 #endif
         }
 
-        TypedStagingBuffer<shader::StaticMeshData> staging(1);
-        staging.map(MappingAccess::WriteOnly)[0] = shader::StaticMeshData {
+        const shader::StaticMeshData static_mesh_data = {
             buffers[usize(VertexStreamType::Position)].vk_device_address(),
             buffers[usize(VertexStreamType::NormalTangent)].vk_device_address(),
             buffers[usize(VertexStreamType::Uv)].vk_device_address(),
-            {}
+            streams.format(VertexStreamType::Position),
+            streams.format(VertexStreamType::NormalTangent),
+            streams.format(VertexStreamType::Uv),
+            0, {},
+            math::Vec4(streams.position_offset(), 0.0f),
+            math::Vec4(streams.position_scale(), 0.0f),
+            streams.uv_offset_scale(),
         };
 
         const u64 item_size = sizeof(shader::StaticMeshData);
-        recorder.unbarriered_copy(staging, SubBuffer<BufferUsage::TransferDstBit>(_mesh_datas, item_size, item_size * index));
-    }
+        uploads.upload(SubBuffer<BufferUsage::TransferDstBit>(_mesh_datas, item_size, item_size * index), core::Span<u8>(reinterpret_cast<const u8*>(&static_mesh_data), item_size));
 
-    recorder.submit_async();
+        if(_triangle_allocator.fragmentation() > auto_defragment_threshold) {
+            defragment_locked(auto_defragment_triangle_budget);
+        }
+    }
 
     return mesh_data;
 }
@@ -145,21 +153,24 @@ MeshDrawData MeshAllocator::alloc_mesh(const MeshVertexStreams& streams, core::S
 void MeshAllocator::recycle(MeshDrawData* data) {
     const auto lock = std::unique_lock(_lock);
 
-    y_debug_assert(data->_mesh_data_index != u32(-1));
-    y_debug_assert(_mesh_buffers.size() > data->_mesh_data_index);
-    y_debug_assert(!_mesh_buffers[data->_mesh_data_index][0].is_null());
+    const u32 index = data->_mesh_data_index;
 
-    _should_compact = true;
-    _free_blocks << FreeBlock {
-        u64(data->_cmd.first_index) / 3,
-        u64(data->_cmd.index_count) / 3,
-    };
+    y_debug_assert(index != u32(-1));
+    y_debug_assert(_mesh_buffers.size() > index);
+    y_debug_assert(!_mesh_buffers[index][0].is_null());
+    y_debug_assert(_triangle_ranges[index].get() == data->_triangles);
 
-    _free << data->_mesh_data_index;
-    _mesh_buffers[data->_mesh_data_index] = {};
+    // Recycling is deferred by the lifetime manager, so the range is no longer in use
+    const MeshTriangleRange& range = *_triangle_ranges[index];
+    _triangle_allocator.free(range.first_triangle, range.triangle_count);
+
+    _free << index;
+    _mesh_buffers[index] = {};
+    _triangle_ranges[index] = nullptr;
 
     {
         data->_parent = nullptr;
+        data->_triangles = nullptr;
         data->_mesh_data_index = u32(-1);
         data->_mesh_buffers = {};
     }
@@ -170,72 +181,127 @@ void MeshAllocator::recycle(MeshDrawData* data) {
 u64 MeshAllocator::alloc_block(u64 triangle_count) {
     const auto lock = std::unique_lock(_lock);
 
-    sort_and_compact_blocks();
+    collect_pending_frees();
 
-    for(auto& block : _free_blocks) {
-        if(block.triangle_count < triangle_count) {
-            continue;
+    const u64 offset = _triangle_allocator.alloc(triangle_count);
+    if(offset == core::RangeAllocator::invalid_offset) {
+        if(_triangle_allocator.available() >= triangle_count) {
+            y_fatal("Unable to alloc mesh data: triangle buffer is too fragmented");
         }
+        y_fatal("Unable to alloc mesh data: triangle buffer is full");
+    }
 
-        const u64 triangle_offset = block.triangle_offset;
+    return offset;
+}
 
-        block.triangle_offset += triangle_count;
-        block.triangle_count -= triangle_count;
+void MeshAllocator::collect_pending_frees(bool force) {
+    y_debug_assert(!_lock.try_lock());
 
-        return triangle_offset;
+    while(!_pending_frees.is_empty()) {
+        const PendingFree& pending = _pending_frees.first();
+        if(!force && !lifetime_manager().is_collected(pending.fence)) {
+            break;
+        }
+        _triangle_allocator.free(pending.triangle_offset, pending.triangle_count);
+        _pending_frees.pop_front();
     }
+}
 
-    y_fatal("Unable to alloc mesh data");
+u64 MeshAllocator::defragment(u64 max_triangles) {
+    const auto lock = std::unique_lock(_lock);
+    return defragment_locked(max_triangles);
 }
 
-void MeshAllocator::sort_and_compact_blocks() {
+u64 MeshAllocator::defragment_locked(u64 max_triangles) {
     y_profile();
 
     y_debug_assert(!_lock.try_lock());
 
-    const usize block_count = _free_blocks.size();
-    if(!_should_compact || block_count < 2) {
-        return;
+    collect_pending_frees();
+
+    if(_triangle_allocator.free_range_count() < 2) {
+        return 0;
     }
 
-    _should_compact = false;
+    // Move the meshes furthest from the start first, they are the most likely to end up in the last free range
+    core::ScratchVector<MeshTriangleRange*> ranges(_triangle_ranges.size());
+    for(const auto& range : _triangle_ranges) {
+        if(range) {
+            ranges.emplace_back(range.get());
+        }
+    }
 
-    std::sort(_free_blocks.begin(), _free_blocks.end(), [](const auto& a, const auto& b) {
-        return a.triangle_offset < b.triangle_offset;
+    std::sort(ranges.begin(), ranges.end(), [](const MeshTriangleRange* a, const MeshTriangleRange* b) {
+        return a->first_triangle > b->first_triangle;
     });
 
-    usize dst = 0;
-    for(usize i = 1; i != block_count; ++i) {
-        const u64 dst_end = _free_blocks[dst].triangle_offset + _free_blocks[dst].triangle_count;
-        if(_free_blocks[i].triangle_offset == dst_end) {
-            y_debug_assert(_free_blocks[dst].triangle_offset + _free_blocks[dst].triangle_count == _free_blocks[i].triangle_offset);
-            _free_blocks[dst].triangle_count += _free_blocks[i].triangle_count;
-        } else {
-            ++dst;
-            _free_blocks[dst] = _free_blocks[i];
+    UploadQueue& uploads = upload_queue();
+
+    // Moved ranges might still be written by uploads recorded in the same batch
+    uploads.barrier(BufferBarrier(_triangle_buffer, PipelineStage::TransferBit, PipelineStage::TransferBit));
+
+    u64 moved = 0;
+    usize first_pending = _pending_frees.size();
+    for(MeshTriangleRange* range : ranges) {
+        const u64 src_offset = range->first_triangle;
+        const u64 triangle_count = range->triangle_count;
+
+        if(moved + triangle_count > max_triangles) {
+            continue;
+        }
+
+        const u64 dst_offset = _triangle_allocator.alloc(triangle_count);
+        if(dst_offset == core::RangeAllocator::invalid_offset) {
+            continue;
         }
+
+        if(dst_offset > src_offset) {
+            _triangle_allocator.free(dst_offset, triangle_count);
+            continue;
+        }
+
+        const u64 byte_size = triangle_count * sizeof(IndexedTriangle);
+        uploads.copy(
+            SubBuffer<BufferUsage::TransferSrcBit>(_triangle_buffer, byte_size, src_offset * sizeof(IndexedTriangle)),
+            SubBuffer<BufferUsage::TransferDstBit>(_triangle_buffer, byte_size, dst_offset * sizeof(IndexedTriangle))
+        );
+
+        range->first_triangle.store(u32(dst_offset), std::memory_order_release);
+        _pending_frees.emplace_back(PendingFree{ResourceFence(), src_offset, triangle_count});
+
+        moved += triangle_count;
     }
 
-    _free_blocks.shrink_to(dst + 1);
+    // Queried after patching the ranges: anything recorded with the old offsets was created before
+    const ResourceFence fence = lifetime_manager().next_fence();
+    for(; first_pending != _pending_frees.size(); ++first_pending) {
+        _pending_frees[first_pending].fence = fence;
+    }
+
+    y_profile_msg(fmt_c_str("{} triangles moved", moved));
+
+    return moved;
 }
 
 
 u64 MeshAllocator::available() const {
     const auto lock = std::unique_lock(_lock);
-    u64 tris = 0;
-    for(const auto& b : _free_blocks) {
-        tris += b.triangle_count;
-    }
-    return tris;
+    return _triangle_allocator.available();
 }
 
 u64 MeshAllocator::allocated() const {
-    return default_triangle_count - available();
+    const auto lock = std::unique_lock(_lock);
+    return _triangle_allocator.allocated();
 }
 
 usize MeshAllocator::free_blocks() const {
     const auto lock = std::unique_lock(_lock);
-    return _free_blocks.size();
+    return _triangle_allocator.free_range_count();
+}
+
+float MeshAllocator::fragmentation() const {
+    const auto lock = std::unique_lock(_lock);
+    return _triangle_allocator.fragmentation();
 }
 
 const TriangleBuffer<>& MeshAllocator::triangle_buffer() const {
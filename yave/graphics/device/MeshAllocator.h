@@ -24,11 +24,16 @@ SOFTWARE.
 
 #include <yave/graphics/buffers/Buffer.h>
 #include <yave/meshes/MeshDrawData.h>
+#include <yave/meshes/QuantizedVertexStreams.h>
 
 #include <yave/graphics/shader_structs.h>
 
+#include <yave/graphics/commands/CmdBufferData.h>
+
 #include <y/core/Span.h>
 #include <y/core/Vector.h>
+#include <y/core/RangeAllocator.h>
+#include <y/core/RingQueue.h>
 
 #include <mutex>
 
@@ -45,7 +50,8 @@ class MeshAllocator : NonMovable {
     template<typename T>
     using TypedDataBuffer = TypedBuffer<T, BufferUsage::StorageBit | BufferUsage::TransferDstBit | BufferUsage::TransferSrcBit, MemoryType::DeviceLocal>;
 
-    struct FreeBlock {
+    struct PendingFree {
+        ResourceFence fence;
         u64 triangle_offset;
         u64 triangle_count;
     };
@@ -53,16 +59,26 @@ class MeshAllocator : NonMovable {
     public:
         static const u64 default_triangle_count = 8 * 1024 * 1024;
 
+        // Above this, alloc_mesh will incrementally defragment the triangle buffer
+        static constexpr float auto_defragment_threshold = 0.5f;
+        static const u64 auto_defragment_triangle_budget = 256 * 1024;
+
         MeshAllocator();
         ~MeshAllocator();
 
-        MeshDrawData alloc_mesh(const MeshVertexStreams& streams, core::Span<IndexedTriangle> triangles);
+        MeshDrawData alloc_mesh(const MeshVertexStreams& streams, core::Span<IndexedTriangle> triangles, bool quantize = false);
+        MeshDrawData alloc_mesh(const QuantizedVertexStreams& streams, core::Span<IndexedTriangle> triangles);
+
+        // Moves meshes toward the start of the triangle buffer, returns the number of moved triangles.
+        // Moved ranges are only reused once every cmd buffer that might still reference them has completed.
+        u64 defragment(u64 max_triangles = u64(-1));
 
         SubBuffer<BufferUsage::StorageBit> mesh_data_buffer() const;
 
-        u64 available() const; // slow!
-        u64 allocated() const; // slow!
+        u64 available() const;
+        u64 allocated() const;
         usize free_blocks() const;
+        float fragmentation() const;
 
         const TriangleBuffer<>& triangle_buffer() const;
 
@@ -71,16 +87,19 @@ class MeshAllocator : NonMovable {
 
         void recycle(MeshDrawData* data);
         u64 alloc_block(u64 triangle_count);
-        void sort_and_compact_blocks();
+
+        void collect_pending_frees(bool force = false);
+        u64 defragment_locked(u64 max_triangles);
 
         TriangleBuffer<> _triangle_buffer;
 
-        core::Vector<FreeBlock> _free_blocks;
-        bool _should_compact = false;
+        core::RangeAllocator _triangle_allocator;
+        core::RingQueue<PendingFree> _pending_frees;
         mutable ProfiledLock<> _lock;
 
         core::Vector<u32> _free;
         core::Vector<Buffers> _mesh_buffers;
+        core::Vector<std::unique_ptr<MeshTriangleRange>> _triangle_ranges;
         TypedDataBuffer<shader::StaticMeshData> _mesh_datas;
 };
 
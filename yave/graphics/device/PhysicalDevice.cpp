@@ -91,6 +91,7 @@ DeviceProperties PhysicalDevice::device_properties() const {
     properties.max_uniform_buffer_size = limits.maxUniformBufferRange;
     properties.uniform_buffer_alignment = limits.minUniformBufferOffsetAlignment;
     properties.storage_buffer_alignment = limits.minStorageBufferOffsetAlignment;
+    properties.buffer_image_granularity = limits.bufferImageGranularity;
 
     properties.max_memory_allocations = limits.maxMemoryAllocationCount;
 
@@ -0,0 +1,230 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "PipelineCache.h"
+#include "PhysicalDevice.h"
+
+#include <yave/graphics/graphics.h>
+#include <yave/utils/FileSystemModel.h>
+
+#include <y/core/Vector.h>
+#include <y/io2/File.h>
+
+#include <y/utils/log.h>
+#include <y/utils/format.h>
+#include <y/utils/hash.h>
+
+#include <cstring>
+
+namespace yave {
+
+static constexpr const char* pipeline_cache_file = "pipeline_cache.bin";
+
+static constexpr u32 pipeline_cache_magic = 0x43505659; // "YVPC"
+static constexpr u32 pipeline_cache_version = 1;
+
+struct PipelineCacheHeader {
+    u32 magic;
+    u32 version;
+    u32 vendor_id;
+    u32 device_id;
+    u32 driver_version;
+    u8 uuid[VK_UUID_SIZE];
+    u64 data_size;
+    u64 data_hash;
+};
+
+static PipelineCacheHeader create_header() {
+    PipelineCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+
+    const VkPhysicalDeviceProperties& properties = physical_device().vk_properties();
+    header.magic = pipeline_cache_magic;
+    header.version = pipeline_cache_version;
+    header.vendor_id = properties.vendorID;
+    header.device_id = properties.deviceID;
+    header.driver_version = properties.driverVersion;
+    std::memcpy(header.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    return header;
+}
+
+static u64 checksum(core::Span<u8> data) {
+    u64 hash = data.size();
+    usize i = 0;
+    for(; i + sizeof(u64) <= data.size(); i += sizeof(u64)) {
+        u64 word = 0;
+        std::memcpy(&word, data.data() + i, sizeof(u64));
+        hash_combine(hash, u64(hash_u64(word)));
+    }
+    for(; i != data.size(); ++i) {
+        hash_combine(hash, u64(data[i]));
+    }
+    return hash;
+}
+
+static core::Vector<u8> load_cache_data() {
+    y_profile();
+
+    auto file = io2::File::open(pipeline_cache_file);
+    if(!file) {
+        log_msg("No pipeline cache found");
+        return {};
+    }
+
+    PipelineCacheHeader header;
+    if(!file.unwrap().read_one(header)) {
+        log_msg("Pipeline cache is corrupted", Log::Warning);
+        return {};
+    }
+
+    // Don't trust the header before allocating anything: the data must fill the rest of the file exactly
+    const usize file_size = file.unwrap().size();
+    if(file_size < sizeof(header) || header.data_size != file_size - sizeof(header)) {
+        log_msg("Pipeline cache is corrupted", Log::Warning);
+        return {};
+    }
+
+    const PipelineCacheHeader expected = create_header();
+    const bool same_driver =
+        header.magic == expected.magic &&
+        header.version == expected.version &&
+        header.vendor_id == expected.vendor_id &&
+        header.device_id == expected.device_id &&
+        header.driver_version == expected.driver_version &&
+        std::memcmp(header.uuid, expected.uuid, VK_UUID_SIZE) == 0;
+
+    if(!same_driver) {
+        log_msg("Pipeline cache was created by a different driver and will be discarded", Log::Warning);
+        return {};
+    }
+
+    core::Vector<u8> data(usize(header.data_size), u8(0));
+    if(!file.unwrap().read(data.data(), data.size()) || checksum(data) != header.data_hash) {
+        log_msg("Pipeline cache is corrupted", Log::Warning);
+        return {};
+    }
+
+    return data;
+}
+
+
+PipelineCache::PipelineCache(bool load_from_disk) {
+    y_profile();
+
+    core::Vector<u8> data;
+    if(load_from_disk) {
+        data = load_cache_data();
+    }
+
+    VkPipelineCacheCreateInfo create_info = vk_struct();
+    {
+        create_info.initialDataSize = data.size();
+        create_info.pInitialData = data.data();
+    }
+
+    if(vkCreatePipelineCache(vk_device(), &create_info, vk_allocation_callbacks(), &_cache) != VK_SUCCESS) {
+        // Should not happen, but we can always fall back to an empty cache
+        log_msg("Unable to use pipeline cache data", Log::Warning);
+        create_info.initialDataSize = 0;
+        create_info.pInitialData = nullptr;
+        vk_check(vkCreatePipelineCache(vk_device(), &create_info, vk_allocation_callbacks(), &_cache));
+    } else {
+        _loaded_bytes = data.size();
+    }
+
+    log_msg(fmt("Pipeline cache: {} ({}KB)", _loaded_bytes ? "warm" : "cold", _loaded_bytes / 1024));
+}
+
+PipelineCache::~PipelineCache() {
+    const Stats s = stats();
+    log_msg(fmt("{} pipelines created in {}ms with a {} pipeline cache", s.pipeline_count, s.creation_time.to_millis(), s.is_warm ? "warm" : "cold"));
+
+    save();
+    vkDestroyPipelineCache(vk_device(), _cache, vk_allocation_callbacks());
+}
+
+VkPipelineCache PipelineCache::vk_pipeline_cache() const {
+    return _cache;
+}
+
+void PipelineCache::save() const {
+    y_profile();
+
+    usize size = 0;
+    vk_check(vkGetPipelineCacheData(vk_device(), _cache, &size, nullptr));
+
+    core::Vector<u8> data(size, u8(0));
+    vk_check(vkGetPipelineCacheData(vk_device(), _cache, &size, data.data()));
+    data.shrink_to(size);
+
+    PipelineCacheHeader header = create_header();
+    header.data_size = data.size();
+    header.data_hash = checksum(data);
+
+    // Write to a temporary file first so that a crash while saving doesn't corrupt the previous cache
+    const core::String tmp_file = core::String(pipeline_cache_file) + "_";
+    {
+        auto file = io2::File::create(tmp_file);
+        if(!file || !file.unwrap().write_one(header) || !file.unwrap().write(data.data(), data.size())) {
+            log_msg("Unable to write pipeline cache", Log::Error);
+            return;
+        }
+    }
+
+    if(!FileSystemModel::local_filesystem()->rename(tmp_file, pipeline_cache_file)) {
+        log_msg("Unable to write pipeline cache", Log::Error);
+    }
+}
+
+void PipelineCache::on_frame_presented() {
+    if(!_first_frame_presented) {
+        _first_frame_presented = true;
+        _first_frame_time = _startup_timer.elapsed();
+        log_msg(fmt("First frame presented after {}ms with a {} pipeline cache ({} pipelines created in {}ms)",
+            _first_frame_time.to_millis(), _loaded_bytes ? "warm" : "cold", _pipeline_count.load(), core::Duration::nanoseconds(_creation_time_ns).to_millis()), Log::Perf);
+    }
+
+    const usize pipeline_count = _pipeline_count;
+    if(pipeline_count != _saved_pipeline_count && _save_timer.elapsed().to_secs() > save_interval_secs) {
+        _saved_pipeline_count = pipeline_count;
+        _save_timer.reset();
+        save();
+    }
+}
+
+void PipelineCache::register_pipeline(core::Duration creation_time) {
+    ++_pipeline_count;
+    _creation_time_ns += creation_time.to_nanos();
+}
+
+PipelineCache::Stats PipelineCache::stats() const {
+    return Stats {
+        _pipeline_count,
+        core::Duration::nanoseconds(_creation_time_ns),
+        _first_frame_time,
+        _loaded_bytes,
+        _loaded_bytes != 0,
+    };
+}
+
+}
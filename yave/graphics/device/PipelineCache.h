@@ -0,0 +1,85 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_DEVICE_PIPELINECACHE_H
+#define YAVE_DEVICE_PIPELINECACHE_H
+
+#include <yave/graphics/vk/vk.h>
+
+#include <y/core/Chrono.h>
+
+#include <atomic>
+
+namespace yave {
+
+// Device wide pipeline cache, persisted on disk between runs.
+// The file is discarded if it wasn't written by the same driver (see VkPhysicalDeviceProperties::pipelineCacheUUID).
+// New pipelines are saved periodically so that a crash doesn't lose the whole cache.
+class PipelineCache : NonMovable {
+    public:
+        static constexpr double save_interval_secs = 10.0;
+
+        struct Stats {
+            usize pipeline_count = 0;
+            core::Duration creation_time;
+
+            // Time between the creation of the cache (with the device) and the first presented frame
+            core::Duration first_frame_time;
+
+            usize loaded_bytes = 0;
+            bool is_warm = false;
+        };
+
+        PipelineCache(bool load_from_disk = true);
+        ~PipelineCache();
+
+        VkPipelineCache vk_pipeline_cache() const;
+
+        // Writes the current content of the cache to disk, can be called at any time
+        void save() const;
+
+        // Called from the main thread after every present: records the time to the first frame
+        // and saves the cache if pipelines were created since the last save
+        void on_frame_presented();
+
+        // Used to compare startup times with cold and warm caches
+        void register_pipeline(core::Duration creation_time);
+        Stats stats() const;
+
+    private:
+        VkPipelineCache _cache = {};
+
+        usize _loaded_bytes = 0;
+
+        std::atomic<usize> _pipeline_count = 0;
+        std::atomic<u64> _creation_time_ns = 0;
+
+        core::StopWatch _startup_timer;
+        core::Duration _first_frame_time;
+        bool _first_frame_presented = false;
+
+        core::StopWatch _save_timer;
+        usize _saved_pipeline_count = 0;
+};
+
+}
+
+#endif // YAVE_DEVICE_PIPELINECACHE_H
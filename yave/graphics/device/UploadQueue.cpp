@@ -0,0 +1,176 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include "UploadQueue.h"
+#include "UploadRing.h"
+
+#include <yave/graphics/graphics.h>
+#include <yave/graphics/commands/CmdQueue.h>
+#include <yave/graphics/commands/CmdBufferPool.h>
+#include <yave/graphics/barriers/Barrier.h>
+#include <yave/graphics/images/Image.h>
+#include <yave/graphics/images/ImageData.h>
+
+#include <y/core/ScratchPad.h>
+#include <y/utils/format.h>
+
+#include <cstring>
+
+namespace yave {
+
+static core::ScratchPad<VkBufferImageCopy> get_copy_regions(const ImageData& data, u64 buffer_offset) {
+    core::ScratchPad<VkBufferImageCopy> regions(data.mipmaps());
+
+    usize index = 0;
+    for(usize m = 0; m != data.mipmaps(); ++m) {
+        const auto size = data.mip_size(m);
+        VkBufferImageCopy copy = {};
+        {
+            copy.bufferOffset = buffer_offset + data.data_offset(m);
+            copy.imageExtent = {size.x(), size.y(), size.z()};
+            copy.imageSubresource.aspectMask = data.format().vk_aspect();
+            copy.imageSubresource.mipLevel = u32(m);
+            copy.imageSubresource.baseArrayLayer = 0;
+            copy.imageSubresource.layerCount = 1;
+        }
+        regions[index++] = copy;
+    }
+
+    return regions;
+}
+
+
+UploadQueue::UploadQueue(CmdQueue& queue) :
+        _queue(&queue),
+        _pool(std::make_unique<CmdBufferPool>(&queue, false)) {
+
+    y_debug_assert(!_queue->_upload_queue);
+    _queue->_upload_queue = this;
+}
+
+UploadQueue::~UploadQueue() {
+    y_debug_assert(_queue->_upload_queue == this);
+    _queue->_upload_queue = nullptr;
+
+    flush();
+
+    // Destroying the pool will submit and wait, so it needs to be done without holding the lock
+    std::unique_ptr<CmdBufferPool> pool;
+    {
+        const std::unique_lock lock(_lock);
+        pool = std::move(_pool);
+    }
+}
+
+usize UploadQueue::pending_uploads() const {
+    const std::unique_lock lock(_lock);
+    return _pending;
+}
+
+TransferCmdBufferRecorder& UploadQueue::batch_recorder() {
+    y_debug_assert(!_lock.try_lock());
+
+    // The cmd buffer is created by the first upload of the batch, so that any destination
+    // destroyed before the batch is submitted will be kept alive until it has been completed
+    if(!_recorder) {
+        _recorder = _pool->create_transfer_cmd_buffer();
+    }
+
+    ++_pending;
+    return *_recorder;
+}
+
+void UploadQueue::upload(SubBuffer<BufferUsage::TransferDstBit> dst, core::Span<u8> data) {
+    y_profile();
+
+    y_always_assert(dst.byte_size() == data.size(), "Upload size does not match buffer size");
+    if(data.is_empty()) {
+        return;
+    }
+
+    const std::unique_lock lock(_lock);
+
+    TransferCmdBufferRecorder& recorder = batch_recorder();
+
+    const auto staging = upload_ring().allocate(recorder, data.size());
+    std::memcpy(staging.map_bytes(MappingAccess::WriteOnly).data(), data.data(), data.size());
+
+    recorder.unbarriered_copy(staging, dst);
+}
+
+void UploadQueue::upload(const ImageBase& image, const ImageData& data) {
+    y_profile();
+
+    const std::unique_lock lock(_lock);
+
+    TransferCmdBufferRecorder& recorder = batch_recorder();
+
+    const auto staging = upload_ring().allocate(recorder, data.byte_size());
+    {
+        y_profile_zone("copy");
+        auto mapping = staging.map_bytes(MappingAccess::WriteOnly);
+        if(data.data()) {
+            std::memcpy(mapping.data(), data.data(), data.byte_size());
+        } else {
+            std::memset(mapping.data(), 0, data.byte_size());
+        }
+    }
+
+    const auto regions = get_copy_regions(data, staging.byte_offset());
+
+    recorder.barriers({ImageBarrier::transition_barrier(image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)});
+    vkCmdCopyBufferToImage(recorder.vk_cmd_buffer(), staging.vk_buffer(), image.vk_image(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, u32(regions.size()), regions.data());
+    recorder.barriers({ImageBarrier::transition_barrier(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, vk_image_layout(image.usage()))});
+}
+
+void UploadQueue::copy(SubBuffer<BufferUsage::TransferSrcBit> src, SubBuffer<BufferUsage::TransferDstBit> dst) {
+    const std::unique_lock lock(_lock);
+    batch_recorder().unbarriered_copy(src, dst);
+}
+
+void UploadQueue::transition(const ImageBase& image) {
+    const std::unique_lock lock(_lock);
+    batch_recorder().barriers({ImageBarrier::transition_barrier(image, VK_IMAGE_LAYOUT_UNDEFINED, vk_image_layout(image.usage()))});
+}
+
+void UploadQueue::barrier(const BufferBarrier& barrier) {
+    const std::unique_lock lock(_lock);
+    if(_recorder) {
+        _recorder->barriers({barrier});
+    }
+}
+
+void UploadQueue::flush() {
+    const std::unique_lock lock(_lock);
+
+    if(!_recorder) {
+        return;
+    }
+
+    y_profile_msg(fmt_c_str("{} uploads", _pending));
+
+    // Every later submission on the queue will wait for this
+    _recorder->submit_async();
+    _recorder.reset();
+    _pending = 0;
+}
+
+}
@@ -0,0 +1,72 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_GRAPHICS_DEVICE_UPLOADQUEUE_H
+#define YAVE_GRAPHICS_DEVICE_UPLOADQUEUE_H
+
+#include <yave/graphics/buffers/Buffer.h>
+#include <yave/graphics/commands/CmdBufferRecorder.h>
+
+#include <y/core/Span.h>
+
+#include <optional>
+#include <memory>
+#include <mutex>
+
+namespace yave {
+
+// Batches resource uploads and initial layout transitions in a single transfer cmd buffer.
+// The batch is submitted right before anything else is submitted on the queue,
+// so uploads are always complete before any later cmd buffer executes.
+class UploadQueue : NonMovable {
+    public:
+        UploadQueue(CmdQueue& queue);
+        ~UploadQueue();
+
+        void upload(SubBuffer<BufferUsage::TransferDstBit> dst, core::Span<u8> data);
+        void upload(const ImageBase& image, const ImageData& data);
+
+        void copy(SubBuffer<BufferUsage::TransferSrcBit> src, SubBuffer<BufferUsage::TransferDstBit> dst);
+        void transition(const ImageBase& image);
+
+        // Synchronizes with what has already been recorded in the current batch
+        void barrier(const BufferBarrier& barrier);
+
+        void flush();
+
+        usize pending_uploads() const;
+
+    private:
+        TransferCmdBufferRecorder& batch_recorder();
+
+        CmdQueue* _queue = nullptr;
+
+        // Only ever accessed under _lock
+        std::unique_ptr<CmdBufferPool> _pool;
+        std::optional<TransferCmdBufferRecorder> _recorder;
+        usize _pending = 0;
+
+        mutable std::mutex _lock;
+};
+
+}
+
+#endif // YAVE_GRAPHICS_DEVICE_UPLOADQUEUE_H
@@ -0,0 +1,167 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#include "UploadRing.h"
+
+#include <yave/graphics/graphics.h>
+#include <yave/graphics/commands/CmdBufferRecorder.h>
+#include <yave/graphics/device/DebugUtils.h>
+
+#include <y/core/ScratchPad.h>
+#include <y/utils/memory.h>
+
+#include <cstring>
+
+namespace yave {
+
+UploadRing::UploadRing(u64 block_size) :
+        _block_size(block_size),
+        _alignment(std::max(RingSubBuffer::byte_alignment(), SubBufferBase::host_side_alignment())) {
+}
+
+UploadRing::~UploadRing() {
+    const std::unique_lock lock(_lock);
+    for(const Block& block : _retired) {
+        y_always_assert(lifetime_manager().is_collected(block.fence), "Upload ring block is still in use");
+    }
+    for(const Block& block : _oversized) {
+        y_always_assert(lifetime_manager().is_collected(block.fence), "Upload ring block is still in use");
+    }
+}
+
+usize UploadRing::block_count() const {
+    const std::unique_lock lock(_lock);
+    return _retired.size() + _oversized.size() + _free.size() + (_current.buffer.is_null() ? 0 : 1);
+}
+
+UploadRing::Block UploadRing::create_block(u64 byte_size) const {
+    y_profile();
+
+    Block block;
+    block.buffer = RingBuffer(byte_size);
+
+#ifdef Y_DEBUG
+    if(const auto* debug = debug_utils()) {
+        debug->set_resource_name(block.buffer.vk_buffer(), "Upload ring block");
+    }
+#endif
+
+    return block;
+}
+
+void UploadRing::collect_retired() {
+    // Fences are not ordered, every block has to be checked
+    for(usize i = 0; i < _retired.size();) {
+        if(lifetime_manager().is_collected(_retired[i].fence)) {
+            Block& block = _free.emplace_back(std::move(_retired[i]));
+            block.offset = 0;
+            _retired.erase_unordered(_retired.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+
+    // Oversized blocks are never reused
+    for(usize i = 0; i < _oversized.size();) {
+        if(lifetime_manager().is_collected(_oversized[i].fence)) {
+            _oversized.erase_unordered(_oversized.begin() + i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+void UploadRing::next_block() {
+    if(!_current.buffer.is_null()) {
+        _retired.push_back(std::move(_current));
+    }
+
+    collect_retired();
+
+    _current = _free.is_empty() ? create_block(_block_size) : _free.pop();
+}
+
+UploadRing::RingSubBuffer UploadRing::allocate(const CmdBufferRecorderBase& recorder, u64 byte_size) {
+    y_debug_assert(byte_size);
+
+    const ResourceFence fence = recorder.resource_fence();
+    const u64 aligned_size = align_up_to(byte_size, _alignment);
+
+    const std::unique_lock lock(_lock);
+
+    if(aligned_size > _block_size) {
+        // Too big for the ring: give it its own block, it will get dropped once no longer in use
+        Block& block = _oversized.emplace_back(create_block(aligned_size));
+        block.offset = aligned_size;
+        block.fence = fence;
+        return RingSubBuffer(block.buffer, byte_size, 0);
+    }
+
+    if(_current.buffer.is_null() || _current.offset + aligned_size > _block_size) {
+        next_block();
+    }
+
+    const u64 offset = _current.offset;
+    _current.offset += aligned_size;
+    _current.fence = std::max(_current.fence, fence);
+
+    y_debug_assert(offset % _alignment == 0);
+    return RingSubBuffer(_current.buffer, byte_size, offset);
+}
+
+void UploadRing::upload(CmdBufferRecorderBase& recorder, core::Span<Upload> uploads) {
+    y_profile();
+
+    u64 total_size = 0;
+    for(const Upload& upload : uploads) {
+        y_always_assert(upload.dst.byte_size() == upload.data.size(), "Upload size does not match buffer size");
+        total_size += upload.data.size();
+    }
+
+    if(!total_size) {
+        return;
+    }
+
+    const RingSubBuffer staging = allocate(recorder, total_size);
+
+    core::ScratchVector<std::pair<u64, usize>> copies(uploads.size());
+    {
+        auto mapping = staging.map_bytes(MappingAccess::WriteOnly);
+
+        u64 offset = 0;
+        for(usize i = 0; i != uploads.size(); ++i) {
+            const Upload& upload = uploads[i];
+            if(upload.data.is_empty()) {
+                continue;
+            }
+            std::memcpy(mapping.data() + offset, upload.data.data(), upload.data.size());
+            copies.emplace_back(offset, i);
+            offset += upload.data.size();
+        }
+    }
+
+    for(const auto& [offset, index] : copies) {
+        const Upload& upload = uploads[index];
+        recorder.unbarriered_copy(SubBuffer<BufferUsage::TransferSrcBit, memory_type>(staging, upload.data.size(), offset), upload.dst);
+    }
+}
+
+}
@@ -0,0 +1,99 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_GRAPHICS_DEVICE_UPLOADRING_H
+#define YAVE_GRAPHICS_DEVICE_UPLOADRING_H
+
+#include <yave/graphics/buffers/Buffer.h>
+#include <yave/graphics/buffers/buffers.h>
+#include <yave/graphics/commands/CmdBufferData.h>
+
+#include <y/core/Vector.h>
+#include <y/core/Span.h>
+
+#include <mutex>
+
+namespace yave {
+
+// Linearly suballocates transient CPU written data (staging, uniforms or storage)
+// from large persistently mapped blocks. Blocks are recycled once every cmd buffer
+// that used them has been collected by the lifetime manager.
+class UploadRing : NonMovable {
+    public:
+        static constexpr BufferUsage usage = BufferUsage::StorageBit | BufferUsage::UniformBit | BufferUsage::TransferSrcBit;
+        static constexpr MemoryType memory_type = MemoryType::Staging;
+
+        static constexpr u64 default_block_size = 4 * 1024 * 1024;
+
+        using RingBuffer = Buffer<usage, memory_type>;
+        using RingSubBuffer = SubBuffer<usage, memory_type>;
+
+        template<typename T>
+        using TypedRingSubBuffer = TypedSubBuffer<T, usage, memory_type>;
+
+        struct Upload {
+            SubBuffer<BufferUsage::TransferDstBit> dst;
+            core::Span<u8> data;
+        };
+
+        UploadRing(u64 block_size = default_block_size);
+        ~UploadRing();
+
+        // The returned buffer is only valid for the lifetime of recorder
+        RingSubBuffer allocate(const CmdBufferRecorderBase& recorder, u64 byte_size);
+
+        template<typename T>
+        TypedRingSubBuffer<T> allocate(const CmdBufferRecorderBase& recorder, usize size) {
+            return TypedRingSubBuffer<T>(allocate(recorder, TypedRingSubBuffer<T>::total_byte_size(std::max(usize(1), size))));
+        }
+
+        // Copies all the data in a single ring allocation and records all copies back to back.
+        // Barriers are left to the caller.
+        void upload(CmdBufferRecorderBase& recorder, core::Span<Upload> uploads);
+
+        usize block_count() const;
+
+    private:
+        struct Block {
+            RingBuffer buffer;
+            u64 offset = 0;
+            ResourceFence fence;
+        };
+
+        Block create_block(u64 byte_size) const;
+        void next_block();
+        void collect_retired();
+
+        // Blocks can be retired out of fence order: cmd buffers are not always submitted in creation order
+        core::Vector<Block> _retired;
+        core::Vector<Block> _oversized;
+        core::Vector<Block> _free;
+        Block _current;
+
+        const u64 _block_size;
+        const u64 _alignment;
+
+        mutable std::mutex _lock;
+};
+
+}
+
+#endif // YAVE_GRAPHICS_DEVICE_UPLOADRING_H
@@ -154,6 +154,11 @@ RenderPass::Layout::Layout(AttachmentData depth, core::Span<AttachmentData> colo
     std::transform(colors.begin(), colors.end(), _colors.begin(), [](const auto& e) { return e.format; });
 }
 
+RenderPass::Layout::Layout(ImageFormat depth, core::Span<ImageFormat> colors) : _depth(depth) {
+    y_always_assert(colors.size() <= _colors.size(), "Too many color attachments");
+    std::copy(colors.begin(), colors.end(), _colors.begin());
+}
+
 u64 RenderPass::Layout::hash() const {
     u64 h = u64(_depth.vk_format());
     for(const auto& c : _colors) {
@@ -166,6 +171,15 @@ bool RenderPass::Layout::is_depth_only() const {
     return !_colors[0].is_valid();
 }
 
+ImageFormat RenderPass::Layout::depth_format() const {
+    return _depth;
+}
+
+core::Span<ImageFormat> RenderPass::Layout::color_formats() const {
+    const auto end = std::find_if(_colors.begin(), _colors.end(), [](const ImageFormat& f) { return !f.is_valid(); });
+    return core::Span<ImageFormat>(_colors.data(), usize(end - _colors.begin()));
+}
+
 bool RenderPass::Layout::operator==(const Layout& other) const {
     return _depth == other._depth && _colors == other._colors;
 }
@@ -181,6 +195,22 @@ RenderPass::RenderPass(core::Span<AttachmentData> colors) :
         RenderPass(AttachmentData(), colors) {
 }
 
+RenderPass::RenderPass(const Layout& layout) : _layout(layout) {
+    // Only formats (and sample counts) matter for render pass compatibility
+    const core::Span<ImageFormat> color_formats = layout.color_formats();
+    auto colors = core::ScratchPad<AttachmentData>(color_formats.size());
+    std::transform(color_formats.begin(), color_formats.end(), colors.begin(), [](ImageFormat format) {
+        return AttachmentData(format, ImageUsage::ColorBit, LoadOp::Load);
+    });
+
+    const AttachmentData depth = layout.depth_format().is_valid()
+        ? AttachmentData(layout.depth_format(), ImageUsage::DepthBit, LoadOp::Load)
+        : AttachmentData();
+
+    _attachment_count = colors.size();
+    _render_pass = create_renderpass(depth, colors);
+}
+
 RenderPass::~RenderPass() {
     destroy_graphic_resource(std::move(_render_pass));
 }
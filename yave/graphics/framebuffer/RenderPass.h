@@ -62,10 +62,14 @@ class RenderPass {
             public:
                 Layout() = default;
                 Layout(AttachmentData depth, core::Span<AttachmentData> colors);
+                Layout(ImageFormat depth, core::Span<ImageFormat> colors);
 
                 u64 hash() const;
                 bool is_depth_only() const;
 
+                ImageFormat depth_format() const;
+                core::Span<ImageFormat> color_formats() const;
+
                 bool operator==(const Layout& other) const;
 
             private:
@@ -80,6 +84,9 @@ class RenderPass {
         RenderPass(AttachmentData depth, core::Span<AttachmentData> colors);
         RenderPass(core::Span<AttachmentData> colors);
 
+        // Creates a render pass compatible with any other render pass with the same layout (for pipeline creation)
+        explicit RenderPass(const Layout& layout);
+
         ~RenderPass();
 
         bool is_depth_only() const;
@@ -33,10 +33,14 @@ SOFTWARE.
 #include <yave/graphics/device/LifetimeManager.h>
 #include <yave/graphics/device/MeshAllocator.h>
 #include <yave/graphics/device/MaterialAllocator.h>
+#include <yave/graphics/device/UploadRing.h>
+#include <yave/graphics/device/UploadQueue.h>
 #include <yave/graphics/device/DescriptorLayoutAllocator.h>
 #include <yave/graphics/images/TextureLibrary.h>
 #include <yave/graphics/device/DiagnosticCheckpoints.h>
+#include <yave/graphics/device/PipelineCache.h>
 
+#include <y/concurrent/JobSystem.h>
 #include <y/core/ScratchPad.h>
 
 #include <y/utils/log.h>
@@ -58,6 +62,10 @@ Uninitialized<LifetimeManager> lifetime_manager;
 Uninitialized<DescriptorLayoutAllocator> layout_allocator;
 Uninitialized<MeshAllocator> mesh_allocator;
 Uninitialized<MaterialAllocator> material_allocator;
+Uninitialized<UploadRing> upload_ring;
+Uninitialized<UploadQueue> upload_queue;
+Uninitialized<PipelineCache> pipeline_cache;
+Uninitialized<concurrent::JobSystem> pipeline_compiler;
 Uninitialized<TextureLibrary> texture_library;
 Uninitialized<DeviceResources> resources;
 
@@ -263,8 +271,12 @@ void init_device(Instance& instance, PhysicalDevice device) {
     device::lifetime_manager.init();
     device::mesh_allocator.init();
     device::material_allocator.init();
+    device::upload_ring.init();
+    device::upload_queue.init(*device::queue);
     device::texture_library.init();
     device::layout_allocator.init();
+    device::pipeline_cache.init(instance_params().pipeline_cache);
+    device::pipeline_compiler.init(std::max(2u, std::thread::hardware_concurrency() / 2));
 
     for(usize i = 0; i != device::samplers.size(); ++i) {
         device::samplers[i].init(create_sampler(SamplerType(i)));
@@ -280,8 +292,16 @@ void destroy_device() {
 
     device::resources.destroy();
 
+    // Material templates wait for their own pipelines, this should never have anything left to do
+    device::pipeline_compiler.destroy();
+
+    // Submits whatever is left and waits for it
+    device::upload_queue.destroy();
+
     lifetime_manager().wait_cmd_buffers();
 
+    device::pipeline_cache.destroy();
+
 #ifdef Y_DEBUG
     device::destroying = true;
     y_defer(device::destroying = false);
@@ -298,6 +318,7 @@ void destroy_device() {
 
     device::layout_allocator.destroy();
     device::texture_library.destroy();
+    device::upload_ring.destroy();
     device::material_allocator.destroy();
     device::mesh_allocator.destroy();
     device::lifetime_manager.destroy();
@@ -374,6 +395,22 @@ MaterialAllocator& material_allocator() {
     return *device::material_allocator;
 }
 
+PipelineCache& pipeline_cache() {
+    return *device::pipeline_cache;
+}
+
+UploadRing& upload_ring() {
+    return *device::upload_ring;
+}
+
+UploadQueue& upload_queue() {
+    return *device::upload_queue;
+}
+
+concurrent::JobSystem& pipeline_compiler() {
+    return *device::pipeline_compiler;
+}
+
 TextureLibrary& texture_library() {
     return *device::texture_library;
 }
@@ -429,6 +466,10 @@ const VkAllocationCallbacks* vk_allocation_callbacks() {
 #endif
 }
 
+VkPipelineCache vk_pipeline_cache() {
+    return device::pipeline_cache->vk_pipeline_cache();
+}
+
 VkSampler vk_sampler(SamplerType type) {
     y_debug_assert(usize(type) < device::samplers.size());
     return device::samplers[usize(type)]->vk_sampler();
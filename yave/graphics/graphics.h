@@ -53,6 +53,10 @@ VmaAllocator device_allocator();
 DescriptorLayoutAllocator& layout_allocator();
 MeshAllocator& mesh_allocator();
 MaterialAllocator& material_allocator();
+UploadRing& upload_ring();
+UploadQueue& upload_queue();
+PipelineCache& pipeline_cache();
+concurrent::JobSystem& pipeline_compiler();
 TextureLibrary& texture_library();
 CmdQueue& command_queue();
 CmdQueue& loading_command_queue();
@@ -62,6 +66,7 @@ bool raytracing_enabled();
 LifetimeManager& lifetime_manager();
 
 const VkAllocationCallbacks* vk_allocation_callbacks();
+VkPipelineCache vk_pipeline_cache();
 VkSampler vk_sampler(SamplerType type);
 
 const DebugUtils* debug_utils();
@@ -25,48 +25,11 @@ SOFTWARE.
 
 #include <yave/graphics/buffers/Buffer.h>
 #include <yave/graphics/barriers/Barrier.h>
-#include <yave/graphics/commands/CmdQueue.h>
+#include <yave/graphics/device/UploadQueue.h>
 #include <yave/graphics/graphics.h>
 
-#include <y/core/ScratchPad.h>
-
 namespace yave {
 
-static core::ScratchPad<VkBufferImageCopy> get_copy_regions(const ImageData& data) {
-    core::ScratchPad<VkBufferImageCopy> regions(data.mipmaps());
-
-    usize index = 0;
-    for(usize m = 0; m != data.mipmaps(); ++m) {
-        const auto size = data.mip_size(m);
-        VkBufferImageCopy copy = {};
-        {
-            copy.bufferOffset = data.data_offset(m);
-            copy.imageExtent = {size.x(), size.y(), size.z()};
-            copy.imageSubresource.aspectMask = data.format().vk_aspect();
-            copy.imageSubresource.mipLevel = u32(m);
-            copy.imageSubresource.baseArrayLayer = 0;
-            copy.imageSubresource.layerCount = 1;
-        }
-        regions[index++] = copy;
-    }
-
-    return regions;
-}
-
-static auto create_staging_buffer(usize byte_size, const void* data) {
-    y_profile();
-    auto staging_buffer = StagingBuffer(byte_size);
-    {
-        y_profile_zone("copy");
-        if(data) {
-            std::memcpy(staging_buffer.map_bytes(MappingAccess::WriteOnly).data(), data, byte_size);
-        } else {
-            std::memset(staging_buffer.map_bytes(MappingAccess::WriteOnly).data(), 0, byte_size);
-        }
-    }
-    return staging_buffer;
-}
-
 static VkHandle<VkImageView> create_view(VkImage image, ImageFormat format, u32 layers, u32 mips, ImageType type) {
     VkImageViewCreateInfo create_info = vk_struct();
     {
@@ -83,6 +46,24 @@ static VkHandle<VkImageView> create_view(VkImage image, ImageFormat format, u32
     return view;
 }
 
+static VkImageCreateInfo image_create_info(const math::Vec3ui& size, u32 layers, u32 mips, ImageFormat format, ImageUsage usage, ImageType type) {
+    VkImageCreateInfo create_info = vk_struct();
+    {
+        create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        create_info.flags = type == ImageType::Cube ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+        create_info.arrayLayers = u32(layers);
+        create_info.extent = {size.x(), size.y(), size.z()};
+        create_info.format = format.vk_format();
+        create_info.imageType = type == ImageType::ThreeD ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
+        create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        create_info.mipLevels = u32(mips);
+        create_info.usage = VkImageUsageFlags(usage);
+        create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    }
+    return create_info;
+}
+
 static std::tuple<VkHandle<VkImage>, DeviceMemory, VkHandle<VkImageView>> alloc_image(const math::Vec3ui& size,
                                                                                       u32 layers, u32 mips,
                                                                                       ImageFormat format,
@@ -93,20 +74,7 @@ static std::tuple<VkHandle<VkImage>, DeviceMemory, VkHandle<VkImageView>> alloc_
 
     unused(alloc_flags);
 
-    VkImageCreateInfo image_create_info = vk_struct();
-    {
-        image_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        image_create_info.flags = type == ImageType::Cube ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
-        image_create_info.arrayLayers = u32(layers);
-        image_create_info.extent = {size.x(), size.y(), size.z()};
-        image_create_info.format = format.vk_format();
-        image_create_info.imageType = type == ImageType::ThreeD ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
-        image_create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
-        image_create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        image_create_info.mipLevels = u32(mips);
-        image_create_info.usage = VkImageUsageFlags(usage);
-        image_create_info.samples = VK_SAMPLE_COUNT_1_BIT;
-    }
+    const VkImageCreateInfo image_create_info = image_create_info(size, layers, mips, format, usage, type);
 
     VmaAllocationCreateInfo alloc_create_info = {};
     {
@@ -120,32 +88,6 @@ static std::tuple<VkHandle<VkImage>, DeviceMemory, VkHandle<VkImageView>> alloc_
     return {std::move(image), alloc, create_view(image, format, layers, mips, type)};
 }
 
-static void upload_data(ImageBase& image, const ImageData& data) {
-    y_profile();
-
-    const auto staging_buffer = create_staging_buffer(data.byte_size(), data.data());
-    const auto regions = get_copy_regions(data);
-
-    TransferCmdBufferRecorder recorder = create_disposable_transfer_cmd_buffer();
-
-    {
-        const auto region = recorder.region("Image upload");
-        recorder.barriers({ImageBarrier::transition_barrier(image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)});
-        vkCmdCopyBufferToImage(recorder.vk_cmd_buffer(), staging_buffer.vk_buffer(), image.vk_image(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, u32(regions.size()), regions.data());
-        recorder.barriers({ImageBarrier::transition_barrier(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, vk_image_layout(image.usage()))});
-    }
-
-    recorder.submit_async();
-}
-
-static void transition_image(ImageBase& image) {
-    y_profile();
-
-    TransferCmdBufferRecorder recorder = create_disposable_transfer_cmd_buffer();
-    recorder.barriers({ImageBarrier::transition_barrier(image, VK_IMAGE_LAYOUT_UNDEFINED, vk_image_layout(image.usage()))});
-    recorder.submit_async();
-}
-
 static void check_layer_count(ImageType type, const math::Vec3ui& size, usize layers) {
     y_always_assert(type != ImageType::TwoD || layers == 1, "Invalid layer count");
     y_always_assert(type != ImageType::Cube || layers == 6, "Invalid layer count");
@@ -165,7 +107,27 @@ ImageBase::ImageBase(ImageFormat format, ImageUsage usage, const math::Vec3ui& s
 
     std::tie(_image, _memory, _view) = alloc_image(_size, _layers, _mips, _format, _usage, type, alloc_flags);
 
-    transition_image(*this);
+    upload_queue().transition(*this);
+}
+
+ImageBase::ImageBase(ImageFormat format, ImageUsage usage, const math::Vec3ui& size, ImageType type, u32 layers, u32 mips, const DeviceMemory& heap, u64 heap_offset) :
+        _size(size),
+        _layers(layers),
+        _mips(mips),
+        _format(format),
+        _usage(usage) {
+
+    y_profile();
+
+    check_layer_count(type, _size, _layers);
+    y_debug_assert(!heap.is_null());
+
+    // The image doesn't own its memory and is left in an undefined layout:
+    // it is up to the owner of the heap to transition it before its first use
+    const VkImageCreateInfo create_info = image_create_info(_size, _layers, _mips, _format, _usage, type);
+    vk_check(vmaCreateAliasingImage2(device_allocator(), heap._alloc, heap_offset, &create_info, _image.get_ptr_for_init()));
+
+    _view = create_view(_image, _format, _layers, _mips, type);
 }
 
 ImageBase::ImageBase(ImageUsage usage, ImageType type, const ImageData& data) :
@@ -178,7 +140,7 @@ ImageBase::ImageBase(ImageUsage usage, ImageType type, const ImageData& data) :
 
     std::tie(_image, _memory, _view) = alloc_image(_size, _layers, _mips, _format, _usage, type);
 
-    upload_data(*this, data);
+    upload_queue().upload(*this, data);
 }
 
 ImageBase::~ImageBase() {
@@ -187,6 +149,20 @@ ImageBase::~ImageBase() {
     destroy_graphic_resource(std::move(_memory));
 }
 
+VkMemoryRequirements ImageBase::memory_requirements(ImageFormat format, ImageUsage usage, const math::Vec3ui& size, ImageType type, u32 layers, u32 mips) {
+    const VkImageCreateInfo create_info = image_create_info(size, layers, mips, format, usage, type);
+
+    VkDeviceImageMemoryRequirements info = vk_struct();
+    {
+        info.pCreateInfo = &create_info;
+    }
+
+    VkMemoryRequirements2 requirements = vk_struct();
+    vkGetDeviceImageMemoryRequirements(vk_device(), &info, &requirements);
+
+    return requirements.memoryRequirements;
+}
+
 bool ImageBase::is_null() const {
     return !_image;
 }
@@ -52,6 +52,8 @@ class ImageBase : NonCopyable {
         ImageFormat format() const;
         ImageUsage usage() const;
 
+        static VkMemoryRequirements memory_requirements(ImageFormat format, ImageUsage usage, const math::Vec3ui& size, ImageType type = ImageType::TwoD, u32 layers = 1, u32 mips = 1);
+
     protected:
         ImageBase() = default;
         ImageBase(ImageBase&&) = default;
@@ -60,6 +62,9 @@ class ImageBase : NonCopyable {
         ImageBase(ImageFormat format, ImageUsage usage, const math::Vec3ui& size, ImageType type = ImageType::TwoD, u32 layers = 1, u32 mips = 1, MemoryAllocFlags alloc_flags = MemoryAllocFlags::None);
         ImageBase(ImageUsage usage, ImageType type, const ImageData& data);
 
+        // Placed image, created in memory owned by someone else
+        ImageBase(ImageFormat format, ImageUsage usage, const math::Vec3ui& size, ImageType type, u32 layers, u32 mips, const DeviceMemory& heap, u64 heap_offset);
+
 
         math::Vec3ui _size;
         u32 _layers = 1;
@@ -53,6 +53,8 @@ class DeviceMemory final : NonCopyable {
     private:
         friend class LifetimeManager;
         friend class DeviceMemoryView;
+        friend class ImageBase;
+        friend class BufferBase;
 
         void free() {
             y_debug_assert(_alloc);
@@ -96,8 +96,10 @@ static std::pair<VkHandle<VkAccelerationStructureKHR>, Buffer<BufferUsage::Accel
     {
         const VkDeviceAddress position_buffer = mesh_buffers.attribs[usize(VertexStreamType::Position)].vk_device_address();
 
-        triangles.vertexFormat = VK_FORMAT_R32G32B32_SFLOAT;
-        triangles.vertexStride = sizeof(math::Vec3);
+        // Snorm16 positions are padded to 4 components, the decode transform is applied by the instance
+        const bool quantized = mesh_buffers.formats[usize(VertexStreamType::Position)] == VertexStreamFormat::Snorm16;
+        triangles.vertexFormat = quantized ? VK_FORMAT_R16G16B16A16_SNORM : VK_FORMAT_R32G32B32_SFLOAT;
+        triangles.vertexStride = quantized ? sizeof(math::Vec<4, i16>) : sizeof(math::Vec3);
         triangles.vertexData.deviceAddress = position_buffer;
         triangles.maxVertex = mesh.vertex_count();
 
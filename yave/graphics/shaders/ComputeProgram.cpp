@@ -24,6 +24,7 @@ SOFTWARE.
 
 #include <yave/graphics/graphics.h>
 #include <yave/graphics/device/DescriptorLayoutAllocator.h>
+#include <yave/graphics/device/PipelineCache.h>
 #include <yave/graphics/images/TextureLibrary.h>
 
 #include <y/core/ScratchPad.h>
@@ -70,7 +71,9 @@ ComputeProgram::ComputeProgram(const ComputeShader& comp) : _local_size(comp.loc
         create_info.stage = stage;
     }
 
-    vk_check(vkCreateComputePipelines(vk_device(), {}, 1, &create_info, vk_allocation_callbacks(), _pipeline.get_ptr_for_init()));
+    const core::StopWatch timer;
+    vk_check(vkCreateComputePipelines(vk_device(), vk_pipeline_cache(), 1, &create_info, vk_allocation_callbacks(), _pipeline.get_ptr_for_init()));
+    pipeline_cache().register_pipeline(timer.elapsed());
 }
 
 ComputeProgram::~ComputeProgram() {
@@ -0,0 +1,193 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "ShaderBundle.h"
+
+#include <y/io2/File.h>
+#include <y/io2/Buffer.h>
+
+#include <y/utils/log.h>
+#include <y/utils/format.h>
+
+namespace yave {
+
+static io2::WriteResult write_padding(io2::Writer& writer) {
+    const std::array<u8, 4> padding = {};
+    const usize pad = (4 - writer.tell() % 4) % 4;
+    return writer.write(padding.data(), pad);
+}
+
+template<typename T>
+static bool is_in_range(core::Span<u8> data, u32 offset, u32 size) {
+    return offset % alignof(T) == 0 && size % sizeof(T) == 0 && u64(offset) + size <= data.size();
+}
+
+
+core::Result<ShaderBundle> ShaderBundle::open(const core::String& filename) {
+    y_profile();
+
+    auto file = io2::File::open(filename);
+    if(!file) {
+        return core::Err();
+    }
+
+    ShaderBundle bundle;
+    if(!file.unwrap().read_all(bundle._data)) {
+        return core::Err();
+    }
+
+    if(bundle._data.size() < sizeof(Header)) {
+        return core::Err();
+    }
+
+    Header header;
+    std::memcpy(&header, bundle._data.data(), sizeof(Header));
+    if(header.magic != magic || header.version != version) {
+        return core::Err();
+    }
+
+    if(bundle._data.size() < sizeof(Header) + sizeof(Entry) * header.entry_count) {
+        return core::Err();
+    }
+
+    for(u32 i = 0; i != header.entry_count; ++i) {
+        Entry entry;
+        std::memcpy(&entry, bundle._data.data() + sizeof(Header) + sizeof(Entry) * i, sizeof(Entry));
+
+        const bool valid =
+            is_in_range<char>(bundle._data, entry.name_offset, entry.name_size) &&
+            is_in_range<u32>(bundle._data, entry.spirv_offset, entry.spirv_size) &&
+            is_in_range<u8>(bundle._data, entry.reflection_offset, entry.reflection_size);
+
+        if(!valid) {
+            return core::Err();
+        }
+
+        const char* name = reinterpret_cast<const char*>(bundle._data.data() + entry.name_offset);
+        bundle._entries.emplace(core::String(name, entry.name_size), entry);
+    }
+
+    return core::Ok(std::move(bundle));
+}
+
+ShaderBundle ShaderBundle::open_default() {
+    auto bundle = open(core::String(default_filename));
+    if(!bundle) {
+        log_msg(fmt("Unable to open shader bundle \"{}\", loading SPIR-V files", default_filename), Log::Warning);
+        return ShaderBundle();
+    }
+    return std::move(bundle.unwrap());
+}
+
+io2::WriteResult ShaderBundle::write(io2::Writer& writer, core::Span<Shader> shaders) {
+    y_profile();
+
+    const usize start = writer.tell();
+
+    Header header;
+    {
+        header.magic = magic;
+        header.version = version;
+        header.entry_count = u32(shaders.size());
+    }
+
+    y_try(writer.write_one(header));
+
+    // Entries are written once all the offsets are known
+    core::Vector<Entry> entries(shaders.size(), Entry{});
+    y_try(writer.write_array(entries.data(), entries.size()));
+
+    for(usize i = 0; i != shaders.size(); ++i) {
+        const Shader& shader = shaders[i];
+        Entry& entry = entries[i];
+
+        entry.name_offset = u32(writer.tell() - start);
+        entry.name_size = u32(shader.name.size());
+        y_try(writer.write(shader.name.data(), shader.name.size()));
+        y_try(write_padding(writer));
+
+        const core::Span<u32> spirv = shader.spirv.data();
+        entry.spirv_offset = u32(writer.tell() - start);
+        entry.spirv_size = u32(spirv.size() * sizeof(u32));
+        y_try(writer.write_array(spirv.data(), spirv.size()));
+
+        entry.reflection_offset = u32(writer.tell() - start);
+        for(const ShaderReflection& reflection : ShaderReflection::reflect_all(spirv)) {
+            y_try(reflection.serialize(writer));
+        }
+        entry.reflection_size = u32(writer.tell() - start - entry.reflection_offset);
+        y_try(write_padding(writer));
+    }
+
+    const usize end = writer.tell();
+    writer.seek(start + sizeof(Header));
+    y_try(writer.write_array(entries.data(), entries.size()));
+    writer.seek(end);
+
+    return core::Ok();
+}
+
+bool ShaderBundle::is_empty() const {
+    return _entries.is_empty();
+}
+
+usize ShaderBundle::size() const {
+    return _entries.size();
+}
+
+core::Result<SpirVData> ShaderBundle::find(std::string_view name) const {
+    const auto it = _entries.find(core::String(name));
+    if(it == _entries.end()) {
+        return core::Err();
+    }
+
+    const Entry& entry = it->second;
+
+    SpirVData spirv(core::Span<u32>(reinterpret_cast<const u32*>(_data.data() + entry.spirv_offset), entry.spirv_size / sizeof(u32)));
+
+    io2::Buffer reflections;
+    reflections.write(_data.data() + entry.reflection_offset, entry.reflection_size).unwrap();
+    reflections.reset();
+    while(!reflections.at_end()) {
+        auto reflection = ShaderReflection::deserialized(reflections);
+        if(!reflection) {
+            log_msg(fmt("Invalid reflection data for \"{}\" in shader bundle", name), Log::Warning);
+            return core::Err();
+        }
+        spirv._reflections << std::move(reflection.unwrap());
+    }
+
+    return core::Ok(std::move(spirv));
+}
+
+SpirVData ShaderBundle::load(std::string_view name) const {
+    y_debug_assert(!name.empty());
+
+    if(auto spirv = find(name)) {
+        return std::move(spirv.unwrap());
+    }
+
+    const core::String filename = fmt_to_owned("{}.spv", name);
+    return SpirVData::deserialized(io2::File::open(filename).expected(fmt_c_str("Unable to open SPIR-V file ({})", filename)));
+}
+
+}
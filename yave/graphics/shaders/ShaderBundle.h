@@ -0,0 +1,90 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_GRAPHICS_SHADERS_SHADERBUNDLE_H
+#define YAVE_GRAPHICS_SHADERS_SHADERBUNDLE_H
+
+#include "SpirVData.h"
+
+#include <y/core/HashMap.h>
+
+namespace yave {
+
+// All the SPIR-V modules used by the engine packed with their reflection data in a single file.
+// Everything is stored 4 byte aligned at offsets from the start of the file so the bundle can be used straight from memory.
+class ShaderBundle : NonCopyable {
+    struct Header {
+        u32 magic = 0;
+        u32 version = 0;
+        u32 entry_count = 0;
+        u32 reserved = 0;
+    };
+
+    struct Entry {
+        u32 name_offset = 0;
+        u32 name_size = 0;
+        u32 spirv_offset = 0;
+        u32 spirv_size = 0;
+        u32 reflection_offset = 0;
+        u32 reflection_size = 0;
+    };
+
+    public:
+        static constexpr u32 magic = 0x42485359; // "YSHB"
+        static constexpr u32 version = 1;
+
+        static constexpr std::string_view default_filename = "shaders.bundle";
+
+        struct Shader {
+            core::String name;
+            SpirVData spirv;
+        };
+
+        ShaderBundle() = default;
+
+        ShaderBundle(ShaderBundle&&) = default;
+        ShaderBundle& operator=(ShaderBundle&&) = default;
+
+        static core::Result<ShaderBundle> open(const core::String& filename);
+
+        // Returns an empty bundle (and logs) if the default bundle is missing or out of date
+        static ShaderBundle open_default();
+
+        // Reflects every module and writes the bundle
+        static io2::WriteResult write(io2::Writer& writer, core::Span<Shader> shaders);
+
+        bool is_empty() const;
+        usize size() const;
+
+        // Returns an error if the bundle does not contain the module or if its reflection data is corrupted
+        core::Result<SpirVData> find(std::string_view name) const;
+
+        // Falls back on the loose <name>.spv file if the module can not be found in the bundle
+        SpirVData load(std::string_view name) const;
+
+    private:
+        core::Vector<u8> _data;
+        core::FlatHashMap<core::String, Entry> _entries;
+};
+
+}
+
+#endif // YAVE_GRAPHICS_SHADERS_SHADERBUNDLE_H
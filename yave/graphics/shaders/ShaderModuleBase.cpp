@@ -24,13 +24,6 @@ SOFTWARE.
 
 #include <yave/graphics/graphics.h>
 
-#include <y/core/ScratchPad.h>
-
-#include <y/utils/log.h>
-#include <y/utils/format.h>
-
-#include <external/spirv_reflect/spirv_reflect.h>
-
 namespace yave {
 
 static VkHandle<VkShaderModule> create_shader_module(const SpirVData& spirv) {
@@ -51,145 +44,41 @@ static VkHandle<VkShaderModule> create_shader_module(const SpirVData& spirv) {
     return shader;
 }
 
-static ShaderType shader_exec_model(SpvExecutionModel exec_model) {
-    switch(exec_model) {
-        case SpvExecutionModelVertex:               return ShaderType::Vertex;
-        case SpvExecutionModelGeometry:             return ShaderType::Geometry;
-        case SpvExecutionModelFragment:             return ShaderType::Fragment;
-        case SpvExecutionModelGLCompute:            return ShaderType::Compute;
-        case SpvExecutionModelRayGenerationKHR:     return ShaderType::RayGen;
-        case SpvExecutionModelMissKHR:              return ShaderType::Miss;
-        case SpvExecutionModelClosestHitKHR:        return ShaderType::ClosestHit;
-
-        default:
-        break;
-    }
-    y_fatal("Unknown shader execution model");
-}
-
-static void spv_check(SpvReflectResult result) {
-    y_always_assert(result == SPV_REFLECT_RESULT_SUCCESS, "SpirV-Reflect error");
-}
-
-[[maybe_unused]]
-static const SpvReflectEntryPoint& find_entry_point(const SpvReflectShaderModule& module, const core::String& name) {
-    for(u32 i = 0; i != module.entry_point_count; ++i) {
-        if(name == module.entry_points[i].name) {
-            return module.entry_points[i];
-        }
-    }
-
-    y_fatal("SpirV entry point not found");
-}
-
-[[maybe_unused]]
-static const SpvReflectEntryPoint& find_entry_point(const SpvReflectShaderModule& module, ShaderType type) {
-    y_debug_assert(type != ShaderType::None);
-    for(u32 i = 0; i != module.entry_point_count; ++i) {
-        if(shader_exec_model(module.entry_points[i].spirv_execution_model) == type) {
-            return module.entry_points[i];
-        }
-    }
-
-    y_fatal("SpirV entry point not found for shader type");
-}
-
-
-
-
 ShaderModuleBase::ShaderModuleBase(const SpirVData& spirv, ShaderType type) : _module(create_shader_module(spirv)), _type(type) {
     y_profile();
 
     y_debug_assert(_type != ShaderType::None);
 
-    SpvReflectShaderModule module = {};
-
-    const core::Span<u32> data = spirv.data();
-    spv_check(spvReflectCreateShaderModule(data.size() * sizeof(u32), data.data(), &module));
-    y_defer(spvReflectDestroyShaderModule(&module));
-
-    const SpvReflectEntryPoint& entry_point = find_entry_point(module, type);
-
-    _entry_point = entry_point.name;
-
-    _local_size = {
-        entry_point.local_size.x,
-        entry_point.local_size.y,
-        entry_point.local_size.z,
-    };
-
-    {
-        u32 ds_count = 0;
-        spv_check(spvReflectEnumerateDescriptorSets(&module, &ds_count, nullptr));
-
-        core::ScratchPad<SpvReflectDescriptorSet*> sets(ds_count);
-        spv_check(spvReflectEnumerateDescriptorSets(&module, &ds_count, sets.data()));
-
-        for(const SpvReflectDescriptorSet* set : sets) {
-            _bindings.set_min_size(set->set + 1);
-            auto& set_bindings = _bindings[set->set];
-            for(u32 i = 0; i != set->binding_count; ++i) {
-                const SpvReflectDescriptorBinding& refl_binding = *set->bindings[i];
-
-                y_always_assert(refl_binding.block.size == refl_binding.block.padded_size, "Invalid block size");
-                y_debug_assert(refl_binding.count <= 1);
-
-                if(!refl_binding.count) {
-                    _variable_size_sets << set->set;
-                }
-
-                VkDescriptorSetLayoutBinding& binding = set_bindings.emplace_back();
-                {
-                    binding.stageFlags = VK_SHADER_STAGE_ALL;
-                    binding.binding = refl_binding.binding;
-                    binding.descriptorCount = 1;
-                    binding.descriptorType = VkDescriptorType(refl_binding.descriptor_type);
-                }
-            }
-
-            std::sort(set_bindings.begin(), set_bindings.end(), [](const auto& a, const auto& b) { return a.binding < b.binding; });
-        }
-    }
-
-
-    {
-        u32 attrib_count = 0;
-        spv_check(spvReflectEnumerateEntryPointInputVariables(&module, entry_point.name, &attrib_count, nullptr));
-
-        core::ScratchPad<SpvReflectInterfaceVariable*> attribs(attrib_count);
-        spv_check(spvReflectEnumerateEntryPointInputVariables(&module, entry_point.name, &attrib_count, attribs.data()));
-
-        for(const SpvReflectInterfaceVariable* variable : attribs) {
-            if(variable->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN) {
-                continue;
-            }
-
-            Attribute& attrib = _attribs.emplace_back();
-            {
-                attrib.component_count = std::max(1u, variable->numeric.matrix.column_count);
-                attrib.location = variable->location;
-                attrib.format = VkFormat(variable->format);
-                attrib.is_packed = std::string_view(variable->name).ends_with("_Packed");
-            }
-        }
+    if(const ShaderReflection* reflection = spirv.reflection(type)) {
+        set_reflection(*reflection);
+    } else {
+        set_reflection(ShaderReflection::reflect(spirv.data(), type));
     }
+}
 
-    {
-        u32 out_count = 0;
-        spv_check(spvReflectEnumerateEntryPointOutputVariables(&module, entry_point.name, &out_count, nullptr));
+void ShaderModuleBase::set_reflection(const ShaderReflection& reflection) {
+    y_debug_assert(reflection.type == _type);
 
-        core::ScratchPad<SpvReflectInterfaceVariable*> outputs(out_count);
-        spv_check(spvReflectEnumerateEntryPointOutputVariables(&module, entry_point.name, &out_count, outputs.data()));
+    _entry_point = reflection.entry_point;
+    _local_size = reflection.local_size;
 
-        for(const SpvReflectInterfaceVariable* variable : outputs) {
-            if(variable->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN) {
-                continue;
-            }
+    for(const ShaderReflection::Binding& refl_binding : reflection.bindings) {
+        if(refl_binding.is_variable_size) {
+            _variable_size_sets << refl_binding.set;
+        }
 
-            _stage_output.emplace_back(variable->location);
+        _bindings.set_min_size(refl_binding.set + 1);
+        VkDescriptorSetLayoutBinding& binding = _bindings[refl_binding.set].emplace_back();
+        {
+            binding.stageFlags = VK_SHADER_STAGE_ALL;
+            binding.binding = refl_binding.binding;
+            binding.descriptorCount = 1;
+            binding.descriptorType = refl_binding.type;
         }
     }
 
+    _attribs = reflection.attributes;
+    _stage_output = reflection.stage_output;
 }
 
 ShaderModuleBase::~ShaderModuleBase() {
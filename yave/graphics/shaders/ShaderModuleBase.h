@@ -32,26 +32,9 @@ SOFTWARE.
 
 namespace yave {
 
-enum class ShaderType : u32 {
-    None = 0,
-    Fragment = VK_SHADER_STAGE_FRAGMENT_BIT,
-    Vertex = VK_SHADER_STAGE_VERTEX_BIT,
-    Geometry = VK_SHADER_STAGE_GEOMETRY_BIT,
-    Compute = VK_SHADER_STAGE_COMPUTE_BIT,
-    RayGen = VK_SHADER_STAGE_RAYGEN_BIT_KHR,
-    Miss = VK_SHADER_STAGE_MISS_BIT_KHR,
-    ClosestHit = VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR,
-};
-
-
 class ShaderModuleBase : NonMovable {
     public:
-        struct Attribute {
-            u32 location;
-            u32 component_count;
-            VkFormat format;
-            bool is_packed;
-        };
+        using Attribute = ShaderReflection::Attribute;
 
         ~ShaderModuleBase();
 
@@ -96,6 +79,8 @@ class ShaderModuleBase : NonMovable {
             return _variable_size_sets;
         }
 
+        void set_reflection(const ShaderReflection& reflection);
+
     private:
         VkHandle<VkShaderModule> _module;
         core::String _entry_point = "main";
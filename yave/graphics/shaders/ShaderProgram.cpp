@@ -25,6 +25,7 @@ SOFTWARE.
 #include <yave/graphics/device/deviceutils.h>
 #include <yave/graphics/device/DeviceProperties.h>
 #include <yave/graphics/device/DescriptorLayoutAllocator.h>
+#include <yave/graphics/device/PipelineCache.h>
 #include <yave/graphics/images/TextureLibrary.h>
 #include <yave/graphics/device/MeshAllocator.h>
 
@@ -274,7 +275,9 @@ RaytracingProgram::RaytracingProgram(const RayGenShader& gen, const MissShader&
         create_info.layout = _layout;
     }
 
-    vk_check(vkCreateRayTracingPipelinesKHR(vk_device(), nullptr, nullptr, 1, &create_info, nullptr, _pipeline.get_ptr_for_init()));
+    const core::StopWatch timer;
+    vk_check(vkCreateRayTracingPipelinesKHR(vk_device(), nullptr, vk_pipeline_cache(), 1, &create_info, nullptr, _pipeline.get_ptr_for_init()));
+    pipeline_cache().register_pipeline(timer.elapsed());
 
     const u32 group_size = u32(groups.size());
     const u32 table_size = device_properties().shader_group_handle_size_aligned * group_size;
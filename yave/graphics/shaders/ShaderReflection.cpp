@@ -0,0 +1,222 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "ShaderReflection.h"
+
+#include <y/core/ScratchPad.h>
+
+#include <y/utils/log.h>
+#include <y/utils/format.h>
+
+#include <external/spirv_reflect/spirv_reflect.h>
+
+namespace yave {
+
+static ShaderType shader_exec_model(SpvExecutionModel exec_model) {
+    switch(exec_model) {
+        case SpvExecutionModelVertex:               return ShaderType::Vertex;
+        case SpvExecutionModelGeometry:             return ShaderType::Geometry;
+        case SpvExecutionModelFragment:             return ShaderType::Fragment;
+        case SpvExecutionModelGLCompute:            return ShaderType::Compute;
+        case SpvExecutionModelRayGenerationKHR:     return ShaderType::RayGen;
+        case SpvExecutionModelMissKHR:              return ShaderType::Miss;
+        case SpvExecutionModelClosestHitKHR:        return ShaderType::ClosestHit;
+
+        default:
+        break;
+    }
+    y_fatal("Unknown shader execution model");
+}
+
+static void spv_check(SpvReflectResult result) {
+    y_always_assert(result == SPV_REFLECT_RESULT_SUCCESS, "SpirV-Reflect error");
+}
+
+static const SpvReflectEntryPoint& find_entry_point(const SpvReflectShaderModule& module, ShaderType type) {
+    y_debug_assert(type != ShaderType::None);
+    for(u32 i = 0; i != module.entry_point_count; ++i) {
+        if(shader_exec_model(module.entry_points[i].spirv_execution_model) == type) {
+            return module.entry_points[i];
+        }
+    }
+
+    y_fatal("SpirV entry point not found for shader type");
+}
+
+static ShaderReflection reflect_entry_point(SpvReflectShaderModule& module, const SpvReflectEntryPoint& entry_point) {
+    y_profile();
+
+    ShaderReflection reflection;
+
+    reflection.type = shader_exec_model(entry_point.spirv_execution_model);
+    reflection.entry_point = entry_point.name;
+    reflection.local_size = {
+        entry_point.local_size.x,
+        entry_point.local_size.y,
+        entry_point.local_size.z,
+    };
+
+    {
+        u32 ds_count = 0;
+        spv_check(spvReflectEnumerateDescriptorSets(&module, &ds_count, nullptr));
+
+        core::ScratchPad<SpvReflectDescriptorSet*> sets(ds_count);
+        spv_check(spvReflectEnumerateDescriptorSets(&module, &ds_count, sets.data()));
+
+        for(const SpvReflectDescriptorSet* set : sets) {
+            for(u32 i = 0; i != set->binding_count; ++i) {
+                const SpvReflectDescriptorBinding& refl_binding = *set->bindings[i];
+
+                y_always_assert(refl_binding.block.size == refl_binding.block.padded_size, "Invalid block size");
+                y_debug_assert(refl_binding.count <= 1);
+
+                ShaderReflection::Binding& binding = reflection.bindings.emplace_back();
+                {
+                    binding.set = set->set;
+                    binding.binding = refl_binding.binding;
+                    binding.type = VkDescriptorType(refl_binding.descriptor_type);
+                    binding.is_variable_size = !refl_binding.count;
+                }
+            }
+        }
+
+        std::sort(reflection.bindings.begin(), reflection.bindings.end(), [](const auto& a, const auto& b) {
+            return std::tie(a.set, a.binding) < std::tie(b.set, b.binding);
+        });
+    }
+
+    {
+        u32 attrib_count = 0;
+        spv_check(spvReflectEnumerateEntryPointInputVariables(&module, entry_point.name, &attrib_count, nullptr));
+
+        core::ScratchPad<SpvReflectInterfaceVariable*> attribs(attrib_count);
+        spv_check(spvReflectEnumerateEntryPointInputVariables(&module, entry_point.name, &attrib_count, attribs.data()));
+
+        for(const SpvReflectInterfaceVariable* variable : attribs) {
+            if(variable->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN) {
+                continue;
+            }
+
+            ShaderReflection::Attribute& attrib = reflection.attributes.emplace_back();
+            {
+                attrib.component_count = std::max(1u, variable->numeric.matrix.column_count);
+                attrib.location = variable->location;
+                attrib.format = VkFormat(variable->format);
+                attrib.is_packed = std::string_view(variable->name).ends_with("_Packed");
+            }
+        }
+    }
+
+    {
+        u32 out_count = 0;
+        spv_check(spvReflectEnumerateEntryPointOutputVariables(&module, entry_point.name, &out_count, nullptr));
+
+        core::ScratchPad<SpvReflectInterfaceVariable*> outputs(out_count);
+        spv_check(spvReflectEnumerateEntryPointOutputVariables(&module, entry_point.name, &out_count, outputs.data()));
+
+        for(const SpvReflectInterfaceVariable* variable : outputs) {
+            if(variable->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN) {
+                continue;
+            }
+
+            reflection.stage_output.emplace_back(variable->location);
+        }
+    }
+
+    return reflection;
+}
+
+
+
+ShaderReflection ShaderReflection::reflect(core::Span<u32> spirv, ShaderType type) {
+    SpvReflectShaderModule module = {};
+    spv_check(spvReflectCreateShaderModule(spirv.size() * sizeof(u32), spirv.data(), &module));
+    y_defer(spvReflectDestroyShaderModule(&module));
+
+    return reflect_entry_point(module, find_entry_point(module, type));
+}
+
+core::Vector<ShaderReflection> ShaderReflection::reflect_all(core::Span<u32> spirv) {
+    SpvReflectShaderModule module = {};
+    spv_check(spvReflectCreateShaderModule(spirv.size() * sizeof(u32), spirv.data(), &module));
+    y_defer(spvReflectDestroyShaderModule(&module));
+
+    core::Vector<ShaderReflection> reflections;
+    for(u32 i = 0; i != module.entry_point_count; ++i) {
+        reflections << reflect_entry_point(module, module.entry_points[i]);
+    }
+    return reflections;
+}
+
+
+
+template<typename T>
+static io2::WriteResult write_vector(io2::Writer& writer, core::Span<T> data) {
+    y_try(writer.write_one(u32(data.size())));
+    return writer.write_array(data.data(), data.size());
+}
+
+template<typename T>
+static io2::ReadResult read_vector(io2::Reader& reader, core::Vector<T>& data) {
+    u32 size = 0;
+    y_try(reader.read_one(size));
+
+    // Corrupt or truncated data should not trigger a huge allocation
+    if(u64(size) * sizeof(T) > reader.remaining()) {
+        return core::Err<usize>(0);
+    }
+
+    data = core::Vector<T>(usize(size), T{});
+    return reader.read_array(data.data(), size);
+}
+
+io2::WriteResult ShaderReflection::serialize(io2::Writer& writer) const {
+    y_try(writer.write_one(type));
+    y_try(writer.write_one(local_size));
+    y_try(write_vector(writer, core::Span<char>(entry_point.data(), entry_point.size())));
+    y_try(write_vector(writer, core::Span<Binding>(bindings)));
+    y_try(write_vector(writer, core::Span<Attribute>(attributes)));
+    y_try(write_vector(writer, core::Span<u32>(stage_output)));
+    return core::Ok();
+}
+
+core::Result<ShaderReflection> ShaderReflection::deserialized(io2::Reader& reader) {
+    ShaderReflection reflection;
+    core::Vector<char> entry_point;
+
+    const bool ok =
+        reader.read_one(reflection.type) &&
+        reader.read_one(reflection.local_size) &&
+        read_vector(reader, entry_point) &&
+        read_vector(reader, reflection.bindings) &&
+        read_vector(reader, reflection.attributes) &&
+        read_vector(reader, reflection.stage_output);
+
+    if(!ok) {
+        return core::Err();
+    }
+
+    reflection.entry_point = core::String(entry_point.data(), entry_point.size());
+    return core::Ok(std::move(reflection));
+}
+
+}
@@ -0,0 +1,85 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_GRAPHICS_SHADERS_SHADERREFLECTION_H
+#define YAVE_GRAPHICS_SHADERS_SHADERREFLECTION_H
+
+#include <yave/graphics/graphics.h>
+
+#include <y/core/Vector.h>
+#include <y/core/String.h>
+#include <y/core/Span.h>
+#include <y/math/Vec.h>
+
+#include <y/io2/io.h>
+
+namespace yave {
+
+enum class ShaderType : u32 {
+    None = 0,
+    Fragment = VK_SHADER_STAGE_FRAGMENT_BIT,
+    Vertex = VK_SHADER_STAGE_VERTEX_BIT,
+    Geometry = VK_SHADER_STAGE_GEOMETRY_BIT,
+    Compute = VK_SHADER_STAGE_COMPUTE_BIT,
+    RayGen = VK_SHADER_STAGE_RAYGEN_BIT_KHR,
+    Miss = VK_SHADER_STAGE_MISS_BIT_KHR,
+    ClosestHit = VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR,
+};
+
+// Everything ShaderModuleBase needs to know about one entry point of a SPIR-V module.
+// Can be extracted offline and stored alongside the SPIR-V (see ShaderBundle)
+struct ShaderReflection {
+    struct Binding {
+        u32 set = 0;
+        u32 binding = 0;
+        VkDescriptorType type = {};
+        u32 is_variable_size = false;
+    };
+
+    struct Attribute {
+        u32 location;
+        u32 component_count;
+        VkFormat format;
+        bool is_packed;
+    };
+
+    ShaderType type = ShaderType::None;
+    core::String entry_point;
+    math::Vec3ui local_size;
+
+    // Sorted by set then binding
+    core::Vector<Binding> bindings;
+    core::Vector<Attribute> attributes;
+    core::Vector<u32> stage_output;
+
+
+    static ShaderReflection reflect(core::Span<u32> spirv, ShaderType type);
+
+    // One reflection per entry point
+    static core::Vector<ShaderReflection> reflect_all(core::Span<u32> spirv);
+
+    io2::WriteResult serialize(io2::Writer& writer) const;
+    static core::Result<ShaderReflection> deserialized(io2::Reader& reader);
+};
+
+}
+
+#endif // YAVE_GRAPHICS_SHADERS_SHADERREFLECTION_H
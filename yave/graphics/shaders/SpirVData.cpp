@@ -49,5 +49,14 @@ bool SpirVData::is_empty() const {
     return _data.is_empty();
 }
 
+const ShaderReflection* SpirVData::reflection(ShaderType type) const {
+    for(const ShaderReflection& reflection : _reflections) {
+        if(reflection.type == type) {
+            return &reflection;
+        }
+    }
+    return nullptr;
+}
+
 }
 
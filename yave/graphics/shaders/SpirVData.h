@@ -22,7 +22,7 @@ SOFTWARE.
 #ifndef YAVE_GRAPHICS_SHADERS_SPIRVDATA_H
 #define YAVE_GRAPHICS_SHADERS_SPIRVDATA_H
 
-#include <yave/yave.h>
+#include "ShaderReflection.h"
 
 #include <y/reflect/reflect.h>
 #include <y/core/Vector.h>
@@ -42,14 +42,20 @@ class SpirVData {
 
         core::Span<u32> data() const;
 
+        // Reflection extracted offline, null if the module needs to be reflected at runtime
+        const ShaderReflection* reflection(ShaderType type) const;
+
         Y_TODO(what is this?)
         static SpirVData deserialized(io2::Reader& reader);
 
     private:
+        friend class ShaderBundle;
+
         SpirVData(core::Span<u32> data);
         SpirVData(core::Span<u8> data);
 
         core::Vector<u32> _data;
+        core::Vector<ShaderReflection> _reflections;
 };
 
 }
@@ -28,6 +28,7 @@ SOFTWARE.
 #include <yave/graphics/barriers/Barrier.h>
 
 #include <yave/graphics/device/DebugUtils.h>
+#include <yave/graphics/device/PipelineCache.h>
 
 #include <y/core/FixedArray.h>
 #include <y/core/ScratchPad.h>
@@ -383,6 +384,8 @@ void Swapchain::present(const FrameToken& token, CmdBufferRecorder&& recorder, C
         // Nothing ?
     }
 
+    pipeline_cache().on_frame_presented();
+
     ++_frame_id;
 
     y_profile_frame_end();
@@ -194,6 +194,8 @@ VK_STRUCT_TYPE(VkImageMemoryRequirementsInfo2,                      VK_STRUCTURE
 VK_STRUCT_TYPE(VkImageSparseMemoryRequirementsInfo2,                VK_STRUCTURE_TYPE_IMAGE_SPARSE_MEMORY_REQUIREMENTS_INFO_2)
 VK_STRUCT_TYPE(VkMemoryRequirements2,                               VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2)
 VK_STRUCT_TYPE(VkSparseImageMemoryRequirements2,                    VK_STRUCTURE_TYPE_SPARSE_IMAGE_MEMORY_REQUIREMENTS_2)
+VK_STRUCT_TYPE(VkDeviceBufferMemoryRequirements,                    VK_STRUCTURE_TYPE_DEVICE_BUFFER_MEMORY_REQUIREMENTS)
+VK_STRUCT_TYPE(VkDeviceImageMemoryRequirements,                     VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS)
 VK_STRUCT_TYPE(VkPhysicalDeviceFeatures2,                           VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2)
 VK_STRUCT_TYPE(VkPhysicalDeviceProperties2,                         VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2)
 VK_STRUCT_TYPE(VkFormatProperties2,                                 VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2)
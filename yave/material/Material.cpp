@@ -115,6 +115,10 @@ bool Material::alpha_tested() const {
     return _data.alpha_tested();
 }
 
+bool Material::double_sided() const {
+    return _data.double_sided();
+}
+
 const MaterialTemplate* Material::material_template(PassType pass_type) const {
     return _templates[usize(pass_type)];
 }
@@ -52,6 +52,7 @@ class Material final : NonCopyable {
         bool is_transparent() const;
         bool depth_write() const;
         bool alpha_tested() const;
+        bool double_sided() const;
 
         const MaterialTemplate* material_template(PassType pass_type) const;
         const MaterialDrawData& draw_data() const;
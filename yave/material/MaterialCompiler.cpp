@@ -26,6 +26,7 @@ SOFTWARE.
 #include <yave/graphics/shaders/ShaderProgram.h>
 #include <yave/meshes/Vertex.h>
 #include <yave/graphics/graphics.h>
+#include <yave/graphics/device/PipelineCache.h>
 
 #include <y/core/ScratchPad.h>
 #include <y/core/Chrono.h>
@@ -238,7 +239,9 @@ GraphicPipeline MaterialCompiler::compile(const MaterialTemplate* material, cons
     }
 
     VkHandle<VkPipeline> pipeline;
-    vk_check(vkCreateGraphicsPipelines(vk_device(), {}, 1, &create_info, vk_allocation_callbacks(), pipeline.get_ptr_for_init()));
+    const core::StopWatch timer;
+    vk_check(vkCreateGraphicsPipelines(vk_device(), vk_pipeline_cache(), 1, &create_info, vk_allocation_callbacks(), pipeline.get_ptr_for_init()));
+    pipeline_cache().register_pipeline(timer.elapsed());
 
     return GraphicPipeline(std::move(pipeline), std::move(pipeline_layout));
 }
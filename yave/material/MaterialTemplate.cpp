@@ -26,42 +26,119 @@ SOFTWARE.
 #include <yave/graphics/framebuffer/RenderPass.h>
 #include <yave/graphics/device/DebugUtils.h>
 
+#include <y/concurrent/JobSystem.h>
+
 #include <y/utils/log.h>
 #include <y/utils/format.h>
 
-#include <mutex>
+#include <atomic>
 
 namespace yave {
 
-MaterialTemplate::MaterialTemplate(MaterialTemplateData&& data) : _data(std::move(data)) {
+struct MaterialTemplate::CompiledPipeline : NonMovable {
+    RenderPass::Layout layout;
+    GraphicPipeline pipeline;
+
+    concurrent::JobSystem::JobHandle job;
+    std::atomic<bool> is_ready = false;
+};
+
+
+MaterialTemplate::MaterialTemplate() : _lock(std::make_unique<std::mutex>()) {
 }
 
-const GraphicPipeline& MaterialTemplate::compile(const RenderPass& render_pass) const {
-    Y_TODO(make material compilation thread safe?)
-    if(!render_pass.vk_render_pass()) {
-        y_fatal("Unable to compile material: null renderpass");
+MaterialTemplate::MaterialTemplate(MaterialTemplateData&& data) : _lock(std::make_unique<std::mutex>()), _data(std::move(data)) {
+}
+
+MaterialTemplate::MaterialTemplate(MaterialTemplate&& other) : MaterialTemplate() {
+    *this = std::move(other);
+}
+
+MaterialTemplate& MaterialTemplate::operator=(MaterialTemplate&& other) {
+    // Pending jobs hold a pointer to the template they compile
+    wait_for_pipelines();
+    other.wait_for_pipelines();
+
+    std::swap(_lock, other._lock);
+    std::swap(_compiled, other._compiled);
+    std::swap(_data, other._data);
+#ifdef Y_DEBUG
+    std::swap(_name, other._name);
+#endif
+
+    return *this;
+}
+
+MaterialTemplate::~MaterialTemplate() {
+    wait_for_pipelines();
+}
+
+void MaterialTemplate::wait_for_pipelines() const {
+    for(const auto& compiled : _compiled) {
+        if(!compiled->is_ready) {
+            compiled->job.wait();
+        }
     }
+}
 
-    const auto& key = render_pass.layout();
-    const auto it = _compiled.find(key);
-    if(it == _compiled.end()) {
-        if(_compiled.size() == max_compiled_pipelines) {
-            log_msg("Discarding graphic pipeline", Log::Warning);
-            std::move(_compiled.begin() + 1, _compiled.end(), _compiled.begin());
-            _compiled.pop();
+MaterialTemplate::CompiledPipeline& MaterialTemplate::find_or_schedule(const RenderPass::Layout& layout) const {
+    const auto lock = std::unique_lock(*_lock);
+
+    for(const auto& compiled : _compiled) {
+        if(compiled->layout == layout) {
+            return *compiled;
         }
+    }
+
+    CompiledPipeline* compiled = _compiled.emplace_back(std::make_unique<CompiledPipeline>()).get();
+    compiled->layout = layout;
+    compiled->job = pipeline_compiler().schedule([this, compiled] {
+        y_profile_zone("compile material");
 
-        _compiled.insert(key, MaterialCompiler::compile(this, render_pass));
+        const RenderPass render_pass(compiled->layout);
+        compiled->pipeline = MaterialCompiler::compile(this, render_pass);
 
 #ifdef Y_DEBUG
         if(const auto* debug = debug_utils(); debug && !_name.is_empty()) {
-            debug->set_resource_name(_compiled.last().second.vk_pipeline(), _name.data());
+            debug->set_resource_name(compiled->pipeline.vk_pipeline(), _name.data());
         }
 #endif
 
-        return _compiled.last().second;
+        compiled->is_ready.store(true, std::memory_order_release);
+    });
+
+    return *compiled;
+}
+
+const GraphicPipeline& MaterialTemplate::compile(const RenderPass& render_pass) const {
+    if(!render_pass.vk_render_pass()) {
+        y_fatal("Unable to compile material: null renderpass");
+    }
+
+    const CompiledPipeline& compiled = find_or_schedule(render_pass.layout());
+    if(!compiled.is_ready.load(std::memory_order_acquire)) {
+        y_profile_zone("waiting for pipeline");
+        compiled.job.wait();
+    }
+
+    return compiled.pipeline;
+}
+
+const GraphicPipeline* MaterialTemplate::try_compile(const RenderPass& render_pass) const {
+    if(!render_pass.vk_render_pass()) {
+        y_fatal("Unable to compile material: null renderpass");
+    }
+
+    const CompiledPipeline& compiled = find_or_schedule(render_pass.layout());
+    return compiled.is_ready.load(std::memory_order_acquire) ? &compiled.pipeline : nullptr;
+}
+
+void MaterialTemplate::precompile(const RenderPass::Layout& layout, bool wait) const {
+    const CompiledPipeline& compiled = find_or_schedule(layout);
+    if(wait && !compiled.is_ready.load(std::memory_order_acquire)) {
+        y_profile_zone("waiting for pipeline");
+        compiled.job.wait();
     }
-    return it->second;
 }
 
 
@@ -25,24 +25,41 @@ SOFTWARE.
 #include <yave/yave.h>
 
 #include <yave/graphics/framebuffer/RenderPass.h>
-#include <y/core/AssocVector.h>
+#include <y/core/Vector.h>
 #include <y/core/String.h>
 
 #include "GraphicPipeline.h"
 #include "MaterialTemplateData.h"
 
+#include <memory>
+#include <mutex>
+
 namespace yave {
 
-class MaterialTemplate final {
+class MaterialTemplate final : NonCopyable {
 
-    public:
-        static constexpr usize max_compiled_pipelines = 8;
+    struct CompiledPipeline;
 
-        MaterialTemplate() = default;
+    public:
+        MaterialTemplate();
         MaterialTemplate(MaterialTemplateData&& data);
 
+        MaterialTemplate(MaterialTemplate&& other);
+        MaterialTemplate& operator=(MaterialTemplate&& other);
+
+        ~MaterialTemplate();
+
+        // Pipelines are compiled on the pipeline_compiler() job system, one per render pass layout
+
+        // Waits for the pipeline if it isn't ready yet
         const GraphicPipeline& compile(const RenderPass& render_pass) const;
 
+        // Returns nullptr if the pipeline isn't ready yet
+        const GraphicPipeline* try_compile(const RenderPass& render_pass) const;
+
+        // Schedules the pipeline for layout, if wait is true also waits for it to be ready
+        void precompile(const RenderPass::Layout& layout, bool wait = false) const;
+
         const MaterialTemplateData& data() const;
 
         void set_name(const char* name);
@@ -50,9 +67,11 @@ class MaterialTemplate final {
 
 
     private:
-        //void swap(Material& other);
+        CompiledPipeline& find_or_schedule(const RenderPass::Layout& layout) const;
+        void wait_for_pipelines() const;
 
-        mutable core::AssocVector<RenderPass::Layout, GraphicPipeline> _compiled;
+        std::unique_ptr<std::mutex> _lock;
+        mutable core::Vector<std::unique_ptr<CompiledPipeline>> _compiled;
 
         MaterialTemplateData _data;
 
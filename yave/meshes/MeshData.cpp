@@ -80,6 +80,7 @@ u32 MeshData::add_vertices_from_streams(const MeshVertexStreams& streams) {
 
 void MeshData::add_sub_mesh(core::Span<IndexedTriangle> triangles, u32 vertex_offset) {
     y_debug_assert(!triangles.is_empty());
+    y_always_assert(_lod_errors.is_empty(), "Sub-meshes can not be added after LODs");
 
     const u32 first_triangle = u32(_triangles.size());
     _triangles.set_min_capacity(_triangles.size() + triangles.size());
@@ -95,6 +96,42 @@ void MeshData::add_sub_mesh(core::Span<IndexedTriangle> triangles, u32 vertex_of
     _sub_meshes << SubMesh{u32(triangles.size()), first_triangle};
 }
 
+void MeshData::add_lod(float error, core::Span<IndexedTriangle> triangles, core::Span<SubMesh> sub_meshes) {
+    y_always_assert(sub_meshes.size() == _sub_meshes.size(), "LODs must have the same sub-meshes as the full detail mesh");
+    y_debug_assert(error >= 0.0f);
+
+    const u32 first_triangle = u32(_triangles.size());
+    const u32 vertex_count = u32(_vertex_streams.vertex_count());
+
+    _triangles.set_min_capacity(_triangles.size() + triangles.size());
+    for(const IndexedTriangle& tri : triangles) {
+        y_always_assert(tri[0] < vertex_count && tri[1] < vertex_count && tri[2] < vertex_count, "LOD index out of range");
+        _triangles << tri;
+    }
+
+    for(const SubMesh& sub_mesh : sub_meshes) {
+        y_always_assert(sub_mesh.first_triangle + sub_mesh.triangle_count <= triangles.size(), "LOD sub-mesh out of range");
+        _lod_sub_meshes << SubMesh{sub_mesh.triangle_count, sub_mesh.first_triangle + first_triangle};
+    }
+
+    _lod_errors << error;
+}
+
+void MeshData::add_meshlets(usize sub_mesh, core::Span<Meshlet> meshlets) {
+    const SubMesh range = _sub_meshes[sub_mesh];
+
+    u32 end = _meshlets.is_empty() ? 0 : _meshlets.last().first_triangle + _meshlets.last().triangle_count;
+    for(const Meshlet& meshlet : meshlets) {
+        y_always_assert(meshlet.first_triangle + meshlet.triangle_count <= range.triangle_count, "Meshlet out of range");
+
+        Meshlet& m = _meshlets.emplace_back(meshlet);
+        m.first_triangle += range.first_triangle;
+
+        y_always_assert(m.first_triangle >= end, "Meshlets must be sorted");
+        end = m.first_triangle + m.triangle_count;
+    }
+}
+
 void MeshData::add_sub_mesh(core::Span<FullVertex> vertices, core::Span<IndexedTriangle> triangles) {
     add_sub_mesh(pack_vertices(vertices), triangles);
 }
@@ -119,8 +156,40 @@ core::Span<IndexedTriangle> MeshData::triangles() const {
     return _triangles;
 }
 
-core::Span<MeshData::SubMesh> MeshData::sub_meshes() const {
-    return _sub_meshes;
+core::Span<IndexedTriangle> MeshData::lod_triangles(usize lod) const {
+    const core::Span<SubMesh> lod_sub_meshes = sub_meshes(lod);
+    if(lod_sub_meshes.is_empty()) {
+        return {};
+    }
+
+    u32 begin = u32(-1);
+    u32 end = 0;
+    for(const SubMesh& sub_mesh : lod_sub_meshes) {
+        begin = std::min(begin, sub_mesh.first_triangle);
+        end = std::max(end, sub_mesh.first_triangle + sub_mesh.triangle_count);
+    }
+    return core::Span<IndexedTriangle>(_triangles.data() + begin, end - begin);
+}
+
+core::Span<MeshData::SubMesh> MeshData::sub_meshes(usize lod) const {
+    y_debug_assert(lod < lod_count());
+    if(!lod) {
+        return _sub_meshes;
+    }
+    return core::Span<SubMesh>(_lod_sub_meshes.data() + (lod - 1) * _sub_meshes.size(), _sub_meshes.size());
+}
+
+core::Span<MeshData::Meshlet> MeshData::meshlets() const {
+    return _meshlets;
+}
+
+usize MeshData::lod_count() const {
+    return _lod_errors.size() + 1;
+}
+
+float MeshData::lod_error(usize lod) const {
+    y_debug_assert(lod < lod_count());
+    return lod ? _lod_errors[lod - 1] : 0.0f;
 }
 
 core::Span<Bone> MeshData::bones() const {
@@ -141,11 +210,19 @@ MeshTriangleData MeshData::triangle_data() const {
     y_profile();
 
     return MeshTriangleData {
-        core::Span<IndexedTriangle>(_triangles), 
+        lod_triangles(0),
         _vertex_streams.stream<VertexStreamType::Position>()
     };
 }
 
+void MeshData::set_quantized_vertices(bool quantized) {
+    _quantized_vertices = quantized;
+}
+
+bool MeshData::quantized_vertices() const {
+    return _quantized_vertices;
+}
+
 bool MeshData::has_skeleton() const {
     return bool(_skeleton);
 }
@@ -154,5 +231,14 @@ bool MeshData::is_empty() const {
     return _vertex_streams.is_empty() || _triangles.is_empty() || _sub_meshes.is_empty();
 }
 
+
+usize select_lod(core::Span<float> lod_errors, float max_error) {
+    usize lod = 0;
+    while(lod + 1 < lod_errors.size() && lod_errors[lod + 1] <= max_error) {
+        ++lod;
+    }
+    return lod;
+}
+
 }
 
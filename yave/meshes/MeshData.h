@@ -44,6 +44,23 @@ class MeshData {
             u32 first_triangle = 0;
         };
 
+        static constexpr usize max_meshlet_vertex_count = 64;
+        static constexpr usize max_meshlet_triangle_count = 124;
+
+        // Cluster of triangles of the full detail mesh, in object space.
+        // Meshlets are contiguous triangle ranges that partition their sub-mesh, sorted by first_triangle.
+        struct Meshlet {
+            math::Vec3 center;
+            float radius = 0.0f;
+
+            // See math::NormalCone
+            math::Vec3 cone_axis;
+            float cone_cutoff = 1.0f;
+
+            u32 triangle_count = 0;
+            u32 first_triangle = 0;
+        };
+
         MeshData() = default;
 
         MeshData(core::Span<FullVertex> vertices, core::Span<IndexedTriangle> triangles);
@@ -57,12 +74,31 @@ class MeshData {
         u32 add_vertices_from_streams(const MeshVertexStreams& streams);
         void add_sub_mesh(core::Span<IndexedTriangle> triangles, u32 vertex_offset);
 
+        // LODs share the vertices of the full detail mesh and must have the same number of sub-meshes.
+        // Sub-mesh ranges are relative to the start of triangles, error is the object space distance to the full detail surface.
+        // Sub-meshes can not be added once a LOD has been added.
+        void add_lod(float error, core::Span<IndexedTriangle> triangles, core::Span<SubMesh> sub_meshes);
+
+        // Meshlet ranges are relative to the start of the sub-mesh. Sub-meshes must be given in order.
+        void add_meshlets(usize sub_mesh, core::Span<Meshlet> meshlets);
+
         float radius() const;
         const AABB& aabb() const;
 
         const MeshVertexStreams& vertex_streams() const;
+        // Triangles of every LOD, LOD 0 first
         core::Span<IndexedTriangle> triangles() const;
-        core::Span<SubMesh> sub_meshes() const;
+        core::Span<IndexedTriangle> lod_triangles(usize lod) const;
+        core::Span<SubMesh> sub_meshes(usize lod = 0) const;
+
+        usize lod_count() const;
+        float lod_error(usize lod) const;
+
+        core::Span<Meshlet> meshlets() const;
+
+        // Vertices are quantized when uploaded to the GPU (see QuantizedVertexStreams), the CPU side streams keep full precision
+        void set_quantized_vertices(bool quantized);
+        bool quantized_vertices() const;
 
         core::Span<Bone> bones() const;
         core::Span<SkinWeights> skin() const;
@@ -73,7 +109,7 @@ class MeshData {
 
         bool is_empty() const;
 
-        y_reflect(MeshData, _aabb, _vertex_streams, _triangles, _sub_meshes, _skeleton)
+        y_reflect(MeshData, _aabb, _vertex_streams, _triangles, _sub_meshes, _skeleton, _lod_errors, _lod_sub_meshes, _meshlets, _quantized_vertices)
 
     private:
         struct SkeletonData {
@@ -89,9 +125,20 @@ class MeshData {
         core::Vector<IndexedTriangle> _triangles;
         core::Vector<SubMesh> _sub_meshes;
 
+        // For LOD 1 and up, _lod_sub_meshes stores _sub_meshes.size() sub-meshes per LOD
+        core::Vector<float> _lod_errors;
+        core::Vector<SubMesh> _lod_sub_meshes;
+
+        core::Vector<Meshlet> _meshlets;
+
+        bool _quantized_vertices = false;
+
         std::unique_ptr<SkeletonData> _skeleton;
 };
 
+// Returns the coarsest LOD with an object space error of at most max_error, lod_errors starts with LOD 0 and is increasing
+usize select_lod(core::Span<float> lod_errors, float max_error);
+
 }
 
 #endif // YAVE_MESHES_MESHDATA_H
@@ -46,7 +46,7 @@ void MeshDrawData::recycle() {
 }
 
 void MeshDrawData::swap(MeshDrawData& other) {
-    std::swap(_cmd, other._cmd);
+    std::swap(_triangles, other._triangles);
     std::swap(_vertex_count, other._vertex_count);
     std::swap(_mesh_data_index, other._mesh_data_index);
     std::swap(_parent, other._parent);
@@ -70,8 +70,13 @@ TriangleSubBuffer MeshDrawData::triangle_buffer() const {
     return _parent->triangle_buffer();
 }
 
-const MeshDrawCommand& MeshDrawData::draw_command() const {
-    return _cmd;
+MeshDrawCommand MeshDrawData::draw_command() const {
+    y_debug_assert(_triangles);
+    return MeshDrawCommand {
+        _triangles->triangle_count * 3,
+        _triangles->first_triangle.load(std::memory_order_acquire) * 3,
+        0
+    };
 }
 
 u32 MeshDrawData::mesh_data_index() const {
@@ -27,6 +27,10 @@ SOFTWARE.
 #include <yave/graphics/buffers/Buffer.h>
 #include <yave/graphics/buffers/buffers.h>
 
+#include <y/math/Transform.h>
+
+#include <atomic>
+
 
 namespace yave {
 
@@ -46,10 +50,20 @@ struct MeshDrawCommand {
     }
 };
 
+// Owned by the MeshAllocator, first_triangle can change when the allocator is defragmented
+struct MeshTriangleRange {
+    std::atomic<u32> first_triangle = 0;
+    u32 triangle_count = 0;
+};
+
 struct MeshDrawBuffers {
     static constexpr usize stream_count = usize(VertexStreamType::Max);
 
     std::array<SubBuffer<BufferUsage::StorageBit | BufferUsage::AccelStructureInputBit>, stream_count> attribs;
+    std::array<VertexStreamFormat, stream_count> formats = {VertexStreamFormat::Float, VertexStreamFormat::Packed, VertexStreamFormat::Float};
+
+    // Maps the stored positions to object space, see QuantizedVertexStreams
+    math::Transform<> position_decode;
 };
 
 class MeshDrawData : NonCopyable {
@@ -64,7 +78,7 @@ class MeshDrawData : NonCopyable {
 
         const MeshAllocator* parent() const;
 
-        const MeshDrawCommand& draw_command() const;
+        MeshDrawCommand draw_command() const;
 
         MeshDrawBuffers mesh_buffers() const;
         TriangleSubBuffer triangle_buffer() const;
@@ -80,7 +94,7 @@ class MeshDrawData : NonCopyable {
         void recycle();
         void swap(MeshDrawData& other);
 
-        MeshDrawCommand _cmd;
+        const MeshTriangleRange* _triangles = nullptr;
 
         u32 _vertex_count = 0;
         u32 _mesh_data_index = u32(-1);
@@ -24,6 +24,8 @@ SOFTWARE.
 
 #include "Vertex.h"
 
+#include <yave/graphics/shader_structs.h>
+
 #include <y/core/FixedArray.h>
 #include <y/core/Span.h>
 
@@ -53,6 +55,8 @@ struct VertexStreamInfo {};
     DECLARE_STREAM_INFOS(Uv, math::Vec2);
 #undef DECLARE_STREAM_INFOS
 
+using VertexStreamFormat = shader::VertexStreamFormat;
+
 
 inline constexpr usize vertex_stream_element_size(VertexStreamType type) {
 #define STREAM_CASE(Type) case VertexStreamType::Type: return sizeof(VertexStreamInfo<VertexStreamType::Type>::type)
@@ -66,6 +70,30 @@ inline constexpr usize vertex_stream_element_size(VertexStreamType type) {
 #undef STREAM_CASE
 }
 
+// Format of the full precision streams stored in MeshVertexStreams
+inline constexpr VertexStreamFormat default_vertex_stream_format(VertexStreamType type) {
+    switch(type) {
+        case VertexStreamType::Position:        return VertexStreamFormat::Float;
+        case VertexStreamType::NormalTangent:   return VertexStreamFormat::Packed;
+        case VertexStreamType::Uv:              return VertexStreamFormat::Float;
+        default:
+            y_fatal("Unknown stream type");
+    }
+}
+
+inline constexpr usize vertex_stream_element_size(VertexStreamType type, VertexStreamFormat format) {
+    switch(format) {
+        case VertexStreamFormat::Float:
+        case VertexStreamFormat::Packed:        return vertex_stream_element_size(type);
+        case VertexStreamFormat::Snorm16:       return 8;
+        case VertexStreamFormat::Octahedral:    return 4;
+        case VertexStreamFormat::Half:          return 4;
+        case VertexStreamFormat::Unorm16:       return 4;
+        default:
+            y_fatal("Unknown stream format");
+    }
+}
+
 inline constexpr std::string_view vertex_stream_name(VertexStreamType type) {
 #define STREAM_CASE(Type) case VertexStreamType::Type: return #Type;
     switch(type) {
@@ -0,0 +1,371 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "QuantizedVertexStreams.h"
+
+#include <y/utils/memory.h>
+
+#include <cstring>
+#include <bit>
+
+namespace yave {
+
+static_assert(sizeof(math::Vec<4, i16>) == 8);
+
+static constexpr float snorm16_max = 32767.0f;
+static constexpr float unorm16_max = 65535.0f;
+static constexpr float octahedral_max = 2047.0f;
+static constexpr u32 tangent_angle_steps = 512;
+
+static u16 float_to_half(float f) {
+    const u32 bits = std::bit_cast<u32>(f);
+    const u32 sign = (bits >> 16) & 0x8000;
+    const i32 exponent = i32((bits >> 23) & 0xFF) - 127 + 15;
+    u32 mantissa = bits & 0x007FFFFF;
+
+    if(exponent <= 0) {
+        if(exponent < -10) {
+            return u16(sign);
+        }
+        mantissa |= 0x00800000;
+        const u32 shift = u32(14 - exponent);
+        const u32 rounded = (mantissa + (1 << (shift - 1))) >> shift;
+        return u16(sign | rounded);
+    }
+
+    if(exponent >= 31) {
+        return u16(sign | 0x7C00);
+    }
+
+    // Round to nearest, carries into the exponent if needed
+    return u16((sign | (u32(exponent) << 10) | (mantissa >> 13)) + ((mantissa >> 12) & 1));
+}
+
+static float half_to_float(u16 h) {
+    const u32 sign = u32(h & 0x8000) << 16;
+    const u32 exponent = (h >> 10) & 0x1F;
+    const u32 mantissa = h & 0x03FF;
+
+    if(!exponent) {
+        const float f = float(mantissa) / float(1 << 24);
+        return sign ? -f : f;
+    }
+    if(exponent == 31) {
+        return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+}
+
+static float snorm16_to_float(i16 v) {
+    return std::max(float(v) / snorm16_max, -1.0f);
+}
+
+// https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+static math::Vec2 octahedron_encode(math::Vec3 n) {
+    n /= std::abs(n.x()) + std::abs(n.y()) + std::abs(n.z());
+    math::Vec2 f = n.to<2>();
+    if(n.z() < 0.0f) {
+        f = math::Vec2(
+            (1.0f - std::abs(n.y())) * (n.x() >= 0.0f ? 1.0f : -1.0f),
+            (1.0f - std::abs(n.x())) * (n.y() >= 0.0f ? 1.0f : -1.0f)
+        );
+    }
+    return f * 0.5f + 0.5f;
+}
+
+static math::Vec3 octahedron_decode(math::Vec2 f) {
+    f = f * 2.0f - 1.0f;
+    math::Vec3 n(f.x(), f.y(), 1.0f - std::abs(f.x()) - std::abs(f.y()));
+    const float t = std::clamp(-n.z(), 0.0f, 1.0f);
+    n.x() += n.x() >= 0.0f ? -t : t;
+    n.y() += n.y() >= 0.0f ? -t : t;
+    return n.normalized();
+}
+
+// Duff et al. 2017, "Building an Orthonormal Basis, Revisited". Must match orthonormal_basis in shaders/lib/utils.slang
+static std::pair<math::Vec3, math::Vec3> orthonormal_basis(const math::Vec3& n) {
+    const float s = n.z() >= 0.0f ? 1.0f : -1.0f;
+    const float a = -1.0f / (s + n.z());
+    const float b = n.x() * n.y() * a;
+    return {
+        math::Vec3(1.0f + s * n.x() * n.x() * a, s * b, -s * n.x()),
+        math::Vec3(b, s + n.y() * n.y() * a, -n.y())
+    };
+}
+
+static u32 encode_octahedral_tbn(const math::Vec3& normal, const math::Vec4& tangent_sign) {
+    const math::Vec2 oct = octahedron_encode(normal);
+    const u32 x = u32(std::round(std::clamp(oct.x(), 0.0f, 1.0f) * octahedral_max));
+    const u32 y = u32(std::round(std::clamp(oct.y(), 0.0f, 1.0f) * octahedral_max));
+
+    // The tangent angle is relative to a basis built from the decoded normal, so that both sides agree
+    const math::Vec3 decoded_normal = octahedron_decode(math::Vec2(float(x), float(y)) / octahedral_max);
+    const auto [b1, b2] = orthonormal_basis(decoded_normal);
+
+    const math::Vec3 tangent = tangent_sign.to<3>();
+    const float angle = std::atan2(tangent.dot(b2), tangent.dot(b1));
+    const u32 a = u32(std::round((angle / (2.0f * math::pi<float>) + 0.5f) * float(tangent_angle_steps))) % tangent_angle_steps;
+
+    return x | (y << 11) | (a << 22) | (tangent_sign.w() < 0.0f ? 0x80000000 : 0);
+}
+
+
+
+QuantizedVertexStreams QuantizedVertexStreams::full_precision(const MeshVertexStreams& streams) {
+    QuantizedVertexStreams quantized;
+    quantized._vertex_count = streams.vertex_count();
+    for(usize i = 0; i != MeshVertexStreams::stream_count; ++i) {
+        const VertexStreamType type = VertexStreamType(i);
+        quantized._streams[i] = Stream{default_vertex_stream_format(type), streams.stream_data(type)};
+    }
+    return quantized;
+}
+
+QuantizedVertexStreams QuantizedVertexStreams::quantize(const MeshVertexStreams& streams, VertexStreamFormat uv_format) {
+    y_profile();
+
+    y_always_assert(uv_format == VertexStreamFormat::Unorm16 || uv_format == VertexStreamFormat::Half, "Invalid uv format");
+
+    const usize vertex_count = streams.vertex_count();
+
+    QuantizedVertexStreams quantized;
+    quantized._vertex_count = vertex_count;
+
+    auto alloc_stream = [&](VertexStreamType type, VertexStreamFormat format) {
+        const usize index = usize(type);
+        quantized._storage[index] = core::FixedArray<u8>(vertex_count * vertex_stream_element_size(type, format));
+        quantized._streams[index] = Stream{format, quantized._storage[index]};
+        return quantized._storage[index].data();
+    };
+
+    {
+        const core::Span<math::Vec3> positions = streams.stream<VertexStreamType::Position>();
+
+        math::Vec3 min(std::numeric_limits<float>::max());
+        math::Vec3 max(-std::numeric_limits<float>::max());
+        for(const math::Vec3& p : positions) {
+            min = min.min(p);
+            max = max.max(p);
+        }
+
+        if(vertex_count) {
+            quantized._position_offset = (min + max) * 0.5f;
+            quantized._position_scale = (max - min) * 0.5f;
+        }
+
+        u8* data = alloc_stream(VertexStreamType::Position, VertexStreamFormat::Snorm16);
+        for(usize i = 0; i != vertex_count; ++i) {
+            math::Vec<4, i16> q;
+            for(usize k = 0; k != 3; ++k) {
+                const float scale = quantized._position_scale[k];
+                const float snorm = scale > 0.0f ? (positions[i][k] - quantized._position_offset[k]) / scale : 0.0f;
+                q[k] = i16(std::round(std::clamp(snorm, -1.0f, 1.0f) * snorm16_max));
+            }
+            std::memcpy(data + i * sizeof(q), &q, sizeof(q));
+        }
+    }
+
+    {
+        const core::Span<math::Vec2ui> tbns = streams.stream<VertexStreamType::NormalTangent>();
+
+        u8* data = alloc_stream(VertexStreamType::NormalTangent, VertexStreamFormat::Octahedral);
+        for(usize i = 0; i != vertex_count; ++i) {
+            const math::Vec3 normal = unpack_2_10_10_10(tbns[i].x()).to<3>();
+            const u32 packed = encode_octahedral_tbn(normal.sq_length() > 0.0f ? normal.normalized() : math::Vec3(0.0f, 0.0f, 1.0f), unpack_2_10_10_10(tbns[i].y()));
+            std::memcpy(data + i * sizeof(u32), &packed, sizeof(u32));
+        }
+    }
+
+    {
+        const core::Span<math::Vec2> uvs = streams.stream<VertexStreamType::Uv>();
+
+        if(uv_format == VertexStreamFormat::Half) {
+            u8* data = alloc_stream(VertexStreamType::Uv, VertexStreamFormat::Half);
+            for(usize i = 0; i != vertex_count; ++i) {
+                const u32 packed = u32(float_to_half(uvs[i].x())) | (u32(float_to_half(uvs[i].y())) << 16);
+                std::memcpy(data + i * sizeof(u32), &packed, sizeof(u32));
+            }
+        } else {
+            math::Vec2 min(std::numeric_limits<float>::max());
+            math::Vec2 max(-std::numeric_limits<float>::max());
+            for(const math::Vec2& uv : uvs) {
+                min = min.min(uv);
+                max = max.max(uv);
+            }
+
+            if(vertex_count) {
+                quantized._uv_offset_scale = math::Vec4(min, max - min);
+            }
+
+            u8* data = alloc_stream(VertexStreamType::Uv, VertexStreamFormat::Unorm16);
+            for(usize i = 0; i != vertex_count; ++i) {
+                u32 packed = 0;
+                for(usize k = 0; k != 2; ++k) {
+                    const float range = max[k] - min[k];
+                    const float unorm = range > 0.0f ? (uvs[i][k] - min[k]) / range : 0.0f;
+                    packed |= u32(std::round(std::clamp(unorm, 0.0f, 1.0f) * unorm16_max)) << (16 * k);
+                }
+                std::memcpy(data + i * sizeof(u32), &packed, sizeof(u32));
+            }
+        }
+    }
+
+    return quantized;
+}
+
+usize QuantizedVertexStreams::vertex_count() const {
+    return _vertex_count;
+}
+
+usize QuantizedVertexStreams::byte_size() const {
+    usize size = 0;
+    for(const Stream& stream : _streams) {
+        size += stream.data.size();
+    }
+    return size;
+}
+
+VertexStreamFormat QuantizedVertexStreams::format(VertexStreamType type) const {
+    return _streams[usize(type)].format;
+}
+
+core::Span<u8> QuantizedVertexStreams::stream_data(VertexStreamType type) const {
+    return _streams[usize(type)].data;
+}
+
+const math::Vec3& QuantizedVertexStreams::position_offset() const {
+    return _position_offset;
+}
+
+const math::Vec3& QuantizedVertexStreams::position_scale() const {
+    return _position_scale;
+}
+
+const math::Vec4& QuantizedVertexStreams::uv_offset_scale() const {
+    return _uv_offset_scale;
+}
+
+math::Transform<> QuantizedVertexStreams::position_decode_transform() const {
+    if(format(VertexStreamType::Position) != VertexStreamFormat::Snorm16) {
+        return math::Transform<>();
+    }
+    math::Transform<> tr(_position_offset);
+    for(usize i = 0; i != 3; ++i) {
+        tr[i][i] = _position_scale[i];
+    }
+    return tr;
+}
+
+float QuantizedVertexStreams::max_position_error() const {
+    if(format(VertexStreamType::Position) != VertexStreamFormat::Snorm16) {
+        return 0.0f;
+    }
+    // Half a step on every axis
+    return (_position_scale / (snorm16_max * 2.0f)).length();
+}
+
+float QuantizedVertexStreams::max_uv_error() const {
+    switch(format(VertexStreamType::Uv)) {
+        case VertexStreamFormat::Half: {
+            float max_abs = 0.0f;
+            for(usize i = 0; i != _vertex_count; ++i) {
+                max_abs = std::max(max_abs, uv(i).abs().max_component());
+            }
+            // Half a ulp, halfs have 11 bits of precision
+            return max_abs / 2048.0f;
+        }
+
+        case VertexStreamFormat::Unorm16:
+            return std::max(_uv_offset_scale.z(), _uv_offset_scale.w()) / (unorm16_max * 2.0f);
+
+        default:
+            return 0.0f;
+    }
+}
+
+math::Vec3 QuantizedVertexStreams::position(usize index) const {
+    const u8* data = stream_data(VertexStreamType::Position).data();
+    if(format(VertexStreamType::Position) == VertexStreamFormat::Snorm16) {
+        math::Vec<4, i16> q;
+        std::memcpy(&q, data + index * sizeof(q), sizeof(q));
+        return _position_offset + math::Vec3(snorm16_to_float(q.x()), snorm16_to_float(q.y()), snorm16_to_float(q.z())) * _position_scale;
+    }
+
+    math::Vec3 p;
+    std::memcpy(&p, data + index * sizeof(p), sizeof(p));
+    return p;
+}
+
+math::Vec3 QuantizedVertexStreams::normal(usize index) const {
+    const u8* data = stream_data(VertexStreamType::NormalTangent).data();
+    if(format(VertexStreamType::NormalTangent) == VertexStreamFormat::Octahedral) {
+        u32 packed = 0;
+        std::memcpy(&packed, data + index * sizeof(u32), sizeof(u32));
+        return octahedron_decode(math::Vec2(float(packed & 0x7FF), float((packed >> 11) & 0x7FF)) / octahedral_max);
+    }
+
+    math::Vec2ui packed;
+    std::memcpy(&packed, data + index * sizeof(packed), sizeof(packed));
+    return unpack_2_10_10_10(packed.x()).to<3>();
+}
+
+math::Vec4 QuantizedVertexStreams::tangent_sign(usize index) const {
+    const u8* data = stream_data(VertexStreamType::NormalTangent).data();
+    if(format(VertexStreamType::NormalTangent) == VertexStreamFormat::Octahedral) {
+        u32 packed = 0;
+        std::memcpy(&packed, data + index * sizeof(u32), sizeof(u32));
+
+        const auto [b1, b2] = orthonormal_basis(normal(index));
+        const float angle = float((packed >> 22) & 0x1FF) * (2.0f * math::pi<float> / float(tangent_angle_steps)) - math::pi<float>;
+        return math::Vec4(b1 * std::cos(angle) + b2 * std::sin(angle), (packed >> 31) ? -1.0f : 1.0f);
+    }
+
+    math::Vec2ui packed;
+    std::memcpy(&packed, data + index * sizeof(packed), sizeof(packed));
+    return unpack_2_10_10_10(packed.y());
+}
+
+math::Vec2 QuantizedVertexStreams::uv(usize index) const {
+    const u8* data = stream_data(VertexStreamType::Uv).data();
+    switch(format(VertexStreamType::Uv)) {
+        case VertexStreamFormat::Half: {
+            u32 packed = 0;
+            std::memcpy(&packed, data + index * sizeof(u32), sizeof(u32));
+            return math::Vec2(half_to_float(u16(packed)), half_to_float(u16(packed >> 16)));
+        }
+
+        case VertexStreamFormat::Unorm16: {
+            u32 packed = 0;
+            std::memcpy(&packed, data + index * sizeof(u32), sizeof(u32));
+            const math::Vec2 unorm = math::Vec2(float(packed & 0xFFFF), float(packed >> 16)) / unorm16_max;
+            return _uv_offset_scale.to<2>() + unorm * math::Vec2(_uv_offset_scale.z(), _uv_offset_scale.w());
+        }
+
+        default: {
+            math::Vec2 uv;
+            std::memcpy(&uv, data + index * sizeof(uv), sizeof(uv));
+            return uv;
+        }
+    }
+}
+
+}
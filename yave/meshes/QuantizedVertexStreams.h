@@ -0,0 +1,83 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_MESHES_QUANTIZEDVERTEXSTREAMS_H
+#define YAVE_MESHES_QUANTIZEDVERTEXSTREAMS_H
+
+#include "MeshVertexStreams.h"
+#include "AABB.h"
+
+namespace yave {
+
+// GPU storage of MeshVertexStreams.
+// Quantized streams use 16 bytes per vertex instead of 28: positions are snorm16 in the mesh AABB,
+// normals and tangents are stored in 32 bits (octahedral normal and tangent angle) and uvs use either unorm16 in the uv bounds or halfs.
+class QuantizedVertexStreams {
+    public:
+        QuantizedVertexStreams() = default;
+
+        // Keeps the full precision formats (no copy is made, streams should outlive the result)
+        static QuantizedVertexStreams full_precision(const MeshVertexStreams& streams);
+        // Unorm16 uvs have a lower error bound than halfs, but halfs do not need decode parameters and are more precise close to 0
+        static QuantizedVertexStreams quantize(const MeshVertexStreams& streams, VertexStreamFormat uv_format = VertexStreamFormat::Unorm16);
+
+        usize vertex_count() const;
+        usize byte_size() const;
+
+        VertexStreamFormat format(VertexStreamType type) const;
+        core::Span<u8> stream_data(VertexStreamType type) const;
+
+        // Decode parameters for shader::StaticMeshData
+        const math::Vec3& position_offset() const;
+        const math::Vec3& position_scale() const;
+        const math::Vec4& uv_offset_scale() const;
+
+        // Maps the stored positions to object space (identity for full precision positions)
+        math::Transform<> position_decode_transform() const;
+
+        // Bounds of the absolute decoding error
+        float max_position_error() const;
+        float max_uv_error() const;
+
+        // Same decoding as read_vertex in shaders/lib/utils.slang
+        math::Vec3 position(usize index) const;
+        math::Vec3 normal(usize index) const;
+        math::Vec4 tangent_sign(usize index) const;
+        math::Vec2 uv(usize index) const;
+
+    private:
+        struct Stream {
+            VertexStreamFormat format = VertexStreamFormat::Float;
+            core::Span<u8> data;
+        };
+
+        usize _vertex_count = 0;
+        std::array<Stream, MeshVertexStreams::stream_count> _streams;
+        std::array<core::FixedArray<u8>, MeshVertexStreams::stream_count> _storage;
+
+        math::Vec3 _position_offset;
+        math::Vec3 _position_scale = math::Vec3(1.0f);
+        math::Vec4 _uv_offset_scale = math::Vec4(0.0f, 0.0f, 1.0f, 1.0f);
+};
+
+}
+
+#endif // YAVE_MESHES_QUANTIZEDVERTEXSTREAMS_H
@@ -28,25 +28,60 @@ SOFTWARE.
 namespace yave {
 
 StaticMesh::StaticMesh(const MeshData& mesh_data) :
-    _draw_data(mesh_allocator().alloc_mesh(mesh_data.vertex_streams(), mesh_data.triangles())),
+    _draw_data(mesh_allocator().alloc_mesh(mesh_data.vertex_streams(), mesh_data.triangles(), mesh_data.quantized_vertices())),
     _aabb(mesh_data.aabb()),
+    _position_decode(_draw_data.mesh_buffers().position_decode),
     _triangle_data(mesh_data.triangle_data()) {
 
-    const auto sub_meshes = mesh_data.sub_meshes();
-    _sub_meshes = core::FixedArray<MeshDrawCommand>(sub_meshes.size());
-    std::transform(sub_meshes.begin(), sub_meshes.end(), _sub_meshes.begin(), [cmd = _draw_data.draw_command()](auto sub_mesh) {
-        return MeshDrawCommand {
-            sub_mesh.triangle_count * 3,
-            sub_mesh.first_triangle * 3 + cmd.first_index,
-            cmd.vertex_offset
+    const usize lod_count = mesh_data.lod_count();
+    const usize sub_mesh_count = mesh_data.sub_meshes().size();
+
+    _lods = core::FixedArray<MeshDrawCommand>(lod_count);
+    _lod_errors = core::FixedArray<float>(lod_count);
+    _sub_meshes = core::FixedArray<MeshDrawCommand>(sub_mesh_count * lod_count);
+    for(usize lod = 0; lod != lod_count; ++lod) {
+        const auto sub_meshes = mesh_data.sub_meshes(lod);
+        std::transform(sub_meshes.begin(), sub_meshes.end(), _sub_meshes.begin() + lod * sub_mesh_count, [](auto sub_mesh) {
+            return MeshDrawCommand {
+                sub_mesh.triangle_count * 3,
+                sub_mesh.first_triangle * 3,
+                0
+            };
+        });
+
+        const core::Span<IndexedTriangle> lod_triangles = mesh_data.lod_triangles(lod);
+        _lods[lod] = MeshDrawCommand {
+            u32(lod_triangles.size() * 3),
+            lod_triangles.is_empty() ? 0 : u32(lod_triangles.data() - mesh_data.triangles().data()) * 3,
+            0
         };
-    });
+        _lod_errors[lod] = mesh_data.lod_error(lod);
+    }
+
+    {
+        const auto meshlets = mesh_data.meshlets();
+        const auto sub_meshes = mesh_data.sub_meshes();
+
+        _meshlets = core::FixedArray<MeshData::Meshlet>(meshlets.size());
+        std::copy(meshlets.begin(), meshlets.end(), _meshlets.begin());
+
+        _sub_mesh_meshlets = core::FixedArray<u32>(sub_mesh_count + 1);
+        usize meshlet = 0;
+        for(usize i = 0; i != sub_mesh_count; ++i) {
+            _sub_mesh_meshlets[i] = u32(meshlet);
+            const u32 end = sub_meshes[i].first_triangle + sub_meshes[i].triangle_count;
+            while(meshlet != meshlets.size() && meshlets[meshlet].first_triangle < end) {
+                ++meshlet;
+            }
+        }
+        _sub_mesh_meshlets[sub_mesh_count] = u32(meshlet);
+    }
 
     if(raytracing_enabled()) {
-        _blases = std::make_unique<BLAS[]>(_sub_meshes.size());
-        std::transform(_sub_meshes.begin(), _sub_meshes.end(), _blases.get(), [this](const MeshDrawCommand& draw_cmd) {
-            return BLAS(_draw_data, draw_cmd);
-        });
+        _blases = std::make_unique<BLAS[]>(sub_mesh_count);
+        for(usize i = 0; i != sub_mesh_count; ++i) {
+            _blases[i] = BLAS(_draw_data, sub_mesh_draw_command(i));
+        }
     }
 }
 
@@ -63,24 +98,67 @@ const MeshDrawData& StaticMesh::draw_data() const {
     return _draw_data;
 }
 
-const MeshDrawCommand& StaticMesh::draw_command() const {
-    return _draw_data.draw_command();
+MeshDrawCommand StaticMesh::draw_command(usize lod) const {
+    if(_lods.is_empty()) {
+        return _draw_data.draw_command();
+    }
+
+    MeshDrawCommand cmd = _lods[lod];
+    cmd.first_index += _draw_data.draw_command().first_index;
+    return cmd;
 }
 
 u32 StaticMesh::mesh_data_index() const {
     return _draw_data.mesh_data_index();
 }
 
-core::Span<MeshDrawCommand> StaticMesh::sub_meshes() const {
-    return _sub_meshes;
+usize StaticMesh::sub_mesh_count() const {
+    return _lods.is_empty() ? 0 : _sub_meshes.size() / _lods.size();
+}
+
+MeshDrawCommand StaticMesh::sub_mesh_draw_command(usize index, usize lod) const {
+    y_debug_assert(index < sub_mesh_count());
+    MeshDrawCommand cmd = _sub_meshes[lod * sub_mesh_count() + index];
+    cmd.first_index += _draw_data.draw_command().first_index;
+    return cmd;
+}
+
+core::Span<MeshData::Meshlet> StaticMesh::meshlets(usize sub_mesh) const {
+    y_debug_assert(sub_mesh < sub_mesh_count());
+    const u32 begin = _sub_mesh_meshlets[sub_mesh];
+    return core::Span<MeshData::Meshlet>(_meshlets.data() + begin, _sub_mesh_meshlets[sub_mesh + 1] - begin);
+}
+
+MeshDrawCommand StaticMesh::triangle_range_draw_command(u32 first_triangle, u32 triangle_count) const {
+    return MeshDrawCommand {
+        triangle_count * 3,
+        first_triangle * 3 + _draw_data.draw_command().first_index,
+        0
+    };
+}
+
+usize StaticMesh::lod_count() const {
+    return _lods.size();
+}
+
+float StaticMesh::lod_error(usize lod) const {
+    return _lod_errors[lod];
+}
+
+usize StaticMesh::select_lod(float max_error) const {
+    return yave::select_lod(_lod_errors, max_error);
 }
 
 const MeshTriangleData& StaticMesh::triangle_data() const {
     return _triangle_data;
 }
 
+const math::Transform<>& StaticMesh::position_decode_transform() const {
+    return _position_decode;
+}
+
 core::Span<BLAS> StaticMesh::blases() const {
-    return core::Span<BLAS>(_blases.get(), _sub_meshes.size());
+    return core::Span<BLAS>(_blases.get(), sub_mesh_count());
 }
 
 float StaticMesh::radius() const {
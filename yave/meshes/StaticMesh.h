@@ -48,12 +48,28 @@ class StaticMesh : NonCopyable {
         bool is_null() const;
 
         const MeshDrawData& draw_data() const;
-        const MeshDrawCommand& draw_command() const;
+        MeshDrawCommand draw_command(usize lod = 0) const;
         u32 mesh_data_index() const;
 
-        core::Span<MeshDrawCommand> sub_meshes() const;
+        usize sub_mesh_count() const;
+        MeshDrawCommand sub_mesh_draw_command(usize index, usize lod = 0) const;
+
+        usize lod_count() const;
+        float lod_error(usize lod) const;
+
+        // Returns the coarsest LOD with an object space error of at most max_error
+        usize select_lod(float max_error) const;
+
+        // Meshlets of the full detail sub-mesh (empty for meshes imported without meshlets)
+        core::Span<MeshData::Meshlet> meshlets(usize sub_mesh) const;
+
+        // Draws a range of the full detail triangles (usually a run of consecutive meshlets)
+        MeshDrawCommand triangle_range_draw_command(u32 first_triangle, u32 triangle_count) const;
         core::Span<BLAS> blases() const;
 
+        // BLASes are built from the stored positions, instances need to apply this transform first
+        const math::Transform<>& position_decode_transform() const;
+
         const MeshTriangleData& triangle_data() const;
 
         float radius() const;
@@ -62,9 +78,15 @@ class StaticMesh : NonCopyable {
 
     private:
         MeshDrawData _draw_data = {};
-        core::FixedArray<MeshDrawCommand> _sub_meshes;
+        core::FixedArray<MeshDrawCommand> _lods; // Relative to the start of the mesh
+        core::FixedArray<float> _lod_errors;
+        core::FixedArray<MeshDrawCommand> _sub_meshes; // Relative to the start of the mesh, for every LOD
+
+        core::FixedArray<MeshData::Meshlet> _meshlets;
+        core::FixedArray<u32> _sub_mesh_meshlets; // First meshlet of every sub-mesh, plus the end
         std::unique_ptr<BLAS[]> _blases;
         AABB _aabb;
+        math::Transform<> _position_decode;
 
         MeshTriangleData _triangle_data;
 };
@@ -0,0 +1,868 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "mesh_utils.h"
+
+#include <y/core/FixedArray.h>
+#include <y/math/Volume.h>
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <cmath>
+
+namespace yave {
+
+// Vertex to triangle adjacency, stored in a single array
+struct TriangleAdjacency {
+    core::FixedArray<u32> offsets;
+    core::FixedArray<u32> counts;
+    core::FixedArray<u32> triangles;
+
+    TriangleAdjacency(core::Span<IndexedTriangle> tris, usize vertex_count) : offsets(vertex_count + 1), counts(vertex_count), triangles(tris.size() * 3) {
+        std::fill(counts.begin(), counts.end(), 0u);
+        for(const IndexedTriangle& tri : tris) {
+            for(const u32 v : tri) {
+                ++counts[v];
+            }
+        }
+
+        offsets[0] = 0;
+        for(usize i = 0; i != vertex_count; ++i) {
+            offsets[i + 1] = offsets[i] + counts[i];
+        }
+
+        core::FixedArray<u32> cursors(vertex_count);
+        std::copy_n(offsets.begin(), vertex_count, cursors.begin());
+        for(usize t = 0; t != tris.size(); ++t) {
+            for(const u32 v : tris[t]) {
+                triangles[cursors[v]++] = u32(t);
+            }
+        }
+    }
+
+    core::Span<u32> adjacent(u32 vertex) const {
+        return core::Span<u32>(triangles.data() + offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+    }
+};
+
+
+
+VertexCacheStats analyze_vertex_cache(core::Span<IndexedTriangle> triangles, usize vertex_count, usize cache_size) {
+    if(triangles.is_empty() || !vertex_count) {
+        return {};
+    }
+
+    // Time stamps of the last time each vertex was pushed in the cache
+    core::FixedArray<u32> timestamps(vertex_count);
+    std::fill(timestamps.begin(), timestamps.end(), 0u);
+
+    u32 time = u32(cache_size + 1);
+    usize misses = 0;
+    for(const IndexedTriangle& tri : triangles) {
+        for(const u32 v : tri) {
+            y_debug_assert(v < vertex_count);
+            if(time - timestamps[v] > cache_size) {
+                timestamps[v] = time++;
+                ++misses;
+            }
+        }
+    }
+
+    VertexCacheStats stats;
+    stats.acmr = float(misses) / float(triangles.size());
+    stats.atvr = float(misses) / float(vertex_count);
+    return stats;
+}
+
+void deduplicate_vertices(const MeshVertexStreams& streams, core::MutableSpan<IndexedTriangle> triangles) {
+    y_profile();
+
+    const usize vertex_count = streams.vertex_count();
+
+    auto compare = [&](u32 a, u32 b) {
+        for(usize i = 0; i != MeshVertexStreams::stream_count; ++i) {
+            const VertexStreamType type = VertexStreamType(i);
+            if(const int c = std::memcmp(streams.vertex_stream_data(type, a), streams.vertex_stream_data(type, b), vertex_stream_element_size(type))) {
+                return c;
+            }
+        }
+        return 0;
+    };
+
+    core::FixedArray<u32> sorted(vertex_count);
+    std::iota(sorted.begin(), sorted.end(), 0u);
+    std::stable_sort(sorted.begin(), sorted.end(), [&](u32 a, u32 b) { return compare(a, b) < 0; });
+
+    // stable_sort keeps the first occurrence of every vertex at the start of its run
+    core::FixedArray<u32> remap(vertex_count);
+    for(usize i = 0; i != vertex_count; ++i) {
+        const bool is_duplicate = i && compare(sorted[i - 1], sorted[i]) == 0;
+        remap[sorted[i]] = is_duplicate ? remap[sorted[i - 1]] : sorted[i];
+    }
+
+    for(IndexedTriangle& tri : triangles) {
+        for(u32& v : tri) {
+            v = remap[v];
+        }
+    }
+}
+
+void optimize_vertex_cache(core::MutableSpan<IndexedTriangle> triangles, usize vertex_count, core::Vector<u32>* clusters) {
+    y_profile();
+
+    if(clusters) {
+        clusters->make_empty();
+    }
+
+    if(triangles.is_empty()) {
+        return;
+    }
+
+    const TriangleAdjacency adjacency(triangles, vertex_count);
+
+    core::FixedArray<u32> live_triangles(vertex_count);
+    std::copy(adjacency.counts.begin(), adjacency.counts.end(), live_triangles.begin());
+
+    core::FixedArray<u32> timestamps(vertex_count);
+    std::fill(timestamps.begin(), timestamps.end(), 0u);
+
+    core::FixedArray<u8> emitted(triangles.size());
+    std::fill(emitted.begin(), emitted.end(), u8(0));
+
+    core::Vector<IndexedTriangle> output;
+    output.set_min_capacity(triangles.size());
+
+    core::Vector<u32> dead_ends;
+    core::Vector<u32> candidates;
+
+    const u32 cache_size = u32(vertex_cache_size);
+    u32 time = cache_size + 1;
+    u32 scan_cursor = 0;
+
+    // Dead ends are vertices that still have live triangles but might have left the cache
+    const auto skip_dead_end = [&]() -> i64 {
+        while(!dead_ends.is_empty()) {
+            const u32 v = dead_ends.pop();
+            if(live_triangles[v]) {
+                return v;
+            }
+        }
+        for(; scan_cursor != vertex_count; ++scan_cursor) {
+            if(live_triangles[scan_cursor]) {
+                return scan_cursor;
+            }
+        }
+        return -1;
+    };
+
+    // Picks the vertex that will still be in the cache once all its triangles have been emitted, preferring older ones
+    const auto next_vertex = [&]() -> i64 {
+        i64 best = -1;
+        u32 best_priority = 0;
+        for(const u32 v : candidates) {
+            if(!live_triangles[v]) {
+                continue;
+            }
+
+            u32 priority = 0;
+            if(time - timestamps[v] + 2 * live_triangles[v] <= cache_size) {
+                priority = time - timestamps[v];
+            }
+
+            if(best < 0 || priority > best_priority) {
+                best_priority = priority;
+                best = v;
+            }
+        }
+        return best;
+    };
+
+    i64 fanning = skip_dead_end();
+    while(fanning >= 0) {
+        candidates.make_empty();
+
+        for(const u32 t : adjacency.adjacent(u32(fanning))) {
+            if(emitted[t]) {
+                continue;
+            }
+
+            for(const u32 v : triangles[t]) {
+                dead_ends << v;
+                candidates << v;
+                --live_triangles[v];
+                if(time - timestamps[v] > cache_size) {
+                    timestamps[v] = time++;
+                }
+            }
+
+            emitted[t] = 1;
+            output << triangles[t];
+        }
+
+        fanning = next_vertex();
+        if(fanning < 0) {
+            // We are starting from a vertex that might not be in the cache anymore, so we start a new cluster
+            fanning = skip_dead_end();
+            if(clusters && fanning >= 0) {
+                clusters->push_back(u32(output.size()));
+            }
+        }
+    }
+
+    y_debug_assert(output.size() == triangles.size());
+    std::copy(output.begin(), output.end(), triangles.begin());
+
+    if(clusters) {
+        clusters->insert(clusters->begin(), 0u);
+    }
+}
+
+void optimize_overdraw(core::MutableSpan<IndexedTriangle> triangles, core::Span<math::Vec3> positions, float threshold) {
+    y_profile();
+
+    if(triangles.size() < 2) {
+        return;
+    }
+
+    const usize vertex_count = positions.size();
+
+    core::Vector<u32> hard_clusters;
+    optimize_vertex_cache(triangles, vertex_count, &hard_clusters);
+    hard_clusters << u32(triangles.size());
+
+    const float max_acmr = analyze_vertex_cache(triangles, vertex_count).acmr * threshold;
+
+    // Split hard clusters where the ACMR of the current cluster is low enough
+    core::Vector<u32> clusters;
+    {
+        core::FixedArray<u32> timestamps(vertex_count);
+        std::fill(timestamps.begin(), timestamps.end(), 0u);
+
+        u32 time = u32(vertex_cache_size + 1);
+        for(usize c = 0; c + 1 < hard_clusters.size(); ++c) {
+            const u32 begin = hard_clusters[c];
+            const u32 end = hard_clusters[c + 1];
+
+            clusters << begin;
+
+            usize misses = 0;
+            usize cluster_begin = begin;
+            for(u32 t = begin; t != end; ++t) {
+                for(const u32 v : triangles[t]) {
+                    if(time - timestamps[v] > vertex_cache_size) {
+                        timestamps[v] = time++;
+                        ++misses;
+                    }
+                }
+
+                const usize cluster_size = t + 1 - cluster_begin;
+                if(t + 1 != end && float(misses) / float(cluster_size) <= max_acmr) {
+                    clusters << (t + 1);
+                    cluster_begin = t + 1;
+                    misses = 0;
+                    // Restart with a cold cache to stay conservative
+                    time += u32(vertex_cache_size + 1);
+                }
+            }
+        }
+        clusters << u32(triangles.size());
+    }
+
+    // Sort clusters so that the ones facing away from the center of the mesh are drawn first
+    math::Vec3 mesh_center;
+    {
+        float total_area = 0.0f;
+        for(const IndexedTriangle& tri : triangles) {
+            const math::Vec3 a = positions[tri[0]];
+            const math::Vec3 b = positions[tri[1]];
+            const math::Vec3 c = positions[tri[2]];
+            const float area = (b - a).cross(c - a).length();
+            mesh_center += (a + b + c) * (area / 3.0f);
+            total_area += area;
+        }
+        mesh_center /= std::max(total_area, math::epsilon<float>);
+    }
+
+    struct Cluster {
+        u32 begin = 0;
+        u32 end = 0;
+        float sort_key = 0.0f;
+    };
+
+    core::Vector<Cluster> sorted;
+    sorted.set_min_capacity(clusters.size());
+    for(usize c = 0; c + 1 < clusters.size(); ++c) {
+        Cluster cluster;
+        cluster.begin = clusters[c];
+        cluster.end = clusters[c + 1];
+
+        math::Vec3 center;
+        math::Vec3 normal;
+        float total_area = 0.0f;
+        for(u32 t = cluster.begin; t != cluster.end; ++t) {
+            const IndexedTriangle& tri = triangles[t];
+            const math::Vec3 a = positions[tri[0]];
+            const math::Vec3 b = positions[tri[1]];
+            const math::Vec3 c = positions[tri[2]];
+            const math::Vec3 n = (b - a).cross(c - a);
+            const float area = n.length();
+            center += (a + b + c) * (area / 3.0f);
+            normal += n;
+            total_area += area;
+        }
+
+        if(total_area > 0.0f) {
+            center /= total_area;
+        }
+
+        const float normal_length = normal.length();
+        cluster.sort_key = normal_length > 0.0f ? (center - mesh_center).dot(normal / normal_length) : 0.0f;
+        sorted << cluster;
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) { return a.sort_key > b.sort_key; });
+
+    core::Vector<IndexedTriangle> output;
+    output.set_min_capacity(triangles.size());
+    for(const Cluster& cluster : sorted) {
+        for(u32 t = cluster.begin; t != cluster.end; ++t) {
+            output << triangles[t];
+        }
+    }
+
+    y_debug_assert(output.size() == triangles.size());
+    std::copy(output.begin(), output.end(), triangles.begin());
+}
+
+MeshVertexStreams optimize_vertex_fetch(const MeshVertexStreams& streams, core::MutableSpan<IndexedTriangle> triangles) {
+    y_profile();
+
+    const u32 unused_vertex = u32(-1);
+
+    core::FixedArray<u32> remap(streams.vertex_count());
+    std::fill(remap.begin(), remap.end(), unused_vertex);
+
+    u32 vertex_count = 0;
+    for(IndexedTriangle& tri : triangles) {
+        for(u32& v : tri) {
+            if(remap[v] == unused_vertex) {
+                remap[v] = vertex_count++;
+            }
+            v = remap[v];
+        }
+    }
+
+    MeshVertexStreams optimized(vertex_count);
+    for(usize i = 0; i != MeshVertexStreams::stream_count; ++i) {
+        const VertexStreamType type = VertexStreamType(i);
+        const usize elem_size = vertex_stream_element_size(type);
+        for(usize v = 0; v != remap.size(); ++v) {
+            if(remap[v] != unused_vertex) {
+                std::memcpy(optimized.vertex_stream_data(type, remap[v]), streams.vertex_stream_data(type, v), elem_size);
+            }
+        }
+    }
+
+    return optimized;
+}
+
+// Sum of squared distances to a set of planes, weighted by triangle area
+struct Quadric {
+    double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+    double b2 = 0.0, bc = 0.0, bd = 0.0;
+    double c2 = 0.0, cd = 0.0;
+    double d2 = 0.0;
+    double weight = 0.0;
+
+    static Quadric from_plane(const math::Vec3& n, double d, double weight) {
+        const double a = n.x();
+        const double b = n.y();
+        const double c = n.z();
+
+        Quadric q;
+        q.a2 = a * a * weight; q.ab = a * b * weight; q.ac = a * c * weight; q.ad = a * d * weight;
+        q.b2 = b * b * weight; q.bc = b * c * weight; q.bd = b * d * weight;
+        q.c2 = c * c * weight; q.cd = c * d * weight;
+        q.d2 = d * d * weight;
+        q.weight = weight;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& q) {
+        a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+        b2 += q.b2; bc += q.bc; bd += q.bd;
+        c2 += q.c2; cd += q.cd;
+        d2 += q.d2;
+        weight += q.weight;
+        return *this;
+    }
+
+    Quadric operator+(const Quadric& q) const {
+        Quadric r = *this;
+        return r += q;
+    }
+
+    // Mean squared distance
+    double error(const math::Vec3& p) const {
+        const double x = p.x();
+        const double y = p.y();
+        const double z = p.z();
+        const double e =
+            a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+            b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+            c2 * z * z + 2.0 * cd * z +
+            d2;
+        return weight > 0.0 ? std::max(0.0, e / weight) : 0.0;
+    }
+};
+
+class Simplifier {
+    public:
+        Simplifier(core::Span<math::Vec3> positions, core::Span<IndexedTriangle> triangles) :
+                _positions(positions),
+                _triangles(triangles),
+                _quadrics(positions.size()),
+                _locked(positions.size()) {
+
+            std::fill(_locked.begin(), _locked.end(), u8(0));
+
+            lock_seams_and_borders();
+
+            for(const IndexedTriangle& tri : _triangles) {
+                const math::Vec3 a = _positions[tri[0]];
+                const math::Vec3 n = (_positions[tri[1]] - a).cross(_positions[tri[2]] - a);
+                const float double_area = n.length();
+                if(double_area <= 0.0f) {
+                    continue;
+                }
+
+                const math::Vec3 normal = n / double_area;
+                const Quadric q = Quadric::from_plane(normal, -normal.dot(a), double_area * 0.5f);
+                for(const u32 v : tri) {
+                    _quadrics[v] += q;
+                }
+            }
+        }
+
+        usize triangle_count() const {
+            return _triangles.size();
+        }
+
+        core::Span<IndexedTriangle> triangles() const {
+            return _triangles;
+        }
+
+        float error() const {
+            return _error;
+        }
+
+        void simplify(usize target_count) {
+            struct Collapse {
+                u32 from = 0;
+                u32 to = 0;
+                double cost = 0.0;
+            };
+
+            core::Vector<Collapse> collapses;
+            core::FixedArray<u8> touched(_positions.size());
+            core::FixedArray<u32> collapse_to(_positions.size());
+
+            while(_triangles.size() > target_count) {
+                collapses.make_empty();
+                for(const IndexedTriangle& tri : _triangles) {
+                    for(usize i = 0; i != 3; ++i) {
+                        const u32 from = tri[i];
+                        const u32 to = tri[(i + 1) % 3];
+                        if(!_locked[from]) {
+                            collapses << Collapse{from, to, (_quadrics[from] + _quadrics[to]).error(_positions[to])};
+                        }
+                    }
+                }
+
+                if(collapses.is_empty()) {
+                    break;
+                }
+
+                std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+                const TriangleAdjacency adjacency(_triangles, _positions.size());
+
+                std::fill(touched.begin(), touched.end(), u8(0));
+                std::iota(collapse_to.begin(), collapse_to.end(), 0u);
+
+                // Every collapse removes about two triangles
+                usize budget = (_triangles.size() - target_count) / 2 + 1;
+                usize collapsed = 0;
+
+                for(const Collapse& collapse : collapses) {
+                    if(!budget) {
+                        break;
+                    }
+
+                    if(touched[collapse.from] || touched[collapse.to] || flips(adjacency, collapse.from, collapse.to)) {
+                        continue;
+                    }
+
+                    collapse_to[collapse.from] = collapse.to;
+                    _quadrics[collapse.to] += _quadrics[collapse.from];
+                    _error = std::max(_error, float(std::sqrt(collapse.cost)));
+
+                    // Triangles around the collapsed vertex have changed, so we don't touch their vertices until the next pass
+                    for(const u32 t : adjacency.adjacent(collapse.from)) {
+                        for(const u32 v : _triangles[t]) {
+                            touched[v] = 1;
+                        }
+                    }
+
+                    --budget;
+                    ++collapsed;
+                }
+
+                if(!collapsed) {
+                    break;
+                }
+
+                usize kept = 0;
+                for(const IndexedTriangle& tri : _triangles) {
+                    const IndexedTriangle collapsed_tri = {collapse_to[tri[0]], collapse_to[tri[1]], collapse_to[tri[2]]};
+                    if(collapsed_tri[0] != collapsed_tri[1] && collapsed_tri[1] != collapsed_tri[2] && collapsed_tri[0] != collapsed_tri[2]) {
+                        _triangles[kept++] = collapsed_tri;
+                    }
+                }
+                while(_triangles.size() > kept) {
+                    _triangles.pop();
+                }
+            }
+        }
+
+    private:
+        // Moving from onto to should not flip any of the remaining triangles
+        bool flips(const TriangleAdjacency& adjacency, u32 from, u32 to) const {
+            for(const u32 t : adjacency.adjacent(from)) {
+                const IndexedTriangle& tri = _triangles[t];
+                if(tri[0] == to || tri[1] == to || tri[2] == to) {
+                    continue;
+                }
+
+                std::array<math::Vec3, 3> before = {_positions[tri[0]], _positions[tri[1]], _positions[tri[2]]};
+                std::array<math::Vec3, 3> after = before;
+                for(usize i = 0; i != 3; ++i) {
+                    if(tri[i] == from) {
+                        after[i] = _positions[to];
+                    }
+                }
+
+                const math::Vec3 n_before = (before[1] - before[0]).cross(before[2] - before[0]);
+                const math::Vec3 n_after = (after[1] - after[0]).cross(after[2] - after[0]);
+                if(n_before.dot(n_after) <= 0.25f * n_before.length() * n_after.length()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Vertices sharing a position with another vertex (seams) or on an open edge (borders) are locked
+        void lock_seams_and_borders() {
+            const usize vertex_count = _positions.size();
+
+            core::FixedArray<u32> sorted(vertex_count);
+            std::iota(sorted.begin(), sorted.end(), 0u);
+            const auto position_less = [&](u32 a, u32 b) {
+                const math::Vec3& pa = _positions[a];
+                const math::Vec3& pb = _positions[b];
+                return std::tie(pa.x(), pa.y(), pa.z()) < std::tie(pb.x(), pb.y(), pb.z());
+            };
+            std::sort(sorted.begin(), sorted.end(), position_less);
+
+            core::FixedArray<u32> welded(vertex_count);
+            for(usize i = 0; i != vertex_count; ++i) {
+                const bool same_position = i && _positions[sorted[i - 1]] == _positions[sorted[i]];
+                welded[sorted[i]] = same_position ? welded[sorted[i - 1]] : sorted[i];
+                if(same_position) {
+                    _locked[sorted[i - 1]] = 1;
+                    _locked[sorted[i]] = 1;
+                }
+            }
+
+            core::Vector<u64> edges;
+            edges.set_min_capacity(_triangles.size() * 3);
+            for(const IndexedTriangle& tri : _triangles) {
+                for(usize i = 0; i != 3; ++i) {
+                    const u32 a = welded[tri[i]];
+                    const u32 b = welded[tri[(i + 1) % 3]];
+                    edges << ((u64(std::min(a, b)) << 32) | std::max(a, b));
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+
+            for(usize i = 0; i != edges.size();) {
+                usize end = i + 1;
+                while(end != edges.size() && edges[end] == edges[i]) {
+                    ++end;
+                }
+                if(end - i == 1) {
+                    _locked[u32(edges[i] >> 32)] = 1;
+                    _locked[u32(edges[i])] = 1;
+                }
+                i = end;
+            }
+
+            // Welded vertices are locked through their representative
+            for(usize i = 0; i != vertex_count; ++i) {
+                _locked[i] |= _locked[welded[i]];
+            }
+        }
+
+        core::Span<math::Vec3> _positions;
+        core::Vector<IndexedTriangle> _triangles;
+
+        core::FixedArray<Quadric> _quadrics;
+        core::FixedArray<u8> _locked;
+
+        float _error = 0.0f;
+};
+
+core::Vector<MeshLod> generate_lods(core::Span<math::Vec3> positions, core::Span<IndexedTriangle> triangles, usize max_lod_count, float max_error) {
+    y_profile();
+
+    static constexpr usize min_lod_triangle_count = 16;
+
+    core::Vector<MeshLod> lods;
+
+    Simplifier simplifier(positions, triangles);
+    for(usize lod = 1; lod < max_lod_count; ++lod) {
+        const usize prev_count = simplifier.triangle_count();
+        const usize target_count = prev_count / 2;
+        if(target_count < min_lod_triangle_count) {
+            break;
+        }
+
+        simplifier.simplify(target_count);
+
+        // Not worth a new LOD
+        if(simplifier.triangle_count() * 5 > prev_count * 4) {
+            break;
+        }
+
+        if(simplifier.error() > max_error) {
+            break;
+        }
+
+        MeshLod& mesh_lod = lods.emplace_back();
+        mesh_lod.error = simplifier.error();
+        mesh_lod.triangles = core::Vector<IndexedTriangle>(simplifier.triangles());
+        optimize_vertex_cache(mesh_lod.triangles, positions.size());
+    }
+
+    return lods;
+}
+
+MeshData::Meshlet compute_meshlet_bounds(core::Span<IndexedTriangle> triangles, core::Span<math::Vec3> positions) {
+    math::Vec3 min(std::numeric_limits<float>::max());
+    math::Vec3 max(-std::numeric_limits<float>::max());
+    for(const IndexedTriangle& tri : triangles) {
+        for(const u32 v : tri) {
+            min = min.min(positions[v]);
+            max = max.max(positions[v]);
+        }
+    }
+
+    MeshData::Meshlet meshlet;
+    meshlet.center = (min + max) * 0.5f;
+    for(const IndexedTriangle& tri : triangles) {
+        for(const u32 v : tri) {
+            meshlet.radius = std::max(meshlet.radius, (positions[v] - meshlet.center).length());
+        }
+    }
+
+    core::Vector<math::Vec3> normals;
+    normals.set_min_capacity(triangles.size());
+    for(const IndexedTriangle& tri : triangles) {
+        const math::Vec3 n = (positions[tri[1]] - positions[tri[0]]).cross(positions[tri[2]] - positions[tri[0]]);
+        const float length = n.length();
+        normals << (length > 0.0f ? n / length : math::Vec3());
+    }
+
+    const math::NormalCone<> cone = math::NormalCone<>::from_normals(normals.begin(), normals.end());
+    meshlet.cone_axis = cone.axis();
+    meshlet.cone_cutoff = cone.cutoff();
+
+    return meshlet;
+}
+
+core::Vector<MeshData::Meshlet> build_meshlets(core::MutableSpan<IndexedTriangle> triangles, core::Span<math::Vec3> positions, usize max_vertex_count, usize max_triangle_count) {
+    y_profile();
+
+    y_debug_assert(max_vertex_count >= 3);
+    y_debug_assert(max_triangle_count >= 1);
+
+    const usize vertex_count = positions.size();
+    const TriangleAdjacency adjacency(triangles, vertex_count);
+
+    core::FixedArray<math::Vec3> normals(triangles.size());
+    for(usize t = 0; t != triangles.size(); ++t) {
+        const IndexedTriangle& tri = triangles[t];
+        const math::Vec3 n = (positions[tri[1]] - positions[tri[0]]).cross(positions[tri[2]] - positions[tri[0]]);
+        const float length = n.length();
+        normals[t] = length > 0.0f ? n / length : math::Vec3();
+    }
+
+    core::FixedArray<u8> emitted(triangles.size());
+    std::fill(emitted.begin(), emitted.end(), u8(0));
+
+    // Index of the last meshlet (plus one) that used each vertex
+    core::FixedArray<u32> vertex_meshlet(vertex_count);
+    std::fill(vertex_meshlet.begin(), vertex_meshlet.end(), 0u);
+
+    core::Vector<IndexedTriangle> ordered;
+    ordered.set_min_capacity(triangles.size());
+
+    core::Vector<u32> meshlet_ends;
+    core::Vector<u32> candidates;
+
+    usize cursor = 0;
+    usize meshlet_vertex_count = 0;
+    math::Vec3 normal_sum;
+
+    const auto add_triangle = [&](u32 t) {
+        const u32 meshlet_id = u32(meshlet_ends.size() + 1);
+        for(const u32 v : triangles[t]) {
+            if(vertex_meshlet[v] != meshlet_id) {
+                vertex_meshlet[v] = meshlet_id;
+                ++meshlet_vertex_count;
+                for(const u32 adj : adjacency.adjacent(v)) {
+                    if(!emitted[adj]) {
+                        candidates << adj;
+                    }
+                }
+            }
+        }
+        emitted[t] = 1;
+        ordered << triangles[t];
+        normal_sum += normals[t];
+    };
+
+    while(ordered.size() != triangles.size()) {
+        // Seed with a neighbour of the previous meshlet if possible to keep meshlets spatially coherent
+        u32 seed = u32(-1);
+        for(const u32 t : candidates) {
+            if(!emitted[t]) {
+                seed = t;
+                break;
+            }
+        }
+        if(seed == u32(-1)) {
+            while(emitted[cursor]) {
+                ++cursor;
+            }
+            seed = u32(cursor);
+        }
+
+        candidates.make_empty();
+        meshlet_vertex_count = 0;
+        normal_sum = math::Vec3();
+
+        const usize meshlet_begin = ordered.size();
+        add_triangle(seed);
+
+        while(ordered.size() - meshlet_begin < max_triangle_count) {
+            const u32 meshlet_id = u32(meshlet_ends.size() + 1);
+            const float normal_length = normal_sum.length();
+            const math::Vec3 cone_axis = normal_length > 0.0f ? normal_sum / normal_length : math::Vec3();
+
+            u32 best = u32(-1);
+            float best_score = std::numeric_limits<float>::max();
+            usize kept = 0;
+            for(const u32 t : candidates) {
+                if(emitted[t]) {
+                    continue;
+                }
+                candidates[kept++] = t;
+
+                usize extra = 0;
+                for(const u32 v : triangles[t]) {
+                    extra += vertex_meshlet[v] != meshlet_id;
+                }
+
+                if(meshlet_vertex_count + extra > max_vertex_count) {
+                    continue;
+                }
+
+                // New vertices dominate, normal agreement breaks ties
+                const float score = float(extra) + (1.0f - cone_axis.dot(normals[t])) * 0.5f;
+                if(score < best_score) {
+                    best_score = score;
+                    best = t;
+                }
+            }
+
+            while(candidates.size() > kept) {
+                candidates.pop();
+            }
+
+            if(best == u32(-1)) {
+                break;
+            }
+
+            add_triangle(best);
+        }
+
+        meshlet_ends << u32(ordered.size());
+    }
+
+    std::copy(ordered.begin(), ordered.end(), triangles.begin());
+
+    core::Vector<MeshData::Meshlet> meshlets;
+    meshlets.set_min_capacity(meshlet_ends.size());
+
+    u32 begin = 0;
+    for(const u32 end : meshlet_ends) {
+        MeshData::Meshlet& meshlet = meshlets.emplace_back(compute_meshlet_bounds(core::Span<IndexedTriangle>(triangles.data() + begin, end - begin), positions));
+        meshlet.first_triangle = begin;
+        meshlet.triangle_count = end - begin;
+        begin = end;
+    }
+
+    return meshlets;
+}
+
+MeshOptimizationStats optimize_mesh(MeshVertexStreams& streams, core::MutableSpan<IndexedTriangle> triangles, core::Vector<MeshData::Meshlet>* meshlets) {
+    y_profile();
+
+    MeshOptimizationStats stats;
+    stats.vertex_count_before = streams.vertex_count();
+    stats.before = analyze_vertex_cache(triangles, streams.vertex_count());
+
+    deduplicate_vertices(streams, triangles);
+    optimize_overdraw(triangles, streams.stream<VertexStreamType::Position>());
+    if(meshlets) {
+        *meshlets = build_meshlets(triangles, streams.stream<VertexStreamType::Position>());
+    }
+    streams = optimize_vertex_fetch(streams, triangles);
+
+    stats.vertex_count_after = streams.vertex_count();
+    stats.after = analyze_vertex_cache(triangles, streams.vertex_count());
+    return stats;
+}
+
+}
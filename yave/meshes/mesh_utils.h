@@ -0,0 +1,92 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_MESHES_MESHUTILS_H
+#define YAVE_MESHES_MESHUTILS_H
+
+#include "MeshData.h"
+
+#include <y/core/Vector.h>
+
+#include <limits>
+
+namespace yave {
+
+inline constexpr usize vertex_cache_size = 16;
+
+struct VertexCacheStats {
+    // Average cache miss ratio: transformed vertices per triangle (0.5 is the best possible, 3 the worst)
+    float acmr = 0.0f;
+
+    // Average transform to vertex ratio: transformed vertices per vertex (1 is the best possible)
+    float atvr = 0.0f;
+};
+
+struct MeshLod {
+    // Maximum object space distance to the original surface
+    float error = 0.0f;
+    core::Vector<IndexedTriangle> triangles;
+};
+
+struct MeshOptimizationStats {
+    VertexCacheStats before;
+    VertexCacheStats after;
+
+    usize vertex_count_before = 0;
+    usize vertex_count_after = 0;
+};
+
+// Simulates a FIFO post-transform cache
+[[nodiscard]] VertexCacheStats analyze_vertex_cache(core::Span<IndexedTriangle> triangles, usize vertex_count, usize cache_size = vertex_cache_size);
+
+// Remaps indices of identical vertices (same data in every stream) to their first occurrence
+void deduplicate_vertices(const MeshVertexStreams& streams, core::MutableSpan<IndexedTriangle> triangles);
+
+// Tipsify (Sander et al. 2007). If clusters is not null, it gets the first triangle of every cluster, in the output order
+void optimize_vertex_cache(core::MutableSpan<IndexedTriangle> triangles, usize vertex_count, core::Vector<u32>* clusters = nullptr);
+
+// Reorders clusters of triangles so that outward facing ones come first, only splitting clusters while ACMR stays under threshold times the current one.
+// Triangles should already be optimized for the vertex cache.
+void optimize_overdraw(core::MutableSpan<IndexedTriangle> triangles, core::Span<math::Vec3> positions, float threshold = 1.05f);
+
+// Orders vertices by first use and drops unused ones
+[[nodiscard]] MeshVertexStreams optimize_vertex_fetch(const MeshVertexStreams& streams, core::MutableSpan<IndexedTriangle> triangles);
+
+// Quadric error simplification (Garland and Heckbert 1997) using half edge collapses, so vertices are shared with the full detail mesh.
+// Each LOD has about half the triangles of the previous one, generation stops when simplification stalls or when the error goes over max_error.
+// Vertices on borders and attribute seams are never moved.
+[[nodiscard]] core::Vector<MeshLod> generate_lods(core::Span<math::Vec3> positions, core::Span<IndexedTriangle> triangles, usize max_lod_count = 4, float max_error = std::numeric_limits<float>::max());
+
+// Bounding sphere and normal cone of a set of triangles, the triangle range is left empty
+[[nodiscard]] MeshData::Meshlet compute_meshlet_bounds(core::Span<IndexedTriangle> triangles, core::Span<math::Vec3> positions);
+
+// Greedily grows meshlets from adjacent triangles that add the fewest vertices and best match the meshlet normal cone.
+// Triangles are reordered so that every meshlet is a contiguous range, seeds follow the input order.
+[[nodiscard]] core::Vector<MeshData::Meshlet> build_meshlets(core::MutableSpan<IndexedTriangle> triangles, core::Span<math::Vec3> positions,
+                                                           usize max_vertex_count = MeshData::max_meshlet_vertex_count,
+                                                           usize max_triangle_count = MeshData::max_meshlet_triangle_count);
+
+// Runs all of the above (except LOD generation). Builds meshlets if meshlets is not null.
+[[nodiscard]] MeshOptimizationStats optimize_mesh(MeshVertexStreams& streams, core::MutableSpan<IndexedTriangle> triangles, core::Vector<MeshData::Meshlet>* meshlets = nullptr);
+
+}
+
+#endif // YAVE_MESHES_MESHUTILS_H
@@ -24,13 +24,131 @@ SOFTWARE.
 
 #include <yave/material/MaterialTemplate.h>
 #include <yave/graphics/device/DeviceResources.h>
+#include <yave/graphics/device/MaterialAllocator.h>
+
+#include <y/math/Volume.h>
 
 namespace yave {
 
+// Converts the allowed screen error into an object space error: LODs are selected per object on the CPU
+class LodSelector {
+    public:
+        LodSelector(const Camera& camera, PassType pass_type, const CollectBatchesSubPass::LodSettings& settings) :
+                _position(camera.position()),
+                _is_orthographic(camera.is_orthographic()) {
+
+            const float max_error = settings.max_screen_error * (pass_type == PassType::Depth ? settings.depth_error_scale : 1.0f);
+
+            // proj[1][1] is 1 / tan(fov / 2) for perspective and 2 / height for orthographic projections
+            // A full screen height spans 2 in NDC
+            _world_error_factor = max_error * 2.0f / std::max(std::abs(camera.proj_matrix()[1][1]), math::epsilon<float>);
+        }
+
+        usize select_lod(const StaticMeshObject& mesh, const StaticMesh& static_mesh) const {
+            if(static_mesh.lod_count() <= 1) {
+                return 0;
+            }
+
+            const float local_radius = static_mesh.aabb().radius();
+            const float scale = local_radius > 0.0f ? mesh.global_aabb.radius() / local_radius : 1.0f;
+
+            float world_error = _world_error_factor;
+            if(!_is_orthographic) {
+                // Use the closest point of the bounding sphere so that large objects are not simplified while the camera is close to one of their ends
+                const float dist = (mesh.global_aabb.center() - _position).length() - mesh.global_aabb.radius();
+                world_error *= std::max(dist, math::epsilon<float>);
+            }
+
+            return static_mesh.select_lod(world_error / std::max(scale, math::epsilon<float>));
+        }
+
+    private:
+        math::Vec3 _position;
+        float _world_error_factor = 0.0f;
+        bool _is_orthographic = false;
+};
+
+// Culls the meshlets of the full detail mesh against the frustum and, for single sided materials, using their normal cones.
+// Runs of consecutive visible meshlets are merged into a single draw.
+class MeshletCuller {
+    public:
+        MeshletCuller(const SceneView& scene_view, PassType pass_type) :
+                _scene(scene_view.scene()),
+                _frustum(scene_view.camera().frustum()),
+                _position(scene_view.camera().position()),
+                _forward(scene_view.camera().forward()),
+                _is_orthographic(scene_view.camera().is_orthographic()),
+                _cull_backfaces(pass_type == PassType::GBuffer || pass_type == PassType::Forward) {
+        }
+
+        bool is_enabled() const {
+            return _scene;
+        }
+
+        // Returns false if the mesh has no meshlets, in which case nothing is emitted
+        template<typename F>
+        bool for_each_visible_range(const StaticMeshObject& mesh, const StaticMesh& static_mesh, usize sub_mesh, bool double_sided, F&& emit) const {
+            const core::Span<MeshData::Meshlet> meshlets = static_mesh.meshlets(sub_mesh);
+            if(meshlets.is_empty()) {
+                return false;
+            }
+
+            const math::Transform<>& transform = _scene->transform(mesh);
+            const math::Vec3 scale = transform.scale();
+            const float max_scale = scale.max_component();
+
+            // Normal cones can not be transformed by non uniform scales
+            const bool cull_backfaces = _cull_backfaces && !double_sided && max_scale - scale.min_component() <= max_scale * 0.01f;
+
+            u32 range_begin = 0;
+            u32 range_end = 0;
+            for(const MeshData::Meshlet& meshlet : meshlets) {
+                const math::Vec3 center = transform.transform_point(meshlet.center);
+                const float radius = meshlet.radius * max_scale;
+
+                bool visible = _frustum.is_inside(center, radius);
+                if(visible && cull_backfaces) {
+                    const math::NormalCone<> cone(transform.transform_direction(meshlet.cone_axis) / max_scale, meshlet.cone_cutoff);
+                    visible = !(_is_orthographic ? cone.is_backfacing(_forward) : cone.is_backfacing(center, radius, _position));
+                }
+
+                if(!visible) {
+                    continue;
+                }
+
+                if(meshlet.first_triangle != range_end) {
+                    if(range_end != range_begin) {
+                        emit(static_mesh.triangle_range_draw_command(range_begin, range_end - range_begin));
+                    }
+                    range_begin = meshlet.first_triangle;
+                }
+                range_end = meshlet.first_triangle + meshlet.triangle_count;
+            }
+
+            if(range_end != range_begin) {
+                emit(static_mesh.triangle_range_draw_command(range_begin, range_end - range_begin));
+            }
+
+            return true;
+        }
+
+    private:
+        const Scene* _scene = nullptr;
+        Frustum _frustum;
+        math::Vec3 _position;
+        math::Vec3 _forward;
+        bool _is_orthographic = false;
+        bool _cull_backfaces = false;
+};
+
 template<typename F>
-static void collect_batches(core::Span<const StaticMeshObject*> meshes, core::Vector<StaticMeshBatch>& batches, PassType pass_type, F&& mat_filter) {
+static void collect_batches(core::Span<const StaticMeshObject*> meshes, core::Vector<StaticMeshBatch>& batches, PassType pass_type, usize material_count, const LodSelector& lod_selector, const MeshletCuller& meshlet_culler, F&& mat_filter) {
     y_profile();
 
+    const auto is_drawable = [&](const Material& mat) {
+        return mat.draw_data().index() < material_count && mat_filter(mat);
+    };
+
     batches.set_min_capacity(meshes.size() * 4);
     for(const StaticMeshObject* mesh : meshes) {
         const u32 transform_index = mesh->transform_index;
@@ -40,33 +158,46 @@ static void collect_batches(core::Span<const StaticMeshObject*> meshes, core::Ve
             continue;
         }
 
+        const usize lod = lod_selector.select_lod(*mesh, *static_mesh);
+
+        // Meshlets only exist for the full detail mesh
+        const bool cull_meshlets = !lod && meshlet_culler.is_enabled();
+
         const core::Span<AssetPtr<Material>> materials = mesh->component.materials();
         if(materials.size() == 1) {
             if(const Material* mat = materials[0].get()) {
                 y_debug_assert(!static_mesh->draw_command().vk_indirect_data().vertexOffset);
                 const MaterialTemplate* templ = mat->material_template(pass_type);
-                if(!templ || !mat_filter(*mat)) {
+                if(!templ || !is_drawable(*mat)) {
                     continue;
                 }
-                batches.emplace_back(
-                    templ,
-                    static_mesh->draw_command().vk_indirect_data(),
-                    shader::MeshObject{transform_index, mat->draw_data().index(), static_mesh->mesh_data_index()}
-                );
+
+                const shader::MeshObject mesh_object = {transform_index, mat->draw_data().index(), static_mesh->mesh_data_index()};
+                const auto emit = [&](const MeshDrawCommand& cmd) { batches.emplace_back(templ, cmd.vk_indirect_data(), mesh_object); };
+
+                if(cull_meshlets && !static_mesh->meshlets(0).is_empty()) {
+                    for(usize i = 0; i != static_mesh->sub_mesh_count(); ++i) {
+                        meshlet_culler.for_each_visible_range(*mesh, *static_mesh, i, mat->double_sided(), emit);
+                    }
+                } else {
+                    emit(static_mesh->draw_command(lod));
+                }
             }
         } else {
-            y_debug_assert(static_mesh->sub_meshes().size() == materials.size());
+            y_debug_assert(static_mesh->sub_mesh_count() == materials.size());
             for(usize i = 0; i != materials.size(); ++i) {
                 if(const Material* mat = materials[i].get()) {
                     const MaterialTemplate* templ = mat->material_template(pass_type);
-                    if(!templ || !mat_filter(*mat)) {
+                    if(!templ || !is_drawable(*mat)) {
                         continue;
                     }
-                    batches.emplace_back(
-                        templ,
-                        static_mesh->sub_meshes()[i].vk_indirect_data(),
-                        shader::MeshObject{transform_index, mat->draw_data().index(), static_mesh->mesh_data_index()}
-                    );
+
+                    const shader::MeshObject mesh_object = {transform_index, mat->draw_data().index(), static_mesh->mesh_data_index()};
+                    const auto emit = [&](const MeshDrawCommand& cmd) { batches.emplace_back(templ, cmd.vk_indirect_data(), mesh_object); };
+
+                    if(!cull_meshlets || !meshlet_culler.for_each_visible_range(*mesh, *static_mesh, i, mat->double_sided(), emit)) {
+                        emit(static_mesh->sub_mesh_draw_command(i, lod));
+                    }
                 }
             }
         }
@@ -102,22 +233,28 @@ static void collect_batches_for_id(core::Span<const StaticMeshObject*> meshes, c
     }
 }
 
-CollectBatchesSubPass CollectBatchesSubPass::create(const SceneVisibilitySubPass& visibility, PassType pass_type) {
+CollectBatchesSubPass CollectBatchesSubPass::create(const SceneVisibilitySubPass& visibility, PassType pass_type, const LodSettings& lod_settings) {
     CollectBatchesSubPass pass;
     pass.pass_type = pass_type;
     pass.batches = std::make_shared<SceneBatches>();
+    pass.materials = material_allocator().material_buffer();
+
+    const usize material_count = pass.materials.size();
+
+    const LodSelector lod_selector(visibility.scene_view.camera(), pass_type, lod_settings);
+    const MeshletCuller meshlet_culler(visibility.scene_view, pass_type);
 
     switch(pass_type) {
         case PassType::Depth:
-            collect_batches(visibility.visible->meshes, pass.batches->static_mesh_batches, pass_type, [=](const Material&) { return true; });
+            collect_batches(visibility.visible->meshes, pass.batches->static_mesh_batches, pass_type, material_count, lod_selector, meshlet_culler, [=](const Material&) { return true; });
         break;
 
         case PassType::GBuffer:
-            collect_batches(visibility.visible->meshes, pass.batches->static_mesh_batches, pass_type, [=](const Material& mat) { return !mat.is_transparent(); });
+            collect_batches(visibility.visible->meshes, pass.batches->static_mesh_batches, pass_type, material_count, lod_selector, meshlet_culler, [=](const Material& mat) { return !mat.is_transparent(); });
         break;
 
         case PassType::Forward:
-            collect_batches(visibility.visible->meshes, pass.batches->static_mesh_batches, pass_type, [=](const Material& mat) { return mat.is_transparent(); });
+            collect_batches(visibility.visible->meshes, pass.batches->static_mesh_batches, pass_type, material_count, lod_selector, meshlet_culler, [=](const Material& mat) { return mat.is_transparent(); });
         break;
 
         case PassType::Id:
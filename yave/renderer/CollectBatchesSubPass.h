@@ -26,6 +26,7 @@ SOFTWARE.
 #include <yave/scene/Scene.h>
 
 #include <yave/graphics/shader_structs.h>
+#include <yave/graphics/buffers/Buffer.h>
 
 namespace yave {
 
@@ -40,10 +41,22 @@ struct SceneBatches {
 };
 
 struct CollectBatchesSubPass {
+    struct LodSettings {
+        // Maximum projected error, as a fraction of the screen height
+        float max_screen_error = 1.0f / 1000.0f;
+
+        // Multiplies the allowed error in depth only (shadow) passes
+        float depth_error_scale = 4.0f;
+    };
+
     PassType pass_type;
     std::shared_ptr<SceneBatches> batches;
 
-    static CollectBatchesSubPass create(const SceneVisibilitySubPass& visibility, PassType pass_type);
+    // Material buffer the batches were collected against, passes should bind this one.
+    // Materials allocated after it was fetched might not fit in it: they are skipped until the next frame.
+    TypedSubBuffer<shader::MaterialData, BufferUsage::StorageBit> materials;
+
+    static CollectBatchesSubPass create(const SceneVisibilitySubPass& visibility, PassType pass_type, const LodSettings& lod_settings = {});
 };
 
 }
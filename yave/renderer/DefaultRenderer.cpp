@@ -71,5 +71,19 @@ DefaultRenderer DefaultRenderer::create(FrameGraph& framegraph, const SceneView&
     return renderer;
 }
 
+void DefaultRenderer::precompile_pipelines(const Scene* scene, bool wait) {
+    y_profile();
+
+    SceneRenderSubPass::precompile_pipelines(scene, PassType::Depth, ShadowMapPass::render_pass_layout());
+    SceneRenderSubPass::precompile_pipelines(scene, PassType::GBuffer, GBufferPass::render_pass_layout());
+    SceneRenderSubPass::precompile_pipelines(scene, PassType::Forward, ForwardPass::render_pass_layout());
+
+    if(wait) {
+        SceneRenderSubPass::precompile_pipelines(scene, PassType::Depth, ShadowMapPass::render_pass_layout(), true);
+        SceneRenderSubPass::precompile_pipelines(scene, PassType::GBuffer, GBufferPass::render_pass_layout(), true);
+        SceneRenderSubPass::precompile_pipelines(scene, PassType::Forward, ForwardPass::render_pass_layout(), true);
+    }
+}
+
 }
 
@@ -79,6 +79,10 @@ struct DefaultRenderer {
                                   const SceneView& scene_view,
                                   const math::Vec2ui& size,
                                   const RendererSettings& settings = RendererSettings());
+
+    // Starts compiling all the pipelines needed to render the scene, should be called after the scene is loaded.
+    // Renders that are only done once (thumbnails, captures) should wait, otherwise batches that aren't ready are not drawn.
+    static void precompile_pipelines(const Scene* scene, bool wait = false);
 };
 
 }
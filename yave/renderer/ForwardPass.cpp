@@ -69,13 +69,18 @@ ForwardPass ForwardPass::create(FrameGraph& framegraph, FrameGraphImageId in_dep
     builder.add_depth_output(depth);
     builder.add_color_output(lit);
 
-    builder.set_render_func([=](RenderPassRecorder& render_pass, const FrameGraphPass* self) {
+    builder.set_parallel_render_func([=](RenderPassRecorder& render_pass, const FrameGraphPass* self, usize split_index) {
         y_debug_assert(pass.scene_pass.batches.pass_type == PassType::Forward);
-        pass.scene_pass.render(render_pass, self);
-    });
+        pass.scene_pass.render(render_pass, self, split_index);
+    }, pass.scene_pass.split_count);
 
     return pass;
 }
 
+RenderPass::Layout ForwardPass::render_pass_layout() {
+    // Renders on top of the lit G-buffer emissive target
+    return RenderPass::Layout(GBufferPass::depth_format, GBufferPass::emissive_format);
+}
+
 }
 
@@ -33,6 +33,8 @@ struct ForwardPass {
     SceneRenderSubPass scene_pass;
 
     static ForwardPass create(FrameGraph& framegraph, FrameGraphImageId in_depth, FrameGraphImageId in_lit, const CameraBufferPass& camera, const LightClusterPass& cluster, const SceneVisibilitySubPass& visibility);
+
+    static RenderPass::Layout render_pass_layout();
 };
 
 
@@ -30,12 +30,6 @@ SOFTWARE.
 namespace yave {
 
 GBufferPass GBufferPass::create(FrameGraph& framegraph, const CameraBufferPass& camera, const SceneVisibilitySubPass& visibility, const math::Vec2ui& size) {
-    static constexpr ImageFormat depth_format = VK_FORMAT_D32_SFLOAT;
-    static constexpr ImageFormat motion_format = VK_FORMAT_R16G16_SFLOAT;
-    static constexpr ImageFormat color_format = VK_FORMAT_R8G8B8A8_SRGB;
-    static constexpr ImageFormat normal_format = VK_FORMAT_R32_UINT;
-    static constexpr ImageFormat emissive_format = VK_FORMAT_B10G11R11_UFLOAT_PACK32;
-
     FrameGraphPassBuilder builder = framegraph.add_pass("G-buffer pass");
 
     const auto depth = builder.declare_image(depth_format, size);
@@ -58,13 +52,18 @@ GBufferPass GBufferPass::create(FrameGraph& framegraph, const CameraBufferPass&
     builder.add_color_output(normal);
     builder.add_color_output(emissive);
 
-    builder.set_render_func([=](RenderPassRecorder& render_pass, const FrameGraphPass* self) {
+    builder.set_parallel_render_func([=](RenderPassRecorder& render_pass, const FrameGraphPass* self, usize split_index) {
         y_debug_assert(pass.scene_pass.batches.pass_type == PassType::GBuffer);
-        pass.scene_pass.render(render_pass, self);
-    });
+        pass.scene_pass.render(render_pass, self, split_index);
+    }, pass.scene_pass.split_count);
 
     return pass;
 }
 
+RenderPass::Layout GBufferPass::render_pass_layout() {
+    const std::array<ImageFormat, 4> colors = {motion_format, color_format, normal_format, emissive_format};
+    return RenderPass::Layout(depth_format, colors);
+}
+
 }
 
@@ -27,6 +27,12 @@ SOFTWARE.
 namespace yave {
 
 struct GBufferPass {
+    static constexpr ImageFormat depth_format = VK_FORMAT_D32_SFLOAT;
+    static constexpr ImageFormat motion_format = VK_FORMAT_R16G16_SFLOAT;
+    static constexpr ImageFormat color_format = VK_FORMAT_R8G8B8A8_SRGB;
+    static constexpr ImageFormat normal_format = VK_FORMAT_R32_UINT;
+    static constexpr ImageFormat emissive_format = VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+
     SceneRenderSubPass scene_pass;
 
     FrameGraphImageId depth;
@@ -36,6 +42,8 @@ struct GBufferPass {
     FrameGraphImageId emissive;
 
     static GBufferPass create(FrameGraph& framegraph, const CameraBufferPass& camera, const SceneVisibilitySubPass& visibility, const math::Vec2ui& size);
+
+    static RenderPass::Layout render_pass_layout();
 };
 
 }
@@ -112,6 +112,7 @@ RTGIPass RTGIPass::create(FrameGraph& framegraph, const GBufferPass& gbuffer, Fr
     builder.add_uniform_input(gbuffer.scene_pass.camera);
 
     builder.add_external_input(ibl_probe ? *ibl_probe : *device_resources().empty_probe());
+    // The TLAS is built with the scene, before this is fetched: as the buffer never shrinks, all its material indices fit
     builder.add_external_input(Descriptor(material_allocator().material_buffer()));
     builder.add_storage_input(directional_buffer);
 
@@ -32,16 +32,29 @@ SOFTWARE.
 
 #include <yave/graphics/device/DeviceResources.h>
 #include <yave/graphics/device/MeshAllocator.h>
-#include <yave/graphics/device/MaterialAllocator.h>
 #include <yave/graphics/images/TextureLibrary.h>
 
+#include <yave/material/Material.h>
+#include <yave/material/MaterialTemplate.h>
+
 
 #include <yave/ecs/EntityWorld.h>
 
 
 namespace yave {
 
-static SceneRenderSubPass::RenderFunc prepare_scene_render(const Scene* scene, FrameGraphPassBuilder& builder, i32 desc_set_index, const CollectBatchesSubPass& batches, PassType pass_type) {
+// Big scene passes are split in batch ranges that can be recorded concurrently
+static constexpr usize min_batches_per_split = 256;
+static constexpr usize max_split_count = 8;
+
+static usize compute_split_count(usize batch_count, PassType pass_type) {
+    if(pass_type == PassType::Id) {
+        return 1;
+    }
+    return std::clamp(batch_count / min_batches_per_split, usize(1), max_split_count);
+}
+
+static SceneRenderSubPass::RenderFunc prepare_scene_render(const Scene* scene, FrameGraphPassBuilder& builder, i32 desc_set_index, const CollectBatchesSubPass& batches, PassType pass_type, usize split_count) {
     y_profile();
 
     const std::shared_ptr scene_batches = batches.batches;
@@ -57,18 +70,22 @@ static SceneRenderSubPass::RenderFunc prepare_scene_render(const Scene* scene, F
     builder.map_buffer(indirect_buffer);
 
     builder.add_external_input(Descriptor(scene->transform_manager().transform_buffer()), PipelineStage::None, desc_set_index);
-    builder.add_external_input(Descriptor(material_allocator().material_buffer()), PipelineStage::None, desc_set_index);
+    builder.add_external_input(Descriptor(batches.materials), PipelineStage::None, desc_set_index);
     builder.add_external_input(Descriptor(mesh_allocator().mesh_data_buffer()), PipelineStage::None, desc_set_index);
     builder.add_storage_input(object_buffer, PipelineStage::None, desc_set_index);
 
     builder.add_indrect_input(indirect_buffer);
 
-    return [=](RenderPassRecorder& render_pass, const FrameGraphPass* pass) {
+    return [=](RenderPassRecorder& render_pass, const FrameGraphPass* pass, usize split_index) {
         y_profile_zone("scene render");
 
         y_debug_assert(!scene_batches->static_mesh_batches.is_empty());
+        y_debug_assert(split_index < split_count);
 
         const core::Span<StaticMeshBatch> batches = scene_batches->static_mesh_batches;
+        const usize split_begin = batch_count * split_index / split_count;
+        const usize split_end = batch_count * (split_index + 1) / split_count;
+        y_debug_assert(split_begin < split_end);
 
         const IndirectSubBuffer buffer = pass->resources().buffer<BufferUsage::IndirectBit>(indirect_buffer);
 
@@ -86,16 +103,17 @@ static SceneRenderSubPass::RenderFunc prepare_scene_render(const Scene* scene, F
                     texture_library().descriptor_set()
                 };
 
-                usize start_of_batch = 0;
-                const MaterialTemplate* prev_template = batches[0].material_template;
+                usize start_of_batch = split_begin;
+                const MaterialTemplate* prev_template = batches[split_begin].material_template;
                 auto push_batch = [&](const MaterialTemplate* material_template, usize index) {
                     if(prev_template == material_template) {
                         return;
                     }
 
                     if(const usize batch_size = index - start_of_batch) {
-                        if(prev_template) {
-                            render_pass.bind_material_template(prev_template, desc_sets);
+                        // Batches whose pipeline is still being compiled are skipped for this frame.
+                        // One-shot renders should use DefaultRenderer::precompile_pipelines with wait = true beforehand.
+                        if(prev_template && render_pass.try_bind_material_template(prev_template, desc_sets)) {
                             render_pass.draw_indirect(IndirectSubBuffer(buffer, batch_size, start_of_batch));
                         }
 
@@ -105,7 +123,7 @@ static SceneRenderSubPass::RenderFunc prepare_scene_render(const Scene* scene, F
                     prev_template = material_template;
                 };
 
-                for(usize i = 0; i != batches.size(); ++i) {
+                for(usize i = split_begin; i != split_end; ++i) {
                     StaticMeshBatch batch = batches[i];
                     batch.cmd.firstInstance = u32(i);
 
@@ -114,10 +132,11 @@ static SceneRenderSubPass::RenderFunc prepare_scene_render(const Scene* scene, F
 
                     push_batch(batch.material_template, i);
                 }
-                push_batch(nullptr, batches.size());
+                push_batch(nullptr, split_end);
             } break;
 
             case PassType::Id: {
+                y_debug_assert(split_count == 1);
                 for(usize i = 0; i != batches.size(); ++i) {
                     const StaticMeshBatch& batch = batches[i];
                     indirect_mapping[i] = batch.cmd;
@@ -140,7 +159,8 @@ static void fill_scene_render_pass(SceneRenderSubPass& pass, FrameGraphPassBuild
     builder.add_uniform_input(pass.camera, PipelineStage::None, pass.descriptor_set_index);
 
     pass.batches = CollectBatchesSubPass::create(pass.visibility, pass_type);
-    pass.render_func = prepare_scene_render(pass.scene_view.scene(), builder, pass.descriptor_set_index, pass.batches, pass_type);
+    pass.split_count = compute_split_count(pass.batches.batches->static_mesh_batches.size(), pass_type);
+    pass.render_func = prepare_scene_render(pass.scene_view.scene(), builder, pass.descriptor_set_index, pass.batches, pass_type, pass.split_count);
 }
 
 
@@ -170,8 +190,47 @@ SceneRenderSubPass SceneRenderSubPass::create(FrameGraphPassBuilder& builder, co
 }
 
 void SceneRenderSubPass::render(RenderPassRecorder& render_pass, const FrameGraphPass* pass) const {
+    for(usize i = 0; i != split_count; ++i) {
+        render(render_pass, pass, i);
+    }
+}
+
+void SceneRenderSubPass::render(RenderPassRecorder& render_pass, const FrameGraphPass* pass, usize split_index) const {
     if(render_func) {
-        render_func(render_pass, pass);
+        render_func(render_pass, pass, split_index);
+    }
+}
+
+void SceneRenderSubPass::precompile_pipelines(const Scene* scene, PassType pass_type, const RenderPass::Layout& layout, bool wait) {
+    y_profile();
+
+    y_debug_assert(pass_type != PassType::Id);
+
+    core::Vector<const MaterialTemplate*> templates;
+    for(const StaticMeshObject& mesh : scene->meshes()) {
+        for(const AssetPtr<Material>& material : mesh.component.materials()) {
+            if(const Material* mat = material.get()) {
+                if(pass_type != PassType::Depth && mat->is_transparent() != (pass_type == PassType::Forward)) {
+                    continue;
+                }
+                if(const MaterialTemplate* templ = mat->material_template(pass_type)) {
+                    if(std::find(templates.begin(), templates.end(), templ) == templates.end()) {
+                        templates << templ;
+                    }
+                }
+            }
+        }
+    }
+
+    // Schedule everything before waiting so pipelines compile concurrently
+    for(const MaterialTemplate* templ : templates) {
+        templ->precompile(layout);
+    }
+
+    if(wait) {
+        for(const MaterialTemplate* templ : templates) {
+            templ->precompile(layout, true);
+        }
     }
 }
 
@@ -25,6 +25,7 @@ SOFTWARE.
 #include <yave/scene/Scene.h>
 #include <yave/scene/SceneView.h>
 #include <yave/framegraph/FrameGraphResourceId.h>
+#include <yave/graphics/framebuffer/RenderPass.h>
 
 #include "SceneVisibilitySubPass.h"
 #include "CollectBatchesSubPass.h"
@@ -34,7 +35,7 @@ SOFTWARE.
 namespace yave {
 
 struct SceneRenderSubPass {
-    using RenderFunc = std::function<void(RenderPassRecorder&, const FrameGraphPass*)>;
+    using RenderFunc = std::function<void(RenderPassRecorder&, const FrameGraphPass*, usize)>;
 
     SceneView scene_view;
 
@@ -42,6 +43,7 @@ struct SceneRenderSubPass {
     FrameGraphTypedBufferId<shader::Camera> camera;
 
     RenderFunc render_func;
+    usize split_count = 1;
 
     SceneVisibilitySubPass visibility;
     CollectBatchesSubPass batches;
@@ -50,6 +52,12 @@ struct SceneRenderSubPass {
     static SceneRenderSubPass create(FrameGraphPassBuilder& builder, const CameraBufferPass& camera, const SceneVisibilitySubPass& visibility, PassType pass_type);
 
     void render(RenderPassRecorder& render_pass, const FrameGraphPass* pass) const;
+
+    // Renders a range of batches, different splits can be recorded concurrently
+    void render(RenderPassRecorder& render_pass, const FrameGraphPass* pass, usize split_index) const;
+
+    // Starts compiling the pipelines of all the scene's materials in the background, if wait is true also waits for them
+    static void precompile_pipelines(const Scene* scene, PassType pass_type, const RenderPass::Layout& layout, bool wait = false);
 };
 
 
@@ -219,12 +219,11 @@ static float total_occupancy(const ShadowCastingLights& lights) {
 
 
 
+static constexpr ImageFormat shadow_format = VK_FORMAT_D32_SFLOAT;
+
 ShadowMapPass ShadowMapPass::create(FrameGraph& framegraph, const SceneVisibilitySubPass& visibility, const ShadowMapSettings& settings) {
     y_profile();
 
-
-    static constexpr ImageFormat shadow_format = VK_FORMAT_D32_SFLOAT;
-
     FrameGraphPassBuilder builder = framegraph.add_pass("Shadow pass");
 
     const u32 shadow_map_log_size = log2ui(settings.shadow_map_size);
@@ -294,25 +293,29 @@ ShadowMapPass ShadowMapPass::create(FrameGraph& framegraph, const SceneVisibilit
 
     builder.map_buffer(shadow_buffer);
     builder.add_depth_output(shadow_map);
-    builder.set_render_func([=, passes = std::move(sub_passes)](RenderPassRecorder& render_pass, const FrameGraphPass* self) {
+    // Each shadow map is its own split
+    const usize split_count = sub_passes.size();
+    builder.set_parallel_render_func([=, passes = std::move(sub_passes)](RenderPassRecorder& render_pass, const FrameGraphPass* self, usize split_index) {
         auto shadow_infos = self->resources().map_buffer(shadow_buffer);
 
-        for(usize i = 0; i != passes.size(); ++i) {
-            const ShadowSubPass& pass = passes[i];
-            shadow_infos[i] = pass.info;
-            
-            const char* pass_name = pass.scene_pass.scene_view.camera().is_orthographic() ? "Directional cascade" : "Spot light";
-            y_profile_dyn_zone(pass_name);
+        const ShadowSubPass& pass = passes[split_index];
+        shadow_infos[split_index] = pass.info;
 
-            const auto region = render_pass.region(pass_name);
-            render_pass.set_viewport(Viewport(math::Vec2(float(pass.viewport_size)), pass.viewport_offset));
-            pass.scene_pass.render(render_pass, self);
-        }
-    });
+        const char* pass_name = pass.scene_pass.scene_view.camera().is_orthographic() ? "Directional cascade" : "Spot light";
+        y_profile_dyn_zone(pass_name);
+
+        const auto region = render_pass.region(pass_name);
+        render_pass.set_viewport(Viewport(math::Vec2(float(pass.viewport_size)), pass.viewport_offset));
+        pass.scene_pass.render(render_pass, self);
+    }, split_count);
 
 
     return pass;
 }
 
+RenderPass::Layout ShadowMapPass::render_pass_layout() {
+    return RenderPass::Layout(shadow_format, {});
+}
+
 }
 
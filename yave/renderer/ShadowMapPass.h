@@ -45,6 +45,8 @@ struct ShadowMapPass {
     std::shared_ptr<core::FlatHashMap<const void*, math::Vec4ui>> shadow_indices;
 
     static ShadowMapPass create(FrameGraph& framegraph, const SceneVisibilitySubPass& visibility, const ShadowMapSettings& settings = ShadowMapSettings());
+
+    static RenderPass::Layout render_pass_layout();
 };
 
 
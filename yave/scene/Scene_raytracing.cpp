@@ -37,7 +37,7 @@ void Scene::update_tlas() {
         y_profile_zone("gather instances");
         for(const StaticMeshObject& mesh_obj : _meshes) {
             if(const StaticMesh* mesh = mesh_obj.component.mesh().get()) {
-                const math::Transform<>& tr = transform(mesh_obj);
+                const math::Transform<> tr = transform(mesh_obj) * mesh->position_decode_transform();
 
                 const auto blases = mesh->blases();
                 const auto materials = mesh_obj.component.materials();
@@ -22,9 +22,11 @@ SOFTWARE.
 
 #include "TransformManager.h"
 
+#include <yave/graphics/graphics.h>
 #include <yave/graphics/commands/CmdBufferRecorder.h>
 #include <yave/graphics/barriers/Barrier.h>
 #include <yave/graphics/device/DeviceResources.h>
+#include <yave/graphics/device/UploadRing.h>
 
 namespace yave {
 
@@ -90,8 +92,8 @@ void TransformManager::update_buffer(ComputeCapableCmdBufferRecorder& recorder)
     };
 
 
-    auto transform_staging = TypedBuffer<math::Transform<>, BufferUsage::StorageBit, MemoryType::Staging>(update_count);
-    auto index_staging = TypedBuffer<u32, BufferUsage::StorageBit, MemoryType::Staging>(update_count);
+    const auto transform_staging = upload_ring().allocate<math::Transform<>>(recorder, update_count);
+    const auto index_staging = upload_ring().allocate<u32>(recorder, update_count);
 
     {
         usize updates = 0;
@@ -123,8 +125,8 @@ void TransformManager::update_buffer(ComputeCapableCmdBufferRecorder& recorder)
         const u32 count = u32(update_count);
         const auto descriptors = make_descriptor_set(
             _transform_buffer,
-            transform_staging,
-            index_staging,
+            SubBuffer<BufferUsage::StorageBit>(transform_staging),
+            SubBuffer<BufferUsage::StorageBit>(index_staging),
             InlineDescriptor(count)
         );
 
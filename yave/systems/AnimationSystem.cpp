@@ -0,0 +1,145 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "AnimationSystem.h"
+#include "TimeSystem.h"
+
+#include <yave/components/AnimatorComponent.h>
+#include <yave/components/TransformableComponent.h>
+
+#include <y/concurrent/JobSystem.h>
+
+#include <cstring>
+
+namespace yave {
+
+AnimationSystem::AnimationSystem() : ecs::System("AnimationSystem") {
+}
+
+void AnimationSystem::setup(ecs::SystemScheduler& sched) {
+    sched.schedule(ecs::SystemSchedule::Update, "Update animations", [this](
+            const ecs::EntityWorld& world,
+            concurrent::JobSystem* job_system,
+            ecs::EntityGroup<ecs::Mutate<AnimatorComponent>, TransformableComponent>&& group) {
+
+        update(TimeSystem::dt(world), job_system, group);
+    });
+}
+
+const BonePalette& AnimationSystem::bone_palette() const {
+    return _palette;
+}
+
+void AnimationSystem::set_view_position(const math::Vec3& pos) {
+    _view_position = pos;
+}
+
+void AnimationSystem::set_lod_distance(float distance) {
+    _lod_distance = std::max(distance, math::epsilon<float>);
+}
+
+void AnimationSystem::set_max_update_interval(u32 frames) {
+    _max_update_interval = std::max(frames, 1u);
+}
+
+u32 AnimationSystem::update_interval(float distance) const {
+    return std::min(_max_update_interval, 1 + u32(distance / _lod_distance));
+}
+
+void AnimationSystem::update(float dt, concurrent::JobSystem* job_system, ecs::EntityGroup<ecs::Mutate<AnimatorComponent>, TransformableComponent>& group) {
+    y_profile();
+
+    ++_frame;
+    _instances.make_empty();
+
+    usize bone_count = 0;
+
+    {
+        y_profile_zone("Collect animators");
+
+        for(auto&& [id, animator, tr] : group.id_components()) {
+            animator._bone_offset = u32(-1);
+
+            if(!animator._skeleton || !animator._animation) {
+                continue;
+            }
+
+            if(animator._needs_binding) {
+                animator._bound_animation = BoundAnimation(*animator._animation, *animator._skeleton);
+                animator._key_cursors = core::Vector<u32>(animator._bound_animation.track_count(), 0);
+                animator._needs_binding = false;
+            }
+
+            const usize animator_bones = animator._skeleton->bones().size();
+            animator._bone_offset = u32(bone_count);
+            bone_count += animator_bones;
+
+            const float duration = animator._bound_animation.duration();
+            animator._time = duration > 0.0f ? std::fmod(animator._time + dt, duration) : 0.0f;
+
+            // Distant animators are staggered so they don't all get evaluated on the same frame
+            animator._update_interval = update_interval((tr.position() - _view_position).length());
+            const bool has_pose = animator._pose.size() == animator_bones;
+            const bool evaluate = !has_pose || (_frame + id.index()) % animator._update_interval == 0;
+
+            _instances << Instance{&animator, evaluate};
+        }
+    }
+
+    _palette.next_frame(bone_count);
+
+    if(_instances.is_empty()) {
+        return;
+    }
+
+    auto mapping = _palette.buffer().map(MappingAccess::WriteOnly);
+    math::Transform<>* palette = mapping.data();
+
+    const auto update_instances = [&](const Instance* begin, const Instance* end) {
+        for(const Instance* it = begin; it != end; ++it) {
+            AnimatorComponent& animator = *it->animator;
+            const Skeleton& skeleton = *animator._skeleton;
+
+            if(it->evaluate) {
+                animator._pose.set_min_size(skeleton.bones().size());
+                animator._bound_animation.evaluate(skeleton, animator._time, animator._key_cursors, animator._pose);
+            }
+
+            // Skipped animators still need their last pose in this frame's palette
+            std::memcpy(palette + animator._bone_offset, animator._pose.data(), animator._pose.size() * sizeof(math::Transform<>));
+        }
+    };
+
+    {
+        y_profile_zone("Evaluate poses");
+
+        const Instance* begin = _instances.data();
+        const Instance* end = begin + _instances.size();
+        if(job_system) {
+            job_system->parallel_for(begin, end, update_instances);
+        } else {
+            update_instances(begin, end);
+        }
+    }
+}
+
+}
@@ -0,0 +1,70 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_SYSTEMS_ANIMATIONSYSTEM_H
+#define YAVE_SYSTEMS_ANIMATIONSYSTEM_H
+
+#include <yave/ecs/EntityWorld.h>
+
+#include <yave/animations/BonePalette.h>
+
+namespace yave {
+
+// Updates every AnimatorComponent in parallel and packs their bones in a single bone palette.
+// Animators far from the view position are only evaluated every few frames.
+class AnimationSystem : public ecs::System {
+    public:
+        AnimationSystem();
+
+        void setup(ecs::SystemScheduler& sched) override;
+
+        const BonePalette& bone_palette() const;
+
+        void set_view_position(const math::Vec3& pos);
+
+        // Animators closer than lod_distance are evaluated every frame,
+        // the update interval then grows by one frame every lod_distance up to max_update_interval
+        void set_lod_distance(float distance);
+        void set_max_update_interval(u32 frames);
+
+    private:
+        struct Instance {
+            AnimatorComponent* animator = nullptr;
+            bool evaluate = false;
+        };
+
+        u32 update_interval(float distance) const;
+
+        void update(float dt, concurrent::JobSystem* job_system, ecs::EntityGroup<ecs::Mutate<AnimatorComponent>, TransformableComponent>& group);
+
+        BonePalette _palette;
+        core::Vector<Instance> _instances;
+
+        math::Vec3 _view_position;
+        float _lod_distance = 25.0f;
+        u32 _max_update_interval = 8;
+
+        u64 _frame = 0;
+};
+
+}
+
+#endif // YAVE_SYSTEMS_ANIMATIONSYSTEM_H
@@ -21,6 +21,7 @@ SOFTWARE.
 **********************************/
 
 #include "SceneSystem.h"
+#include "TransformSystem.h"
 
 namespace yave {
 
@@ -30,9 +31,13 @@ SceneSystem::SceneSystem() : ecs::System("SceneSystem") {
 void SceneSystem::setup(ecs::SystemScheduler& sched) {
     _scene = std::make_unique<EcsScene>(&world());
 
+    // Transforms need to be propagated before the scene picks up the changes
+    const TransformSystem* transform_system = world().find_system<TransformSystem>();
+    y_always_assert(transform_system, "SceneSystem requires a TransformSystem, which should be added before it");
+
     sched.schedule(ecs::SystemSchedule::PostUpdate, "Scene update", [&]() {
         _scene->update_from_world();
-    });
+    }, transform_system->propagation_job());
 }
 
 
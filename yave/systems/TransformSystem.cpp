@@ -0,0 +1,188 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+
+#include "TransformSystem.h"
+
+#include <yave/components/TransformableComponent.h>
+
+#include <y/concurrent/JobSystem.h>
+
+namespace yave {
+
+TransformSystem::TransformSystem() : ecs::System("TransformSystem") {
+}
+
+void TransformSystem::setup(ecs::SystemScheduler& sched) {
+    _propagation_job = sched.schedule(ecs::SystemSchedule::PostUpdate, "Propagate transforms", [this](concurrent::JobSystem* job_system) {
+        propagate(job_system);
+    });
+}
+
+ecs::SystemJobHandle TransformSystem::propagation_job() const {
+    return _propagation_job;
+}
+
+void TransformSystem::propagate(concurrent::JobSystem* job_system) {
+    y_profile();
+
+    ecs::EntityWorld& world = this->world();
+
+    _dirty.make_empty();
+    _roots.make_empty();
+
+    {
+        y_profile_zone("Collect dirty entities");
+
+        auto group = world.create_group<ecs::Changed<TransformableComponent>>();
+        for(const ecs::EntityId id : group.ids()) {
+            _dirty.insert(id);
+        }
+
+        for(const ecs::EntityId id : world.parent_changed()) {
+            if(world.exists(id)) {
+                _dirty.insert(id);
+            }
+        }
+    }
+
+    {
+        y_profile_zone("Find dirty roots");
+
+        for(const ecs::EntityId id : _dirty) {
+            if(!world.has_children(id)) {
+                const TransformableComponent* tr = world.component<TransformableComponent>(id);
+                if(!tr || !tr->is_parent_relative()) {
+                    continue;
+                }
+            }
+
+            // Subtrees under a dirty ancestor will be processed with it
+            bool has_dirty_parent = false;
+            for(const ecs::EntityId parent : world.parents(id)) {
+                if(_dirty.contains(parent)) {
+                    has_dirty_parent = true;
+                    break;
+                }
+            }
+
+            if(!has_dirty_parent) {
+                _roots << id;
+            }
+        }
+    }
+
+    if(_roots.is_empty()) {
+        return;
+    }
+
+    _subtrees.set_min_size(_roots.size());
+
+    {
+        y_profile_zone("Propagate");
+
+        // Roots are independent, so their subtrees can be processed in parallel
+        const auto process_roots = [&](usize begin, usize end) {
+            for(usize i = begin; i != end; ++i) {
+                propagate_subtree(world, _roots[i], _subtrees[i]);
+            }
+        };
+
+        if(job_system && _roots.size() > 1) {
+            job_system->parallel_for(usize(0), _roots.size(), process_roots);
+        } else {
+            process_roots(0, _roots.size());
+        }
+    }
+
+    {
+        y_profile_zone("Write transforms");
+
+        for(usize i = 0; i != _roots.size(); ++i) {
+            for(const Node& node : _subtrees[i]) {
+                if(!node.changed) {
+                    continue;
+                }
+
+                // This marks the component as changed for the scene
+                TransformableComponent* tr = world.component_mut<TransformableComponent>(node.id);
+                tr->_transform = node.world;
+                tr->_local_transform = node.local;
+                tr->_sync_local = false;
+            }
+        }
+    }
+}
+
+void TransformSystem::propagate_subtree(const ecs::EntityWorld& world, ecs::EntityId root, core::Vector<Node>& nodes) const {
+    nodes.make_empty();
+
+    const auto push_node = [&](ecs::EntityId id, const math::Transform<>& parent_world) {
+        Node& node = nodes.emplace_back();
+        node.id = id;
+
+        const TransformableComponent* tr = world.component<TransformableComponent>(id);
+        if(!tr) {
+            // Entities without transform are transparent to their children
+            node.world = parent_world;
+            return;
+        }
+
+        node.world = tr->transform();
+        node.local = tr->local_transform();
+
+        if(!tr->is_parent_relative()) {
+            return;
+        }
+
+        if(tr->_sync_local || world.parent_changed().contains(id)) {
+            // The world transform was set directly (or the entity was reparented): keep it and recompute the local one
+            node.local = parent_world.inverse() * node.world;
+            node.changed = true;
+        } else {
+            node.world = parent_world * node.local;
+            node.changed = node.world != tr->transform();
+        }
+    };
+
+    {
+        math::Transform<> parent_world;
+        for(const ecs::EntityId parent : world.parents(root)) {
+            if(const TransformableComponent* tr = world.component<TransformableComponent>(parent)) {
+                parent_world = tr->transform();
+                break;
+            }
+        }
+
+        push_node(root, parent_world);
+    }
+
+    // Breadth first so that parents are always processed before their children
+    for(usize i = 0; i != nodes.size(); ++i) {
+        const ecs::EntityId id = nodes[i].id;
+        const math::Transform<> world_transform = nodes[i].world;
+        for(const ecs::EntityId child : world.direct_children(id)) {
+            push_node(child, world_transform);
+        }
+    }
+}
+
+}
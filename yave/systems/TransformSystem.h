@@ -0,0 +1,63 @@
+/*******************************
+Copyright (c) 2016-2026 Grégoire Angerand
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+**********************************/
+#ifndef YAVE_SYSTEMS_TRANSFORMSYSTEM_H
+#define YAVE_SYSTEMS_TRANSFORMSYSTEM_H
+
+#include <yave/ecs/EntityWorld.h>
+
+#include <y/math/Transform.h>
+
+namespace yave {
+
+// Propagates the transforms of parent relative TransformableComponents.
+// Only the subtrees under entities that changed (or got reparented) are updated.
+class TransformSystem : public ecs::System {
+    public:
+        TransformSystem();
+
+        void setup(ecs::SystemScheduler& sched) override;
+
+        // Systems reading transforms after the update stage should depend on this
+        ecs::SystemJobHandle propagation_job() const;
+
+    private:
+        struct Node {
+            ecs::EntityId id;
+            math::Transform<> world;
+            math::Transform<> local;
+            bool changed = false;
+        };
+
+        void propagate(concurrent::JobSystem* job_system);
+        void propagate_subtree(const ecs::EntityWorld& world, ecs::EntityId root, core::Vector<Node>& nodes) const;
+
+        ecs::SystemJobHandle _propagation_job;
+
+        // Reused across frames to avoid allocations
+        core::Vector<ecs::EntityId> _roots;
+        core::Vector<core::Vector<Node>> _subtrees;
+        ecs::SparseIdSet _dirty;
+};
+
+}
+
+#endif // YAVE_SYSTEMS_TRANSFORMSYSTEM_H
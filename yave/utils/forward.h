@@ -30,6 +30,8 @@ class AABB;
 class AccelerationStructure;
 class Animation;
 class AnimationChannel;
+class AnimationSystem;
+class AnimatorComponent;
 class AssetDependencies;
 class AssetLoader;
 class AssetLoaderSystem;
@@ -38,6 +40,8 @@ class AssetLoadingThreadPool;
 class AssetStore;
 class AtmosphereComponent;
 class BLAS;
+class BonePalette;
+class BoundAnimation;
 class BufferBarrier;
 class BufferBase;
 class BufferMappingBase;
@@ -73,12 +77,15 @@ class FolderAssetStore;
 class FolderFileSystemModel;
 class FrameGraph;
 class FrameGraphComputePassBuilder;
+class FrameGraphCulling;
 class FrameGraphDescriptorBinding;
 class FrameGraphFrameResources;
+class FrameGraphHeapPacker;
 class FrameGraphPass;
 class FrameGraphPassBuilder;
 class FrameGraphPassBuilderBase;
 class FrameGraphPersistentResourceId;
+class FrameGraphPlan;
 class FrameGraphRegion;
 class FrameGraphResourceId;
 class FrameGraphResourcePool;
@@ -113,7 +120,10 @@ class MeshData;
 class MeshDrawData;
 class MeshVertexStreams;
 class PhysicalDevice;
+class PipelineCache;
 class PointLightComponent;
+class Pose;
+class PoseGraph;
 class RaytracingProgram;
 class RenderPass;
 class RenderPassRecorder;
@@ -146,7 +156,10 @@ class TransferCmdBufferRecorder;
 class TransformManager;
 class TransformableComponent;
 class TransientBuffer;
+class TransientHeap;
 class TransientMipViewContainer;
+class UploadQueue;
+class UploadRing;
 class Window;
 struct AOPass;
 struct AOSettings;
@@ -212,6 +225,7 @@ struct LoadableComponentTypeInfo;
 struct MeshDrawBuffers;
 struct MeshDrawCommand;
 struct MeshTriangleData;
+struct MeshTriangleRange;
 struct Mip;
 struct Monitor;
 struct ObjectIndices;